@@ -0,0 +1,28 @@
+#include "stdafx.h"
+
+#include "camera.h"
+
+Camera
+make_camera(float time)
+{
+    Camera camera = {};
+
+    // NOTE(gr3yknigh1): Zoom goes from 1x to 4x, pan keeps the view inside the grid, which spans [-1, 1]. [2025/04/01]
+    camera.zoom = 2.5f - 1.5f * cosf(time * 0.25f);
+
+    float pan = 1.0f - 1.0f / camera.zoom;
+    camera.position[0] = pan * sinf(time * 0.3f);
+    camera.position[1] = pan * cosf(time * 0.2f);
+
+    return camera;
+}
+
+bool
+camera_is_circle_visible(const Camera &camera, const float center[2], float radius)
+{
+    float x = (center[0] - camera.position[0]) * camera.zoom;
+    float y = (center[1] - camera.position[1]) * camera.zoom;
+    float view_radius = radius * camera.zoom;
+
+    return fabsf(x) - view_radius <= 1.0f && fabsf(y) - view_radius <= 1.0f;
+}
@@ -0,0 +1,22 @@
+#pragma once
+///
+/// @brief 2D camera, applied after draw's own transform: `(position - camera.position) * camera.zoom`.
+/// @note Pushed right after `Draw_Push_Constants`, at `s_camera_push_constant_offset`.
+///
+
+struct Camera {
+    float position[2] = {};
+    float zoom        = 1.0f;
+};
+
+constexpr uint32_t s_camera_push_constant_offset = 16;
+
+///
+/// @brief Slowly pans and zooms over the grid, so part of it goes off screen. Deterministic for given `time`.
+///
+Camera make_camera(float time);
+
+///
+/// @brief Tests bounding circle in world space against the view, which is [-1, 1] square after camera transform.
+///
+bool camera_is_circle_visible(const Camera &camera, const float center[2], float radius);
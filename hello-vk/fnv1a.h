@@ -0,0 +1,22 @@
+#pragma once
+///
+/// @brief 64-bit FNV-1a. Cheap, and good enough to notice changed or corrupted data, not for anything adversarial.
+///
+
+constexpr uint64_t s_fnv1a_offset_basis = 0xcbf29ce484222325ull;
+constexpr uint64_t s_fnv1a_prime        = 0x100000001b3ull;
+
+///
+/// @param hash Result of the previous piece, so data may be hashed piece by piece. Same as hashing them joined.
+///
+inline uint64_t
+fnv1a(const void *data, size_t size, uint64_t hash = s_fnv1a_offset_basis)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    for (size_t index = 0; index < size; ++index) {
+        hash ^= bytes[index];
+        hash *= s_fnv1a_prime;
+    }
+    return hash;
+}
@@ -0,0 +1,219 @@
+#include "stdafx.h"
+
+#include "frame_arena.h"
+
+static std::atomic<uint64_t> s_heap_allocations_count = 0;
+
+static uintptr_t
+frame_arena_align_up(uintptr_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+}
+
+void
+frame_arena_init(Frame_Arena *arena, size_t capacity)
+{
+    *arena = {};
+    arena->base = static_cast<uint8_t *>(malloc(capacity));
+    arena->capacity = arena->base != nullptr ? capacity : 0;
+
+    // NOTE(gr3yknigh1): Overflow is rare, but bookkeeping of it shouldn't be the thing which allocates. [2025/04/07]
+    arena->overflow_blocks.reserve(16);
+}
+
+void
+frame_arena_destroy(Frame_Arena *arena)
+{
+    for (void *block : arena->overflow_blocks) {
+        free(block);
+    }
+
+    free(arena->base);
+    *arena = {};
+}
+
+void
+frame_arena_reset(Frame_Arena *arena)
+{
+    size_t used = arena->offset + arena->overflow_size;
+    arena->high_water = std::max(arena->high_water, used);
+
+    if (!arena->overflow_blocks.empty()) {
+        for (void *block : arena->overflow_blocks) {
+            free(block);
+        }
+        arena->overflow_blocks.clear();
+
+        size_t capacity = std::max<size_t>(arena->capacity, 4096);
+        while (capacity < arena->high_water) {
+            capacity *= 2;
+        }
+
+        uint8_t *base = static_cast<uint8_t *>(malloc(capacity));
+        if (base != nullptr) {
+            free(arena->base);
+            arena->base = base;
+            arena->capacity = capacity;
+            arena->grows_count++;
+
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION, "Frame arena: frame pushed %zu KiB, grown to %zu KiB", used / 1024, capacity / 1024);
+        }
+    }
+
+    arena->offset = 0;
+    arena->overflow_size = 0;
+}
+
+void *
+frame_arena_push(Frame_Arena *arena, size_t size, size_t alignment)
+{
+    SDL_assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(arena->base);
+    uintptr_t address = frame_arena_align_up(base + arena->offset, alignment);
+
+    if (arena->base != nullptr && address + size <= base + arena->capacity) {
+        arena->offset = address + size - base;
+        return reinterpret_cast<void *>(address);
+    }
+
+    // NOTE(gr3yknigh1): Counted as heap allocation of the frame, that's what it is. [2025/04/07]
+    s_heap_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+    void *block = malloc(size + alignment);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    arena->overflow_blocks.push_back(block);
+    arena->overflow_size += size + alignment;
+
+    return reinterpret_cast<void *>(frame_arena_align_up(reinterpret_cast<uintptr_t>(block), alignment));
+}
+
+uint64_t
+heap_allocations_count(void)
+{
+    return s_heap_allocations_count.load(std::memory_order_relaxed);
+}
+
+void
+frame_heap_stats_begin(Frame_Heap_Stats *stats, uint32_t warmup_frames_count)
+{
+    *stats = {};
+    stats->warmup_frames_count = warmup_frames_count;
+    stats->last_count = heap_allocations_count();
+    stats->frequency = SDL_GetPerformanceFrequency();
+    stats->report_counter = SDL_GetPerformanceCounter();
+}
+
+void
+frame_heap_stats_tick(Frame_Heap_Stats *stats)
+{
+    uint64_t count = heap_allocations_count();
+    uint64_t frame_count = count - stats->last_count;
+    stats->last_count = count;
+
+    stats->frames_count++;
+    if (stats->frames_count <= stats->warmup_frames_count) {
+        return;
+    }
+
+    stats->report_count += frame_count;
+
+    stats->run_count += frame_count;
+    stats->run_allocating_count += frame_count > 0 ? 1 : 0;
+    stats->run_max_count = std::max(stats->run_max_count, frame_count);
+
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    // NOTE(gr3yknigh1): Report once per second, like frame time, but only when something allocated. [2025/04/07]
+    if (counter - stats->report_counter >= stats->frequency) {
+        if (stats->report_count > 0) {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION, "Heap: %llu allocations in steady frames over the last second",
+                static_cast<unsigned long long>(stats->report_count));
+        }
+
+        stats->report_counter = counter;
+        stats->report_count = 0;
+    }
+}
+
+void
+frame_heap_stats_report_run(const Frame_Heap_Stats *stats)
+{
+    if (stats->frames_count <= stats->warmup_frames_count) {
+        return;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Run: %llu heap allocations in %llu of %llu steady frames (max %llu per frame)",
+        static_cast<unsigned long long>(stats->run_count), static_cast<unsigned long long>(stats->run_allocating_count),
+        static_cast<unsigned long long>(stats->frames_count - stats->warmup_frames_count),
+        static_cast<unsigned long long>(stats->run_max_count));
+}
+
+//
+// NOTE(gr3yknigh1): Replaced global allocation functions, so every `new` (STL containers included) of every thread is
+// counted. Nothrow and array forms forward to these by default. [2025/04/07]
+//
+void *
+operator new(size_t size)
+{
+    s_heap_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+    void *block = malloc(size > 0 ? size : 1);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+void *
+operator new(size_t size, std::align_val_t alignment)
+{
+    s_heap_allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+    size_t align = static_cast<size_t>(alignment);
+    size = frame_arena_align_up(size > 0 ? size : 1, align);
+
+#if defined(_MSC_VER)
+    void *block = _aligned_malloc(size, align);
+#else
+    void *block = aligned_alloc(align, size);
+#endif
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+void
+operator delete(void *block) noexcept
+{
+    free(block);
+}
+
+void
+operator delete(void *block, std::align_val_t) noexcept
+{
+#if defined(_MSC_VER)
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+void
+operator delete(void *block, size_t) noexcept
+{
+    operator delete(block);
+}
+
+void
+operator delete(void *block, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(block, alignment);
+}
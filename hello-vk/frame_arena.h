@@ -0,0 +1,126 @@
+#pragma once
+///
+/// @brief Per-frame bump allocator and heap allocation counter.
+///
+/// Every frame in flight owns an arena, which is reset once the frame's timeline value is waited, so anything pushed into it
+/// lives exactly as long as the frame's command buffers may be in use. Push is a pointer bump, nothing is freed one
+/// by one. Use it for per-frame scratch: draw lists, barrier arrays, create-info structs.
+///
+/// @note Arena which runs out of space falls back to heap blocks for the rest of the frame and grows to the frame's
+/// high water mark on next reset, so after a few frames steady state doesn't touch the heap.
+///
+
+struct Frame_Arena {
+    uint8_t *base     = nullptr;
+    size_t   capacity = 0;
+    size_t   offset   = 0;
+
+    std::vector<void *> overflow_blocks; // Heap blocks pushed past capacity, freed on reset.
+    size_t              overflow_size = 0;
+
+    size_t   high_water  = 0; // The most one frame has pushed, including overflow.
+    uint64_t grows_count = 0;
+};
+
+void frame_arena_init(Frame_Arena *arena, size_t capacity);
+void frame_arena_destroy(Frame_Arena *arena);
+
+///
+/// @brief Forgets everything pushed since the last reset. Grows arena if the frame overflowed it.
+///
+void frame_arena_reset(Frame_Arena *arena);
+
+///
+/// @param alignment Power of two.
+/// @return Uninitialized memory, valid until next `frame_arena_reset`.
+///
+void *frame_arena_push(Frame_Arena *arena, size_t size, size_t alignment);
+
+///
+/// @brief Pushes `count` zero-initialized elements, same as `T value = {};` for Vulkan structs.
+///
+template <typename T>
+T *
+frame_arena_push_array(Frame_Arena *arena, size_t count)
+{
+    static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+
+    T *result = static_cast<T *>(frame_arena_push(arena, count * sizeof(T), alignof(T)));
+    memset(result, 0, count * sizeof(T));
+    return result;
+}
+
+///
+/// @brief STL allocator on top of frame arena.
+///
+/// @note Deallocation is a no-op, memory comes back on reset. Growing container leaves its old storage in the arena
+/// until then, so reserve if the size is known up front.
+///
+template <typename T>
+struct Frame_Allocator {
+    using value_type = T;
+
+    Frame_Arena *arena = nullptr;
+
+    Frame_Allocator(Frame_Arena *arena) noexcept : arena(arena)
+    {
+    }
+
+    template <typename U>
+    Frame_Allocator(const Frame_Allocator<U> &other) noexcept : arena(other.arena)
+    {
+    }
+
+    T *
+    allocate(size_t count)
+    {
+        return static_cast<T *>(frame_arena_push(arena, count * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T *, size_t) noexcept
+    {
+    }
+
+    template <typename U>
+    bool
+    operator==(const Frame_Allocator<U> &other) const noexcept
+    {
+        return arena == other.arena;
+    }
+};
+
+template <typename T>
+using Frame_Vector = std::vector<T, Frame_Allocator<T>>;
+
+///
+/// @return `operator new` calls made by any thread since start. `malloc` called directly (SDL, Vulkan driver) isn't
+/// counted.
+///
+uint64_t heap_allocations_count(void);
+
+struct Frame_Heap_Stats {
+    uint32_t warmup_frames_count = 0;
+    uint64_t frames_count        = 0;
+    uint64_t last_count          = 0;
+
+    uint64_t frequency      = 0;
+    uint64_t report_counter = 0;
+    uint64_t report_count   = 0; // Allocated by steady frames since the last report.
+
+    uint64_t run_count            = 0; // Allocated by steady frames.
+    uint64_t run_allocating_count = 0; // Steady frames which allocated.
+    uint64_t run_max_count        = 0;
+};
+
+///
+/// @param warmup_frames_count Frames which may allocate: swapchain, pipelines, uploads and containers settle there.
+///
+void frame_heap_stats_begin(Frame_Heap_Stats *stats, uint32_t warmup_frames_count);
+
+///
+/// @brief Counts allocations since the previous tick. Call once per frame.
+///
+void frame_heap_stats_tick(Frame_Heap_Stats *stats);
+
+void frame_heap_stats_report_run(const Frame_Heap_Stats *stats);
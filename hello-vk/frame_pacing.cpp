@@ -0,0 +1,228 @@
+#include "stdafx.h"
+
+#include "frame_pacing.h"
+
+// NOTE(gr3yknigh1): Slack for wake up jitter and work estimate error, better to idle a bit than to miss. [2025/04/04]
+constexpr double s_limiter_margin_ms = 0.5;
+
+// NOTE(gr3yknigh1): `SDL_Delay` may oversleep by scheduler quantum, the last part is spun. [2025/04/04]
+constexpr double s_limiter_spin_ms = 2.0;
+
+struct Present_Mode_Name {
+    VkPresentModeKHR mode;
+    const char      *name;
+};
+
+static const Present_Mode_Name s_present_mode_names[] = {
+    { VK_PRESENT_MODE_FIFO_KHR,         "fifo" },
+    { VK_PRESENT_MODE_FIFO_RELAXED_KHR, "fifo-relaxed" },
+    { VK_PRESENT_MODE_MAILBOX_KHR,      "mailbox" },
+    { VK_PRESENT_MODE_IMMEDIATE_KHR,    "immediate" },
+};
+
+const char *
+present_mode_name(VkPresentModeKHR present_mode)
+{
+    for (const auto &entry : s_present_mode_names) {
+        if (entry.mode == present_mode) {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+std::optional<VkPresentModeKHR>
+present_mode_from_name(std::string_view name)
+{
+    for (const auto &entry : s_present_mode_names) {
+        if (name == entry.name) {
+            return entry.mode;
+        }
+    }
+    return std::nullopt;
+}
+
+void
+frame_limiter_init(Frame_Limiter *limiter, uint32_t fps_limit)
+{
+    *limiter = {};
+    limiter->frequency = SDL_GetPerformanceFrequency();
+    limiter->period = fps_limit > 0 ? limiter->frequency / fps_limit : 0;
+}
+
+uint64_t
+frame_limiter_wait(Frame_Limiter *limiter)
+{
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    if (limiter->period == 0) {
+        limiter->input_counter = counter;
+        return counter;
+    }
+
+    // NOTE(gr3yknigh1): First frame, or a hitch (window drag, breakpoint): don't try to catch up, start over. [2025/04/04]
+    if (limiter->deadline == 0 || counter > limiter->deadline + limiter->period) {
+        limiter->deadline = counter + limiter->period;
+    }
+
+    double frequency_ms = static_cast<double>(limiter->frequency) / 1000.0;
+    uint64_t lead = static_cast<uint64_t>(limiter->work_ticks + s_limiter_margin_ms * frequency_ms);
+    uint64_t wake_counter = limiter->deadline - std::min(lead, limiter->period);
+
+    uint64_t now = counter;
+    while (now < wake_counter) {
+        double remaining_ms = static_cast<double>(wake_counter - now) / frequency_ms;
+
+        if (remaining_ms > s_limiter_spin_ms) {
+            SDL_Delay(static_cast<uint32_t>(remaining_ms - s_limiter_spin_ms) + 1);
+        } else {
+            std::this_thread::yield();
+        }
+
+        now = SDL_GetPerformanceCounter();
+    }
+
+    limiter->waited_ticks += now - counter;
+    limiter->input_counter = now;
+    return now;
+}
+
+void
+frame_limiter_end_frame(Frame_Limiter *limiter)
+{
+    if (limiter->period == 0) {
+        return;
+    }
+
+    uint64_t counter = SDL_GetPerformanceCounter();
+    double work_ticks = static_cast<double>(counter - limiter->input_counter);
+
+    limiter->work_ticks = work_ticks > limiter->work_ticks ? work_ticks : limiter->work_ticks * 0.95 + work_ticks * 0.05;
+
+    if (counter > limiter->deadline) {
+        limiter->late_frames++;
+    }
+
+    limiter->deadline += limiter->period;
+}
+
+void
+frame_limiter_report_run(const Frame_Limiter *limiter, uint64_t frames_count)
+{
+    if (limiter->period == 0 || frames_count == 0) {
+        return;
+    }
+
+    double frequency_ms = static_cast<double>(limiter->frequency) / 1000.0;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Frame limiter: %.1f FPS target, waited %.3f ms/frame, frame work %.3f ms, %llu late frames",
+        static_cast<double>(limiter->frequency) / static_cast<double>(limiter->period),
+        static_cast<double>(limiter->waited_ticks) / frequency_ms / static_cast<double>(frames_count),
+        limiter->work_ticks / frequency_ms, static_cast<unsigned long long>(limiter->late_frames));
+}
+
+void
+present_latency_init(Present_Latency *latency, VkDevice device, PFN_vkWaitForPresentKHR wait_for_present)
+{
+    *latency = {};
+    latency->device = device;
+    latency->wait_for_present = wait_for_present;
+    latency->frequency = SDL_GetPerformanceFrequency();
+    latency->report_counter = SDL_GetPerformanceCounter();
+}
+
+uint64_t
+present_latency_next_id(Present_Latency *latency)
+{
+    return latency->wait_for_present != nullptr ? latency->next_present_id++ : 0;
+}
+
+static void
+present_latency_add(Present_Latency *latency, uint64_t input_counter, uint64_t present_counter)
+{
+    double latency_ms = static_cast<double>(present_counter - input_counter) * 1000.0 / static_cast<double>(latency->frequency);
+
+    latency->count++;
+    latency->total_ms += latency_ms;
+    latency->max_ms = std::max(latency->max_ms, latency_ms);
+
+    latency->run_count++;
+    latency->run_total_ms += latency_ms;
+    latency->run_max_ms = std::max(latency->run_max_ms, latency_ms);
+}
+
+void
+present_latency_on_present(Present_Latency *latency, VkSwapchainKHR swapchain, uint64_t present_id, uint64_t input_counter)
+{
+    if (present_id == 0) {
+        present_latency_add(latency, input_counter, SDL_GetPerformanceCounter());
+        return;
+    }
+
+    Pending_Present pending = {};
+    pending.swapchain = swapchain;
+    pending.present_id = present_id;
+    pending.input_counter = input_counter;
+
+    latency->pending.push_back(pending);
+}
+
+void
+present_latency_poll(Present_Latency *latency)
+{
+    // NOTE(gr3yknigh1): Presents of one swapchain complete in order, so the first unfinished one ends polling. [2025/04/04]
+    while (!latency->pending.empty()) {
+        const Pending_Present &pending = latency->pending.front();
+
+        VkResult result = latency->wait_for_present(latency->device, pending.swapchain, pending.present_id, 0);
+        if (result == VK_TIMEOUT) {
+            break;
+        }
+
+        // NOTE(gr3yknigh1): Out of date or lost surface: the present will never be shown, sample is dropped. [2025/04/04]
+        if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+            present_latency_add(latency, pending.input_counter, SDL_GetPerformanceCounter());
+        }
+
+        latency->pending.erase(latency->pending.begin());
+    }
+
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    // NOTE(gr3yknigh1): Report once per second, like frame time. [2025/04/04]
+    if (counter - latency->report_counter >= latency->frequency && latency->count > 0) {
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Latency: input to %s avg %.3f ms, max %.3f ms",
+            latency->wait_for_present != nullptr ? "present" : "vkQueuePresentKHR", latency->total_ms / latency->count,
+            latency->max_ms);
+
+        latency->report_counter = counter;
+        latency->count = 0;
+        latency->total_ms = 0.0;
+        latency->max_ms = 0.0;
+    }
+}
+
+void
+present_latency_forget(Present_Latency *latency, VkSwapchainKHR swapchain)
+{
+    auto is_forgotten = [swapchain](const Pending_Present &pending) {
+        return pending.swapchain == swapchain;
+    };
+
+    latency->pending.erase(std::remove_if(latency->pending.begin(), latency->pending.end(), is_forgotten), latency->pending.end());
+}
+
+void
+present_latency_report_run(const Present_Latency *latency)
+{
+    if (latency->run_count == 0) {
+        return;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Run: input to %s latency avg %.3f ms, max %.3f ms over %llu frames",
+        latency->wait_for_present != nullptr ? "present" : "vkQueuePresentKHR", latency->run_total_ms / latency->run_count,
+        latency->run_max_ms, static_cast<unsigned long long>(latency->run_count));
+}
@@ -0,0 +1,107 @@
+#pragma once
+///
+/// @brief CPU frame limiter and input-to-present latency measurement.
+///
+/// Limiter waits just in time: right before input is sampled, for as long as the frame's deadline allows minus
+/// expected CPU work of the frame. Input is then as fresh as possible when the frame is presented, unlike waiting
+/// after present, where input goes stale for the whole wait.
+///
+
+///
+/// @return Lowercase name used on command line ("fifo", "fifo-relaxed", "mailbox", "immediate").
+///
+const char *present_mode_name(VkPresentModeKHR present_mode);
+std::optional<VkPresentModeKHR> present_mode_from_name(std::string_view name);
+
+struct Frame_Limiter {
+    uint64_t frequency = 0;
+    uint64_t period    = 0; // Ticks per frame, 0 disables the limiter.
+
+    uint64_t deadline      = 0; // When the frame being prepared should be presented.
+    uint64_t input_counter = 0; // When the frame sampled input, i.e. `frame_limiter_wait` returned.
+
+    // NOTE(gr3yknigh1): Input to present CPU time. Grows at once and decays slowly, so a single fast frame doesn't
+    // make the next one late. [2025/04/04]
+    double work_ticks = 0.0;
+
+    uint64_t waited_ticks = 0;
+    uint64_t late_frames  = 0; // Presented after their deadline.
+};
+
+///
+/// @param fps_limit 0 disables the limiter, `frame_limiter_wait` only stamps input time then.
+///
+void frame_limiter_init(Frame_Limiter *limiter, uint32_t fps_limit);
+
+///
+/// @brief Sleeps until `deadline - expected work`. Call right before input is sampled.
+///
+/// @return Counter input is sampled at (same as `limiter->input_counter`).
+///
+uint64_t frame_limiter_wait(Frame_Limiter *limiter);
+
+///
+/// @brief Updates work estimate and moves to the next deadline. Call right after present.
+///
+void frame_limiter_end_frame(Frame_Limiter *limiter);
+
+void frame_limiter_report_run(const Frame_Limiter *limiter, uint64_t frames_count);
+
+struct Pending_Present {
+    VkSwapchainKHR swapchain     = VK_NULL_HANDLE;
+    uint64_t       present_id    = 0;
+    uint64_t       input_counter = 0;
+};
+
+///
+/// @brief Input-to-present latency. With VK_KHR_present_wait it is measured up to the moment image is shown, otherwise
+/// only up to return from `vkQueuePresentKHR` (CPU part of it).
+///
+/// @note Present completion is polled without blocking a few times per frame, so measured latency may be late by the
+/// time between polls.
+///
+struct Present_Latency {
+    VkDevice                device           = VK_NULL_HANDLE;
+    PFN_vkWaitForPresentKHR wait_for_present = nullptr;
+
+    uint64_t frequency       = 0;
+    uint64_t report_counter  = 0;
+    uint64_t next_present_id = 1;
+
+    std::vector<Pending_Present> pending; // A few presents long, vector doesn't allocate per frame as deque does.
+
+    uint32_t count    = 0;
+    double   total_ms = 0.0;
+    double   max_ms   = 0.0;
+
+    uint64_t run_count    = 0;
+    double   run_total_ms = 0.0;
+    double   run_max_ms   = 0.0;
+};
+
+///
+/// @param wait_for_present nullptr if VK_KHR_present_wait isn't enabled.
+///
+void present_latency_init(Present_Latency *latency, VkDevice device, PFN_vkWaitForPresentKHR wait_for_present);
+
+///
+/// @return Id to chain into `VkPresentInfoKHR` with `VkPresentIdKHR`, 0 if present wait isn't available.
+///
+uint64_t present_latency_next_id(Present_Latency *latency);
+
+///
+/// @brief Call after `vkQueuePresentKHR` of the frame whose input was sampled at `input_counter`.
+///
+void present_latency_on_present(Present_Latency *latency, VkSwapchainKHR swapchain, uint64_t present_id, uint64_t input_counter);
+
+///
+/// @brief Collects finished presents without blocking. Reports once per second.
+///
+void present_latency_poll(Present_Latency *latency);
+
+///
+/// @brief Drops presents of `swapchain`, it must not be waited on after it is replaced.
+///
+void present_latency_forget(Present_Latency *latency, VkSwapchainKHR swapchain);
+
+void present_latency_report_run(const Present_Latency *latency);
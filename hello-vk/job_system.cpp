@@ -0,0 +1,219 @@
+#include "stdafx.h"
+
+#include "job_system.h"
+
+constexpr uint32_t s_job_deque_mask = s_job_deque_capacity - 1;
+
+//
+// NOTE(gr3yknigh1): Operations on `top` and `bottom` are sequentially consistent. Chase-Lev needs a full fence
+// between owner's write of `bottom` and read of `top` in pop (and the other way around in steal), and seq_cst
+// accesses give it without standalone fences, which thread sanitizer doesn't understand. [2025/04/16]
+//
+
+///
+/// @return False if the deque is full. Owner only.
+///
+static bool
+job_deque_push(Job_Deque *deque, uint32_t job_index)
+{
+    int64_t bottom = deque->bottom.load(std::memory_order_relaxed);
+    int64_t top = deque->top.load();
+
+    if (bottom - top >= static_cast<int64_t>(s_job_deque_capacity)) {
+        return false;
+    }
+
+    deque->jobs[bottom & s_job_deque_mask].store(job_index, std::memory_order_relaxed);
+    deque->bottom.store(bottom + 1);
+    return true;
+}
+
+///
+/// @brief Takes the newest job. Owner only.
+///
+static bool
+job_deque_pop(Job_Deque *deque, uint32_t *job_index)
+{
+    int64_t bottom = deque->bottom.load(std::memory_order_relaxed) - 1;
+    deque->bottom.store(bottom);
+    int64_t top = deque->top.load();
+
+    if (top > bottom) {
+        deque->bottom.store(bottom + 1);
+        return false;
+    }
+
+    *job_index = deque->jobs[bottom & s_job_deque_mask].load(std::memory_order_relaxed);
+
+    if (top == bottom) {
+        // NOTE(gr3yknigh1): Last job, thieves may be after it too. Whoever moves the top first takes it. [2025/04/16]
+        bool is_taken = deque->top.compare_exchange_strong(top, top + 1);
+        deque->bottom.store(bottom + 1);
+        return is_taken;
+    }
+    return true;
+}
+
+///
+/// @brief Takes the oldest job. Any thread but the owner.
+///
+/// @return False if the deque is empty or the job was taken by someone else first.
+///
+static bool
+job_deque_steal(Job_Deque *deque, uint32_t *job_index)
+{
+    int64_t top = deque->top.load();
+    int64_t bottom = deque->bottom.load();
+
+    if (top >= bottom) {
+        return false;
+    }
+
+    uint32_t index = deque->jobs[top & s_job_deque_mask].load(std::memory_order_relaxed);
+
+    if (!deque->top.compare_exchange_strong(top, top + 1)) {
+        return false;
+    }
+
+    *job_index = index;
+    return true;
+}
+
+static void
+job_execute(Job_System *system, uint32_t job_index, uint32_t thread_index)
+{
+    Job_Batch &batch = system->batch;
+
+    uint32_t begin = job_index * batch.chunk_size;
+    batch.function(batch.user_data, begin, std::min(begin + batch.chunk_size, batch.count), thread_index);
+
+    // NOTE(gr3yknigh1): Thread 0 may start the next batch right after this, don't touch `batch` anymore. [2025/04/16]
+    batch.pending.fetch_sub(1, std::memory_order_release);
+}
+
+static void
+job_system_worker_main(Job_System *system, uint32_t thread_index)
+{
+    while (!system->should_stop.load(std::memory_order_relaxed)) {
+        uint32_t job_index = 0;
+        if (job_deque_steal(&system->deque, &job_index)) {
+            system->queued_count.fetch_sub(1, std::memory_order_relaxed);
+            system->stolen_count.fetch_add(1, std::memory_order_relaxed);
+            job_execute(system, job_index, thread_index);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(system->sleep_mutex);
+        system->sleep_condition.wait(lock, [system] {
+            return system->should_stop.load() || system->queued_count.load() > 0;
+        });
+    }
+}
+
+void
+job_system_init(Job_System *system, uint32_t threads_count)
+{
+    system->threads_count = std::max(threads_count, 1u);
+    system->deque.top = 0;
+    system->deque.bottom = 0;
+    system->batch.pending = 0;
+    system->should_stop = false;
+    system->queued_count = 0;
+    system->stolen_count = 0;
+
+    for (uint32_t thread_index = 1; thread_index < system->threads_count; ++thread_index) {
+        system->workers.emplace_back(job_system_worker_main, system, thread_index);
+    }
+}
+
+void
+job_system_destroy(Job_System *system)
+{
+    {
+        std::lock_guard<std::mutex> lock(system->sleep_mutex);
+        system->should_stop = true;
+    }
+    system->sleep_condition.notify_all();
+
+    for (auto &worker : system->workers) {
+        worker.join();
+    }
+
+    system->workers.clear();
+    system->threads_count = 0;
+}
+
+static bool
+job_system_pop(Job_System *system, uint32_t *job_index)
+{
+    if (!job_deque_pop(&system->deque, job_index)) {
+        return false;
+    }
+
+    system->queued_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void
+job_system_parallel_for(Job_System *system, uint32_t count, uint32_t chunk_size, Job_Function function, void *user_data)
+{
+    if (count == 0) {
+        return;
+    }
+
+    chunk_size = std::max(chunk_size, 1u);
+    uint32_t jobs_count = (count + chunk_size - 1) / chunk_size;
+
+    if (system->threads_count == 1 || jobs_count == 1) {
+        for (uint32_t begin = 0; begin < count; begin += chunk_size) {
+            function(user_data, begin, std::min(begin + chunk_size, count), 0);
+        }
+        return;
+    }
+
+    Job_Batch &batch = system->batch;
+    batch.function = function;
+    batch.user_data = user_data;
+    batch.count = count;
+    batch.chunk_size = chunk_size;
+    batch.pending.store(jobs_count, std::memory_order_relaxed);
+
+    //
+    // NOTE(gr3yknigh1): Thieves take the first ranges from the top, owner works from the last one. Counter is bumped
+    // before push, so it never underflows when job is stolen right away. [2025/04/16]
+    //
+    bool is_woken = false;
+
+    for (uint32_t job_index = 0; job_index < jobs_count; ++job_index) {
+        system->queued_count.fetch_add(1, std::memory_order_relaxed);
+
+        while (!job_deque_push(&system->deque, job_index)) {
+            uint32_t popped_index = 0;
+            if (job_system_pop(system, &popped_index)) {
+                job_execute(system, popped_index, 0);
+            }
+        }
+
+        //
+        // NOTE(gr3yknigh1): Workers are woken up after the first push, not the last, so they start stealing while
+        // the rest is pushed. Mutex is taken to not lose wakeup of worker which is between predicate check and
+        // sleep. [2025/04/16]
+        //
+        if (!is_woken) {
+            {
+                std::lock_guard<std::mutex> lock(system->sleep_mutex);
+            }
+            system->sleep_condition.notify_all();
+            is_woken = true;
+        }
+    }
+
+    while (batch.pending.load(std::memory_order_acquire) > 0) {
+        uint32_t job_index = 0;
+        if (job_system_pop(system, &job_index)) {
+            job_execute(system, job_index, 0);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+///
+/// @brief Fixed pool of worker threads fed through a lock-free work-stealing deque.
+///
+/// Deque is a bounded Chase-Lev one: its owner pushes and pops jobs at the bottom (LIFO, cache-warm), idle threads
+/// steal from the top with a CAS. Thread index 0 is the thread which called `job_system_init` (main thread), workers
+/// are 1..N, so per-thread resources can be simply indexed by it.
+///
+/// @note `job_system_parallel_for` may be called only from thread 0: the main thread, or the render thread, which
+/// takes index 0 over while frames are rendered. Jobs don't spawn jobs, so thread 0 is the only producer and owns
+/// the only deque, workers only steal. Per-thread deques would pay for scanning empty ones on every steal.
+///
+
+using Job_Function = void (*)(void *user_data, uint32_t begin, uint32_t end, uint32_t thread_index);
+
+// NOTE(gr3yknigh1): Power of two. Owner runs jobs itself while the deque is full, so nothing is lost. [2025/04/16]
+constexpr uint32_t s_job_deque_capacity = 1024;
+
+///
+/// @brief Deque of job indices into the running `job_system_parallel_for`, not jobs themselves: thief reads its
+/// cell before it wins the CAS and owner may refill the cell meanwhile, so cells have to be atomic.
+///
+struct Job_Deque {
+    std::array<std::atomic<uint32_t>, s_job_deque_capacity> jobs;
+
+    // NOTE(gr3yknigh1): Own cache lines, thieves hammer the top while owner pushes at the bottom. [2025/04/16]
+    alignas(64) std::atomic<int64_t> top    = 0;
+    alignas(64) std::atomic<int64_t> bottom = 0; // Written by owner only.
+};
+
+///
+/// @brief Range split of the running `job_system_parallel_for`. Written by thread 0 while the deque is empty and
+/// nobody runs its jobs.
+///
+struct Job_Batch {
+    Job_Function function   = nullptr;
+    void        *user_data  = nullptr;
+    uint32_t     count      = 0;
+    uint32_t     chunk_size = 0;
+
+    std::atomic<uint32_t> pending = 0;
+};
+
+struct Job_System {
+    std::vector<std::thread> workers;
+    uint32_t                 threads_count = 0; // Workers + main thread.
+
+    Job_Deque deque; // Owned by thread 0.
+    Job_Batch batch;
+
+    std::atomic<bool>     should_stop  = false;
+    std::atomic<uint32_t> queued_count = 0;
+
+    std::mutex              sleep_mutex;
+    std::condition_variable sleep_condition;
+
+    std::atomic<uint64_t> stolen_count = 0;
+};
+
+///
+/// @param threads_count Total number of threads, including the calling one. 1 means no workers, jobs run inline.
+///
+void job_system_init(Job_System *system, uint32_t threads_count);
+void job_system_destroy(Job_System *system);
+
+///
+/// @brief Splits [0, count) into ranges of at most `chunk_size` and runs `function` on them in parallel. Calling
+/// thread executes jobs too and returns once all of them are done.
+///
+void job_system_parallel_for(Job_System *system, uint32_t count, uint32_t chunk_size, Job_Function function, void *user_data);
@@ -0,0 +1,156 @@
+#include "stdafx.h"
+
+#include "mapped_file.h"
+#include "ktx2.h"
+
+static constexpr uint8_t s_ktx2_identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Ktx2_Header {
+    uint8_t  identifier[12];
+    uint32_t vk_format;
+    uint32_t type_size;
+    uint32_t pixel_width;
+    uint32_t pixel_height;
+    uint32_t pixel_depth;
+    uint32_t layer_count;
+    uint32_t face_count;
+    uint32_t level_count;
+    uint32_t supercompression_scheme;
+
+    uint32_t dfd_byte_offset;
+    uint32_t dfd_byte_length;
+    uint32_t kvd_byte_offset;
+    uint32_t kvd_byte_length;
+    uint64_t sgd_byte_offset;
+    uint64_t sgd_byte_length;
+};
+
+struct Ktx2_Level_Index {
+    uint64_t byte_offset;
+    uint64_t byte_length;
+    uint64_t uncompressed_byte_length;
+};
+
+static_assert(sizeof(Ktx2_Header) == 80);
+static_assert(sizeof(Ktx2_Level_Index) == 24);
+
+uint32_t
+ktx2_format_block(VkFormat format, uint32_t *block_size)
+{
+    *block_size = 4;
+
+    switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+    case VK_FORMAT_BC4_SNORM_BLOCK:
+        return 8;
+    case VK_FORMAT_BC2_UNORM_BLOCK:
+    case VK_FORMAT_BC2_SRGB_BLOCK:
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC5_SNORM_BLOCK:
+    case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+    case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        return 16;
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+        *block_size = 1;
+        return 4;
+    default:
+        *block_size = 0;
+        return 0;
+    }
+}
+
+bool
+ktx2_open(const char *path, Ktx2_File *texture)
+{
+    *texture = {};
+
+    if (!mapped_file_open(path, &texture->file)) {
+        return false;
+    }
+
+    const Ktx2_Header *header = reinterpret_cast<const Ktx2_Header *>(texture->file.data);
+
+    if (texture->file.size < sizeof(Ktx2_Header) || memcmp(header->identifier, s_ktx2_identifier, sizeof(s_ktx2_identifier)) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "KTX2: %s isn't a KTX2 file", path);
+        ktx2_close(texture);
+        return false;
+    }
+
+    VkFormat format = static_cast<VkFormat>(header->vk_format);
+    uint32_t block_size = 0;
+    uint32_t block_bytes = ktx2_format_block(format, &block_size);
+
+    // NOTE(gr3yknigh1): Level count of 0 asks loader to generate mips. Not done here, texture is streamed
+    // as one level then. [2025/04/12]
+    uint32_t levels_count = std::max(header->level_count, 1u);
+
+    bool is_supported = block_bytes != 0
+        && header->supercompression_scheme == 0
+        && header->pixel_width > 0 && header->pixel_height > 0 && header->pixel_depth == 0
+        && header->layer_count <= 1 && header->face_count == 1
+        && levels_count <= s_ktx2_levels_max
+        && (std::max(header->pixel_width, header->pixel_height) >> (levels_count - 1)) > 0;
+
+    if (!is_supported) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "KTX2: %s isn't supported (format %u, supercompression %u), only plain 2D textures in BCn or RGBA8 are",
+            path, header->vk_format, header->supercompression_scheme);
+        ktx2_close(texture);
+        return false;
+    }
+
+    if (static_cast<uint64_t>(levels_count) * sizeof(Ktx2_Level_Index) > texture->file.size - sizeof(Ktx2_Header)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "KTX2: %s is truncated", path);
+        ktx2_close(texture);
+        return false;
+    }
+
+    texture->format = format;
+    texture->width = header->pixel_width;
+    texture->height = header->pixel_height;
+    texture->levels_count = levels_count;
+
+    const Ktx2_Level_Index *level_index = reinterpret_cast<const Ktx2_Level_Index *>(texture->file.data + sizeof(Ktx2_Header));
+
+    for (uint32_t level = 0; level < levels_count; ++level) {
+        const Ktx2_Level_Index &entry = level_index[level];
+        VkExtent3D extent = ktx2_level_extent(*texture, level);
+
+        uint64_t blocks_x = (extent.width + block_size - 1) / block_size;
+        uint64_t blocks_y = (extent.height + block_size - 1) / block_size;
+        uint64_t expected_size = blocks_x * blocks_y * block_bytes;
+
+        bool is_valid = entry.byte_length == expected_size
+            && entry.byte_offset <= texture->file.size
+            && entry.byte_length <= texture->file.size - entry.byte_offset;
+
+        if (!is_valid) {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_APPLICATION, "KTX2: %s level %u is out of file bounds or has unexpected size", path, level);
+            ktx2_close(texture);
+            return false;
+        }
+
+        texture->levels[level].data = texture->file.data + entry.byte_offset;
+        texture->levels[level].size = entry.byte_length;
+    }
+
+    return true;
+}
+
+void
+ktx2_close(Ktx2_File *texture)
+{
+    mapped_file_close(&texture->file);
+    *texture = {};
+}
@@ -0,0 +1,44 @@
+#pragma once
+///
+/// @brief KTX2 texture, mapped into memory. Only what streaming needs is read: format, size and the level index, so
+/// any mip level is a pointer into the mapping, ready to be copied into staging memory.
+///
+/// Supported: 2D textures (one layer, one face) without supercompression, in BCn or 8-bit RGBA formats. KTX2 stores
+/// levels smallest first, so loading lowest mips first reads the file front to back.
+///
+
+constexpr uint32_t s_ktx2_levels_max = 16;
+
+struct Ktx2_Level {
+    const uint8_t *data = nullptr;
+    uint64_t       size = 0;
+};
+
+struct Ktx2_File {
+    Mapped_File file;
+
+    VkFormat format       = VK_FORMAT_UNDEFINED;
+    uint32_t width        = 0;
+    uint32_t height       = 0;
+    uint32_t levels_count = 0;
+
+    // NOTE(gr3yknigh1): Level 0 is the most detailed one. [2025/04/12]
+    std::array<Ktx2_Level, s_ktx2_levels_max> levels = {};
+};
+
+///
+/// @note Level sizes are checked against what the format needs, so levels can be uploaded tightly packed as is.
+///
+bool ktx2_open(const char *path, Ktx2_File *texture);
+void ktx2_close(Ktx2_File *texture);
+
+inline VkExtent3D
+ktx2_level_extent(const Ktx2_File &texture, uint32_t level)
+{
+    return { std::max(texture.width >> level, 1u), std::max(texture.height >> level, 1u), 1 };
+}
+
+///
+/// @return Bytes of texel block and its size in texels (4 for BCn, 1 otherwise). 0 bytes if format isn't supported.
+///
+uint32_t ktx2_format_block(VkFormat format, uint32_t *block_size);
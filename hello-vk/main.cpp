@@ -1,585 +1,3604 @@
 #include "stdafx.h"
 
 #include "defer.h"
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_timeline.h"
+#include "vk_bindless.h"
+#include "vk_upload.h"
+#include "vk_compute.h"
+#include "vk_pipeline_cache.h"
+#include "vk_deletion_queue.h"
+#include "vk_render_graph.h"
+#include "vk_draw_queue.h"
+#include "vk_shader.h"
+#include "vk_pipeline.h"
+#include "camera.h"
+#include "vk_benchmark.h"
+#include "vk_particles.h"
+#include "vk_gpu_culling.h"
+#include "mapped_file.h"
+#include "scene_format.h"
+#include "scene.h"
+#include "vk_scene.h"
+#include "ktx2.h"
+#include "vk_texture_streamer.h"
+#include "frame_pacing.h"
+#include "frame_arena.h"
+#include "job_system.h"
+#include "mpsc_ring.h"
+#include "profiler.h"
+#include "task_graph.h"
+#include "spsc_queue.h"
+#include "render_channel.h"
+#include "vk_debug_sink.h"
 
-bool global_should_stop = false;
+///
+/// @brief Runtime configuration, filled from command line.
+///
+struct App_Config {
+    uint32_t frames_in_flight = 2;
+
+    // NOTE(gr3yknigh1): 0 means run until window is closed. Headless mode defaults to 1000 frames. [2025/03/24]
+    uint32_t frame_count = 0;
+
+    bool        headless        = false;
+    uint32_t    headless_width  = 1280;
+    uint32_t    headless_height = 720;
+    const char *dump_file_path  = nullptr;
+
+    uint32_t staging_size_mb = 64;
+
+    // NOTE(gr3yknigh1): nullptr disables persistence, every run is a cold start. [2025/03/27]
+    const char *pipeline_cache_path = "pipeline_cache.bin";
+
+    // NOTE(gr3yknigh1): Threads which record draws, including main one. 0 means hardware concurrency. [2025/03/28]
+    uint32_t threads_count = 0;
+
+    // NOTE(gr3yknigh1): 0 means 1, or 50k for recording benchmark. [2025/03/28]
+    uint32_t draw_count = 0;
+
+    bool benchmark_recording = false;
+
+    // NOTE(gr3yknigh1): Simulated on compute queue. 0 disables, compute benchmark defaults to 4M. [2025/03/31]
+    uint32_t particles_count = 0;
+
+    bool benchmark_compute = false;
+
+    const char *profile_trace_path = nullptr;
+    const char *profile_csv_path   = nullptr;
+
+    const char *device_name = nullptr; // Index or part of name, overrides HELLO_VK_DEVICE.
+
+    // NOTE(gr3yknigh1): Falls back to CPU culling if device can't draw indirect. [2025/04/01]
+    bool gpu_culling = true;
+
+    // NOTE(gr3yknigh1): Forces pooled descriptor sets even if device supports descriptor indexing. [2025/04/02]
+    bool no_bindless = false;
+
+    bool benchmark_culling = false;
+
+    // NOTE(gr3yknigh1): Written (as Graphviz DOT) every time frame graph is compiled anew. [2025/04/03]
+    const char *graph_dump_path = nullptr;
+
+    // NOTE(gr3yknigh1): nullopt picks MAILBOX if surface supports it, else FIFO. Switched at runtime with V. [2025/04/04]
+    std::optional<VkPresentModeKHR> present_mode = std::nullopt;
+
+    // NOTE(gr3yknigh1): 0 means minImageCount + 1. Clamped to what surface supports. [2025/04/04]
+    uint32_t swapchain_images_count = 0;
+
+    // NOTE(gr3yknigh1): 0 disables CPU frame limiter. [2025/04/04]
+    uint32_t fps_limit = 0;
+
+    // NOTE(gr3yknigh1): Needs glslc, from Vulkan SDK or PATH. [2025/04/05]
+    bool hot_reload = false;
+
+    // NOTE(gr3yknigh1): Exit status is failure if any frame after warmup allocated from the heap. [2025/04/07]
+    bool fail_on_frame_allocations = false;
+
+    // NOTE(gr3yknigh1): CPU culling path only. Off records every draw separately, in parallel. [2025/04/08]
+    bool draw_queue = true;
+
+    // NOTE(gr3yknigh1): Forces fence-backed timelines, as on drivers without timeline semaphores. [2025/04/10]
+    bool no_timeline_semaphores = false;
+
+    // NOTE(gr3yknigh1): Scene written by scene-convert. Its first mesh is drawn instead of the triangle. [2025/04/11]
+    const char *scene_path = nullptr;
+
+    // NOTE(gr3yknigh1): Every *.ktx2 in it is streamed, draws are assigned textures round-robin. [2025/04/12]
+    const char *texture_dir = nullptr;
+
+    // NOTE(gr3yknigh1): 0 means what is left of device-local heap's budget. [2025/04/12]
+    uint32_t texture_budget_mb = 0;
+
+    // NOTE(gr3yknigh1): Startup tasks run one by one on main thread, to measure what running them in parallel
+    // buys. [2025/04/13]
+    bool serial_startup = false;
+
+    // NOTE(gr3yknigh1): Validation messages logged per message id per second, 0 logs every one. Builds with
+    // validation layers only. [2025/04/15]
+    uint32_t debug_messages_per_second = 5;
+};
+
+bool app_parse_command_line(int argc, char **argv, App_Config *config);
+
+static const std::vector<const char *> s_vk_required_validation_layers = {
+    "VK_LAYER_KHRONOS_validation",
+};
+#if defined(NDEBUG)
+constexpr static bool s_vk_enable_validation_layers = false;
+#else
+constexpr static bool s_vk_enable_validation_layers = true;
+#endif
+
+///
+/// @brief State shared by startup tasks. Field is written by one task and read by tasks which depend on it, or by
+/// main thread once the graph is finished.
+///
+/// Instance and device are created by a chain of tasks (`app_startup_sdl` ... `app_startup_device`). Files they
+/// don't need (scene, pipeline cache, SPIR-V) are read concurrently. Pipelines are compiled by the second graph,
+/// while main thread creates everything else.
+///
+struct App_Startup {
+    App_Config *config = nullptr;
+
+    // NOTE(gr3yknigh1): "sdl". Vulkan library is loaded only with a window. [2025/04/13]
+    bool                      is_sdl_initialized       = false;
+    bool                      is_vulkan_library_loaded = false;
+    std::vector<const char *> window_extensions; // Instance extensions window system needs.
+
+    // NOTE(gr3yknigh1): "window". Headless size is set up front. [2025/04/13]
+    SDL_Window *window        = nullptr;
+    int         window_width  = 0;
+    int         window_height = 0;
+
+    // NOTE(gr3yknigh1): "vulkan loader". [2025/04/13]
+    VkApplicationInfo                  app_info = {};
+    std::vector<VkExtensionProperties> extensions_properties;
+
+    // NOTE(gr3yknigh1): "instance" and "surface". [2025/04/13]
+    VkInstance                          instance                = VK_NULL_HANDLE;
+    VkDebugUtilsMessengerEXT            debug_messenger         = VK_NULL_HANDLE;
+    PFN_vkDestroyDebugUtilsMessengerEXT destroy_debug_messenger = nullptr;
+    Vk_Debug_Sink                      *debug_sink              = nullptr; // Receives messages of the messenger.
+    VkSurfaceKHR                        surface                 = VK_NULL_HANDLE;
+
+    // NOTE(gr3yknigh1): "device". [2025/04/13]
+    Vk_Device_Capabilities device_capabilities     = {};
+    uint32_t               transfer_queue_index    = 0;
+    uint32_t               compute_queue_index     = 0;
+    bool                   is_bindless             = false;
+    bool                   has_timeline_semaphores = false;
+
+    VkDevice device         = VK_NULL_HANDLE;
+    VkQueue  graphics_queue = VK_NULL_HANDLE;
+    VkQueue  present_queue  = VK_NULL_HANDLE;
+    VkQueue  transfer_queue = VK_NULL_HANDLE;
+    VkQueue  compute_queue  = VK_NULL_HANDLE;
+
+    PFN_vkCmdDrawIndexedIndirectCountKHR cmd_draw_indexed_indirect_count = nullptr;
+    PFN_vkWaitForPresentKHR              wait_for_present                = nullptr;
+
+    // NOTE(gr3yknigh1): "scene", "texture list", "pipeline cache file" and "shader code". [2025/04/13]
+    Scene                              scene = {};
+    std::vector<std::filesystem::path> texture_paths;
+    std::vector<uint8_t>               pipeline_cache_file;
+    std::vector<uint32_t>              vertex_shader_code;
+    std::vector<uint32_t>              fragment_shader_code;
+
+    //
+    // NOTE(gr3yknigh1): Pipelines graph. Render pass and layout are made by main thread before it starts. [2025/04/13]
+    //
+    VkRenderPass               render_pass     = VK_NULL_HANDLE;
+    VkPipelineLayout           pipeline_layout = VK_NULL_HANDLE;
+    Vk_Bindless_Specialization bindless_specialization;
+    Vk_Pipeline_Cache          pipeline_cache;
+    VkShaderModule             vertex_shader   = VK_NULL_HANDLE;
+    VkShaderModule             fragment_shader = VK_NULL_HANDLE;
+    VkPipeline                 pipeline        = VK_NULL_HANDLE;
+};
+
+bool app_startup_sdl(void *user_data);     // Main thread.
+bool app_startup_window(void *user_data);  // Main thread.
+bool app_startup_vulkan_loader(void *user_data);
+bool app_startup_instance(void *user_data);
+bool app_startup_surface(void *user_data); // Main thread.
+bool app_startup_device(void *user_data);
+bool app_startup_scene(void *user_data);
+bool app_startup_texture_list(void *user_data);
+bool app_startup_pipeline_cache_file(void *user_data);
+bool app_startup_shader_code(void *user_data);
+
+bool app_startup_pipeline_cache(void *user_data);
+bool app_startup_shader_modules(void *user_data);
+bool app_startup_triangle_pipeline(void *user_data);
+
+double app_counter_ms(uint64_t begin_counter, uint64_t end_counter);
+
+///
+/// @brief Event thread: pumps SDL events and pushes what render thread cares about into `channel`, until it is stopped.
+///
+void app_run_event_thread(Render_Channel *channel, SDL_Window *window, Profiler *profiler);
+
+// NOTE(gr3yknigh1): Longest frame waits for event thread to pump before it samples input without it. [2025/04/14]
+constexpr uint32_t s_app_input_sync_timeout_ms = 2;
+
+///
+/// @brief Command pool of one recording thread. Command pools are externally synchronized, so every thread
+/// allocates secondary buffers only from its own pool.
+///
+struct alignas(64) Vk_Thread_Commands {
+    VkCommandPool                command_pool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> secondary_buffers;
+    uint32_t                     used_count   = 0;
+};
+
+///
+/// @brief Per frame-in-flight resources. CPU records frame N+1 while GPU still executes frame N.
+///
+struct Vk_Frame {
+    VkCommandPool   command_pool    = VK_NULL_HANDLE;
+    VkCommandBuffer command_buffer  = VK_NULL_HANDLE;
+    VkSemaphore     image_available = VK_NULL_HANDLE;
+
+    // NOTE(gr3yknigh1): Indexed by job system thread index. [2025/03/28]
+    std::vector<Vk_Thread_Commands> thread_commands;
+
+    // NOTE(gr3yknigh1): Scratch of frame's recording, reset together with its pools. [2025/04/07]
+    Frame_Arena arena;
+
+    // NOTE(gr3yknigh1): Graphics timeline value of the frame's last submit, which is its frame number. [2025/04/10]
+    uint64_t submitted_frame_number = 0;
+};
+
+// NOTE(gr3yknigh1): Initial size, arena grows if a frame needs more. [2025/04/07]
+constexpr size_t s_frame_arena_capacity = 64 * 1024;
+
+VkResult vk_make_frame(VkDevice device, uint32_t graphics_queue_index, uint32_t threads_count, Vk_Frame *frame);
+
+///
+/// @brief Resets frame's primary and per-thread pools and its arena. Frame's last submit must be already waited.
+///
+void vk_reset_frame(VkDevice device, Vk_Frame *frame);
+
+///
+/// @brief Per-draw data. Triangle pipeline reads it from a storage buffer of the bindless table.
+///
+struct Draw_Command {
+    float offset[2];
+    float scale;
+};
+
+///
+/// @brief Push constants of the triangle pipeline, camera follows at `s_camera_push_constant_offset`.
+///
+struct Draw_Push_Constants {
+    uint32_t draws_buffer = 0; // Shader index of `Vk_Draw_List::draws_handle`.
+    uint32_t draw         = 0;
+};
+
+///
+/// @brief Lays `count` draws of the triangle out in a square grid over the whole viewport.
+///
+std::vector<Draw_Command> make_grid_draws(uint32_t count);
+
+///
+/// @brief Bounding circles of draws of a mesh with `mesh_radius`, as GPU culling takes them.
+///
+std::vector<Gpu_Object> make_gpu_objects(const Draw_Command *draws, uint32_t draws_count, float mesh_radius);
+
+///
+/// @brief One-mesh scene of the triangle, in static memory. Used if no scene file is given.
+///
+Scene make_triangle_scene(void);
+
+///
+/// @brief Everything a frame draws.
+///
+struct Vk_Draw_List {
+    VkPipeline       pipeline        = VK_NULL_HANDLE;
+    VkPipelineLayout pipeline_layout = VK_NULL_HANDLE;
+
+    VkBuffer    vertex_buffer        = VK_NULL_HANDLE;
+    uint64_t    vertex_buffer_ticket = 0;
+    VkBuffer    index_buffer         = VK_NULL_HANDLE;
+    uint64_t    index_buffer_ticket  = 0;
+    uint32_t    index_count          = 0;
+    VkIndexType index_type           = VK_INDEX_TYPE_UINT16;
+    float       mesh_radius          = 0.0f; // Bounding circle of the mesh, before draw's scale.
+
+    const Draw_Command *draws       = nullptr;
+    uint32_t            draws_count = 0;
+
+    // NOTE(gr3yknigh1): Copy of `draws` on GPU, which the triangle pipeline reads through the table. [2025/04/17]
+    const Vk_Bindless_Table *bindless_table      = nullptr;
+    Vk_Bindless_Handle       draws_handle;
+    uint64_t                 draws_buffer_ticket = 0;
+
+    Camera camera;
+
+    // NOTE(gr3yknigh1): If not nullptr, draws are culled and issued by GPU, `draws` are ignored. [2025/04/01]
+    const Vk_Gpu_Culling *gpu_culling = nullptr;
+
+    // NOTE(gr3yknigh1): Otherwise, if not nullptr, CPU-culled draws are sorted and instanced by the queue. [2025/04/08]
+    Vk_Draw_Queue *draw_queue          = nullptr;
+    uint32_t       draw_queue_pipeline = 0;
+    uint32_t       draw_queue_material = 0;
+
+    std::array<uint32_t, 2> draw_queue_meshes = {};
+    std::array<float, 2>    draw_queue_radii  = {}; // Of `draw_queue_meshes`, before draw's scale.
+};
+
+constexpr uint32_t s_draw_queue_main_pass = 0;
+
+///
+/// @brief Screen-space feedback of texture streaming: requests texture of every visible draw (`index % count`) at
+/// the size its bounding circle covers on screen.
+///
+void app_request_textures(Vk_Texture_Streamer *streamer, const Vk_Draw_List &draw_list, VkExtent2D extent, uint64_t frame_number);
+
+///
+/// @brief Color target which replaces swapchain image in headless mode.
+///
+struct Vk_Offscreen_Target {
+    VkImage       image       = VK_NULL_HANDLE;
+    Vk_Allocation allocation;
+    VkImageView   image_view  = VK_NULL_HANDLE;
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+};
+
+VkResult vk_make_offscreen_target(
+    Vk_Allocator *allocator, VkRenderPass render_pass, VkFormat format, VkExtent2D extent, Vk_Offscreen_Target *target);
+void vk_destroy_offscreen_target(Vk_Allocator *allocator, Vk_Offscreen_Target *target);
+
+///
+/// @brief Copies color image (in `TRANSFER_SRC_OPTIMAL` layout) to host and writes it as binary PPM.
+///
+/// @note Blocks until copy is done. Meant for correctness dumps, not for hot loop.
+///
+bool vk_dump_image_ppm(
+    Vk_Allocator *allocator, VkQueue queue, uint32_t queue_index,
+    VkImage image, VkFormat format, VkExtent2D extent, const char *file_path);
+
+///
+/// @brief Swapchain and everything which depends on its images or extent.
+///
+struct Vk_Swapchain {
+    VkSwapchainKHR handle = VK_NULL_HANDLE;
+    VkExtent2D     extent = {};
+
+    std::vector<VkImage>       images;
+    std::vector<VkImageView>   image_views;
+    std::vector<VkFramebuffer> framebuffers;
+
+    //
+    // NOTE(gr3yknigh1): `render finished` semaphore is owned by swapchain image, not by frame. Presentation
+    // engine may still wait on it after frame's submit is completed, so it is safe to reuse only once the same
+    // image is acquired again. [2025/03/22]
+    //
+    std::vector<VkSemaphore> render_finished_semaphores;
 
+    // NOTE(gr3yknigh1): Number of the frame which last rendered into swapchain image, 0 if none. [2025/03/22]
+    std::vector<uint64_t> images_frame_numbers;
+};
 
-static VKAPI_ATTR VkBool32 VKAPI_CALL vk_debug_callback(
-    VkDebugUtilsMessageSeverityFlagBitsEXT message_severity, 
-    VkDebugUtilsMessageTypeFlagsEXT message_type,
-    const VkDebugUtilsMessengerCallbackDataEXT* callback_data, 
-    void* user_data);
+///
+/// @brief Creates new swapchain (and its image views, framebuffers, semaphores) in place of `swapchain`.
+///
+/// Previous swapchain is passed as `oldSwapchain` and retired into `deletion_queue` instead of being destroyed,
+/// so no device wait is needed. Unless `force` is set, nothing is done if extent didn't change.
+///
+/// @param image_count 0 means `minImageCount + 1`, see `vk_make_swapchain`.
+///
+VkResult vk_recreate_swapchain(
+    VkPhysicalDevice physical_device, VkDevice device, VkSurfaceKHR surface, VkSurfaceFormatKHR surface_format,
+    uint32_t graphics_queue_index, uint32_t present_queue_index, VkPresentModeKHR present_mode, uint32_t image_count,
+    VkRenderPass render_pass, int width, int height, bool force, uint64_t frame_number,
+    Vk_Swapchain *swapchain, Vk_Deletion_Queue *deletion_queue);
 
 ///
-/// @brief Searches for indices of queue which supports `present` and `graphics` from queue families of physical device.
+/// @brief Pushes swapchain and its views, framebuffers and semaphores into `deletion_queue`.
+///
+/// @param last_frame_number The last frame which rendered into swapchain images.
+///
+void vk_retire_swapchain(Vk_Deletion_Queue *deletion_queue, Vk_Swapchain *swapchain, uint64_t last_frame_number);
+
+void vk_destroy_swapchain(VkDevice device, Vk_Swapchain *swapchain);
+void vk_destroy_frame(VkDevice device, Vk_Frame *frame);
+
 ///
-/// @note For full support both of indices should has non-null values.
+/// @brief Accumulates CPU frame times and periodically reports them via `SDL_LogInfo`.
 ///
-std::pair<std::optional<uint32_t>, std::optional<uint32_t>> vk_find_queue_family_indices(VkPhysicalDevice device, VkSurfaceKHR surface);
+struct Frame_Time_Stats {
+    uint64_t frequency      = 0;
+    uint64_t last_counter   = 0;
+    uint64_t report_counter = 0;
+
+    uint32_t frames   = 0;
+    double   total_ms = 0.0;
+    double   min_ms   = 0.0;
+    double   max_ms   = 0.0;
+
+    uint64_t run_frames   = 0;
+    double   run_total_ms = 0.0;
+};
+
+void frame_time_stats_begin(Frame_Time_Stats *stats);
+void frame_time_stats_tick(Frame_Time_Stats *stats);
+void frame_time_stats_report_run(const Frame_Time_Stats *stats);
 
-VkPhysicalDevice vk_pick_physical_device(VkInstance instance, VkSurfaceKHR surface, const std::vector<const char*>& required_device_extensions);
 
 VkDevice vk_make_logical_device(
     VkPhysicalDevice physical_device, 
     const std::vector<const char *> &required_validation_layers, const std::vector<const char *> &required_device_extensions,
-    uint32_t graphics_queue_index, uint32_t present_queue_index, bool enable_validation_layers);
+    uint32_t graphics_queue_index, uint32_t present_queue_index, uint32_t transfer_queue_index, uint32_t compute_queue_index,
+    const VkPhysicalDeviceFeatures &enabled_features, const void *features_chain, bool enable_validation_layers);
 
 VkExtent2D vk_pick_swap_extent(VkSurfaceCapabilitiesKHR *capabilities, int width, int height);
 
+///
+/// @brief Next of FIFO, FIFO_RELAXED, MAILBOX, IMMEDIATE (wrapping around) supported by the surface.
+///
+VkPresentModeKHR vk_next_present_mode(const Vk_Device_Capabilities &capabilities, VkPresentModeKHR present_mode);
+
+///
+/// @param image_count 0 means `minImageCount + 1`. Clamped to surface limits.
+///
 VkResult vk_make_swapchain(
     VkDevice device, VkSurfaceKHR surface, VkSurfaceFormatKHR surface_format,
-    uint32_t graphics_queue_index, uint32_t present_queue_index, VkPresentModeKHR present_mode,
-    VkSurfaceCapabilitiesKHR* capabilities, VkExtent2D extent, VkSwapchainKHR* result);
+    uint32_t graphics_queue_index, uint32_t present_queue_index, VkPresentModeKHR present_mode, uint32_t image_count,
+    VkSurfaceCapabilitiesKHR* capabilities, VkExtent2D extent, VkSwapchainKHR old_swapchain, VkSwapchainKHR* result);
+
+VkResult vk_make_swapchain_image_views(
+    VkDevice device, const std::vector<VkImage> &images, VkFormat format, std::vector<VkImageView> *result);
+
+///
+/// @brief Single subpass render pass which clears and stores one color attachment.
+///
+/// @note Attachment stays in `COLOR_ATTACHMENT_OPTIMAL` from begin to end, transitions and external dependencies
+/// are placed by the frame graph.
+///
+VkRenderPass vk_make_render_pass(VkDevice device, VkFormat color_format);
+
+VkResult vk_make_framebuffers(
+    VkDevice device, VkRenderPass render_pass, const std::vector<VkImageView> &image_views, VkExtent2D extent,
+    std::vector<VkFramebuffer> *result);
+
+///
+/// @brief Records draws into secondary command buffers in parallel, one buffer per chunk of draws.
+///
+/// @param secondary_buffers Filled in draw order, ready for `vkCmdExecuteCommands`.
+///
+void vk_record_draws(
+    Job_System *job_system, Profiler *profiler, VkDevice device, Vk_Frame *frame, VkRenderPass render_pass,
+    VkFramebuffer framebuffer, VkExtent2D extent, const Vk_Draw_List &draw_list, Frame_Vector<VkCommandBuffer> *secondary_buffers);
+
+///
+/// @brief Culls draws on CPU, pushes the visible ones into `draw_list.draw_queue` and records them as instanced batches.
+///
+void vk_record_draw_queue(VkCommandBuffer command_buffer, uint32_t frame_index, const Vk_Draw_List &draw_list, VkExtent2D extent);
+
+///
+/// @brief What passes of the frame graph need to record themselves.
+///
+struct Vk_Frame_Pass_Data {
+    Job_System *job_system  = nullptr;
+    Profiler   *profiler    = nullptr;
+    VkDevice    device      = VK_NULL_HANDLE;
+    Vk_Frame   *frame       = nullptr;
+    uint32_t    frame_index = 0;
+
+    VkRenderPass  render_pass = VK_NULL_HANDLE;
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+    VkExtent2D    extent      = {};
+
+    const Vk_Draw_List *draw_list          = nullptr;
+    const Vk_Particles *particles          = nullptr;
+    bool                is_draw_list_ready = false;
+};
+
+///
+/// @brief Records finished uploads' acquire barriers and the frame itself into frame's primary buffer. Frame is
+/// declared as a graph (GPU culling, main pass) and recorded by `render_graph`.
+///
+/// @note Draws are skipped until uploads of `draw_list` buffers (and GPU objects, if culled on GPU) are finished.
+///
+/// @param frame_number Number the frame gets on submit, stamped into GPU samples.
+/// @param color_image Image behind `framebuffer`, left in `color_final_layout`. Its contents are discarded.
+/// @param particles Drawn after the draw list if not nullptr. Submit must wait for frame's simulation.
+///
+void vk_record_frame(
+    Job_System *job_system, Profiler *profiler, Vk_Render_Graph *render_graph, VkDevice device, Vk_Frame *frame,
+    uint32_t frame_index, uint64_t frame_number, Vk_Upload_Context *upload_context, VkRenderPass render_pass,
+    VkImage color_image, VkFramebuffer framebuffer, VkImageLayout color_final_layout, VkExtent2D extent,
+    const Vk_Draw_List &draw_list, const Vk_Particles *particles);
+
+///
+/// @brief Measures CPU time of `vk_record_draws` for 1, 2, 4, ... up to `max_threads_count` threads.
+///
+void vk_benchmark_recording(
+    VkDevice device, Vk_Frame *frame, VkRenderPass render_pass, VkFramebuffer framebuffer, VkExtent2D extent,
+    const Vk_Draw_List &draw_list, uint32_t max_threads_count);
+
+///
+/// @brief Headless frames which benchmarks of GPU modules drive (see vk_benchmark.h): frame waits for its last
+/// submit, is recorded by `vk_record_frame` into its offscreen target and submitted to graphics queue.
+///
+struct App_Benchmark_Frames {
+    Job_System                             *job_system        = nullptr;
+    Vk_Render_Graph                        *render_graph      = nullptr;
+    VkDevice                                device            = VK_NULL_HANDLE;
+    VkQueue                                 graphics_queue    = VK_NULL_HANDLE;
+    Vk_Timeline                            *graphics_timeline = nullptr;
+    std::vector<Vk_Frame>                  *frames            = nullptr;
+    const std::vector<Vk_Offscreen_Target> *targets           = nullptr;
+    VkExtent2D                              extent            = {};
+    Vk_Upload_Context                      *upload_context    = nullptr;
+    VkRenderPass                            render_pass       = VK_NULL_HANDLE;
+    const Vk_Draw_List                     *draw_list         = nullptr;
+    const Vk_Particles                     *particles         = nullptr; // Drawn if not nullptr.
+};
+
+Vk_Benchmark_Frames app_benchmark_frames(App_Benchmark_Frames *frames);
 
 int
-main(void) {
+main(int argc, char **argv) {
     using namespace std::literals;
 
+    // NOTE(gr3yknigh1): Start of time-to-first-frame measurement. [2025/03/27]
+    uint64_t startup_counter = SDL_GetPerformanceCounter();
+
+    App_Config config = {};
+    if (!app_parse_command_line(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+
     //
-    // SDL initialization:
+    // Profiler:
     //
-    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() = %s\n", SDL_GetError());
+    Profiler profiler;
+    profiler_init(&profiler, 1 << 20);
+    defer({
+        profiler_collect(&profiler);
+        profiler_log_summary(&profiler);
+
+        if (config.profile_trace_path != nullptr) {
+            profiler_export_chrome_trace(&profiler, config.profile_trace_path);
+        }
+        if (config.profile_csv_path != nullptr) {
+            profiler_export_csv(&profiler, config.profile_csv_path);
+        }
+
+        profiler_destroy(&profiler);
+    });
+
+    //
+    // Validation messages: logged by a background thread, so validation can stay on in performance test builds.
+    //
+    Vk_Debug_Sink vk_debug_sink;
+    if constexpr (s_vk_enable_validation_layers) {
+        vk_debug_sink_init(&vk_debug_sink, config.debug_messages_per_second);
+    }
+    defer(vk_debug_sink_destroy(&vk_debug_sink));
+
+    //
+    // Startup: instance and device. Window and reads of files which don't need them overlap with their creation.
+    //
+    App_Startup startup = {};
+    startup.config = &config;
+    startup.debug_sink = &vk_debug_sink;
+
+    // NOTE(gr3yknigh1): Headless mode has no window at all, so it runs on CI boxes without display. [2025/03/24]
+    startup.window_width = static_cast<int>(config.headless_width);
+    startup.window_height = static_cast<int>(config.headless_height);
+
+    // NOTE(gr3yknigh1): Any task may fail, so everything is guarded. Destroyed in the same order as when startup
+    // was serial. [2025/04/13]
+    defer(if (startup.is_sdl_initialized) SDL_Quit());
+    defer(if (startup.is_vulkan_library_loaded) SDL_Vulkan_UnloadLibrary());
+    defer(if (startup.window) SDL_DestroyWindow(startup.window));
+    defer(if (startup.instance) vkDestroyInstance(startup.instance, nullptr));
+    defer(if (startup.debug_messenger) startup.destroy_debug_messenger(startup.instance, startup.debug_messenger, nullptr));
+    defer(if (startup.surface) vkDestroySurfaceKHR(startup.instance, startup.surface, nullptr));
+    defer(if (startup.device) vkDestroyDevice(startup.device, nullptr));
+    defer(scene_close(&startup.scene));
+
+    // NOTE(gr3yknigh1): Startup shares the recording threads limit, `--threads 1` makes it serial as well. [2025/04/13]
+    uint32_t startup_workers_count = config.serial_startup ? 0 : config.threads_count - 1;
+
+    Task_Graph device_graph;
+    {
+        uint32_t sdl_task = task_graph_add(&device_graph, "sdl", app_startup_sdl, &startup, {}, true);
+        uint32_t loader_task = task_graph_add(&device_graph, "vulkan loader", app_startup_vulkan_loader, &startup);
+        uint32_t instance_task = task_graph_add(&device_graph, "instance", app_startup_instance, &startup, { sdl_task, loader_task });
+
+        uint32_t device_dependency = instance_task;
+        if (!config.headless) {
+            uint32_t window_task = task_graph_add(&device_graph, "window", app_startup_window, &startup, { sdl_task }, true);
+            device_dependency = task_graph_add(
+                &device_graph, "surface", app_startup_surface, &startup, { window_task, instance_task }, true);
+        }
+        task_graph_add(&device_graph, "device", app_startup_device, &startup, { device_dependency });
+
+        task_graph_add(&device_graph, "scene", app_startup_scene, &startup);
+        task_graph_add(&device_graph, "shader code", app_startup_shader_code, &startup);
+
+        if (config.pipeline_cache_path != nullptr) {
+            task_graph_add(&device_graph, "pipeline cache file", app_startup_pipeline_cache_file, &startup);
+        }
+        if (config.texture_dir != nullptr) {
+            task_graph_add(&device_graph, "texture list", app_startup_texture_list, &startup);
+        }
+    }
+
+    bool is_device_created = task_graph_run(&device_graph, startup_workers_count, &profiler);
+    task_graph_log_report(device_graph, "instance and device", startup_counter);
+
+    if (!is_device_created) {
         return EXIT_FAILURE;
     }
-    defer(SDL_Quit());
 
-    SDL_version v = {};
-    SDL_GetVersion(&v);
-    SDL_LogInfo(
-        SDL_LOG_CATEGORY_APPLICATION, "SDL version %d.%d.%d\n", v.major,
-        v.minor, v.patch);
+    uint64_t device_counter = SDL_GetPerformanceCounter();
+
+    SDL_Window *window = startup.window;
+    int window_width = startup.window_width, window_height = startup.window_height;
+
+    VkResult vk_result = VK_SUCCESS;
+    VkSurfaceKHR vk_surface = startup.surface;
+
+    const Vk_Device_Capabilities &vk_device_capabilities = startup.device_capabilities;
+    VkPhysicalDevice vk_physical_device = vk_device_capabilities.handle;
+
+    std::optional<uint32_t> vk_graphics_queue_index = vk_device_capabilities.graphics_queue_index;
+    std::optional<uint32_t> vk_present_queue_index = vk_device_capabilities.present_queue_index;
+    uint32_t vk_transfer_queue_index = startup.transfer_queue_index;
+    uint32_t vk_compute_queue_index = startup.compute_queue_index;
+
+    bool vk_is_bindless = startup.is_bindless;
+    bool vk_has_timeline_semaphores = startup.has_timeline_semaphores;
+
+    VkDevice vk_device = startup.device;
+    VkQueue vk_graphics_queue = startup.graphics_queue, vk_present_queue = startup.present_queue;
+    VkQueue vk_transfer_queue = startup.transfer_queue, vk_compute_queue = startup.compute_queue;
+
+    PFN_vkCmdDrawIndexedIndirectCountKHR vk_cmd_draw_indexed_indirect_count = startup.cmd_draw_indexed_indirect_count;
+    PFN_vkWaitForPresentKHR vk_wait_for_present = startup.wait_for_present;
+
+    //
+    // VK: searching for surface format and present mode.
+    //
+    std::optional<VkSurfaceFormatKHR> vk_surface_format = std::nullopt;
+    std::optional<VkPresentModeKHR> vk_present_mode = std::nullopt;
+
+    if (config.headless) {
+        vk_surface_format = VkSurfaceFormatKHR{ VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+        vk_present_mode = VK_PRESENT_MODE_FIFO_KHR;
+    } else {
+        VkSurfaceFormatKHR preferred_format = { VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+        if (vk_device_has_surface_format(vk_device_capabilities, preferred_format)) {
+            vk_surface_format = preferred_format;
+        }
+        SDL_assert(vk_surface_format.has_value());
+
+        // NOTE(gr3yknigh1): FIFO is the only mode every surface has to support. [2025/04/04]
+        if (config.present_mode.has_value()) {
+            vk_present_mode = config.present_mode.value();
+
+            if (!vk_device_has_present_mode(vk_device_capabilities, vk_present_mode.value())) {
+                SDL_LogWarn(
+                    SDL_LOG_CATEGORY_APPLICATION, "Present mode %s isn't supported by surface, falling back to fifo",
+                    present_mode_name(vk_present_mode.value()));
+                vk_present_mode = VK_PRESENT_MODE_FIFO_KHR;
+            }
+        } else {
+            vk_present_mode = vk_device_has_present_mode(vk_device_capabilities, VK_PRESENT_MODE_MAILBOX_KHR)
+                ? VK_PRESENT_MODE_MAILBOX_KHR
+                : VK_PRESENT_MODE_FIFO_KHR;
+        }
+    }
+
+    //
+    // VK: render pass.
+    //
+    // NOTE(gr3yknigh1): Offscreen targets are never presented, but may be copied out for a frame dump. [2025/03/24]
+    VkImageLayout vk_final_layout = config.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkRenderPass vk_render_pass = vk_make_render_pass(vk_device, vk_surface_format.value().format);
+    SDL_assert(vk_render_pass);
+    defer(vkDestroyRenderPass(vk_device, vk_render_pass, nullptr));
+
+    //
+    // VK: bindless resource table. Made before pipeline layout of the triangle, which takes its set layout.
+    //
+    Vk_Bindless_Table vk_bindless_table = {};
+    SDL_assert(vk_bindless_init(&vk_bindless_table, vk_device, vk_device_capabilities, vk_is_bindless, 4096, 4096) == VK_SUCCESS);
+    defer(vk_bindless_destroy(&vk_bindless_table));
+
+    //
+    // VK: pipeline layout of the triangle.
+    //
+    VkPushConstantRange vk_push_constant_range = {};
+    vk_push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    vk_push_constant_range.offset = 0;
+    vk_push_constant_range.size = s_camera_push_constant_offset + sizeof(Camera);
+
+    VkPipelineLayoutCreateInfo vk_pipeline_layout_create_info = {};
+    vk_pipeline_layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    vk_pipeline_layout_create_info.setLayoutCount = 1;
+    vk_pipeline_layout_create_info.pSetLayouts = &vk_bindless_table.set_layout;
+    vk_pipeline_layout_create_info.pushConstantRangeCount = 1;
+    vk_pipeline_layout_create_info.pPushConstantRanges = &vk_push_constant_range;
+
+    VkPipelineLayout vk_pipeline_layout = VK_NULL_HANDLE;
+    SDL_assert(vkCreatePipelineLayout(vk_device, &vk_pipeline_layout_create_info, nullptr, &vk_pipeline_layout) == VK_SUCCESS);
+    defer(vkDestroyPipelineLayout(vk_device, vk_pipeline_layout, nullptr));
+
+    //
+    // Startup: pipelines are compiled by workers while main thread creates everything else. Waited for right before
+    // the first thing which needs pipeline cache.
+    //
+    startup.render_pass = vk_render_pass;
+    startup.pipeline_layout = vk_pipeline_layout;
+    vk_bindless_specialization(vk_bindless_table, &startup.bindless_specialization);
+
+    defer(vk_pipeline_cache_destroy(&startup.pipeline_cache));
+    defer(vkDestroyShaderModule(vk_device, startup.vertex_shader, nullptr));
+    defer(vkDestroyShaderModule(vk_device, startup.fragment_shader, nullptr));
+    defer(vkDestroyPipeline(vk_device, startup.pipeline, nullptr));
+
+    Task_Graph pipelines_graph;
+
+    uint32_t pipeline_cache_task = task_graph_add(&pipelines_graph, "pipeline cache", app_startup_pipeline_cache, &startup);
+    uint32_t shader_modules_task = task_graph_add(&pipelines_graph, "shader modules", app_startup_shader_modules, &startup);
+    uint32_t triangle_pipeline_task = task_graph_add(
+        &pipelines_graph, "triangle pipeline", app_startup_triangle_pipeline, &startup, { pipeline_cache_task, shader_modules_task });
+
+    task_graph_start(&pipelines_graph, startup_workers_count, &profiler);
+
+    // NOTE(gr3yknigh1): Registered after what tasks write, so early return doesn't destroy it under them. [2025/04/13]
+    defer(task_graph_wait(&pipelines_graph));
+
+    //
+    // VK: GPU timestamps.
+    //
+    SDL_assert(vk_profiler_init_gpu(
+        &profiler, vk_device_capabilities, vk_device, vk_graphics_queue, vk_graphics_queue_index.value(),
+        config.frames_in_flight, 32) == VK_SUCCESS);
+    defer(vk_profiler_destroy_gpu(&profiler));
+
+    //
+    // VK: device memory allocator.
+    //
+    Vk_Allocator vk_allocator = {};
+    SDL_assert(vk_allocator_init(&vk_allocator, vk_device_capabilities, vk_device) == VK_SUCCESS);
+    defer(vk_allocator_destroy(&vk_allocator));
+
+    //
+    // VK: deferred destruction of objects replaced while frames are in flight (swapchain, pipelines, transients).
+    // Declared before everything it may hold, so it is flushed after the device wait and before their owners go.
+    //
+    Vk_Deletion_Queue vk_deletion_queue = {};
+    vk_deletion_queue_init(&vk_deletion_queue, vk_device, &vk_allocator);
+    defer(vk_deletion_queue_destroy(&vk_deletion_queue));
+
+    //
+    // VK: staging ring and upload batches.
+    //
+    Vk_Upload_Context vk_upload_context = {};
+    SDL_assert(vk_upload_init(
+        &vk_upload_context, vk_device_capabilities, &vk_allocator, vk_transfer_queue, vk_transfer_queue_index,
+        vk_graphics_queue_index.value(), static_cast<VkDeviceSize>(config.staging_size_mb) * 1024 * 1024, 4,
+        vk_has_timeline_semaphores) == VK_SUCCESS);
+    defer(vk_upload_destroy(&vk_upload_context));
+
+    //
+    // VK: frame graph. Declared every frame by `vk_record_frame`, compiled only when its structure changes.
+    //
+    Vk_Render_Graph vk_render_graph = {};
+    vk_render_graph_init(&vk_render_graph, vk_device, &vk_allocator, &vk_deletion_queue);
+    defer(vk_render_graph_destroy(&vk_render_graph));
+
+    //
+    // VK: mesh. Vertex and index streams go through transfer queue, scene file ones straight from its mapping.
+    // Indexed, since indirect draws of GPU culling are indexed ones.
+    //
+    // NOTE(gr3yknigh1): Opened by "scene" startup task. [2025/04/13]
+    const Scene &scene = startup.scene;
+
+    Vk_Scene vk_scene = {};
+    SDL_assert(vk_scene_upload(&vk_allocator, &vk_upload_context, scene, &vk_scene) == VK_SUCCESS);
+    defer(vk_scene_destroy(&vk_allocator, &vk_scene));
+
+    // NOTE(gr3yknigh1): First mesh starts at offset 0 of both streams, so buffers are bound as they are. Its
+    // `position_scale` is ignored: grid scales draws to fit cells anyway. [2025/04/11]
+    const Scene_Mesh &mesh = scene.meshes[0];
+    SDL_assert(mesh.first_vertex == 0 && mesh.indices_offset == 0);
+
+    std::vector<Draw_Command> draws = make_grid_draws(config.draw_count);
+
+    VkBufferCreateInfo vk_draws_buffer_create_info = {};
+    vk_draws_buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    vk_draws_buffer_create_info.size = draws.size() * sizeof(Draw_Command);
+    vk_draws_buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vk_draws_buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer vk_draws_buffer = VK_NULL_HANDLE;
+    Vk_Allocation vk_draws_allocation = {};
+    SDL_assert(vk_allocator_make_buffer(
+        &vk_allocator, vk_draws_buffer_create_info, Vk_Memory_Usage::Gpu_Only, &vk_draws_buffer, &vk_draws_allocation) == VK_SUCCESS);
+    defer(vk_allocator_destroy_buffer(&vk_allocator, vk_draws_buffer, &vk_draws_allocation));
+
+    Vk_Draw_List vk_draw_list = {};
+    vk_draw_list.pipeline_layout = vk_pipeline_layout;
+    vk_draw_list.vertex_buffer = vk_scene.vertex_buffer;
+    vk_draw_list.vertex_buffer_ticket = vk_scene.vertex_buffer_ticket;
+    vk_draw_list.index_buffer = vk_scene.index_buffer;
+    vk_draw_list.index_buffer_ticket = vk_scene.index_buffer_ticket;
+    vk_draw_list.index_count = mesh.indices_count;
+    vk_draw_list.index_type = vk_scene_index_type(mesh);
+    vk_draw_list.mesh_radius = mesh.radius;
+    vk_draw_list.draws = draws.data();
+    vk_draw_list.draws_count = static_cast<uint32_t>(draws.size());
+    vk_draw_list.bindless_table = &vk_bindless_table;
+    vk_draw_list.draws_handle = vk_bindless_add_buffer(&vk_bindless_table, vk_draws_buffer, 0, VK_WHOLE_SIZE);
+    vk_draw_list.draws_buffer_ticket = vk_upload_buffer(
+        &vk_upload_context, vk_draws_buffer, 0, draws.data(), vk_draws_buffer_create_info.size,
+        VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    vk_draw_list.camera = make_camera(0.0f);
+
+    SDL_assert(vk_bindless_is_valid(vk_bindless_table, vk_draw_list.draws_handle) && vk_draw_list.draws_buffer_ticket != 0);
+
+    //
+    // VK: streamed textures. Only tails are uploaded here, the rest follows screen-space feedback of the frames.
+    //
+    Vk_Texture_Streamer vk_texture_streamer = {};
+    defer(vk_texture_streamer_destroy(&vk_texture_streamer));
+
+    if (config.texture_dir != nullptr) {
+        SDL_assert(vk_texture_streamer_init(
+            &vk_texture_streamer, vk_device_capabilities, vk_device, &vk_allocator, &vk_upload_context, &vk_bindless_table,
+            &vk_deletion_queue, static_cast<VkDeviceSize>(config.texture_budget_mb) * 1024 * 1024,
+            static_cast<VkDeviceSize>(config.staging_size_mb) * 1024 * 1024 / 8) == VK_SUCCESS);
+
+        const std::vector<std::filesystem::path> &texture_paths = startup.texture_paths;
+
+        for (const auto &path : texture_paths) {
+            vk_texture_streamer_add(&vk_texture_streamer, path.string().c_str());
+        }
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Textures: %zu of %zu files in %s are streamed", vk_texture_streamer.textures.size(),
+            texture_paths.size(), config.texture_dir);
+    }
+
+    //
+    // Job system for parallel recording.
+    //
+    Job_System job_system;
+    job_system_init(&job_system, config.threads_count);
+    defer(job_system_destroy(&job_system));
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Recording threads = %u, draws = %u", config.threads_count, config.draw_count);
+
+    //
+    // VK: graphics timeline. Frames are its only submits, so frame N signals value N.
+    //
+    Vk_Timeline vk_graphics_timeline = {};
+    SDL_assert(vk_timeline_init(&vk_graphics_timeline, vk_device, vk_has_timeline_semaphores, "graphics") == VK_SUCCESS);
+    defer(vk_timeline_destroy(&vk_graphics_timeline));
+
+    //
+    // VK: frames in flight.
+    //
+    std::vector<Vk_Frame> vk_frames(config.frames_in_flight);
+    for (auto &frame : vk_frames) {
+        SDL_assert(vk_make_frame(vk_device, vk_graphics_queue_index.value(), config.threads_count, &frame) == VK_SUCCESS);
+    }
+    defer(for (auto& frame : vk_frames) vk_destroy_frame(vk_device, &frame));
+
+    //
+    // VK: compute.
+    //
+    Vk_Compute_Context vk_compute_context = {};
+    if (config.particles_count > 0) {
+        SDL_assert(vk_compute_init(
+            &vk_compute_context, vk_device, vk_compute_queue, vk_compute_queue_index, vk_graphics_queue_index.value(),
+            config.frames_in_flight, vk_has_timeline_semaphores) == VK_SUCCESS);
+    }
+    defer(vk_compute_destroy(&vk_compute_context));
+
+    //
+    // VK: swapchain.
+    //
+    Vk_Swapchain vk_swapchain = {};
+    defer(vk_destroy_swapchain(vk_device, &vk_swapchain));
+
+    if (!config.headless) {
+        SDL_assert(vk_recreate_swapchain(
+            vk_physical_device, vk_device, vk_surface, vk_surface_format.value(),
+            vk_graphics_queue_index.value(), vk_present_queue_index.value(), vk_present_mode.value(),
+            config.swapchain_images_count, vk_render_pass, window_width, window_height, true, 0, &vk_swapchain,
+            &vk_deletion_queue) == VK_SUCCESS);
+    }
+
+    //
+    // VK: offscreen targets (headless mode), one per frame in flight.
+    //
+    VkExtent2D vk_offscreen_extent = { config.headless_width, config.headless_height };
+
+    std::vector<Vk_Offscreen_Target> vk_offscreen_targets;
+    if (config.headless) {
+        vk_offscreen_targets.resize(config.frames_in_flight);
+
+        for (auto &target : vk_offscreen_targets) {
+            SDL_assert(vk_make_offscreen_target(
+                &vk_allocator, vk_render_pass, vk_surface_format.value().format, vk_offscreen_extent, &target) == VK_SUCCESS);
+        }
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Headless: %ux%u, %u frames", vk_offscreen_extent.width, vk_offscreen_extent.height, config.frame_count);
+    }
+    defer(for (auto& target : vk_offscreen_targets) vk_destroy_offscreen_target(&vk_allocator, &target));
+
+    //
+    // Startup: waiting for pipelines.
+    //
+    uint64_t resources_counter = SDL_GetPerformanceCounter();
+
+    bool are_pipelines_created = task_graph_wait(&pipelines_graph);
+    task_graph_log_report(pipelines_graph, "pipelines", startup_counter);
+
+    if (!are_pipelines_created) {
+        // NOTE(gr3yknigh1): Uploads are still in flight, and device idle wait is deferred only further down. [2025/04/17]
+        vkDeviceWaitIdle(vk_device);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t pipelines_counter = SDL_GetPerformanceCounter();
+
+    Vk_Pipeline_Cache &vk_pipeline_cache = startup.pipeline_cache;
+    VkShaderModule vk_fragment_shader = startup.fragment_shader;
+
+    // NOTE(gr3yknigh1): Reference, shader reloader swaps rebuilt pipeline in through its address. [2025/04/13]
+    VkPipeline &vk_pipeline = startup.pipeline;
+    vk_draw_list.pipeline = vk_pipeline;
+
+    //
+    // VK: particles.
+    //
+    uint64_t particles_counter = SDL_GetPerformanceCounter();
+
+    Vk_Particles vk_particles = {};
+    if (config.particles_count > 0) {
+        SDL_assert(vk_make_particles(
+            &vk_allocator, vk_pipeline_cache.handle, vk_render_pass, vk_compute_queue_index, vk_graphics_queue_index.value(),
+            config.frames_in_flight, config.particles_count, &vk_particles) == VK_SUCCESS);
+    }
+    defer(vk_destroy_particles(&vk_allocator, &vk_particles));
+
+    double pipelines_ms = task_graph_task_ms(pipelines_graph, triangle_pipeline_task)
+        + app_counter_ms(particles_counter, SDL_GetPerformanceCounter());
+
+    //
+    // VK: GPU-driven culling.
+    //
+    Vk_Gpu_Culling vk_gpu_culling = {};
+    if (config.gpu_culling) {
+        std::vector<Gpu_Object> objects = make_gpu_objects(vk_draw_list.draws, vk_draw_list.draws_count, vk_draw_list.mesh_radius);
+
+        SDL_assert(vk_make_gpu_culling(
+            vk_device_capabilities, &vk_allocator, &vk_upload_context, vk_pipeline_cache.handle, vk_render_pass,
+            config.frames_in_flight, objects.data(), static_cast<uint32_t>(objects.size()), vk_draw_list.index_count,
+            vk_cmd_draw_indexed_indirect_count, &vk_gpu_culling) == VK_SUCCESS);
+
+        // NOTE(gr3yknigh1): Culling benchmark switches between both paths itself. [2025/04/01]
+        if (!config.benchmark_culling) {
+            vk_draw_list.gpu_culling = &vk_gpu_culling;
+        }
+    }
+    defer(vk_destroy_gpu_culling(&vk_allocator, &vk_gpu_culling));
+
+    //
+    // VK: draw queue. CPU-culled draws are sorted and merged into instanced draws.
+    //
+    Vk_Draw_Queue vk_draw_queue = {};
+    defer(vk_draw_queue_destroy(&vk_draw_queue));
+
+    VkPipeline vk_instanced_pipeline = VK_NULL_HANDLE;
+    defer(vkDestroyPipeline(vk_device, vk_instanced_pipeline, nullptr));
+
+    if (config.draw_queue && vk_draw_list.gpu_culling == nullptr) {
+        SDL_assert(vk_draw_queue_init(
+            &vk_draw_queue, &vk_allocator, config.frames_in_flight, vk_draw_list.draws_count, sizeof(Gpu_Object),
+            VK_NULL_HANDLE, sizeof(Camera)) == VK_SUCCESS);
+
+        // NOTE(gr3yknigh1): Reads objects by `gl_InstanceIndex`, the same as draws issued by GPU culling. [2025/04/08]
+        VkShaderModule vk_instanced_vertex_shader = vk_load_shader_module(vk_device, "shaders/triangle_indirect.vert.spv");
+        SDL_assert(vk_instanced_vertex_shader);
+        defer(vkDestroyShaderModule(vk_device, vk_instanced_vertex_shader, nullptr));
+
+        SDL_assert(vk_make_triangle_pipeline(
+            vk_device, vk_pipeline_cache.handle, vk_render_pass, vk_draw_queue.pipeline_layout, vk_instanced_vertex_shader,
+            vk_fragment_shader, nullptr, &vk_instanced_pipeline) == VK_SUCCESS);
+
+        //
+        // NOTE(gr3yknigh1): Grid alternates two meshes (first ones of the scene, the built-in scene repeats its only
+        // mesh) at varying depth, so draws go through the mesh changes and depth order the queue sorts by. [2025/04/17]
+        //
+        vk_draw_list.draw_queue = &vk_draw_queue;
+        vk_draw_list.draw_queue_pipeline = vk_draw_queue_add_pipeline(&vk_draw_queue, &vk_instanced_pipeline);
+        vk_draw_list.draw_queue_material = vk_draw_queue_add_material(&vk_draw_queue, VK_NULL_HANDLE);
+
+        for (uint32_t index = 0; index < vk_draw_list.draw_queue_meshes.size(); ++index) {
+            const Scene_Mesh &scene_mesh = scene.meshes[index % scene.meshes_count];
+
+            Vk_Draw_Mesh vk_draw_mesh = {};
+            vk_draw_mesh.vertex_buffer = vk_scene.vertex_buffer;
+            vk_draw_mesh.index_buffer = vk_scene.index_buffer;
+            vk_draw_mesh.index_type = vk_scene_index_type(scene_mesh);
+            vk_draw_mesh.index_count = scene_mesh.indices_count;
+            vk_draw_mesh.first_index = static_cast<uint32_t>(scene_mesh.indices_offset / scene_mesh.index_size);
+            vk_draw_mesh.vertex_offset = static_cast<int32_t>(scene_mesh.first_vertex);
+
+            vk_draw_list.draw_queue_meshes[index] = vk_draw_queue_add_mesh(&vk_draw_queue, vk_draw_mesh);
+            vk_draw_list.draw_queue_radii[index] = scene_mesh.radius;
+        }
+    }
+
+    //
+    // VK: shader hot reload. Sources are watched only once main loop starts.
+    //
+    // NOTE(gr3yknigh1): Pipelines are rebuilt on the reloader thread, so it gets its own cache. [2025/04/05]
+    VkPipelineCache vk_reload_pipeline_cache = config.hot_reload ? vk_pipeline_cache_make_thread_cache(&vk_pipeline_cache) : VK_NULL_HANDLE;
+
+    Vk_Pipeline_Build_Args vk_triangle_build_args = {
+        vk_reload_pipeline_cache, vk_render_pass, vk_pipeline_layout, &startup.bindless_specialization.info };
+    Vk_Pipeline_Build_Args vk_particles_simulate_build_args = { vk_reload_pipeline_cache, VK_NULL_HANDLE, vk_particles.simulate_layout };
+    Vk_Pipeline_Build_Args vk_particles_draw_build_args = { vk_reload_pipeline_cache, vk_render_pass, vk_particles.draw_layout };
+    Vk_Pipeline_Build_Args vk_cull_build_args = { vk_reload_pipeline_cache, VK_NULL_HANDLE, vk_gpu_culling.cull_layout };
+    Vk_Pipeline_Build_Args vk_culled_draw_build_args = { vk_reload_pipeline_cache, vk_render_pass, vk_gpu_culling.draw_layout };
+    Vk_Pipeline_Build_Args vk_instanced_draw_build_args = { vk_reload_pipeline_cache, vk_render_pass, vk_draw_queue.pipeline_layout };
+
+    Vk_Shader_Reloader vk_shader_reloader;
+    vk_shader_reload_init(&vk_shader_reloader, vk_device, &vk_deletion_queue);
+    defer(vk_shader_reload_destroy(&vk_shader_reloader));
+
+    if (config.hot_reload) {
+        vk_shader_reload_register(
+            &vk_shader_reloader, "triangle", { "shaders/triangle.vert.spv", "shaders/triangle.frag.spv" },
+            vk_build_triangle_pipeline, &vk_triangle_build_args, &vk_pipeline);
+
+        if (config.particles_count > 0) {
+            vk_shader_reload_register(
+                &vk_shader_reloader, "particles simulate", { "shaders/particles.comp.spv" },
+                vk_build_compute_pipeline, &vk_particles_simulate_build_args, &vk_particles.simulate_pipeline);
+            vk_shader_reload_register(
+                &vk_shader_reloader, "particles draw", { "shaders/particles.vert.spv", "shaders/triangle.frag.spv" },
+                vk_build_particles_draw_pipeline, &vk_particles_draw_build_args, &vk_particles.draw_pipeline);
+        }
+
+        if (config.gpu_culling) {
+            vk_shader_reload_register(
+                &vk_shader_reloader, "gpu culling", { "shaders/cull.comp.spv" },
+                vk_build_compute_pipeline, &vk_cull_build_args, &vk_gpu_culling.cull_pipeline);
+            vk_shader_reload_register(
+                &vk_shader_reloader, "culled draw", { "shaders/triangle_indirect.vert.spv", "shaders/triangle.frag.spv" },
+                vk_build_triangle_pipeline, &vk_culled_draw_build_args, &vk_gpu_culling.draw_pipeline);
+        }
+
+        if (vk_draw_list.draw_queue != nullptr) {
+            vk_shader_reload_register(
+                &vk_shader_reloader, "instanced draw", { "shaders/triangle_indirect.vert.spv", "shaders/triangle.frag.spv" },
+                vk_build_triangle_pipeline, &vk_instanced_draw_build_args, &vk_instanced_pipeline);
+        }
+    }
+
+    // NOTE(gr3yknigh1): Runs first on scope exit, before anything above is destroyed. [2025/03/22]
+    defer(vkDeviceWaitIdle(vk_device));
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frames in flight = %u", config.frames_in_flight);
+
+    if (config.benchmark_recording) {
+        VkFramebuffer framebuffer = config.headless ? vk_offscreen_targets[0].framebuffer : vk_swapchain.framebuffers[0];
+        VkExtent2D extent = config.headless ? vk_offscreen_extent : vk_swapchain.extent;
+
+        // NOTE(gr3yknigh1): Sweep creates its own job systems, workers of the main one would only compete. [2025/03/28]
+        job_system_destroy(&job_system);
+        job_system_init(&job_system, 1);
+
+        vk_benchmark_recording(vk_device, &vk_frames[0], vk_render_pass, framebuffer, extent, vk_draw_list, config.threads_count);
+        return EXIT_SUCCESS;
+    }
+
+    App_Benchmark_Frames benchmark_frames = {};
+    benchmark_frames.job_system = &job_system;
+    benchmark_frames.render_graph = &vk_render_graph;
+    benchmark_frames.device = vk_device;
+    benchmark_frames.graphics_queue = vk_graphics_queue;
+    benchmark_frames.graphics_timeline = &vk_graphics_timeline;
+    benchmark_frames.frames = &vk_frames;
+    benchmark_frames.targets = &vk_offscreen_targets;
+    benchmark_frames.extent = vk_offscreen_extent;
+    benchmark_frames.upload_context = &vk_upload_context;
+    benchmark_frames.render_pass = vk_render_pass;
+    benchmark_frames.draw_list = &vk_draw_list;
+
+    if (config.benchmark_compute) {
+        Vk_Compute_Context vk_serialized_compute_context = {};
+        SDL_assert(vk_compute_init(
+            &vk_serialized_compute_context, vk_device, vk_graphics_queue, vk_graphics_queue_index.value(),
+            vk_graphics_queue_index.value(), config.frames_in_flight, vk_has_timeline_semaphores) == VK_SUCCESS);
+        defer(vk_compute_destroy(&vk_serialized_compute_context));
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Benchmark: %u draws", vk_draw_list.draws_count);
+
+        benchmark_frames.particles = &vk_particles;
+        vk_benchmark_compute(
+            app_benchmark_frames(&benchmark_frames), vk_device, &vk_particles, &vk_serialized_compute_context, &vk_compute_context);
+
+        vkDeviceWaitIdle(vk_device);
+        return EXIT_SUCCESS;
+    }
+
+    if (config.benchmark_culling) {
+        // NOTE(gr3yknigh1): Draw list isn't culled on GPU in culling benchmark, see above. [2025/04/16]
+        Vk_Draw_List vk_gpu_culled_draw_list = vk_draw_list;
+        vk_gpu_culled_draw_list.gpu_culling = &vk_gpu_culling;
+
+        App_Benchmark_Frames gpu_culled_frames = benchmark_frames;
+        gpu_culled_frames.draw_list = &vk_gpu_culled_draw_list;
+
+        Vk_Benchmark_Frames vk_cpu_culled_frames = app_benchmark_frames(&benchmark_frames);
+        Vk_Benchmark_Frames vk_gpu_culled_frames = app_benchmark_frames(&gpu_culled_frames);
+
+        std::vector<Gpu_Object> objects = make_gpu_objects(vk_draw_list.draws, vk_draw_list.draws_count, vk_draw_list.mesh_radius);
+
+        vk_benchmark_culling(
+            vk_cpu_culled_frames, config.gpu_culling ? &vk_gpu_culled_frames : nullptr, vk_device, &vk_upload_context,
+            objects.data(), static_cast<uint32_t>(objects.size()));
+
+        vkDeviceWaitIdle(vk_device);
+        return EXIT_SUCCESS;
+    }
+
+    //
+    // Main loop:
+    //
+    uint32_t frame_index = 0;
+
+    // NOTE(gr3yknigh1): Frames are submitted to single queue, so they complete in submission order. Every frame
+    // with number <= `completed_frame_number` is known to be finished on GPU. [2025/03/23]
+    uint64_t frame_number = 0;
+    uint64_t completed_frame_number = 0;
+
+    bool swapchain_dirty = false;
+    bool swapchain_out_of_date = false;
+
+    uint64_t graph_dumped_compiles = 0;
+
+    Frame_Time_Stats frame_time_stats = {};
+    frame_time_stats_begin(&frame_time_stats);
+    defer(frame_time_stats_report_run(&frame_time_stats));
+
+    Frame_Limiter frame_limiter = {};
+    frame_limiter_init(&frame_limiter, config.fps_limit);
+    defer(frame_limiter_report_run(&frame_limiter, frame_number));
+
+    Present_Latency present_latency = {};
+    present_latency_init(&present_latency, vk_device, vk_wait_for_present);
+    defer(present_latency_report_run(&present_latency));
+
+    // NOTE(gr3yknigh1): Long enough for uploads to land and containers of the loop to reach their size. [2025/04/07]
+    constexpr uint32_t heap_warmup_frames_count = 100;
+
+    Frame_Heap_Stats frame_heap_stats = {};
+    frame_heap_stats_begin(&frame_heap_stats, heap_warmup_frames_count);
+    defer(frame_heap_stats_report_run(&frame_heap_stats));
+
+    if (config.hot_reload) {
+        vk_shader_reload_start(&vk_shader_reloader);
+    }
+
+    uint64_t simulation_start_counter = SDL_GetPerformanceCounter();
+    uint64_t simulation_counter = simulation_start_counter;
+
+    //
+    // NOTE(gr3yknigh1): Frames are rendered on their own thread, the main thread only pumps window events and passes
+    // them over `render_channel`, so event handling and window manager stalls don't hold rendering up. Render thread
+    // takes over thread index 0 of the job system, main thread doesn't use it anymore. [2025/04/14]
+    //
+    Render_Channel render_channel;
+
+    int drawable_width = window_width, drawable_height = window_height;
+    bool is_minimized = false;
+
+    auto render_frames = [&]() {
+        while (!render_channel.should_stop.load()) {
+            profiler.frame_number.store(frame_number + 1, std::memory_order_relaxed);
+
+            {
+                profile_scope(&profiler, "frame limiter");
+                frame_limiter_wait(&frame_limiter);
+            }
+
+            if (!config.headless) {
+                profile_scope(&profiler, "input");
+
+                render_channel_sync(&render_channel, s_app_input_sync_timeout_ms);
+
+                Render_Input input = {};
+                while (render_channel_pop(&render_channel, &input)) {
+                    switch (input.kind) {
+                    case Render_Input_Kind::Resized:
+                        drawable_width = input.width;
+                        drawable_height = input.height;
+                        swapchain_dirty = true;
+                        break;
+                    case Render_Input_Kind::Minimized:
+                        is_minimized = true;
+                        break;
+                    case Render_Input_Kind::Restored:
+                        is_minimized = false;
+                        break;
+                    case Render_Input_Kind::Next_Present_Mode:
+                        vk_present_mode = vk_next_present_mode(vk_device_capabilities, vk_present_mode.value());
+                        swapchain_out_of_date = true;
+                        break;
+                    }
+                }
+
+                // NOTE(gr3yknigh1): Nothing to render to, sleeps until event thread reports restore or resize. [2025/04/14]
+                if (is_minimized || drawable_width == 0 || drawable_height == 0) {
+                    render_channel_wait_input(&render_channel);
+                    continue;
+                }
+            }
+
+            Vk_Frame &frame = vk_frames[frame_index];
+
+            {
+                profile_scope(&profiler, "wait frame");
+
+                vk_result = vk_timeline_wait(&vk_graphics_timeline, frame.submitted_frame_number);
+                SDL_assert(vk_result == VK_SUCCESS);
+            }
+
+            profiler_collect(&profiler);
+
+            completed_frame_number = vk_timeline_poll(&vk_graphics_timeline);
+            vk_deletion_queue_collect(&vk_deletion_queue, completed_frame_number);
+            vk_bindless_collect(&vk_bindless_table, completed_frame_number);
+            present_latency_poll(&present_latency);
+
+            // NOTE(gr3yknigh1): Draw list holds a copy of the handle, which may be just replaced. [2025/04/05]
+            vk_shader_reload_apply(&vk_shader_reloader, frame_number);
+            vk_draw_list.pipeline = vk_pipeline;
+
+            uint32_t image_index = 0;
+            VkImage color_image = VK_NULL_HANDLE;
+            VkFramebuffer framebuffer = VK_NULL_HANDLE;
+            VkExtent2D extent = {};
+
+            if (config.headless) {
+                color_image = vk_offscreen_targets[frame_index].image;
+                framebuffer = vk_offscreen_targets[frame_index].framebuffer;
+                extent = vk_offscreen_extent;
+            } else {
+                profile_scope(&profiler, "acquire image");
+
+                //
+                // NOTE(gr3yknigh1): Resize storm during window drag produces a lot of events, but at most one rebuild
+                // per frame happens here, and only if extent actually changed. No `vkDeviceWaitIdle`: old swapchain is
+                // handed to the new one and destroyed once the last frame which used it completes. [2025/03/23]
+                //
+                if (swapchain_dirty || swapchain_out_of_date) {
+                    VkSwapchainKHR old_swapchain = vk_swapchain.handle;
+
+                    vk_result = vk_recreate_swapchain(
+                        vk_physical_device, vk_device, vk_surface, vk_surface_format.value(),
+                        vk_graphics_queue_index.value(), vk_present_queue_index.value(), vk_present_mode.value(),
+                        config.swapchain_images_count, vk_render_pass, drawable_width, drawable_height, swapchain_out_of_date,
+                        frame_number, &vk_swapchain, &vk_deletion_queue);
+                    SDL_assert(vk_result == VK_SUCCESS);
+
+                    if (vk_swapchain.handle != old_swapchain) {
+                        present_latency_forget(&present_latency, old_swapchain);
+                    }
+
+                    swapchain_dirty = false;
+                    swapchain_out_of_date = false;
+                }
+
+                vk_result = vkAcquireNextImageKHR(
+                    vk_device, vk_swapchain.handle, std::numeric_limits<uint64_t>::max(), frame.image_available, VK_NULL_HANDLE, &image_index);
+
+                if (vk_result == VK_ERROR_OUT_OF_DATE_KHR) {
+                    // NOTE(gr3yknigh1): Nothing was submitted and semaphore wasn't signaled, so frame can be just retried. [2025/03/23]
+                    swapchain_out_of_date = true;
+                    continue;
+                }
+                SDL_assert(vk_result == VK_SUCCESS || vk_result == VK_SUBOPTIMAL_KHR);
+
+                if (vk_result == VK_SUBOPTIMAL_KHR) {
+                    swapchain_out_of_date = true;
+                }
+
+                uint64_t &image_frame_number = vk_swapchain.images_frame_numbers[image_index];
+                vk_result = vk_timeline_wait(&vk_graphics_timeline, image_frame_number);
+                SDL_assert(vk_result == VK_SUCCESS);
+                image_frame_number = frame_number + 1;
+
+                color_image = vk_swapchain.images[image_index];
+                framebuffer = vk_swapchain.framebuffers[image_index];
+                extent = vk_swapchain.extent;
+            }
+
+            Vk_Submit_Waits submit_waits = {};
+
+            if (!config.headless) {
+                vk_submit_waits_add_semaphore(&submit_waits, frame.image_available, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+            }
+
+            //
+            // NOTE(gr3yknigh1): Simulation is submitted before graphics is even recorded, so compute queue starts on it
+            // while graphics queue still renders previous frame. Graphics waits for it only at vertex shader. [2025/03/31]
+            //
+            if (vk_particles.count > 0) {
+                profile_scope(&profiler, "simulate");
+
+                uint64_t counter = SDL_GetPerformanceCounter();
+                float delta_time = std::min(
+                    static_cast<float>(counter - simulation_counter) / static_cast<float>(SDL_GetPerformanceFrequency()), 1.0f / 30.0f);
+                float time = static_cast<float>(counter - simulation_start_counter) / static_cast<float>(SDL_GetPerformanceFrequency());
+                simulation_counter = counter;
+
+                VkCommandBuffer compute_command_buffer = vk_compute_begin(&vk_compute_context, frame_index);
+                vk_record_particles_simulation(&vk_particles, compute_command_buffer, frame_index, delta_time, time);
+
+                vk_result = vk_compute_submit(&vk_compute_context, frame_index, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, &submit_waits);
+                SDL_assert(vk_result == VK_SUCCESS);
+            }
+
+            float camera_time = static_cast<float>(SDL_GetPerformanceCounter() - simulation_start_counter) / static_cast<float>(SDL_GetPerformanceFrequency());
+            vk_draw_list.camera = make_camera(camera_time);
+
+            //
+            // NOTE(gr3yknigh1): Feedback is gathered every few frames only, camera moves slowly and every visible draw
+            // is visited. Promotions staged here are acquired by this frame's recording. [2025/04/12]
+            //
+            if (!vk_texture_streamer.textures.empty()) {
+                profile_scope(&profiler, "textures");
+
+                constexpr uint64_t texture_feedback_period = 4;
+                if (frame_number % texture_feedback_period == 0) {
+                    app_request_textures(&vk_texture_streamer, vk_draw_list, extent, frame_number + 1);
+                }
+
+                vk_texture_streamer_update(&vk_texture_streamer, frame_number);
+            }
+
+            {
+                profile_scope(&profiler, "record");
+
+                vk_reset_frame(vk_device, &frame);
+                vk_record_frame(
+                    &job_system, &profiler, &vk_render_graph, vk_device, &frame, frame_index, frame_number + 1,
+                    &vk_upload_context, vk_render_pass, color_image, framebuffer, vk_final_layout, extent, vk_draw_list,
+                    vk_particles.count > 0 ? &vk_particles : nullptr);
+            }
+
+            if (config.graph_dump_path != nullptr && vk_render_graph.stats.compiles_count != graph_dumped_compiles) {
+                graph_dumped_compiles = vk_render_graph.stats.compiles_count;
+
+                vk_render_graph_log(vk_render_graph);
+                if (vk_render_graph_dump(vk_render_graph, config.graph_dump_path)) {
+                    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Render graph dumped to %s", config.graph_dump_path);
+                }
+            }
+
+            VkSemaphore render_finished = config.headless ? VK_NULL_HANDLE : vk_swapchain.render_finished_semaphores[image_index];
+
+            {
+                profile_scope(&profiler, "submit");
+
+                vk_result = vk_timeline_submit(
+                    &vk_graphics_timeline, vk_graphics_queue, &frame.command_buffer, 1, &submit_waits, render_finished,
+                    &frame.submitted_frame_number);
+                SDL_assert(vk_result == VK_SUCCESS);
+            }
+
+            ++frame_number;
+            SDL_assert(frame.submitted_frame_number == frame_number);
+
+            if (frame_number == 1) {
+                uint64_t first_frame_counter = SDL_GetPerformanceCounter();
+                SDL_LogInfo(
+                    SDL_LOG_CATEGORY_APPLICATION,
+                    "Startup: first frame submitted after %.2f ms: instance and device %.2f ms, resources %.2f ms, waiting for "
+                    "pipelines %.2f ms, the rest %.2f ms; pipelines created in %.2f ms (%s pipeline cache)",
+                    app_counter_ms(startup_counter, first_frame_counter), app_counter_ms(startup_counter, device_counter),
+                    app_counter_ms(device_counter, resources_counter), app_counter_ms(resources_counter, pipelines_counter),
+                    app_counter_ms(pipelines_counter, first_frame_counter), pipelines_ms, vk_pipeline_cache.is_warm ? "warm" : "cold");
+            }
+
+            if (!config.headless) {
+                profile_scope(&profiler, "present");
+
+                VkPresentInfoKHR present_info = {};
+                present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+                present_info.waitSemaphoreCount = 1;
+                present_info.pWaitSemaphores = &vk_swapchain.render_finished_semaphores[image_index];
+                present_info.swapchainCount = 1;
+                present_info.pSwapchains = &vk_swapchain.handle;
+                present_info.pImageIndices = &image_index;
+
+                uint64_t present_id = present_latency_next_id(&present_latency);
+
+                VkPresentIdKHR present_id_info = {};
+                present_id_info.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+                present_id_info.swapchainCount = 1;
+                present_id_info.pPresentIds = &present_id;
+
+                if (present_id != 0) {
+                    present_info.pNext = &present_id_info;
+                }
+
+                vk_result = vkQueuePresentKHR(vk_present_queue, &present_info);
+                if (vk_result == VK_ERROR_OUT_OF_DATE_KHR || vk_result == VK_SUBOPTIMAL_KHR) {
+                    swapchain_out_of_date = true;
+                } else {
+                    SDL_assert(vk_result == VK_SUCCESS);
+                }
+
+                present_latency_on_present(&present_latency, vk_swapchain.handle, present_id, frame_limiter.input_counter);
+                present_latency_poll(&present_latency);
+            }
+
+            frame_limiter_end_frame(&frame_limiter);
+
+            frame_index = (frame_index + 1) % config.frames_in_flight;
+
+            frame_time_stats_tick(&frame_time_stats);
+            frame_heap_stats_tick(&frame_heap_stats);
+
+            if (config.frame_count != 0 && frame_number >= config.frame_count) {
+                render_channel_stop(&render_channel);
+            }
+        }
+
+    };
+
+    if (config.headless) {
+        render_frames();
+    } else {
+        if (!render_channel_init(&render_channel)) {
+            return EXIT_FAILURE;
+        }
+
+        std::thread render_thread(render_frames);
+        app_run_event_thread(&render_channel, window, &profiler);
+        render_thread.join();
+
+        render_channel_report_run(render_channel);
+    }
+
+    //
+    // Frame dump (headless mode): the last submitted frame.
+    //
+    if (config.dump_file_path != nullptr && frame_number > 0) {
+        vkDeviceWaitIdle(vk_device);
+
+        uint32_t last_frame_index = (frame_index + config.frames_in_flight - 1) % config.frames_in_flight;
+        bool is_dumped = vk_dump_image_ppm(
+            &vk_allocator, vk_graphics_queue, vk_graphics_queue_index.value(),
+            vk_offscreen_targets[last_frame_index].image, vk_surface_format.value().format, vk_offscreen_extent,
+            config.dump_file_path);
+
+        if (!is_dumped) {
+            return EXIT_FAILURE;
+        }
+
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frame %llu dumped to %s", static_cast<unsigned long long>(frame_number), config.dump_file_path);
+    }
+
+    if (config.fail_on_frame_allocations && frame_heap_stats.run_count > 0) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION, "%llu heap allocations in steady frames",
+            static_cast<unsigned long long>(frame_heap_stats.run_count));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+double
+app_counter_ms(uint64_t begin_counter, uint64_t end_counter)
+{
+    return static_cast<double>(end_counter - begin_counter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+void
+app_run_event_thread(Render_Channel *channel, SDL_Window *window, Profiler *profiler)
+{
+    uint32_t window_id = SDL_GetWindowID(window);
+
+    bool is_minimized = false;
+    int drawable_width = 0, drawable_height = 0;
+    SDL_Vulkan_GetDrawableSize(window, &drawable_width, &drawable_height);
+
+    // NOTE(gr3yknigh1): Inputs which didn't fit into the full queue, pushed again on the next pass. [2025/04/14]
+    std::vector<Render_Input> pending_inputs;
+
+    while (!channel->should_stop.load()) {
+        SDL_Event event;
+        bool has_event = pending_inputs.empty() ? SDL_WaitEvent(&event) != 0 : SDL_WaitEventTimeout(&event, 1) != 0;
+
+        profile_scope(profiler, "event pump");
+
+        uint64_t pump_number = 0;
+
+        for (; has_event; has_event = SDL_PollEvent(&event) != 0) {
+            if (event.type == SDL_QUIT) {
+                render_channel_stop(channel);
+            }
+
+            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == window_id) {
+                render_channel_stop(channel);
+            }
+
+            if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_v && !event.key.repeat) {
+                pending_inputs.push_back({ Render_Input_Kind::Next_Present_Mode });
+            }
+
+            pump_number = std::max(pump_number, render_channel_pump_number(*channel, event));
+        }
+
+        //
+        // NOTE(gr3yknigh1): Window state is compared with what render thread was told, instead of forwarding
+        // SIZE_CHANGED and MINIMIZED events, so a resize storm produces one input per pump. [2025/04/14]
+        //
+        bool is_now_minimized = (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) != 0;
+        if (is_now_minimized != is_minimized) {
+            is_minimized = is_now_minimized;
+            pending_inputs.push_back({ is_minimized ? Render_Input_Kind::Minimized : Render_Input_Kind::Restored });
+        }
+
+        int width = 0, height = 0;
+        SDL_Vulkan_GetDrawableSize(window, &width, &height);
+        if (width != drawable_width || height != drawable_height) {
+            drawable_width = width;
+            drawable_height = height;
+            pending_inputs.push_back({ Render_Input_Kind::Resized, width, height });
+        }
+
+        size_t pushed_count = 0;
+        while (pushed_count < pending_inputs.size() && render_channel_push(channel, pending_inputs[pushed_count])) {
+            ++pushed_count;
+        }
+        pending_inputs.erase(pending_inputs.begin(), pending_inputs.begin() + static_cast<ptrdiff_t>(pushed_count));
+
+        if (pump_number != 0) {
+            render_channel_pump_done(channel, pump_number);
+        }
+    }
+}
+
+bool
+app_startup_sdl(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+    const App_Config &config = *startup->config;
+
+#if defined(HELLO_VK_VIDEO_DRIVER)
+    // NOTE(gr3yknigh1): Platform picked at configure time. SDL_VIDEODRIVER environment variable still overrides it. [2025/04/06]
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, HELLO_VK_VIDEO_DRIVER);
+#endif
+
+    if (SDL_Init(config.headless ? 0 : SDL_INIT_VIDEO) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init() = %s\n", SDL_GetError());
+        return false;
+    }
+    startup->is_sdl_initialized = true;
+
+    SDL_version v = {};
+    SDL_GetVersion(&v);
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "SDL version %d.%d.%d\n", v.major,
+        v.minor, v.patch);
+
+    if (config.headless) {
+        return true;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Loaded here instead of by window creation, so extensions instance needs are known before
+    // window exists, and instance is created while window is being made. Window may be nullptr since SDL 2.0.8. [2025/04/13]
+    //
+    if (SDL_Vulkan_LoadLibrary(nullptr) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Vulkan_LoadLibrary() = %s", SDL_GetError());
+        return false;
+    }
+    startup->is_vulkan_library_loaded = true;
+
+    unsigned int extensions_count = 0;
+    if (!SDL_Vulkan_GetInstanceExtensions(nullptr, &extensions_count, nullptr)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Vulkan_GetInstanceExtensions() = %s", SDL_GetError());
+        return false;
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: extensions supported = %d", extensions_count);
+
+    startup->window_extensions.resize(extensions_count);
+    if (!SDL_Vulkan_GetInstanceExtensions(nullptr, &extensions_count, startup->window_extensions.data())) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Vulkan_GetInstanceExtensions() = %s", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+bool
+app_startup_window(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    SDL_WindowFlags window_flags = static_cast<SDL_WindowFlags>(SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
+    startup->window = SDL_CreateWindow("Hello VK", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720, window_flags);
+    if (startup->window == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateWindow() = %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_Vulkan_GetDrawableSize(startup->window, &startup->window_width, &startup->window_height);
+    return true;
+}
+
+bool
+app_startup_vulkan_loader(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    VkApplicationInfo &app_info = startup->app_info;
+    app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app_info.pApplicationName = "Hello VK";
+    app_info.applicationVersion = VK_MAKE_API_VERSION(0, 0, 0, 0);
+    app_info.pEngineName = "Hello VK";
+    app_info.engineVersion = VK_MAKE_API_VERSION(0, 0, 0, 0);
+    app_info.apiVersion = VK_API_VERSION_1_0;
+
+    //
+    // NOTE(gr3yknigh1): 1.0 loaders fail instance creation for any newer `apiVersion`, 1.1+ accept anything and
+    // clamp to what each device supports. vkEnumerateInstanceVersion appeared in 1.1. [2025/04/10]
+    //
+    auto enumerate_instance_version = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(
+        vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion"));
+
+    uint32_t instance_version = VK_API_VERSION_1_0;
+    if (enumerate_instance_version != nullptr && enumerate_instance_version(&instance_version) == VK_SUCCESS
+        && instance_version >= VK_API_VERSION_1_1) {
+        app_info.apiVersion = VK_API_VERSION_1_2;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Vulkan: instance %u.%u, requested %u.%u", VK_API_VERSION_MAJOR(instance_version),
+        VK_API_VERSION_MINOR(instance_version), VK_API_VERSION_MAJOR(app_info.apiVersion),
+        VK_API_VERSION_MINOR(app_info.apiVersion));
+
+    //
+    // Extension properties:
+    //
+    uint32_t extensions_properties_count = 0;
+    VkResult result = vkEnumerateInstanceExtensionProperties(nullptr, &extensions_properties_count, nullptr);
+    if (result == VK_SUCCESS) {
+        startup->extensions_properties.resize(extensions_properties_count);
+        result = vkEnumerateInstanceExtensionProperties(nullptr, &extensions_properties_count, startup->extensions_properties.data());
+    }
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkEnumerateInstanceExtensionProperties() = %s", string_VkResult(result));
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: extensions properties:");
+    for (auto &extension_properties : startup->extensions_properties) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    %s", extension_properties.extensionName);
+    }
+
+    //
+    // Validation layers:
+    //
+    uint32_t available_layers_count = 0;
+    result = vkEnumerateInstanceLayerProperties(&available_layers_count, nullptr);
+
+    std::vector<VkLayerProperties> available_layers(available_layers_count);
+    if (result == VK_SUCCESS) {
+        result = vkEnumerateInstanceLayerProperties(&available_layers_count, available_layers.data());
+    }
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkEnumerateInstanceLayerProperties() = %s", string_VkResult(result));
+        return false;
+    }
+
+    if (s_vk_enable_validation_layers) {
+        for (auto &required_layer : s_vk_required_validation_layers) {
+            bool found = false;
+
+            std::string_view required_layer_view(required_layer);
+            for (auto &available_layer : available_layers) {
+                if (required_layer_view == available_layer.layerName) {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: validation layer %s isn't available", required_layer);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool
+app_startup_instance(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    VkInstanceCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    create_info.pApplicationInfo = &startup->app_info;
+
+    VkDebugUtilsMessengerCreateInfoEXT debug_create_info = {};
+    debug_create_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    debug_create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    debug_create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    debug_create_info.pfnUserCallback = vk_debug_sink_callback;
+    debug_create_info.pUserData = startup->debug_sink;
+
+    std::vector<const char *> extensions = startup->window_extensions;
+
+    if constexpr (s_vk_enable_validation_layers) {
+        extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    }
+
+    //
+    // NOTE(gr3yknigh1): Instance is Vulkan 1.0 on old loaders, so device features and properties are queried through
+    // the KHR entry points of this one (see `vk_query_device_capabilities`). Those resolve only if it is enabled, even
+    // where `apiVersion` is 1.2 and the core ones exist. [2025/04/16]
+    //
+    for (auto &extension_properties : startup->extensions_properties) {
+        if (strcmp(extension_properties.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0) {
+            extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+            break;
+        }
+    }
+
+    create_info.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    create_info.ppEnabledExtensionNames = extensions.data();
+
+    if constexpr (s_vk_enable_validation_layers) {
+        create_info.enabledLayerCount = static_cast<uint32_t>(s_vk_required_validation_layers.size());
+        create_info.ppEnabledLayerNames = s_vk_required_validation_layers.data();
+
+        create_info.pNext = &debug_create_info;
+    } else {
+        create_info.enabledLayerCount = 0;
+
+        create_info.pNext = nullptr;
+    }
+
+    VkResult result = vkCreateInstance(&create_info, nullptr, &startup->instance);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateInstance() = %s", string_VkResult(result));
+        startup->instance = VK_NULL_HANDLE;
+
+        SDL_TriggerBreakpoint();
+        return false;
+    }
+
+    //
+    // Debug messenger:
+    //
+    if constexpr (s_vk_enable_validation_layers) {
+        auto create_debug_utils_messenger_ext = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+            vkGetInstanceProcAddr(startup->instance, "vkCreateDebugUtilsMessengerEXT"));
+        startup->destroy_debug_messenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+            vkGetInstanceProcAddr(startup->instance, "vkDestroyDebugUtilsMessengerEXT"));
+        SDL_assert(create_debug_utils_messenger_ext && startup->destroy_debug_messenger);
+
+        if (create_debug_utils_messenger_ext != nullptr && startup->destroy_debug_messenger != nullptr) {
+            result = create_debug_utils_messenger_ext(startup->instance, &debug_create_info, nullptr, &startup->debug_messenger);
+            if (result != VK_SUCCESS) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "vkCreateDebugUtilsMessengerEXT() = %s", string_VkResult(result));
+                startup->debug_messenger = VK_NULL_HANDLE;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool
+app_startup_surface(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    if (!SDL_Vulkan_CreateSurface(startup->window, startup->instance, &startup->surface)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Vulkan_CreateSurface() = %s", SDL_GetError());
+        startup->surface = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+app_startup_device(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+    App_Config &config = *startup->config;
+
+    //
+    // Physical device:
+    //
+    std::vector<const char *> required_device_extensions;
+    if (!config.headless) {
+        required_device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
+
+    // NOTE(gr3yknigh1): Command line wins over environment. [2025/03/30]
+    const char *device_override = config.device_name != nullptr ? config.device_name : SDL_getenv("HELLO_VK_DEVICE");
+
+    Vk_Device_Capabilities &capabilities = startup->device_capabilities;
+    if (vk_pick_physical_device(
+            startup->instance, startup->surface, required_device_extensions, device_override, &capabilities) != VK_SUCCESS) {
+        return false;
+    }
+
+    //
+    // Queue families:
+    //
+    uint32_t graphics_queue_index = capabilities.graphics_queue_index.value();
+    uint32_t present_queue_index = capabilities.present_queue_index.value();
+
+    // NOTE(gr3yknigh1): Without transfer-only family uploads go through graphics queue. [2025/03/26]
+    startup->transfer_queue_index = capabilities.transfer_queue_index.value_or(graphics_queue_index);
+
+    // NOTE(gr3yknigh1): Without async compute family dispatches are serialized with graphics on its queue. [2025/03/31]
+    startup->compute_queue_index = capabilities.compute_queue_index.value_or(graphics_queue_index);
+    SDL_assert((capabilities.queue_families[startup->compute_queue_index].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0);
+
+    //
+    // Optional features and extensions:
+    //
+    // NOTE(gr3yknigh1): GPU culling issues all objects with one indirect call and passes object index as its
+    // `firstInstance`. Both are optional features of Vulkan 1.0. [2025/04/01]
+    const VkPhysicalDeviceFeatures &supported_features = capabilities.features;
+    if (config.gpu_culling && (!supported_features.multiDrawIndirect || !supported_features.drawIndirectFirstInstance)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Culling: device can't draw indirect, falling back to CPU culling");
+        config.gpu_culling = false;
+    }
+
+    VkPhysicalDeviceFeatures enabled_features = {};
+    if (config.gpu_culling) {
+        enabled_features.multiDrawIndirect = VK_TRUE;
+        enabled_features.drawIndirectFirstInstance = VK_TRUE;
+    }
+
+    std::vector<const char *> device_extensions = required_device_extensions;
+
+    bool has_draw_indirect_count = config.gpu_culling && vk_device_has_extension(capabilities, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (has_draw_indirect_count) {
+        device_extensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+
+    // NOTE(gr3yknigh1): Without descriptor indexing bindless table falls back to pooled sets. [2025/04/02]
+    startup->is_bindless = !config.no_bindless && vk_bindless_is_supported(capabilities);
+
+    VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features = {};
+    if (startup->is_bindless) {
+        vk_bindless_fill_features(&descriptor_indexing_features);
+
+        enabled_features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+        enabled_features.shaderStorageBufferArrayDynamicIndexing = VK_TRUE;
+
+        device_extensions.push_back(VK_KHR_MAINTENANCE_3_EXTENSION_NAME);
+        device_extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+
+    const void *features_chain = startup->is_bindless ? &descriptor_indexing_features : nullptr;
+
+    // NOTE(gr3yknigh1): Streamed textures are block-compressed, budget lets them fill what is left of VRAM. [2025/04/12]
+    if (config.texture_dir != nullptr && supported_features.textureCompressionBC) {
+        enabled_features.textureCompressionBC = VK_TRUE;
+    }
+
+    if (vk_device_has_extension(capabilities, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+        device_extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    //
+    // NOTE(gr3yknigh1): Core in 1.2 (device and instance both), extension before. Without timeline semaphores
+    // timelines are backed by fences, see `Vk_Timeline`. [2025/04/10]
+    //
+    bool is_vulkan_1_2 = startup->app_info.apiVersion >= VK_API_VERSION_1_2
+        && capabilities.properties.apiVersion >= VK_API_VERSION_1_2;
+    bool has_timeline_semaphore_extension = vk_device_has_extension(capabilities, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+
+    startup->has_timeline_semaphores = !config.no_timeline_semaphores
+        && (is_vulkan_1_2 || has_timeline_semaphore_extension)
+        && capabilities.timeline_semaphore_features.timelineSemaphore;
+
+    VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features = {};
+    if (startup->has_timeline_semaphores) {
+        timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timeline_semaphore_features.pNext = const_cast<void *>(features_chain);
+        timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+
+        features_chain = &timeline_semaphore_features;
+
+        if (!is_vulkan_1_2) {
+            device_extensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+        }
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Sync: %s", startup->has_timeline_semaphores ? "timeline semaphores" : "fences (no timeline semaphores)");
+
+    // NOTE(gr3yknigh1): Present wait lets latency be measured up to the moment image is shown, not just to
+    // `vkQueuePresentKHR` return. [2025/04/04]
+    bool has_present_wait = !config.headless
+        && vk_device_has_extension(capabilities, VK_KHR_PRESENT_ID_EXTENSION_NAME)
+        && vk_device_has_extension(capabilities, VK_KHR_PRESENT_WAIT_EXTENSION_NAME)
+        && capabilities.present_id_features.presentId
+        && capabilities.present_wait_features.presentWait;
+
+    VkPhysicalDevicePresentIdFeaturesKHR present_id_features = {};
+    VkPhysicalDevicePresentWaitFeaturesKHR present_wait_features = {};
+    if (has_present_wait) {
+        present_wait_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+        present_wait_features.pNext = const_cast<void *>(features_chain);
+        present_wait_features.presentWait = VK_TRUE;
+
+        present_id_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+        present_id_features.pNext = &present_wait_features;
+        present_id_features.presentId = VK_TRUE;
+
+        features_chain = &present_id_features;
+
+        device_extensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+        device_extensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+    }
+
+    //
+    // Logical device:
+    //
+    startup->device = vk_make_logical_device(
+        capabilities.handle, s_vk_required_validation_layers, device_extensions, graphics_queue_index,
+        present_queue_index, startup->transfer_queue_index, startup->compute_queue_index, enabled_features,
+        features_chain, s_vk_enable_validation_layers);
+    if (startup->device == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    if (has_draw_indirect_count) {
+        startup->cmd_draw_indexed_indirect_count = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(startup->device, "vkCmdDrawIndexedIndirectCountKHR"));
+        SDL_assert(startup->cmd_draw_indexed_indirect_count);
+    }
+
+    if (has_present_wait) {
+        startup->wait_for_present = reinterpret_cast<PFN_vkWaitForPresentKHR>(vkGetDeviceProcAddr(startup->device, "vkWaitForPresentKHR"));
+        SDL_assert(startup->wait_for_present);
+    }
+
+    vkGetDeviceQueue(startup->device, graphics_queue_index, 0, &startup->graphics_queue);
+    vkGetDeviceQueue(startup->device, present_queue_index, 0, &startup->present_queue);
+    vkGetDeviceQueue(startup->device, startup->transfer_queue_index, 0, &startup->transfer_queue);
+    vkGetDeviceQueue(startup->device, startup->compute_queue_index, 0, &startup->compute_queue);
+    SDL_assert(startup->graphics_queue && startup->present_queue && startup->transfer_queue && startup->compute_queue);
+
+    return true;
+}
+
+bool
+app_startup_scene(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+    const App_Config &config = *startup->config;
+
+    if (config.scene_path == nullptr) {
+        startup->scene = make_triangle_scene();
+        return true;
+    }
+
+    if (!scene_open(config.scene_path, &startup->scene)) {
+        return false;
+    }
+
+    if (startup->scene.meshes_count == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene: %s has no meshes", config.scene_path);
+        return false;
+    }
+
+    return true;
+}
+
+bool
+app_startup_texture_list(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+    const App_Config &config = *startup->config;
+
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(config.texture_dir, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".ktx2") {
+            startup->texture_paths.push_back(entry.path());
+        }
+    }
+
+    if (error) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Textures: can't list %s, %s", config.texture_dir, error.message().c_str());
+    }
+
+    // NOTE(gr3yknigh1): Directory order is arbitrary, sorted so draws get the same textures every run. [2025/04/12]
+    std::sort(startup->texture_paths.begin(), startup->texture_paths.end());
+    return true;
+}
+
+bool
+app_startup_pipeline_cache_file(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    startup->pipeline_cache_file = vk_pipeline_cache_read_file(startup->config->pipeline_cache_path);
+    return true;
+}
+
+bool
+app_startup_shader_code(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    return vk_read_shader_code("shaders/triangle.vert.spv", &startup->vertex_shader_code)
+        && vk_read_shader_code("shaders/triangle.frag.spv", &startup->fragment_shader_code);
+}
+
+bool
+app_startup_pipeline_cache(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    VkResult result = vk_pipeline_cache_init(
+        &startup->pipeline_cache, startup->device_capabilities.properties, startup->device, startup->config->pipeline_cache_path,
+        &startup->pipeline_cache_file);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vk_pipeline_cache_init() = %s", string_VkResult(result));
+        return false;
+    }
+
+    return true;
+}
+
+bool
+app_startup_shader_modules(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    startup->vertex_shader = vk_make_shader_module(startup->device, startup->vertex_shader_code, "shaders/triangle.vert.spv");
+    startup->fragment_shader = vk_make_shader_module(startup->device, startup->fragment_shader_code, "shaders/triangle.frag.spv");
+
+    return startup->vertex_shader != VK_NULL_HANDLE && startup->fragment_shader != VK_NULL_HANDLE;
+}
+
+bool
+app_startup_triangle_pipeline(void *user_data)
+{
+    App_Startup *startup = static_cast<App_Startup *>(user_data);
+
+    // NOTE(gr3yknigh1): Runs on a worker, alongside main thread and other tasks of the graph. [2025/04/13]
+    VkPipelineCache pipeline_cache = vk_pipeline_cache_make_thread_cache(&startup->pipeline_cache);
+
+    VkResult result = vk_make_triangle_pipeline(
+        startup->device, pipeline_cache, startup->render_pass, startup->pipeline_layout,
+        startup->vertex_shader, startup->fragment_shader, &startup->bindless_specialization.info, &startup->pipeline);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vk_make_triangle_pipeline() = %s", string_VkResult(result));
+        startup->pipeline = VK_NULL_HANDLE;
+        return false;
+    }
+
+    return true;
+}
+
+VkDevice 
+vk_make_logical_device(
+    VkPhysicalDevice physical_device, const std::vector<const char*>& required_validation_layers, const std::vector<const char*>& required_device_extensions,
+    uint32_t graphics_queue_index, uint32_t present_queue_index, uint32_t transfer_queue_index, uint32_t compute_queue_index,
+    const VkPhysicalDeviceFeatures &enabled_features, const void *features_chain, bool enable_validation_layers)
+{
+    VkDevice device = VK_NULL_HANDLE;
+    float queue_priority = 1.0f;
+
+    // NOTE(gr3yknigh1): Queues may share one family; each family must be requested only once. [2025/03/22]
+    std::set<uint32_t> unique_queue_indices = { graphics_queue_index, present_queue_index, transfer_queue_index, compute_queue_index };
+
+    std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
+    for (uint32_t queue_index : unique_queue_indices) {
+        VkDeviceQueueCreateInfo queue_create_info = {};
+        queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queue_create_info.queueFamilyIndex = queue_index;
+        queue_create_info.queueCount = 1;
+        queue_create_info.pQueuePriorities = &queue_priority;
+        queue_create_infos.push_back(queue_create_info);
+    }
+
+    VkDeviceCreateInfo device_create_info = {};
+    device_create_info.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_create_info.pNext                = features_chain;
+    device_create_info.pQueueCreateInfos    = queue_create_infos.data();
+    device_create_info.queueCreateInfoCount = static_cast<uint32_t>(queue_create_infos.size());
+    
+    device_create_info.pEnabledFeatures     = &enabled_features;
+    
+    device_create_info.ppEnabledExtensionNames = required_device_extensions.data();
+    device_create_info.enabledExtensionCount = static_cast<uint32_t>(required_device_extensions.size());
+
+    if (enable_validation_layers) {
+        device_create_info.enabledLayerCount = static_cast<uint32_t>(required_validation_layers.size());
+        device_create_info.ppEnabledLayerNames = required_validation_layers.data();
+    } else {
+        device_create_info.enabledLayerCount = 0;
+    }
+
+    VkResult result = vkCreateDevice(physical_device, &device_create_info, nullptr, &device);
+    if (result != VK_SUCCESS) {
+        // TODO(gr3yknigh1): Find another way to report error from here [2025/03/20]
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateDevice() = %s", string_VkResult(result));
+        SDL_TriggerBreakpoint();
+        return VK_NULL_HANDLE;
+    }
+
+    return device;
+}
+
+
+VkExtent2D
+vk_pick_swap_extent(VkSurfaceCapabilitiesKHR *capabilities, int width, int height)
+{
+    if (capabilities->currentExtent.width != std::numeric_limits<uint32_t>::max()) {
+        return capabilities->currentExtent;
+    }
+
+    VkExtent2D result = {};
+    result.width = std::clamp(static_cast<uint32_t>(width), capabilities->minImageExtent.width, capabilities->maxImageExtent.width);
+    result.height = std::clamp(static_cast<uint32_t>(height), capabilities->minImageExtent.height, capabilities->maxImageExtent.height);
+
+    return result;
+}
+
+VkPresentModeKHR
+vk_next_present_mode(const Vk_Device_Capabilities &capabilities, VkPresentModeKHR present_mode)
+{
+    static const VkPresentModeKHR s_present_modes[] = {
+        VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR,
+    };
+    constexpr uint32_t s_present_modes_count = static_cast<uint32_t>(std::size(s_present_modes));
+
+    uint32_t current = 0;
+    while (current < s_present_modes_count && s_present_modes[current] != present_mode) {
+        current++;
+    }
+
+    for (uint32_t step = 1; step <= s_present_modes_count; ++step) {
+        VkPresentModeKHR candidate = s_present_modes[(current + step) % s_present_modes_count];
+        if (vk_device_has_present_mode(capabilities, candidate)) {
+            return candidate;
+        }
+    }
+
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+VkResult 
+vk_make_swapchain(
+    VkDevice device, VkSurfaceKHR surface, VkSurfaceFormatKHR surface_format, 
+    uint32_t graphics_queue_index, uint32_t present_queue_index, VkPresentModeKHR present_mode, uint32_t image_count,
+    VkSurfaceCapabilitiesKHR *capabilities, VkExtent2D extent, VkSwapchainKHR old_swapchain, VkSwapchainKHR *result)
+{
+    uint32_t requested_image_count = image_count;
+
+    if (image_count == 0) {
+        image_count = capabilities->minImageCount + 1;
+    }
+    if (image_count < capabilities->minImageCount) {
+        image_count = capabilities->minImageCount;
+    }
+    if (capabilities->maxImageCount > 0 && image_count > capabilities->maxImageCount) {
+        image_count = capabilities->maxImageCount;
+    }
+
+    if (requested_image_count != 0 && requested_image_count != image_count) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION, "Swapchain: %u images requested, surface supports [%u, %u], using %u",
+            requested_image_count, capabilities->minImageCount, capabilities->maxImageCount, image_count);
+    }
+
+    VkSwapchainCreateInfoKHR create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    create_info.surface = surface;
+    create_info.minImageCount = image_count;
+    create_info.imageFormat = surface_format.format;
+    create_info.imageColorSpace = surface_format.colorSpace;
+    create_info.imageExtent = extent;
+    create_info.imageArrayLayers = 1;
+    create_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    // TODO(gr3yknigh1): Remove duplication in creation of logical device [2025/03/21]
+    std::array<uint32_t, 2> queue_family_indices = { graphics_queue_index, present_queue_index };
+
+    if (graphics_queue_index != present_queue_index) {
+        create_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+        create_info.queueFamilyIndexCount = queue_family_indices.size();
+        create_info.pQueueFamilyIndices = queue_family_indices.data();
+    } else {
+        create_info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        create_info.queueFamilyIndexCount = 0; // Optional
+        create_info.pQueueFamilyIndices = nullptr; // Optional
+    }
+
+    create_info.preTransform = capabilities->currentTransform;
+    create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    create_info.presentMode = present_mode;
+    create_info.clipped = VK_TRUE;
+    create_info.oldSwapchain = old_swapchain;
+    
+    return vkCreateSwapchainKHR(device, &create_info, nullptr, result);
+}
+
+VkResult
+vk_make_swapchain_image_views(
+    VkDevice device, const std::vector<VkImage> &images, VkFormat format, std::vector<VkImageView> *result)
+{
+    result->resize(images.size(), VK_NULL_HANDLE);
+
+    for (size_t index = 0; index < images.size(); index++) {
+        VkImageViewCreateInfo create_info{};
+        create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        create_info.image = images[index];
+
+        create_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        create_info.format = format;
+
+        create_info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+        create_info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+        create_info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+        create_info.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+
+        create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        create_info.subresourceRange.baseMipLevel = 0;
+        create_info.subresourceRange.levelCount = 1;
+        create_info.subresourceRange.baseArrayLayer = 0;
+        create_info.subresourceRange.layerCount = 1;
+
+        VkResult vk_result = vkCreateImageView(device, &create_info, nullptr, &(*result)[index]);
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+VkResult
+vk_recreate_swapchain(
+    VkPhysicalDevice physical_device, VkDevice device, VkSurfaceKHR surface, VkSurfaceFormatKHR surface_format,
+    uint32_t graphics_queue_index, uint32_t present_queue_index, VkPresentModeKHR present_mode, uint32_t image_count,
+    VkRenderPass render_pass, int width, int height, bool force, uint64_t frame_number,
+    Vk_Swapchain *swapchain, Vk_Deletion_Queue *deletion_queue)
+{
+    VkResult result = VK_SUCCESS;
+
+    VkSurfaceCapabilitiesKHR capabilities = {};
+    result = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physical_device, surface, &capabilities);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkExtent2D extent = vk_pick_swap_extent(&capabilities, width, height);
+
+    bool is_same_extent = extent.width == swapchain->extent.width && extent.height == swapchain->extent.height;
+    if (!force && swapchain->handle != VK_NULL_HANDLE && is_same_extent) {
+        return VK_SUCCESS;
+    }
+
+    Vk_Swapchain fresh = {};
+    fresh.extent = extent;
+
+    result = vk_make_swapchain(
+        device, surface, surface_format, graphics_queue_index, present_queue_index, present_mode, image_count,
+        &capabilities, extent, swapchain->handle, &fresh.handle);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateSwapchainKHR() = %s", string_VkResult(result));
+        return result;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Old swapchain is retired now even if something below fails, it can't be used to
+    // acquire images anymore. [2025/03/23]
+    //
+    if (swapchain->handle != VK_NULL_HANDLE) {
+        vk_retire_swapchain(deletion_queue, swapchain, frame_number);
+    }
+    *swapchain = std::move(fresh);
+
+    uint32_t images_count = 0;
+    vkGetSwapchainImagesKHR(device, swapchain->handle, &images_count, nullptr);
+    swapchain->images.resize(images_count);
+    vkGetSwapchainImagesKHR(device, swapchain->handle, &images_count, swapchain->images.data());
+
+    result = vk_make_swapchain_image_views(device, swapchain->images, surface_format.format, &swapchain->image_views);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = vk_make_framebuffers(device, render_pass, swapchain->image_views, extent, &swapchain->framebuffers);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    swapchain->render_finished_semaphores.resize(images_count, VK_NULL_HANDLE);
+    for (auto &semaphore : swapchain->render_finished_semaphores) {
+        VkSemaphoreCreateInfo semaphore_create_info = {};
+        semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        result = vkCreateSemaphore(device, &semaphore_create_info, nullptr, &semaphore);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    swapchain->images_frame_numbers.assign(images_count, 0);
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Swapchain: %ux%u, %u images, %s", extent.width, extent.height, images_count,
+        present_mode_name(present_mode));
+
+    return VK_SUCCESS;
+}
+
+void
+vk_retire_swapchain(Vk_Deletion_Queue *deletion_queue, Vk_Swapchain *swapchain, uint64_t last_frame_number)
+{
+    for (auto &semaphore : swapchain->render_finished_semaphores) {
+        vk_deletion_queue_push(deletion_queue, VK_OBJECT_TYPE_SEMAPHORE, vk_handle_value(semaphore), last_frame_number);
+    }
+
+    for (auto &framebuffer : swapchain->framebuffers) {
+        vk_deletion_queue_push(deletion_queue, VK_OBJECT_TYPE_FRAMEBUFFER, vk_handle_value(framebuffer), last_frame_number);
+    }
+
+    for (auto &view : swapchain->image_views) {
+        vk_deletion_queue_push(deletion_queue, VK_OBJECT_TYPE_IMAGE_VIEW, vk_handle_value(view), last_frame_number);
+    }
+
+    vk_deletion_queue_push(deletion_queue, VK_OBJECT_TYPE_SWAPCHAIN_KHR, vk_handle_value(swapchain->handle), last_frame_number);
+
+    *swapchain = {};
+}
+
+void
+vk_destroy_swapchain(VkDevice device, Vk_Swapchain *swapchain)
+{
+    for (auto &semaphore : swapchain->render_finished_semaphores) {
+        vkDestroySemaphore(device, semaphore, nullptr);
+    }
+
+    for (auto &framebuffer : swapchain->framebuffers) {
+        vkDestroyFramebuffer(device, framebuffer, nullptr);
+    }
+
+    for (auto &view : swapchain->image_views) {
+        vkDestroyImageView(device, view, nullptr);
+    }
+
+    if (swapchain->handle != VK_NULL_HANDLE) {
+        vkDestroySwapchainKHR(device, swapchain->handle, nullptr);
+    }
+
+    *swapchain = {};
+}
+
+
+VkRenderPass
+vk_make_render_pass(VkDevice device, VkFormat color_format)
+{
+    VkAttachmentDescription color_attachment = {};
+    color_attachment.format = color_format;
+    color_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    color_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    color_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    color_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    color_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    color_attachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    color_attachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference color_attachment_reference = {};
+    color_attachment_reference.attachment = 0;
+    color_attachment_reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &color_attachment_reference;
+
+    //
+    // NOTE(gr3yknigh1): No external dependency: frame graph records barrier into COLOR_ATTACHMENT_OPTIMAL before the
+    // pass (after `image available` wait at color attachment output stage) and out of it after. [2025/04/03]
+    //
+    VkRenderPassCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    create_info.attachmentCount = 1;
+    create_info.pAttachments = &color_attachment;
+    create_info.subpassCount = 1;
+    create_info.pSubpasses = &subpass;
+
+    VkRenderPass render_pass = VK_NULL_HANDLE;
+    VkResult result = vkCreateRenderPass(device, &create_info, nullptr, &render_pass);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateRenderPass() = %s", string_VkResult(result));
+        return VK_NULL_HANDLE;
+    }
+
+    return render_pass;
+}
+
+VkResult
+vk_make_framebuffers(
+    VkDevice device, VkRenderPass render_pass, const std::vector<VkImageView> &image_views, VkExtent2D extent,
+    std::vector<VkFramebuffer> *result)
+{
+    result->resize(image_views.size(), VK_NULL_HANDLE);
+
+    for (size_t index = 0; index < image_views.size(); index++) {
+        VkFramebufferCreateInfo create_info = {};
+        create_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        create_info.renderPass = render_pass;
+        create_info.attachmentCount = 1;
+        create_info.pAttachments = &image_views[index];
+        create_info.width = extent.width;
+        create_info.height = extent.height;
+        create_info.layers = 1;
+
+        VkResult vk_result = vkCreateFramebuffer(device, &create_info, nullptr, &(*result)[index]);
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+VkResult
+vk_make_frame(VkDevice device, uint32_t graphics_queue_index, uint32_t threads_count, Vk_Frame *frame)
+{
+    VkResult result = VK_SUCCESS;
+
+    // NOTE(gr3yknigh1): Pool is reset as a whole each frame, so buffers are never reset individually. [2025/03/22]
+    VkCommandPoolCreateInfo command_pool_create_info = {};
+    command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    command_pool_create_info.queueFamilyIndex = graphics_queue_index;
+
+    frame_arena_init(&frame->arena, s_frame_arena_capacity);
+
+    result = vkCreateCommandPool(device, &command_pool_create_info, nullptr, &frame->command_pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkCommandBufferAllocateInfo command_buffer_allocate_info = {};
+    command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    command_buffer_allocate_info.commandPool = frame->command_pool;
+    command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    command_buffer_allocate_info.commandBufferCount = 1;
+
+    result = vkAllocateCommandBuffers(device, &command_buffer_allocate_info, &frame->command_buffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkSemaphoreCreateInfo semaphore_create_info = {};
+    semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    result = vkCreateSemaphore(device, &semaphore_create_info, nullptr, &frame->image_available);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    frame->thread_commands = std::vector<Vk_Thread_Commands>(threads_count);
+    for (auto &thread_commands : frame->thread_commands) {
+        result = vkCreateCommandPool(device, &command_pool_create_info, nullptr, &thread_commands.command_pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+void
+vk_destroy_frame(VkDevice device, Vk_Frame *frame)
+{
+    vkDestroySemaphore(device, frame->image_available, nullptr);
+    vkDestroyCommandPool(device, frame->command_pool, nullptr);
+
+    for (auto &thread_commands : frame->thread_commands) {
+        vkDestroyCommandPool(device, thread_commands.command_pool, nullptr);
+    }
+
+    frame_arena_destroy(&frame->arena);
+
+    *frame = {};
+}
+
+void
+vk_reset_frame(VkDevice device, Vk_Frame *frame)
+{
+    vkResetCommandPool(device, frame->command_pool, 0);
+
+    // NOTE(gr3yknigh1): Secondary buffers stay allocated and are reused next time, only the pool is reset. [2025/03/28]
+    for (auto &thread_commands : frame->thread_commands) {
+        vkResetCommandPool(device, thread_commands.command_pool, 0);
+        thread_commands.used_count = 0;
+    }
+
+    frame_arena_reset(&frame->arena);
+}
+
+std::vector<Draw_Command>
+make_grid_draws(uint32_t count)
+{
+    std::vector<Draw_Command> draws(count);
+
+    uint32_t side = static_cast<uint32_t>(ceil(sqrt(static_cast<double>(count))));
+    float cell = 2.0f / static_cast<float>(std::max(side, 1u));
+
+    for (uint32_t index = 0; index < count; ++index) {
+        uint32_t column = index % side;
+        uint32_t row = index / side;
+
+        // NOTE(gr3yknigh1): Triangle spans [-0.5, 0.5], so it takes half of its cell. Single draw is the original triangle. [2025/03/28]
+        draws[index].offset[0] = -1.0f + (static_cast<float>(column) + 0.5f) * cell;
+        draws[index].offset[1] = -1.0f + (static_cast<float>(row) + 0.5f) * cell;
+        draws[index].scale = cell * 0.5f;
+    }
+
+    return draws;
+}
+
+// NOTE(gr3yknigh1): SNORM positions, 16384 is 0.5. [2025/04/11]
+static const std::array<Scene_Vertex, 3> s_triangle_vertices = {{
+    { {      0, -16384 }, { 255,   0,   0, 255 } },
+    { {  16384,  16384 }, {   0, 255,   0, 255 } },
+    { { -16384,  16384 }, {   0,   0, 255, 255 } },
+}};
+
+static const std::array<uint16_t, 3> s_triangle_indices = { 0, 1, 2 };
+
+static const Scene_Mesh s_triangle_mesh = {
+    0, static_cast<uint32_t>(s_triangle_vertices.size()), 0, static_cast<uint32_t>(s_triangle_indices.size()),
+    sizeof(uint16_t), 0, 1, 1.0f, 0.70710678f,
+};
+
+static const Scene_Meshlet s_triangle_meshlet = { 0, 1, 3, { 0.0f, 0.0f }, 0.70710678f };
+
+std::vector<Gpu_Object>
+make_gpu_objects(const Draw_Command *draws, uint32_t draws_count, float mesh_radius)
+{
+    std::vector<Gpu_Object> objects(draws_count);
+
+    for (uint32_t index = 0; index < draws_count; ++index) {
+        objects[index].offset[0] = draws[index].offset[0];
+        objects[index].offset[1] = draws[index].offset[1];
+        objects[index].scale = draws[index].scale;
+        objects[index].radius = mesh_radius * draws[index].scale;
+    }
+
+    return objects;
+}
+
+Scene
+make_triangle_scene(void)
+{
+    Scene scene = {};
+    scene.meshes = &s_triangle_mesh;
+    scene.meshes_count = 1;
+    scene.vertices = s_triangle_vertices.data();
+    scene.vertices_count = s_triangle_vertices.size();
+    scene.indices = reinterpret_cast<const uint8_t *>(s_triangle_indices.data());
+    scene.indices_size = sizeof(s_triangle_indices);
+    scene.meshlets = &s_triangle_meshlet;
+    scene.meshlets_count = 1;
+    return scene;
+}
+
+void
+app_request_textures(Vk_Texture_Streamer *streamer, const Vk_Draw_List &draw_list, VkExtent2D extent, uint64_t frame_number)
+{
+    uint32_t textures_count = static_cast<uint32_t>(streamer->textures.size());
+    float screen_size = static_cast<float>(std::max(extent.width, extent.height));
+
+    for (uint32_t index = 0; index < draw_list.draws_count; ++index) {
+        const Draw_Command &draw = draw_list.draws[index];
+
+        float radius = draw_list.mesh_radius * draw.scale;
+        if (!camera_is_circle_visible(draw_list.camera, draw.offset, radius)) {
+            continue;
+        }
+
+        // NOTE(gr3yknigh1): View spans 2 units across the screen, so diameter of `2 * radius` covers this much. [2025/04/12]
+        float footprint = radius * draw_list.camera.zoom * screen_size;
+        vk_texture_streamer_request(streamer, index % textures_count, footprint, frame_number);
+    }
+}
+
+struct Vk_Record_Draws_Job {
+    VkDevice            device     = VK_NULL_HANDLE;
+    Profiler           *profiler   = nullptr;
+    Vk_Frame           *frame      = nullptr;
+    VkExtent2D          extent     = {};
+    const Vk_Draw_List *draw_list  = nullptr;
+    uint32_t            chunk_size = 0;
+
+    VkCommandBufferInheritanceInfo inheritance_info = {};
+
+    // NOTE(gr3yknigh1): Chunk N writes only slot N, so no synchronization is needed. [2025/03/28]
+    Frame_Vector<VkCommandBuffer> *secondary_buffers = nullptr;
+};
+
+///
+/// @brief Takes next unused secondary buffer of the thread (allocating one if needed) and begins it inside render pass.
+///
+static VkCommandBuffer
+vk_begin_secondary_buffer(VkDevice device, Vk_Thread_Commands *thread_commands, const VkCommandBufferInheritanceInfo &inheritance_info)
+{
+    if (thread_commands->used_count == thread_commands->secondary_buffers.size()) {
+        VkCommandBufferAllocateInfo allocate_info = {};
+        allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocate_info.commandPool = thread_commands->command_pool;
+        allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocate_info.commandBufferCount = 1;
+
+        VkCommandBuffer allocated = VK_NULL_HANDLE;
+        VkResult result = vkAllocateCommandBuffers(device, &allocate_info, &allocated);
+        SDL_assert(result == VK_SUCCESS);
+
+        thread_commands->secondary_buffers.push_back(allocated);
+    }
+
+    VkCommandBuffer command_buffer = thread_commands->secondary_buffers[thread_commands->used_count++];
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    begin_info.pInheritanceInfo = &inheritance_info;
+
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+
+    return command_buffer;
+}
+
+static void
+vk_record_draws_job(void *user_data, uint32_t begin, uint32_t end, uint32_t thread_index)
+{
+    auto *job = static_cast<Vk_Record_Draws_Job *>(user_data);
+    const Vk_Draw_List &draw_list = *job->draw_list;
+
+    profile_scope(job->profiler, "record draws chunk");
+
+    VkCommandBuffer command_buffer = vk_begin_secondary_buffer(
+        job->device, &job->frame->thread_commands[thread_index], job->inheritance_info);
+
+    // NOTE(gr3yknigh1): Secondary buffers inherit no state from primary one, so every chunk sets it up again. [2025/03/28]
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_list.pipeline);
 
+    // NOTE(gr3yknigh1): Descriptor sets aren't inherited either. One of these binds, depending on the table's mode. [2025/04/17]
+    const Vk_Bindless_Table &bindless_table = *draw_list.bindless_table;
+    vk_bindless_bind_table(bindless_table, command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_list.pipeline_layout, 0);
+    vk_bindless_bind_resource(
+        bindless_table, command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, draw_list.pipeline_layout, 0, draw_list.draws_handle);
 
-    SDL_WindowFlags window_flags = static_cast<SDL_WindowFlags>(SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
-    SDL_Window *window = SDL_CreateWindow("Hello VK", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 1280, 720, window_flags);
-    if (window == nullptr) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateWindow() = %s\n", SDL_GetError());
-        return EXIT_FAILURE;
-    }
-    defer(SDL_DestroyWindow(window));
+    VkViewport viewport = {};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(job->extent.width);
+    viewport.height = static_cast<float>(job->extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
 
-    int window_width, window_height;
-    SDL_GetWindowSize(window, &window_width, &window_height);
+    VkRect2D scissor = {};
+    scissor.offset = { 0, 0 };
+    scissor.extent = job->extent;
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
-    //
-    // Vulkan Initialization:
-    //
-    VkResult vk_result = VK_SUCCESS;
-    VkInstance vk_instance = {};
+    VkDeviceSize vertex_buffer_offset = 0;
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, &draw_list.vertex_buffer, &vertex_buffer_offset);
+    vkCmdBindIndexBuffer(command_buffer, draw_list.index_buffer, 0, draw_list.index_type);
 
-    VkApplicationInfo vk_app_info = {};
-    vk_app_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
-    vk_app_info.pApplicationName = "Hello VK";
-    vk_app_info.applicationVersion = VK_MAKE_API_VERSION(0, 0, 0, 0);
-    vk_app_info.pEngineName = "Hello VK";
-    vk_app_info.engineVersion = VK_MAKE_API_VERSION(0, 0, 0, 0);
-    vk_app_info.apiVersion = VK_API_VERSION_1_0;
+    vkCmdPushConstants(
+        command_buffer, draw_list.pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, s_camera_push_constant_offset, sizeof(Camera),
+        &draw_list.camera);
 
-    //
-    // VK Extensions:
-    //
-    unsigned int vk_extensions_count = 0;
-    SDL_assert(SDL_Vulkan_GetInstanceExtensions(window, &vk_extensions_count, nullptr));
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: extensions supported = %d", vk_extensions_count);
-    
-    std::vector<const char*> vk_extensions(vk_extensions_count);
-    SDL_assert(SDL_Vulkan_GetInstanceExtensions(window, &vk_extensions_count, vk_extensions.data()));
+    Draw_Push_Constants push_constants = {};
+    push_constants.draws_buffer = vk_bindless_shader_index(bindless_table, draw_list.draws_handle);
 
-    //
-    // VK Extension Properties:
-    //
-    uint32_t vk_extensions_properties_count = 0;
-    SDL_assert(vkEnumerateInstanceExtensionProperties(nullptr, &vk_extensions_properties_count, nullptr) == VK_SUCCESS);
+    for (uint32_t index = begin; index < end; ++index) {
+        const Draw_Command &draw = draw_list.draws[index];
 
-    std::vector<VkExtensionProperties> vk_extensions_properties(vk_extensions_properties_count);
-    SDL_assert(vkEnumerateInstanceExtensionProperties(nullptr, &vk_extensions_properties_count, vk_extensions_properties.data()) == VK_SUCCESS);
+        if (!camera_is_circle_visible(draw_list.camera, draw.offset, draw_list.mesh_radius * draw.scale)) {
+            continue;
+        }
 
-    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: extensions properties:");
-    for (auto &extension_properties : vk_extensions_properties) {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    %s", extension_properties.extensionName);
+        push_constants.draw = index;
+        vkCmdPushConstants(
+            command_buffer, draw_list.pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Draw_Push_Constants), &push_constants);
+        vkCmdDrawIndexed(command_buffer, draw_list.index_count, 1, 0, 0, 0);
     }
 
+    vkEndCommandBuffer(command_buffer);
+
+    (*job->secondary_buffers)[begin / job->chunk_size] = command_buffer;
+}
+
+void
+vk_record_draws(
+    Job_System *job_system, Profiler *profiler, VkDevice device, Vk_Frame *frame, VkRenderPass render_pass,
+    VkFramebuffer framebuffer, VkExtent2D extent, const Vk_Draw_List &draw_list, Frame_Vector<VkCommandBuffer> *secondary_buffers)
+{
     //
-    // VK Validation Layers:
+    // NOTE(gr3yknigh1): Few chunks per thread, so stealing can even out threads which were descheduled. Too small
+    // chunks would pay for begin/end and state setup more than for draws. [2025/03/28]
     //
-    const std::vector<const char *> vk_required_validation_layers = {
-        "VK_LAYER_KHRONOS_validation",
-    };
-    constexpr static bool s_vk_enable_validation_layers = _DEBUG ? true : false;
+    uint32_t chunks_per_thread = job_system->threads_count > 1 ? 4 : 1;
+    uint32_t chunk_size = std::max(
+        256u, (draw_list.draws_count + job_system->threads_count * chunks_per_thread - 1) / (job_system->threads_count * chunks_per_thread));
+
+    Vk_Record_Draws_Job job = {};
+    job.device = device;
+    job.profiler = profiler;
+    job.frame = frame;
+    job.inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    job.inheritance_info.renderPass = render_pass;
+    job.inheritance_info.subpass = 0;
+    job.inheritance_info.framebuffer = framebuffer;
+    job.extent = extent;
+    job.draw_list = &draw_list;
+    job.chunk_size = chunk_size;
+    job.secondary_buffers = secondary_buffers;
+
+    secondary_buffers->assign((draw_list.draws_count + chunk_size - 1) / chunk_size, VK_NULL_HANDLE);
+
+    job_system_parallel_for(job_system, draw_list.draws_count, chunk_size, vk_record_draws_job, &job);
+}
 
-    uint32_t vk_available_layers_count = 0;
-    SDL_assert(vkEnumerateInstanceLayerProperties(&vk_available_layers_count, nullptr) == VK_SUCCESS);
+void
+vk_record_draw_queue(VkCommandBuffer command_buffer, uint32_t frame_index, const Vk_Draw_List &draw_list, VkExtent2D extent)
+{
+    Vk_Draw_Queue *queue = draw_list.draw_queue;
+    vk_draw_queue_begin(queue, frame_index);
 
-    std::vector<VkLayerProperties> vk_available_layers(vk_available_layers_count);
-    SDL_assert(vkEnumerateInstanceLayerProperties(&vk_available_layers_count, vk_available_layers.data()) == VK_SUCCESS);
+    constexpr uint32_t max_depth = (1u << s_draw_key_depth_bits) - 1;
 
-    if (s_vk_enable_validation_layers) {
-        for (auto &required_layer : vk_required_validation_layers) {
-            bool found = false;
-            
-            std::string_view required_layer_view(required_layer);
-            for (auto &available_layer : vk_available_layers) {
-                if (required_layer_view == available_layer.layerName) {
-                    found = true;
-                    break;
-                }
-            }
+    uint32_t meshes_count = static_cast<uint32_t>(draw_list.draw_queue_meshes.size());
+
+    for (uint32_t index = 0; index < draw_list.draws_count; ++index) {
+        const Draw_Command &draw = draw_list.draws[index];
 
-            SDL_assert(found);
+        // NOTE(gr3yknigh1): Neighbours alternate meshes, so the queue has one batch per mesh. [2025/04/17]
+        uint32_t mesh_slot = index % meshes_count;
+
+        float radius = draw_list.draw_queue_radii[mesh_slot] * draw.scale;
+        if (!camera_is_circle_visible(draw_list.camera, draw.offset, radius)) {
+            continue;
         }
-    }
 
-    //
-    // VK Instance creation:
-    //
-    VkInstanceCreateInfo vk_create_info = {};
-    vk_create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
-    vk_create_info.pApplicationInfo = &vk_app_info;
+        // NOTE(gr3yknigh1): Grid is flat, depth is distance from the view's center, so each batch goes center out. [2025/04/16]
+        float dx = (draw.offset[0] - draw_list.camera.position[0]) * draw_list.camera.zoom;
+        float dy = (draw.offset[1] - draw_list.camera.position[1]) * draw_list.camera.zoom;
+        float distance = std::min(sqrtf(dx * dx + dy * dy) / 4.0f, 1.0f);
 
-    VkDebugUtilsMessengerCreateInfoEXT vk_debug_create_info = {};
-    vk_debug_create_info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-    vk_debug_create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-    vk_debug_create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
-    vk_debug_create_info.pfnUserCallback = vk_debug_callback;
-    vk_debug_create_info.pUserData = nullptr;
+        uint64_t key = vk_draw_key(
+            s_draw_queue_main_pass, draw_list.draw_queue_pipeline, draw_list.draw_queue_material,
+            draw_list.draw_queue_meshes[mesh_slot], static_cast<uint32_t>(distance * max_depth));
 
-    if constexpr (s_vk_enable_validation_layers) {
-        vk_extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        Gpu_Object object = {};
+        object.offset[0] = draw.offset[0];
+        object.offset[1] = draw.offset[1];
+        object.scale = draw.scale;
+        object.radius = radius;
+
+        vk_draw_queue_push(queue, key, &object);
     }
 
-    vk_create_info.enabledExtensionCount = static_cast<uint32_t>(vk_extensions.size());
-    vk_create_info.ppEnabledExtensionNames = vk_extensions.data();
+    vk_draw_queue_end(queue);
 
-    if constexpr (s_vk_enable_validation_layers) {
-        vk_create_info.enabledLayerCount = static_cast<uint32_t>(vk_required_validation_layers.size());
-        vk_create_info.ppEnabledLayerNames = vk_required_validation_layers.data();
+    VkViewport viewport = {};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
 
-        vk_create_info.pNext = &vk_debug_create_info;
-    } else {
-        vk_create_info.enabledLayerCount = 0;
+    VkRect2D scissor = {};
+    scissor.offset = { 0, 0 };
+    scissor.extent = extent;
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+    vk_draw_queue_record(queue, command_buffer, &draw_list.camera);
+}
+
+static void
+vk_gpu_culling_reset_pass(VkCommandBuffer command_buffer, void *user_data)
+{
+    const Vk_Frame_Pass_Data *data = static_cast<const Vk_Frame_Pass_Data *>(user_data);
 
-        vk_create_info.pNext = nullptr;
+    if (data->is_draw_list_ready) {
+        vk_record_gpu_culling_reset(*data->draw_list->gpu_culling, command_buffer, data->frame_index);
     }
+}
 
-    vk_result = vkCreateInstance(&vk_create_info, nullptr, &vk_instance);
-    if (vk_result != VK_SUCCESS) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateInstance() = %s", string_VkResult(vk_result));
-        
-        SDL_TriggerBreakpoint();
-        return EXIT_FAILURE;
+static void
+vk_gpu_culling_pass(VkCommandBuffer command_buffer, void *user_data)
+{
+    const Vk_Frame_Pass_Data *data = static_cast<const Vk_Frame_Pass_Data *>(user_data);
+
+    if (!data->is_draw_list_ready) {
+        return;
     }
-    defer(vkDestroyInstance(vk_instance, nullptr));
 
-    //
-    // VK Debug Messenger:
-    //
-    VkDebugUtilsMessengerEXT vk_debug_messeger = nullptr;
-    PFN_vkDestroyDebugUtilsMessengerEXT vk_destroy_debug_utils_messenger_ext = nullptr;
-    defer(if constexpr (s_vk_enable_validation_layers) { 
-        vk_destroy_debug_utils_messenger_ext(vk_instance, vk_debug_messeger, nullptr); });
+    // NOTE(gr3yknigh1): Dispatch isn't allowed inside render pass, so culling goes into primary buffer before it. [2025/04/01]
+    uint32_t culling_scope = vk_profiler_begin_scope(data->profiler, data->frame_index, command_buffer, "gpu culling");
+    vk_record_gpu_culling(*data->draw_list->gpu_culling, command_buffer, data->frame_index, data->draw_list->camera);
+    vk_profiler_end_scope(data->profiler, data->frame_index, command_buffer, culling_scope);
+}
 
-    if constexpr (s_vk_enable_validation_layers) {
-        auto vk_create_debug_utils_messenger_ext = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
-            vkGetInstanceProcAddr(vk_instance, "vkCreateDebugUtilsMessengerEXT"));
-        SDL_assert(vk_create_debug_utils_messenger_ext);
+static void
+vk_main_pass(VkCommandBuffer command_buffer, void *user_data)
+{
+    const Vk_Frame_Pass_Data *data = static_cast<const Vk_Frame_Pass_Data *>(user_data);
+    const Vk_Draw_List &draw_list = *data->draw_list;
+
+    VkCommandBufferInheritanceInfo inheritance_info = {};
+    inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance_info.renderPass = data->render_pass;
+    inheritance_info.subpass = 0;
+    inheritance_info.framebuffer = data->framebuffer;
+
+    Frame_Vector<VkCommandBuffer> secondary_buffers(&data->frame->arena);
+    if (data->is_draw_list_ready && draw_list.gpu_culling != nullptr) {
+        VkCommandBuffer draw_buffer = vk_begin_secondary_buffer(data->device, &data->frame->thread_commands[0], inheritance_info);
+        Vk_Draw_Mesh mesh = {};
+        mesh.vertex_buffer = draw_list.vertex_buffer;
+        mesh.index_buffer = draw_list.index_buffer;
+        mesh.index_type = draw_list.index_type;
+        mesh.index_count = draw_list.index_count;
+
+        vk_record_gpu_culling_draw(*draw_list.gpu_culling, draw_buffer, data->frame_index, mesh, draw_list.camera, data->extent);
+        vkEndCommandBuffer(draw_buffer);
+
+        secondary_buffers.push_back(draw_buffer);
+    } else if (data->is_draw_list_ready && draw_list.draw_queue != nullptr) {
+        VkCommandBuffer draw_buffer = vk_begin_secondary_buffer(data->device, &data->frame->thread_commands[0], inheritance_info);
+        vk_record_draw_queue(draw_buffer, data->frame_index, draw_list, data->extent);
+        vkEndCommandBuffer(draw_buffer);
+
+        secondary_buffers.push_back(draw_buffer);
+    } else if (data->is_draw_list_ready) {
+        vk_record_draws(
+            data->job_system, data->profiler, data->device, data->frame, data->render_pass, data->framebuffer, data->extent,
+            draw_list, &secondary_buffers);
+    }
 
-        if (vk_create_debug_utils_messenger_ext) {
-            SDL_assert(vk_create_debug_utils_messenger_ext(vk_instance, &vk_debug_create_info, nullptr, &vk_debug_messeger) == VK_SUCCESS);
-        }
+    if (data->particles != nullptr) {
+        // NOTE(gr3yknigh1): Recording jobs are done, so main thread's pool is free to use. [2025/03/31]
+        VkCommandBuffer particles_buffer = vk_begin_secondary_buffer(data->device, &data->frame->thread_commands[0], inheritance_info);
+        vk_record_particles_draw(*data->particles, particles_buffer, data->frame_index, data->extent);
+        vkEndCommandBuffer(particles_buffer);
 
-        vk_destroy_debug_utils_messenger_ext = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
-            vkGetInstanceProcAddr(vk_instance, "vkDestroyDebugUtilsMessengerEXT"));
-        SDL_assert(vk_destroy_debug_utils_messenger_ext);
+        secondary_buffers.push_back(particles_buffer);
     }
 
-    //
-    // VK: surface creation.
-    //
-    VkSurfaceKHR vk_surface = VK_NULL_HANDLE;
-    SDL_assert(SDL_Vulkan_CreateSurface(window, vk_instance, &vk_surface));
-    defer(vkDestroySurfaceKHR(vk_instance, vk_surface, nullptr));
+    // NOTE(gr3yknigh1): Timestamps can't be written inside render pass with secondary buffer contents. [2025/03/29]
+    uint32_t main_pass_scope = vk_profiler_begin_scope(data->profiler, data->frame_index, command_buffer, "main pass");
 
-    //
-    // VK: physical device.
-    //
-    std::vector<const char *> vk_required_device_extensions = {
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME
-    };
+    VkClearValue clear_value = {};
+    clear_value.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
 
-    VkPhysicalDevice vk_physical_device = vk_pick_physical_device(vk_instance, vk_surface, vk_required_device_extensions);  
-    SDL_assert(vk_physical_device);
-    // ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-    // TODO(gr3yknigh1): Need cleanup? [2025/03/20]
+    VkRenderPassBeginInfo render_pass_begin_info = {};
+    render_pass_begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    render_pass_begin_info.renderPass = data->render_pass;
+    render_pass_begin_info.framebuffer = data->framebuffer;
+    render_pass_begin_info.renderArea.offset = { 0, 0 };
+    render_pass_begin_info.renderArea.extent = data->extent;
+    render_pass_begin_info.clearValueCount = 1;
+    render_pass_begin_info.pClearValues = &clear_value;
 
-    //
-    // VK: picking queue family.
-    // TODO(gr3yknigh1): Move to Physical Device Picking! [2025/03/20]
-    //
-    auto [vk_graphics_queue_index, vk_present_queue_index] = 
-        vk_find_queue_family_indices(vk_physical_device, vk_surface);
+    vkCmdBeginRenderPass(command_buffer, &render_pass_begin_info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
 
-    SDL_assert(vk_graphics_queue_index.has_value());
-    SDL_assert(vk_present_queue_index.has_value());
+    if (!secondary_buffers.empty()) {
+        vkCmdExecuteCommands(command_buffer, static_cast<uint32_t>(secondary_buffers.size()), secondary_buffers.data());
+    }
 
-    //
-    // VK: logical device.
-    //
-    VkDevice vk_device = vk_make_logical_device(
-        vk_physical_device, vk_required_validation_layers, vk_required_device_extensions, vk_graphics_queue_index.value(),
-        vk_present_queue_index.value(), s_vk_enable_validation_layers);
-    defer(vkDestroyDevice(vk_device, nullptr));
+    vkCmdEndRenderPass(command_buffer);
 
-    VkQueue vk_graphics_queue = VK_NULL_HANDLE, vk_present_queue = VK_NULL_HANDLE;
+    vk_profiler_end_scope(data->profiler, data->frame_index, command_buffer, main_pass_scope);
+}
 
-    vkGetDeviceQueue(vk_device, vk_graphics_queue_index.value(), 0, &vk_graphics_queue);
-    SDL_assert(vk_graphics_queue);
+void
+vk_record_frame(
+    Job_System *job_system, Profiler *profiler, Vk_Render_Graph *render_graph, VkDevice device, Vk_Frame *frame,
+    uint32_t frame_index, uint64_t frame_number, Vk_Upload_Context *upload_context, VkRenderPass render_pass,
+    VkImage color_image, VkFramebuffer framebuffer, VkImageLayout color_final_layout, VkExtent2D extent,
+    const Vk_Draw_List &draw_list, const Vk_Particles *particles)
+{
+    VkCommandBuffer command_buffer = frame->command_buffer;
 
-    vkGetDeviceQueue(vk_device, vk_present_queue_index.value(), 0, &vk_present_queue);
-    SDL_assert(vk_present_queue);
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-    //
-    // VK: searching for surface format.
-    // NOTE(gr3yknigh1): Duplication on physical device picking [2025/03/20]
-    //
-    uint32_t vk_surface_formats_count = 0;
-    SDL_assert(vkGetPhysicalDeviceSurfaceFormatsKHR(vk_physical_device, vk_surface, &vk_surface_formats_count, nullptr) == VK_SUCCESS);
+    vkBeginCommandBuffer(command_buffer, &begin_info);
 
-    std::vector<VkSurfaceFormatKHR> vk_surface_formats(vk_surface_formats_count);
-    SDL_assert(vkGetPhysicalDeviceSurfaceFormatsKHR(
-        vk_physical_device, vk_surface, &vk_surface_formats_count, vk_surface_formats.data()) == VK_SUCCESS);
+    vk_profiler_begin_frame(profiler, frame_index, command_buffer, frame_number);
+    uint32_t frame_scope = vk_profiler_begin_scope(profiler, frame_index, command_buffer, "frame");
 
-    std::optional<VkSurfaceFormatKHR> vk_surface_format = std::nullopt;
-    for (auto &format : vk_surface_formats) {
-        if (format.format == VK_FORMAT_B8G8R8A8_SRGB && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
-            vk_surface_format = format;
-        }
-    }
-    SDL_assert(vk_surface_format.has_value());
+    //
+    // NOTE(gr3yknigh1): Uploads finished up to now become usable in this command buffer. Anything still in flight
+    // is drawn in one of the next frames, render loop never waits for transfer queue. [2025/03/26]
+    //
+    uint32_t upload_scope = vk_profiler_begin_scope(profiler, frame_index, command_buffer, "upload acquire");
+    vk_upload_acquire(upload_context, command_buffer);
+    vk_profiler_end_scope(profiler, frame_index, command_buffer, upload_scope);
+
+    const Vk_Gpu_Culling *gpu_culling = draw_list.gpu_culling;
+
+    Vk_Frame_Pass_Data pass_data = {};
+    pass_data.job_system = job_system;
+    pass_data.profiler = profiler;
+    pass_data.device = device;
+    pass_data.frame = frame;
+    pass_data.frame_index = frame_index;
+    pass_data.render_pass = render_pass;
+    pass_data.framebuffer = framebuffer;
+    pass_data.extent = extent;
+    pass_data.draw_list = &draw_list;
+    pass_data.particles = particles;
+    pass_data.is_draw_list_ready = vk_upload_is_ready(upload_context, draw_list.vertex_buffer_ticket)
+        && vk_upload_is_ready(upload_context, draw_list.index_buffer_ticket)
+        && vk_upload_is_ready(upload_context, draw_list.draws_buffer_ticket)
+        && (gpu_culling == nullptr || vk_upload_is_ready(upload_context, gpu_culling->objects_buffer_ticket));
 
     //
-    // VK: searching for present mode.
+    // NOTE(gr3yknigh1): Structure doesn't depend on upload readiness, passes just record nothing until then, so the
+    // graph is compiled once per mode instead of flipping when uploads land. Particles come from compute queue and
+    // are synchronized by the submit's semaphore wait. [2025/04/03]
     //
+    vk_render_graph_begin(render_graph);
 
-    uint32_t vk_present_modes_count = 0;
-    SDL_assert(vkGetPhysicalDeviceSurfacePresentModesKHR(
-        vk_physical_device, vk_surface, &vk_present_modes_count, nullptr) == VK_SUCCESS);
+    Vk_Graph_State color_initial_state = {};
+    color_initial_state.stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT; // `image available` is waited at this stage.
+    color_initial_state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
 
-    std::vector<VkPresentModeKHR> vk_present_modes(vk_present_modes_count);
-    SDL_assert(vkGetPhysicalDeviceSurfacePresentModesKHR(
-        vk_physical_device, vk_surface, &vk_present_modes_count, vk_present_modes.data()) == VK_SUCCESS);
+    Vk_Graph_State color_final_state = {};
+    color_final_state.stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    color_final_state.layout = color_final_layout;
 
-    using namespace std;
+    uint32_t color_target = vk_render_graph_import_image(
+        render_graph, "color target", color_image, VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT, color_initial_state,
+        color_final_state, true);
 
-    optional<VkPresentModeKHR> vk_present_mode = nullopt;
-    for (auto &present_mode : vk_present_modes) {
-        if (present_mode == VK_PRESENT_MODE_MAILBOX_KHR) {
-            vk_present_mode = present_mode;
+    uint32_t indirect_commands = UINT32_MAX;
+    if (gpu_culling != nullptr) {
+        // NOTE(gr3yknigh1): Frame was waited, so the previous draw from this buffer is finished. [2025/04/01]
+        indirect_commands = vk_render_graph_import_buffer(
+            render_graph, "indirect commands", gpu_culling->indirect_buffers[frame_index], Vk_Graph_State{}, false);
+
+        if (gpu_culling->draw_indexed_indirect_count != nullptr) {
+            uint32_t reset_pass = vk_render_graph_add_pass(render_graph, "indirect count reset", vk_gpu_culling_reset_pass, &pass_data);
+            vk_render_graph_use(render_graph, reset_pass, indirect_commands, Vk_Graph_Usage::Transfer_Write);
         }
+
+        uint32_t culling_pass = vk_render_graph_add_pass(render_graph, "gpu culling", vk_gpu_culling_pass, &pass_data);
+        vk_render_graph_use(render_graph, culling_pass, indirect_commands, Vk_Graph_Usage::Storage_Write_Compute);
     }
-    if (!vk_present_mode) {
-        vk_present_mode = VK_PRESENT_MODE_FIFO_KHR;
+
+    uint32_t main_pass = vk_render_graph_add_pass(render_graph, "main pass", vk_main_pass, &pass_data);
+    vk_render_graph_use(render_graph, main_pass, color_target, Vk_Graph_Usage::Color_Attachment);
+    if (indirect_commands != UINT32_MAX) {
+        vk_render_graph_use(render_graph, main_pass, indirect_commands, Vk_Graph_Usage::Indirect_Read);
     }
 
-    //
-    // VK: swap extent.
-    //
-    VkSurfaceCapabilitiesKHR vk_capabilities = {};
-    SDL_assert(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(vk_physical_device, vk_surface, &vk_capabilities) == VK_SUCCESS);
+    VkResult result = vk_render_graph_compile(render_graph, frame_number);
+    SDL_assert(result == VK_SUCCESS);
 
-    VkExtent2D vk_extent_2d = vk_pick_swap_extent(&vk_capabilities, window_width, window_height);
+    vk_render_graph_execute(*render_graph, command_buffer);
 
-    VkSwapchainKHR vk_swapchain = VK_NULL_HANDLE;
-    SDL_assert(vk_make_swapchain(
-        vk_device, vk_surface, vk_surface_format.value(), 
-        vk_graphics_queue_index.value(), vk_present_queue_index.value(),
-        vk_present_mode.value(), &vk_capabilities, vk_extent_2d, &vk_swapchain) == VK_SUCCESS);
-    defer(vkDestroySwapchainKHR(vk_device, vk_swapchain, nullptr));
+    vk_profiler_end_scope(profiler, frame_index, command_buffer, frame_scope);
 
-    uint32_t vk_swapchain_images_count = 0;
-    vkGetSwapchainImagesKHR(vk_device, vk_swapchain, &vk_swapchain_images_count, nullptr);
-    std::vector<VkImage> vk_swapchain_images(vk_swapchain_images_count);
-    vkGetSwapchainImagesKHR(vk_device, vk_swapchain, &vk_swapchain_images_count, vk_swapchain_images.data());
+    vkEndCommandBuffer(command_buffer);
+}
 
-    std::vector<VkImageView> vk_swapchain_image_views(vk_swapchain_images.size());
-    for (size_t index = 0; index < vk_swapchain_images.size(); index++) {
-        VkImageViewCreateInfo create_info{};
-        create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-        create_info.image = vk_swapchain_images[index];
+void
+vk_benchmark_recording(
+    VkDevice device, Vk_Frame *frame, VkRenderPass render_pass, VkFramebuffer framebuffer, VkExtent2D extent,
+    const Vk_Draw_List &draw_list, uint32_t max_threads_count)
+{
+    constexpr uint32_t warmup_iterations_count = 5;
+    constexpr uint32_t iterations_count = 50;
 
-        create_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-        create_info.format = vk_surface_format.value().format;
+    std::vector<uint32_t> threads_counts;
+    for (uint32_t threads_count = 1; threads_count < max_threads_count; threads_count *= 2) {
+        threads_counts.push_back(threads_count);
+    }
+    threads_counts.push_back(max_threads_count);
 
-        create_info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-        create_info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-        create_info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-        create_info.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Benchmark: recording %u draws, %u iterations per thread count",
+        draw_list.draws_count, iterations_count);
 
-        create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        create_info.subresourceRange.baseMipLevel = 0;
-        create_info.subresourceRange.levelCount = 1;
-        create_info.subresourceRange.baseArrayLayer = 0;
-        create_info.subresourceRange.layerCount = 1;
+    double single_thread_ms = 0.0;
+    size_t secondary_buffers_count = 0;
 
-        SDL_assert(vkCreateImageView(vk_device, &create_info, nullptr, &vk_swapchain_image_views[index]) == VK_SUCCESS);
-    }
-    defer(for (auto& view : vk_swapchain_image_views) vkDestroyImageView(vk_device, view, nullptr));
+    for (uint32_t threads_count : threads_counts) {
+        Job_System job_system;
+        job_system_init(&job_system, threads_count);
+        defer(job_system_destroy(&job_system));
 
+        uint64_t total_ticks = 0;
 
+        for (uint32_t iteration = 0; iteration < warmup_iterations_count + iterations_count; ++iteration) {
+            // NOTE(gr3yknigh1): Buffers are never submitted, so pools can be reset right away. [2025/03/28]
+            vk_reset_frame(device, frame);
 
-    //
-    // Main loop:
-    //
-    while (!global_should_stop) {
+            Frame_Vector<VkCommandBuffer> secondary_buffers(&frame->arena);
 
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
-                global_should_stop = true;
-            }
+            uint64_t counter = SDL_GetPerformanceCounter();
+            vk_record_draws(&job_system, nullptr, device, frame, render_pass, framebuffer, extent, draw_list, &secondary_buffers);
+
+            secondary_buffers_count = secondary_buffers.size();
 
-            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window)) {
-                global_should_stop = true;
+            if (iteration >= warmup_iterations_count) {
+                total_ticks += SDL_GetPerformanceCounter() - counter;
             }
         }
 
-
-        if (SDL_GetWindowFlags(window) & SDL_WINDOW_MINIMIZED) {
-            SDL_Delay(10);
-            continue;
+        double average_ms = static_cast<double>(total_ticks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()) / iterations_count;
+        if (threads_count == 1) {
+            single_thread_ms = average_ms;
         }
+
+        double speedup = single_thread_ms / average_ms;
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Benchmark: %2u threads: %8.3f ms, %7.2f Mdraws/s, speedup %.2fx, efficiency %3.0f%%, %zu secondary buffers",
+            threads_count, average_ms, draw_list.draws_count / average_ms / 1000.0, speedup, speedup / threads_count * 100.0,
+            secondary_buffers_count);
     }
 
-    return EXIT_SUCCESS;
+    vk_reset_frame(device, frame);
 }
 
-static VKAPI_ATTR VkBool32 VKAPI_CALL
-vk_debug_callback(
-    VkDebugUtilsMessageSeverityFlagBitsEXT message_severity, VkDebugUtilsMessageTypeFlagsEXT message_type,
-    const VkDebugUtilsMessengerCallbackDataEXT* callback_data, void* user_data)
+static VkResult
+app_benchmark_wait(void *user_data, uint32_t frame_index)
 {
-    if (message_severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
-        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: %s", callback_data->pMessage);
-    }
-    else {
-        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: %s", callback_data->pMessage);
-    }
-    return VK_FALSE;
+    App_Benchmark_Frames *frames = static_cast<App_Benchmark_Frames *>(user_data);
+    return vk_timeline_wait(frames->graphics_timeline, (*frames->frames)[frame_index].submitted_frame_number);
 }
 
-std::pair<std::optional<uint32_t>, std::optional<uint32_t>> 
-vk_find_queue_family_indices(VkPhysicalDevice device, VkSurfaceKHR surface)
+static VkResult
+app_benchmark_submit(void *user_data, const Vk_Benchmark_Frame &benchmark_frame)
 {
-    uint32_t queue_family_count = 0;
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, nullptr);
+    App_Benchmark_Frames *frames = static_cast<App_Benchmark_Frames *>(user_data);
 
-    std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
-    vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_family_count, queue_families.data());
+    uint32_t frame_index = benchmark_frame.frame_index;
+    Vk_Frame &frame = (*frames->frames)[frame_index];
+    const Vk_Offscreen_Target &target = (*frames->targets)[frame_index];
 
-    std::optional<uint32_t> graphics_queue_index = std::nullopt;
-    std::optional<uint32_t> present_queue_index = std::nullopt;
-
-    for (uint32_t index = 0; index < queue_families.size(); ++index) {
-        auto queue_family = queue_families[index];
-
-        if (queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
-            graphics_queue_index = index;
-            continue; // TODO(gr3yknigh1): Gain more information about Queue picking. Made this because validators complained about same queue index from same family [2025/03/20]
-        }
-        
-        VkBool32 is_surface_supported = false;
-        SDL_assert(vkGetPhysicalDeviceSurfaceSupportKHR(
-            device, index, surface, &is_surface_supported) == VK_SUCCESS);
-        SDL_assert(is_surface_supported);
+    Vk_Draw_List draw_list = *frames->draw_list;
+    if (benchmark_frame.camera != nullptr) {
+        draw_list.camera = *benchmark_frame.camera;
+    }
 
-        if (is_surface_supported) {
-            present_queue_index = index;
-        }
+    vk_reset_frame(frames->device, &frame);
+    vk_record_frame(
+        frames->job_system, nullptr, frames->render_graph, frames->device, &frame, frame_index, benchmark_frame.frame_number,
+        frames->upload_context, frames->render_pass, target.image, target.framebuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        frames->extent, draw_list, frames->particles);
 
-        if (graphics_queue_index.has_value() && present_queue_index.has_value()) {
-            break;
-        }
-    }
+    return vk_timeline_submit(
+        frames->graphics_timeline, frames->graphics_queue, &frame.command_buffer, 1, benchmark_frame.waits, VK_NULL_HANDLE,
+        &frame.submitted_frame_number);
+}
 
-    return { graphics_queue_index, present_queue_index };
+Vk_Benchmark_Frames
+app_benchmark_frames(App_Benchmark_Frames *frames)
+{
+    Vk_Benchmark_Frames result = {};
+    result.frames_count = static_cast<uint32_t>(frames->frames->size());
+    result.wait = app_benchmark_wait;
+    result.submit = app_benchmark_submit;
+    result.user_data = frames;
+    return result;
 }
 
-VkPhysicalDevice 
-vk_pick_physical_device(VkInstance instance, VkSurfaceKHR surface, const std::vector<const char *> &required_device_extensions)
+static const char *s_app_usage =
+    "Usage: hello-vk [options]\n"
+    "    --frames-in-flight <n>  Frames recorded ahead of GPU, [1, 8] (default 2)\n"
+    "    --frame-count <n>       Exit after <n> frames (default: unlimited, 1000 in headless mode)\n"
+    "    --headless              Render into offscreen images, without window and swapchain\n"
+    "    --size <w>x<h>          Offscreen target size in headless mode (default 1280x720)\n"
+    "    --dump <file.ppm>       Write the last headless frame as PPM\n"
+    "    --staging-size <MiB>    Staging ring size for uploads (default 64)\n"
+    "    --pipeline-cache <file> Pipeline cache file (default pipeline_cache.bin)\n"
+    "    --no-pipeline-cache     Don't load or save pipeline cache, always cold start\n"
+    "    --threads <n>           Threads which record draws, [1, 64] (default: hardware concurrency)\n"
+    "    --draw-count <n>        Number of triangles drawn (default 1, 50000 in benchmark)\n"
+    "    --benchmark-recording   Measure draw recording for 1, 2, 4, ... threads and exit\n"
+    "    --particles <n>         Simulate <n> particles on compute queue (default 0, 4M in benchmark)\n"
+    "    --benchmark-compute     Compare particle simulation serialized with graphics and on async compute queue, headless\n"
+    "    --profile-trace <file>  Write CPU and GPU scopes as Chrome trace JSON on exit\n"
+    "    --profile-csv <file>    Write CPU and GPU scopes as CSV on exit\n"
+    "    --device <index|name>   Use this device instead of the best scored one (also HELLO_VK_DEVICE)\n"
+    "    --culling <cpu|gpu>     Where draws are culled and issued (default gpu, if device supports indirect draws)\n"
+    "    --benchmark-culling     Compare CPU frame time of CPU and GPU culling at 100k draws by default, headless\n"
+    "    --no-bindless           Use pooled descriptor sets even if device supports descriptor indexing\n"
+    "    --dump-graph <file.dot> Log compiled frame graph and write it as Graphviz DOT\n"
+    "    --present-mode <mode>   fifo, fifo-relaxed, mailbox or immediate (default mailbox, else fifo; V cycles at runtime)\n"
+    "    --swapchain-images <n>  Swapchain image count, clamped to surface limits (default: minimum + 1)\n"
+    "    --fps-limit <n>         Limit frame rate, waiting right before input is sampled (default: unlimited)\n"
+    "    --hot-reload            Recompile edited shaders with glslc and swap rebuilt pipelines in while running\n"
+    "    --fail-on-frame-allocs  Exit with failure if any frame after warmup allocated from the heap\n"
+    "    --no-draw-queue         Record CPU-culled draws one by one in parallel, instead of sorted instanced batches\n"
+    "    --no-timeline           Synchronize with fences even if device supports timeline semaphores\n"
+    "    --scene <file>          Draw the first mesh of scene made by scene-convert instead of the triangle\n"
+    "    --texture-dir <dir>     Stream mips of *.ktx2 textures in <dir> by their screen size, one texture per draw\n"
+    "    --texture-budget <MiB>  Memory streamed textures may take (default: what is left of device heap's budget)\n"
+    "    --serial-startup        Run startup tasks one by one on main thread, to compare with parallel startup\n"
+    "    --debug-msg-rate <n>    Validation messages logged per message id per second, 0 logs all (default 5)\n";
+
+bool
+app_parse_command_line(int argc, char **argv, App_Config *config)
 {
     using namespace std::literals;
 
-    std::vector<std::string_view> required_device_extensions_views(required_device_extensions.begin(), required_device_extensions.end());
-
-    VkPhysicalDevice result = VK_NULL_HANDLE;
+    for (int index = 1; index < argc; ++index) {
+        std::string_view argument(argv[index]);
 
-    uint32_t devices_count = 0;
-    SDL_assert(vkEnumeratePhysicalDevices(instance, &devices_count, nullptr) == VK_SUCCESS);
-    SDL_assert(devices_count);
-
-    std::vector<VkPhysicalDevice> devices(devices_count);
-    SDL_assert(vkEnumeratePhysicalDevices(instance, &devices_count, devices.data()) == VK_SUCCESS);
-
-    for (auto &device : devices) {
-        [[maybe_unused]] VkPhysicalDeviceProperties device_properties = {};
-        vkGetPhysicalDeviceProperties(device, &device_properties);
-
-        [[maybe_unused]] VkPhysicalDeviceFeatures device_features = {};
-        vkGetPhysicalDeviceFeatures(device, &device_features);
+        if (argument == "--frames-in-flight"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 8) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--frames-in-flight: expected value in range [1, 8]");
+                return false;
+            }
+            config->frames_in_flight = static_cast<uint32_t>(value);
+        } else if (argument == "--frame-count"sv && index + 1 < argc) {
+            config->frame_count = static_cast<uint32_t>(strtoul(argv[++index], nullptr, 10));
+        } else if (argument == "--headless"sv) {
+            config->headless = true;
+        } else if (argument == "--size"sv && index + 1 < argc) {
+            unsigned int width = 0, height = 0;
+            if (sscanf(argv[++index], "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--size: expected <width>x<height>");
+                return false;
+            }
+            config->headless_width = width;
+            config->headless_height = height;
+        } else if (argument == "--dump"sv && index + 1 < argc) {
+            config->dump_file_path = argv[++index];
+        } else if (argument == "--staging-size"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 1024) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--staging-size: expected value in range [1, 1024]");
+                return false;
+            }
+            config->staging_size_mb = static_cast<uint32_t>(value);
+        } else if (argument == "--pipeline-cache"sv && index + 1 < argc) {
+            config->pipeline_cache_path = argv[++index];
+        } else if (argument == "--no-pipeline-cache"sv) {
+            config->pipeline_cache_path = nullptr;
+        } else if (argument == "--threads"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 64) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--threads: expected value in range [1, 64]");
+                return false;
+            }
+            config->threads_count = static_cast<uint32_t>(value);
+        } else if (argument == "--draw-count"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 10000000) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--draw-count: expected value in range [1, 10000000]");
+                return false;
+            }
+            config->draw_count = static_cast<uint32_t>(value);
+        } else if (argument == "--benchmark-recording"sv) {
+            config->benchmark_recording = true;
+        } else if (argument == "--particles"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 16 * 1024 * 1024) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--particles: expected value in range [1, 16777216]");
+                return false;
+            }
+            config->particles_count = static_cast<uint32_t>(value);
+        } else if (argument == "--benchmark-compute"sv) {
+            config->benchmark_compute = true;
+        } else if (argument == "--profile-trace"sv && index + 1 < argc) {
+            config->profile_trace_path = argv[++index];
+        } else if (argument == "--profile-csv"sv && index + 1 < argc) {
+            config->profile_csv_path = argv[++index];
+        } else if (argument == "--device"sv && index + 1 < argc) {
+            config->device_name = argv[++index];
+        } else if (argument == "--culling"sv && index + 1 < argc) {
+            std::string_view value(argv[++index]);
+            if (value != "cpu"sv && value != "gpu"sv) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--culling: expected cpu or gpu");
+                return false;
+            }
+            config->gpu_culling = value == "gpu"sv;
+        } else if (argument == "--benchmark-culling"sv) {
+            config->benchmark_culling = true;
+        } else if (argument == "--no-bindless"sv) {
+            config->no_bindless = true;
+        } else if (argument == "--dump-graph"sv && index + 1 < argc) {
+            config->graph_dump_path = argv[++index];
+        } else if (argument == "--present-mode"sv && index + 1 < argc) {
+            config->present_mode = present_mode_from_name(argv[++index]);
+            if (!config->present_mode.has_value()) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--present-mode: expected fifo, fifo-relaxed, mailbox or immediate");
+                return false;
+            }
+        } else if (argument == "--swapchain-images"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 16) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--swapchain-images: expected value in range [1, 16]");
+                return false;
+            }
+            config->swapchain_images_count = static_cast<uint32_t>(value);
+        } else if (argument == "--fps-limit"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 1000) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--fps-limit: expected value in range [1, 1000]");
+                return false;
+            }
+            config->fps_limit = static_cast<uint32_t>(value);
+        } else if (argument == "--hot-reload"sv) {
+            config->hot_reload = true;
+        } else if (argument == "--fail-on-frame-allocs"sv) {
+            config->fail_on_frame_allocations = true;
+        } else if (argument == "--no-draw-queue"sv) {
+            config->draw_queue = false;
+        } else if (argument == "--no-timeline"sv) {
+            config->no_timeline_semaphores = true;
+        } else if (argument == "--scene"sv && index + 1 < argc) {
+            config->scene_path = argv[++index];
+        } else if (argument == "--texture-dir"sv && index + 1 < argc) {
+            config->texture_dir = argv[++index];
+        } else if (argument == "--texture-budget"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 1 || value > 65536) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--texture-budget: expected value in range [1, 65536]");
+                return false;
+            }
+            config->texture_budget_mb = static_cast<uint32_t>(value);
+        } else if (argument == "--serial-startup"sv) {
+            config->serial_startup = true;
+        } else if (argument == "--debug-msg-rate"sv && index + 1 < argc) {
+            long value = strtol(argv[++index], nullptr, 10);
+            if (value < 0 || value > 100000) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--debug-msg-rate: expected value in range [0, 100000]");
+                return false;
+            }
+            config->debug_messages_per_second = static_cast<uint32_t>(value);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown argument: %s", argv[index]);
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", s_app_usage);
+            return false;
+        }
+    }
 
-        auto [graphics_index, present_index] = vk_find_queue_family_indices(device, surface);
+    // NOTE(gr3yknigh1): Compute benchmark submits frames without presenting them. [2025/03/31]
+    if (config->benchmark_compute) {
+        config->headless = true;
 
-        if (!graphics_index.has_value() || !present_index.has_value()) {
-            continue;
+        if (config->particles_count == 0) {
+            config->particles_count = 4 * 1024 * 1024;
         }
+        if (config->draw_count == 0) {
+            config->draw_count = 20000;
+        }
+    }
 
-        uint32_t extension_count = 0;
-        SDL_assert(vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, nullptr) == VK_SUCCESS);
-
-        std::vector<VkExtensionProperties> available_extensions(extension_count);
-        SDL_assert(vkEnumerateDeviceExtensionProperties(device, nullptr, &extension_count, available_extensions.data()) == VK_SUCCESS);
+    // NOTE(gr3yknigh1): Culling benchmark needs GPU path even if CPU one was asked for. [2025/04/01]
+    if (config->benchmark_culling) {
+        config->headless = true;
+        config->gpu_culling = true;
 
-        uint32_t extension_matches_count = 0;
-        for (const auto &extension : available_extensions) {
-            for (const auto &required_extension : required_device_extensions_views) {
-                if (required_extension == extension.extensionName) {
-                    extension_matches_count++;
-                    break;
-                }
-            }
+        if (config->draw_count == 0) {
+            config->draw_count = 100000;
         }
+    }
 
-        bool all_required_extensions_supported = extension_matches_count == required_device_extensions_views.size();
-
-        if (all_required_extensions_supported) {
-            uint32_t surface_formats_count = 0;
-            SDL_assert(vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &surface_formats_count, nullptr) == VK_SUCCESS);
+    if (config->dump_file_path != nullptr && !config->headless) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--dump: supported only together with --headless");
+        return false;
+    }
 
-            uint32_t present_mode_count = 0;
-            SDL_assert(vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &present_mode_count, nullptr) == VK_SUCCESS);
+    if (config->headless && config->frame_count == 0) {
+        config->frame_count = 1000;
+    }
 
-            if (surface_formats_count > 0 && present_mode_count > 0) {
-                result = device;
-                break;
-            }
-        }
+    if (config->threads_count == 0) {
+        config->threads_count = std::clamp(std::thread::hardware_concurrency(), 1u, 64u);
+    }
 
-#if 0
-        if (device_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && device_features.geometryShader) {
-            break;
-        }
-#endif
+    if (config->draw_count == 0) {
+        config->draw_count = config->benchmark_recording ? 50000 : 1;
     }
 
-    return result;
+    return true;
 }
 
-VkDevice 
-vk_make_logical_device(
-    VkPhysicalDevice physical_device, const std::vector<const char*>& required_validation_layers, const std::vector<const char*>& required_device_extensions,
-    uint32_t graphics_queue_index, uint32_t present_queue_index, bool enable_validation_layers)
+void
+frame_time_stats_begin(Frame_Time_Stats *stats)
 {
-    VkDevice device = VK_NULL_HANDLE;
-    float queue_priority = 1.0f;
+    *stats = {};
+    stats->frequency = SDL_GetPerformanceFrequency();
+    stats->last_counter = SDL_GetPerformanceCounter();
+    stats->report_counter = stats->last_counter;
+}
 
-    std::array<VkDeviceQueueCreateInfo, 2> queue_create_infos = {};
+void
+frame_time_stats_tick(Frame_Time_Stats *stats)
+{
+    uint64_t counter = SDL_GetPerformanceCounter();
+    double frame_ms = static_cast<double>(counter - stats->last_counter) * 1000.0 / static_cast<double>(stats->frequency);
+    stats->last_counter = counter;
 
-    queue_create_infos[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queue_create_infos[0].queueFamilyIndex = graphics_queue_index;
-    queue_create_infos[0].queueCount = 1;
-    queue_create_infos[0].pQueuePriorities = &queue_priority;
+    if (stats->frames == 0) {
+        stats->min_ms = frame_ms;
+        stats->max_ms = frame_ms;
+    }
 
-    queue_create_infos[1].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queue_create_infos[1].queueFamilyIndex = present_queue_index; 
-    queue_create_infos[1].queueCount = 1;
-    queue_create_infos[1].pQueuePriorities = &queue_priority;
+    stats->frames++;
+    stats->total_ms += frame_ms;
+    stats->min_ms = std::min(stats->min_ms, frame_ms);
+    stats->max_ms = std::max(stats->max_ms, frame_ms);
 
-    VkPhysicalDeviceFeatures device_features = {}; // TODO(gr3yknigh1): Go back later... [2025/03/20]
-    
-    VkDeviceCreateInfo device_create_info = {};
-    device_create_info.sType                = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    device_create_info.pQueueCreateInfos    = queue_create_infos.data();
-    device_create_info.queueCreateInfoCount = queue_create_infos.size();
-    
-    device_create_info.pEnabledFeatures     = &device_features;
-    
-    device_create_info.ppEnabledExtensionNames = required_device_extensions.data();
-    device_create_info.enabledExtensionCount = static_cast<uint32_t>(required_device_extensions.size());
+    stats->run_frames++;
+    stats->run_total_ms += frame_ms;
 
-    if (enable_validation_layers) {
-        device_create_info.enabledLayerCount = static_cast<uint32_t>(required_validation_layers.size());
-        device_create_info.ppEnabledLayerNames = required_validation_layers.data();
-    } else {
-        device_create_info.enabledLayerCount = 0;
+    // NOTE(gr3yknigh1): Report once per second. [2025/03/22]
+    if (counter - stats->report_counter >= stats->frequency) {
+        double average_ms = stats->total_ms / stats->frames;
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Frame time: avg %.3f ms (%.1f FPS), min %.3f ms, max %.3f ms",
+            average_ms, 1000.0 / average_ms, stats->min_ms, stats->max_ms);
+
+        stats->report_counter = counter;
+        stats->frames = 0;
+        stats->total_ms = 0.0;
     }
+}
 
-    VkResult result = vkCreateDevice(physical_device, &device_create_info, nullptr, &device);
-    if (result != VK_SUCCESS) {
-        // TODO(gr3yknigh1): Find another way to report error from here [2025/03/20]
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateDevice() = %s", string_VkResult(result));
-        SDL_TriggerBreakpoint();
-        return VK_NULL_HANDLE;
+void
+frame_time_stats_report_run(const Frame_Time_Stats *stats)
+{
+    if (stats->run_frames == 0) {
+        return;
     }
 
-    return device;
+    double average_ms = stats->run_total_ms / stats->run_frames;
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Sustained frame time: %.3f ms (%.1f FPS) over %llu frames",
+        average_ms, 1000.0 / average_ms, static_cast<unsigned long long>(stats->run_frames));
 }
 
-
-VkExtent2D
-vk_pick_swap_extent(VkSurfaceCapabilitiesKHR *capabilities, int width, int height)
+VkResult
+vk_make_offscreen_target(
+    Vk_Allocator *allocator, VkRenderPass render_pass, VkFormat format, VkExtent2D extent, Vk_Offscreen_Target *target)
 {
-    if (capabilities->currentExtent.width != std::numeric_limits<uint32_t>::max()) {
-        return capabilities->currentExtent;
+    VkResult result = VK_SUCCESS;
+
+    VkImageCreateInfo image_create_info = {};
+    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_create_info.imageType = VK_IMAGE_TYPE_2D;
+    image_create_info.format = format;
+    image_create_info.extent = { extent.width, extent.height, 1 };
+    image_create_info.mipLevels = 1;
+    image_create_info.arrayLayers = 1;
+    image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_create_info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    result = vk_allocator_make_image(allocator, image_create_info, Vk_Memory_Usage::Gpu_Only, &target->image, &target->allocation);
+    if (result != VK_SUCCESS) {
+        return result;
     }
 
-    VkExtent2D result = {};
-    result.width = std::clamp(static_cast<uint32_t>(width), capabilities->minImageExtent.width, capabilities->maxImageExtent.width);
-    result.height = std::clamp(static_cast<uint32_t>(height), capabilities->minImageExtent.height, capabilities->maxImageExtent.height);
+    std::vector<VkImageView> image_views;
+    result = vk_make_swapchain_image_views(allocator->device, { target->image }, format, &image_views);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    target->image_view = image_views[0];
+
+    VkFramebufferCreateInfo framebuffer_create_info = {};
+    framebuffer_create_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebuffer_create_info.renderPass = render_pass;
+    framebuffer_create_info.attachmentCount = 1;
+    framebuffer_create_info.pAttachments = &target->image_view;
+    framebuffer_create_info.width = extent.width;
+    framebuffer_create_info.height = extent.height;
+    framebuffer_create_info.layers = 1;
+
+    return vkCreateFramebuffer(allocator->device, &framebuffer_create_info, nullptr, &target->framebuffer);
+}
 
-    return result;
+void
+vk_destroy_offscreen_target(Vk_Allocator *allocator, Vk_Offscreen_Target *target)
+{
+    vkDestroyFramebuffer(allocator->device, target->framebuffer, nullptr);
+    vkDestroyImageView(allocator->device, target->image_view, nullptr);
+    if (target->image != VK_NULL_HANDLE) {
+        vk_allocator_destroy_image(allocator, target->image, &target->allocation);
+    }
+
+    *target = {};
 }
 
-VkResult 
-vk_make_swapchain(
-    VkDevice device, VkSurfaceKHR surface, VkSurfaceFormatKHR surface_format, 
-    uint32_t graphics_queue_index, uint32_t present_queue_index, VkPresentModeKHR present_mode,
-    VkSurfaceCapabilitiesKHR *capabilities, VkExtent2D extent, VkSwapchainKHR *result)
+bool
+vk_dump_image_ppm(
+    Vk_Allocator *allocator, VkQueue queue, uint32_t queue_index,
+    VkImage image, VkFormat format, VkExtent2D extent, const char *file_path)
 {
+    VkDevice device = allocator->device;
 
-    uint32_t image_count = capabilities->minImageCount + 1;
-    if (capabilities->maxImageCount > 0 && image_count > capabilities->maxImageCount) {
-        image_count = capabilities->maxImageCount;
+    bool is_bgra = format == VK_FORMAT_B8G8R8A8_SRGB || format == VK_FORMAT_B8G8R8A8_UNORM;
+    bool is_rgba = format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_R8G8B8A8_UNORM;
+    if (!is_bgra && !is_rgba) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Frame dump: unsupported format %s", string_VkFormat(format));
+        return false;
     }
 
-    VkSwapchainCreateInfoKHR create_info = {};
-    create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-    create_info.surface = surface;
-    create_info.minImageCount = image_count;
-    create_info.imageFormat = surface_format.format;
-    create_info.imageColorSpace = surface_format.colorSpace;
-    create_info.imageExtent = extent;
-    create_info.imageArrayLayers = 1;
-    create_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
 
-    // TODO(gr3yknigh1): Remove duplication in creation of logical device [2025/03/21]
-    std::array<uint32_t, 2> queue_family_indices = { graphics_queue_index, present_queue_index };
+    //
+    // Readback buffer:
+    //
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = size;
+    buffer_create_info.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    Vk_Allocation allocation = {};
+    if (vk_allocator_make_buffer(allocator, buffer_create_info, Vk_Memory_Usage::Gpu_To_Cpu, &buffer, &allocation) != VK_SUCCESS) {
+        return false;
+    }
+    defer(vk_allocator_destroy_buffer(allocator, buffer, &allocation));
 
-    if (graphics_queue_index != present_queue_index) {
-        create_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
-        create_info.queueFamilyIndexCount = queue_family_indices.size();
-        create_info.pQueueFamilyIndices = queue_family_indices.data();
-    } else {
-        create_info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        create_info.queueFamilyIndexCount = 0; // Optional
-        create_info.pQueueFamilyIndices = nullptr; // Optional
+    //
+    // Copy:
+    //
+    VkCommandPoolCreateInfo command_pool_create_info = {};
+    command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    command_pool_create_info.queueFamilyIndex = queue_index;
+
+    VkCommandPool command_pool = VK_NULL_HANDLE;
+    if (vkCreateCommandPool(device, &command_pool_create_info, nullptr, &command_pool) != VK_SUCCESS) {
+        return false;
     }
+    defer(vkDestroyCommandPool(device, command_pool, nullptr));
 
-    create_info.preTransform = capabilities->currentTransform;
-    create_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-    create_info.presentMode = present_mode;
-    create_info.clipped = VK_TRUE;
-    create_info.oldSwapchain = VK_NULL_HANDLE;
-    
-    return vkCreateSwapchainKHR(device, &create_info, nullptr, result);
+    VkCommandBufferAllocateInfo command_buffer_allocate_info = {};
+    command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    command_buffer_allocate_info.commandPool = command_pool;
+    command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    command_buffer_allocate_info.commandBufferCount = 1;
+
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    if (vkAllocateCommandBuffers(device, &command_buffer_allocate_info, &command_buffer) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+
+    // NOTE(gr3yknigh1): Layout is already TRANSFER_SRC_OPTIMAL (render pass final layout), only make writes visible. [2025/03/24]
+    VkImageMemoryBarrier image_barrier = {};
+    image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    image_barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    image_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    image_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    image_barrier.image = image;
+    image_barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+    vkCmdPipelineBarrier(
+        command_buffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &image_barrier);
+
+    VkBufferImageCopy region = {};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { extent.width, extent.height, 1 };
+
+    vkCmdCopyImageToBuffer(command_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+
+    VkBufferMemoryBarrier buffer_barrier = {};
+    buffer_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    buffer_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    buffer_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    buffer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    buffer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    buffer_barrier.buffer = buffer;
+    buffer_barrier.offset = 0;
+    buffer_barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(
+        command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+        0, nullptr, 1, &buffer_barrier, 0, nullptr);
+
+    vkEndCommandBuffer(command_buffer);
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+
+    if (vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE) != VK_SUCCESS) {
+        return false;
+    }
+    vkQueueWaitIdle(queue);
+
+    //
+    // Write:
+    //
+    const uint8_t *pixels = static_cast<const uint8_t *>(allocation.mapped);
+
+    std::vector<uint8_t> rgb(static_cast<size_t>(extent.width) * extent.height * 3);
+    for (size_t index = 0; index < static_cast<size_t>(extent.width) * extent.height; ++index) {
+        rgb[index * 3 + 0] = pixels[index * 4 + (is_bgra ? 2 : 0)];
+        rgb[index * 3 + 1] = pixels[index * 4 + 1];
+        rgb[index * 3 + 2] = pixels[index * 4 + (is_bgra ? 0 : 2)];
+    }
+
+    SDL_RWops *file = SDL_RWFromFile(file_path, "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RWFromFile(%s) = %s", file_path, SDL_GetError());
+        return false;
+    }
+    defer(SDL_RWclose(file));
+
+    char header[64] = {};
+    int header_size = snprintf(header, sizeof(header), "P6\n%u %u\n255\n", extent.width, extent.height);
+
+    bool is_written =
+        SDL_RWwrite(file, header, 1, static_cast<size_t>(header_size)) == static_cast<size_t>(header_size) &&
+        SDL_RWwrite(file, rgb.data(), 1, rgb.size()) == rgb.size();
+
+    return is_written;
 }
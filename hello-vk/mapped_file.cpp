@@ -0,0 +1,127 @@
+#include "stdafx.h"
+
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#if !defined(WIN32_LEAN_AND_MEAN)
+    #define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+bool
+mapped_file_open(const char *path, Mapped_File *file)
+{
+    *file = {};
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: can't open %s (error %lu)", path, GetLastError());
+        return false;
+    }
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: %s is empty or its size is unknown", path);
+        CloseHandle(handle);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (mapping == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: can't map %s (error %lu)", path, GetLastError());
+        return false;
+    }
+
+    // NOTE(gr3yknigh1): View keeps the mapping (and the file) alive, handles aren't needed past this point. [2025/04/11]
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: can't map view of %s (error %lu)", path, GetLastError());
+        return false;
+    }
+
+    file->data = static_cast<const uint8_t *>(data);
+    file->size = static_cast<uint64_t>(size.QuadPart);
+#else
+    int descriptor = open(path, O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: can't open %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    struct stat status = {};
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: %s is empty or its size is unknown", path);
+        close(descriptor);
+        return false;
+    }
+
+    // NOTE(gr3yknigh1): Mapping stays valid after the descriptor is closed. [2025/04/11]
+    void *data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (data == MAP_FAILED) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mapped file: can't map %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    file->data = static_cast<const uint8_t *>(data);
+    file->size = static_cast<uint64_t>(status.st_size);
+#endif
+
+    return true;
+}
+
+void
+mapped_file_close(Mapped_File *file)
+{
+    if (file->data == nullptr) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(file->data);
+#else
+    munmap(const_cast<uint8_t *>(file->data), static_cast<size_t>(file->size));
+#endif
+
+    *file = {};
+}
+
+void
+mapped_file_will_read(const Mapped_File *file, uint64_t offset, uint64_t size)
+{
+    if (file->data == nullptr || offset >= file->size) {
+        return;
+    }
+
+    size = std::min(size, file->size - offset);
+
+#if defined(_WIN32)
+    WIN32_MEMORY_RANGE_ENTRY range = {};
+    range.VirtualAddress = const_cast<uint8_t *>(file->data + offset);
+    range.NumberOfBytes = static_cast<SIZE_T>(size);
+
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    // NOTE(gr3yknigh1): madvise wants page-aligned address, mapping itself starts at page boundary. [2025/04/11]
+    uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t begin = offset & ~(page_size - 1);
+
+    void *address = const_cast<uint8_t *>(file->data + begin);
+    size_t length = static_cast<size_t>(offset + size - begin);
+
+    madvise(address, length, MADV_SEQUENTIAL);
+    madvise(address, length, MADV_WILLNEED);
+#endif
+}
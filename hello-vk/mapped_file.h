@@ -0,0 +1,22 @@
+#pragma once
+///
+/// @brief Read-only memory mapping of a whole file. Pages are read from disk on first touch, nothing is copied
+/// into process memory up front.
+///
+
+struct Mapped_File {
+    const uint8_t *data = nullptr;
+    uint64_t       size = 0;
+};
+
+///
+/// @note Empty files can't be mapped and are reported as failure.
+///
+bool mapped_file_open(const char *path, Mapped_File *file);
+void mapped_file_close(Mapped_File *file);
+
+///
+/// @brief Hints that the range is about to be read front to back, so OS reads it ahead in big requests instead of
+/// faulting it in page by page.
+///
+void mapped_file_will_read(const Mapped_File *file, uint64_t offset, uint64_t size);
@@ -0,0 +1,131 @@
+#pragma once
+///
+/// @brief Bounded lock-free queue of any number of producer threads and one consumer thread (D. Vyukov's
+/// sequence-per-cell scheme).
+///
+/// Every cell carries a sequence number which tells whose turn it is: producer which claimed write position `p`
+/// waits for `p`, consumer waits for `p + 1` and hands the cell back to the next lap with `p + Capacity`. Producers
+/// never block: push into the full ring fails at once.
+///
+/// @note Cells are allocated by `mpsc_ring_init`, so the ring itself is small enough to be a member or a local.
+///
+
+template <typename T, uint64_t Capacity>
+struct Mpsc_Ring {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    struct Cell {
+        std::atomic<uint64_t> sequence = 0;
+        T                     item;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(64) std::atomic<uint64_t> write_position = 0;
+    alignas(64) uint64_t              read_position  = 0; // Consumer only.
+};
+
+template <typename T, uint64_t Capacity>
+void
+mpsc_ring_init(Mpsc_Ring<T, Capacity> *ring)
+{
+    ring->cells = std::make_unique<typename Mpsc_Ring<T, Capacity>::Cell[]>(Capacity);
+    ring->write_position = 0;
+    ring->read_position = 0;
+
+    for (uint64_t index = 0; index < Capacity; ++index) {
+        ring->cells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, uint64_t Capacity>
+void
+mpsc_ring_destroy(Mpsc_Ring<T, Capacity> *ring)
+{
+    ring->cells.reset();
+}
+
+///
+/// @brief Claims a cell for the calling producer, which fills the returned item in place and publishes it with
+/// `mpsc_ring_end_push`. Any thread.
+///
+/// @return nullptr if the ring is full, consumer is behind.
+///
+template <typename T, uint64_t Capacity>
+T *
+mpsc_ring_begin_push(Mpsc_Ring<T, Capacity> *ring, uint64_t *position)
+{
+    uint64_t write_position = ring->write_position.load(std::memory_order_relaxed);
+
+    for (;;) {
+        auto &cell = ring->cells[write_position & (Capacity - 1)];
+
+        uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+        int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(write_position);
+
+        if (difference == 0) {
+            if (ring->write_position.compare_exchange_weak(write_position, write_position + 1, std::memory_order_relaxed)) {
+                *position = write_position;
+                return &cell.item;
+            }
+        } else if (difference < 0) {
+            // NOTE(gr3yknigh1): Cell still holds item from the previous lap. [2025/03/29]
+            return nullptr;
+        } else {
+            write_position = ring->write_position.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, uint64_t Capacity>
+void
+mpsc_ring_end_push(Mpsc_Ring<T, Capacity> *ring, uint64_t position)
+{
+    ring->cells[position & (Capacity - 1)].sequence.store(position + 1, std::memory_order_release);
+}
+
+///
+/// @return False if the ring is full, item isn't pushed then. Any thread.
+///
+template <typename T, uint64_t Capacity>
+bool
+mpsc_ring_push(Mpsc_Ring<T, Capacity> *ring, const T &item)
+{
+    uint64_t position = 0;
+    T *cell_item = mpsc_ring_begin_push(ring, &position);
+
+    if (cell_item == nullptr) {
+        return false;
+    }
+
+    *cell_item = item;
+    mpsc_ring_end_push(ring, position);
+    return true;
+}
+
+///
+/// @brief Calls `consume(const T &)` for every published item, in push order, and frees their cells. Consumer only.
+///
+/// @return Count of consumed items.
+///
+template <typename T, uint64_t Capacity, typename Consume>
+uint64_t
+mpsc_ring_drain(Mpsc_Ring<T, Capacity> *ring, Consume &&consume)
+{
+    uint64_t count = 0;
+
+    for (;;) {
+        auto &cell = ring->cells[ring->read_position & (Capacity - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != ring->read_position + 1) {
+            break;
+        }
+
+        consume(static_cast<const T &>(cell.item));
+
+        cell.sequence.store(ring->read_position + Capacity, std::memory_order_release);
+        ring->read_position++;
+        ++count;
+    }
+
+    return count;
+}
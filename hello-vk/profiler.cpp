@@ -0,0 +1,453 @@
+#include "stdafx.h"
+
+#include "defer.h"
+#include "vk_device.h"
+#include "mpsc_ring.h"
+#include "profiler.h"
+
+static std::atomic<uint32_t> s_profiler_threads_count = 0;
+
+static uint32_t
+profiler_thread_id(void)
+{
+    // NOTE(gr3yknigh1): Small sequential ids read better in trace viewers than `std::thread::id` hashes. [2025/03/29]
+    thread_local uint32_t thread_id = s_profiler_threads_count.fetch_add(1, std::memory_order_relaxed);
+    return thread_id;
+}
+
+void
+profiler_init(Profiler *profiler, size_t max_samples_count)
+{
+    mpsc_ring_init(&profiler->ring);
+
+    profiler->dropped_count = 0;
+    profiler->frequency = SDL_GetPerformanceFrequency();
+    profiler->start_counter = SDL_GetPerformanceCounter();
+    profiler->frame_number = 0;
+
+    profiler->samples.clear();
+    profiler->max_samples_count = max_samples_count;
+}
+
+void
+profiler_destroy(Profiler *profiler)
+{
+    if (profiler->dropped_count > 0) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION, "Profiler: %llu samples dropped",
+            static_cast<unsigned long long>(profiler->dropped_count.load()));
+    }
+
+    mpsc_ring_destroy(&profiler->ring);
+    profiler->samples.clear();
+    profiler->samples.shrink_to_fit();
+}
+
+uint64_t
+profiler_now_ns(const Profiler *profiler)
+{
+    uint64_t ticks = SDL_GetPerformanceCounter() - profiler->start_counter;
+
+    // NOTE(gr3yknigh1): Split to not overflow `ticks * 1e9` on long runs with high frequency counters. [2025/03/29]
+    uint64_t seconds = ticks / profiler->frequency;
+    uint64_t remainder = ticks % profiler->frequency;
+    return seconds * 1000000000ull + remainder * 1000000000ull / profiler->frequency;
+}
+
+void
+profiler_push(Profiler *profiler, const Profile_Sample &sample)
+{
+    if (!mpsc_ring_push(&profiler->ring, sample)) {
+        profiler->dropped_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void
+profiler_collect(Profiler *profiler)
+{
+    mpsc_ring_drain(&profiler->ring, [profiler](const Profile_Sample &sample) {
+        if (profiler->samples.size() < profiler->max_samples_count) {
+            profiler->samples.push_back(sample);
+        } else {
+            profiler->dropped_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+}
+
+void
+profiler_log_summary(const Profiler *profiler)
+{
+    struct Scope_Summary {
+        const char         *name = nullptr;
+        Profile_Sample_Kind kind = Profile_Sample_Kind::Cpu;
+        uint64_t            count = 0;
+        uint64_t            total_ns = 0;
+        uint64_t            max_ns = 0;
+    };
+
+    std::vector<Scope_Summary> summaries;
+
+    for (const auto &sample : profiler->samples) {
+        auto it = std::find_if(summaries.begin(), summaries.end(), [&sample](const Scope_Summary &summary) {
+            return summary.kind == sample.kind && strcmp(summary.name, sample.name) == 0;
+        });
+
+        if (it == summaries.end()) {
+            summaries.push_back(Scope_Summary{ sample.name, sample.kind });
+            it = summaries.end() - 1;
+        }
+
+        uint64_t duration_ns = sample.end_ns - sample.begin_ns;
+        it->count++;
+        it->total_ns += duration_ns;
+        it->max_ns = std::max(it->max_ns, duration_ns);
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Profiler: %zu samples", profiler->samples.size());
+
+    for (const auto &summary : summaries) {
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "    %s %-24s avg %8.3f ms, max %8.3f ms, %llu samples",
+            summary.kind == Profile_Sample_Kind::Gpu ? "GPU" : "CPU", summary.name,
+            static_cast<double>(summary.total_ns) / summary.count / 1e6, static_cast<double>(summary.max_ns) / 1e6,
+            static_cast<unsigned long long>(summary.count));
+    }
+}
+
+static bool
+profiler_write_file(const char *file_path, const std::string &content)
+{
+    SDL_RWops *file = SDL_RWFromFile(file_path, "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RWFromFile(%s) = %s", file_path, SDL_GetError());
+        return false;
+    }
+    defer(SDL_RWclose(file));
+
+    return SDL_RWwrite(file, content.data(), 1, content.size()) == content.size();
+}
+
+bool
+profiler_export_chrome_trace(const Profiler *profiler, const char *file_path)
+{
+    std::string content;
+    content.reserve(profiler->samples.size() * 128 + 256);
+
+    char line[512] = {};
+
+    // NOTE(gr3yknigh1): CPU and GPU are separate processes in the viewer, so GPU gets its own track group. [2025/03/29]
+    content += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    content += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+    content += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+    for (const auto &sample : profiler->samples) {
+        bool is_gpu = sample.kind == Profile_Sample_Kind::Gpu;
+
+        snprintf(
+            line, sizeof(line),
+            ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u,\"args\":{\"frame\":%llu}}",
+            sample.name, is_gpu ? "gpu" : "cpu", static_cast<double>(sample.begin_ns) / 1000.0,
+            static_cast<double>(sample.end_ns - sample.begin_ns) / 1000.0, is_gpu ? 2 : 1, sample.thread_id,
+            static_cast<unsigned long long>(sample.frame_number));
+        content += line;
+    }
+
+    content += "\n]}\n";
+
+    if (!profiler_write_file(file_path, content)) {
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Profiler: Chrome trace written to %s", file_path);
+    return true;
+}
+
+bool
+profiler_export_csv(const Profiler *profiler, const char *file_path)
+{
+    std::string content;
+    content.reserve(profiler->samples.size() * 64 + 64);
+
+    char line[256] = {};
+
+    content += "kind,name,thread,frame,begin_us,duration_us\n";
+
+    for (const auto &sample : profiler->samples) {
+        snprintf(
+            line, sizeof(line), "%s,%s,%u,%llu,%.3f,%.3f\n",
+            sample.kind == Profile_Sample_Kind::Gpu ? "gpu" : "cpu", sample.name, sample.thread_id,
+            static_cast<unsigned long long>(sample.frame_number), static_cast<double>(sample.begin_ns) / 1000.0,
+            static_cast<double>(sample.end_ns - sample.begin_ns) / 1000.0);
+        content += line;
+    }
+
+    if (!profiler_write_file(file_path, content)) {
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Profiler: CSV written to %s", file_path);
+    return true;
+}
+
+Profile_Scope::Profile_Scope(Profiler *profiler, const char *name)
+    : profiler(profiler), name(name)
+{
+    if (profiler != nullptr) {
+        begin_ns = profiler_now_ns(profiler);
+    }
+}
+
+Profile_Scope::~Profile_Scope(void)
+{
+    if (profiler == nullptr) {
+        return;
+    }
+
+    Profile_Sample sample = {};
+    sample.name = name;
+    sample.begin_ns = begin_ns;
+    sample.end_ns = profiler_now_ns(profiler);
+    sample.frame_number = profiler->frame_number.load(std::memory_order_relaxed);
+    sample.thread_id = profiler_thread_id();
+    sample.kind = Profile_Sample_Kind::Cpu;
+
+    profiler_push(profiler, sample);
+}
+
+///
+/// @brief Writes a single timestamp on GPU and pairs it with CPU time around the wait.
+///
+static VkResult
+vk_profiler_calibrate(Profiler *profiler, VkQueue queue, uint32_t queue_index, VkQueryPool query_pool)
+{
+    VkDevice device = profiler->device;
+    VkResult result = VK_SUCCESS;
+
+    VkCommandPoolCreateInfo command_pool_create_info = {};
+    command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    command_pool_create_info.queueFamilyIndex = queue_index;
+
+    VkCommandPool command_pool = VK_NULL_HANDLE;
+    result = vkCreateCommandPool(device, &command_pool_create_info, nullptr, &command_pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    defer(vkDestroyCommandPool(device, command_pool, nullptr));
+
+    VkCommandBufferAllocateInfo allocate_info = {};
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = command_pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1;
+
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    result = vkAllocateCommandBuffers(device, &allocate_info, &command_buffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+    vkCmdResetQueryPool(command_buffer, query_pool, 0, 1);
+    vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool, 0);
+    vkEndCommandBuffer(command_buffer);
+
+    VkFenceCreateInfo fence_create_info = {};
+    fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkFence fence = VK_NULL_HANDLE;
+    result = vkCreateFence(device, &fence_create_info, nullptr, &fence);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    defer(vkDestroyFence(device, fence, nullptr));
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+
+    uint64_t cpu_before_ns = profiler_now_ns(profiler);
+
+    result = vkQueueSubmit(queue, 1, &submit_info, fence);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = vkWaitForFences(device, 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    uint64_t cpu_after_ns = profiler_now_ns(profiler);
+
+    uint64_t gpu_ticks = 0;
+    result = vkGetQueryPoolResults(
+        device, query_pool, 0, 1, sizeof(gpu_ticks), &gpu_ticks, sizeof(gpu_ticks), VK_QUERY_RESULT_64_BIT);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Timestamp was written somewhere between submit and wait return, midpoint is the best
+    // guess. Error is within submit latency (tens of microseconds), fine for frame-level timelines. Clocks may
+    // drift on long runs, VK_EXT_calibrated_timestamps would fix it. [2025/03/29]
+    //
+    uint64_t cpu_ns = cpu_before_ns + (cpu_after_ns - cpu_before_ns) / 2;
+    uint64_t gpu_ns = static_cast<uint64_t>(static_cast<double>(gpu_ticks & profiler->timestamp_mask) * profiler->timestamp_period);
+
+    profiler->gpu_offset_ns = static_cast<int64_t>(cpu_ns) - static_cast<int64_t>(gpu_ns);
+    return VK_SUCCESS;
+}
+
+VkResult
+vk_profiler_init_gpu(
+    Profiler *profiler, const Vk_Device_Capabilities &capabilities, VkDevice device, VkQueue queue, uint32_t queue_index,
+    uint32_t frames_count, uint32_t max_scopes_count)
+{
+    // NOTE(gr3yknigh1): Results are read into fixed array of 256 timestamps. [2025/03/29]
+    profiler->device = device;
+    profiler->is_gpu_enabled = false;
+    profiler->max_gpu_scopes_count = std::min(max_scopes_count, 128u);
+
+    const VkPhysicalDeviceLimits &limits = capabilities.properties.limits;
+
+    uint32_t valid_bits = capabilities.queue_families[queue_index].timestampValidBits;
+    if (valid_bits == 0 || limits.timestampPeriod == 0.0f) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Profiler: queue family %u has no timestamp support, GPU scopes disabled", queue_index);
+        return VK_SUCCESS;
+    }
+
+    profiler->timestamp_period = limits.timestampPeriod;
+    profiler->timestamp_mask = valid_bits >= 64 ? ~0ull : (1ull << valid_bits) - 1;
+
+    profiler->gpu_frames.resize(frames_count);
+    for (auto &frame : profiler->gpu_frames) {
+        VkQueryPoolCreateInfo create_info = {};
+        create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        create_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        create_info.queryCount = profiler->max_gpu_scopes_count * 2;
+
+        VkResult result = vkCreateQueryPool(device, &create_info, nullptr, &frame.query_pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        frame.scope_names.reserve(profiler->max_gpu_scopes_count);
+    }
+
+    VkResult result = vk_profiler_calibrate(profiler, queue, queue_index, profiler->gpu_frames[0].query_pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    profiler->is_gpu_enabled = true;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Profiler: GPU timestamps enabled, period %.3f ns, %u valid bits",
+        profiler->timestamp_period, valid_bits);
+    return VK_SUCCESS;
+}
+
+///
+/// @brief Pushes timestamps of frame's finished scopes as samples.
+///
+static void
+vk_profiler_read_frame(Profiler *profiler, Gpu_Profiler_Frame *frame)
+{
+    if (!frame->is_pending || frame->scope_names.empty()) {
+        return;
+    }
+
+    uint32_t queries_count = static_cast<uint32_t>(frame->scope_names.size()) * 2;
+
+    std::array<uint64_t, 256> ticks = {};
+    SDL_assert(queries_count <= ticks.size());
+
+    // NOTE(gr3yknigh1): No WAIT flag, frame's fence is already signaled, so results are available. [2025/03/29]
+    VkResult result = vkGetQueryPoolResults(
+        profiler->device, frame->query_pool, 0, queries_count, sizeof(uint64_t) * queries_count, ticks.data(),
+        sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+    if (result != VK_SUCCESS) {
+        return;
+    }
+
+    for (uint32_t scope = 0; scope < frame->scope_names.size(); ++scope) {
+        uint64_t begin_ticks = ticks[scope * 2 + 0] & profiler->timestamp_mask;
+        uint64_t end_ticks = ticks[scope * 2 + 1] & profiler->timestamp_mask;
+
+        Profile_Sample sample = {};
+        sample.name = frame->scope_names[scope];
+        sample.begin_ns = static_cast<uint64_t>(static_cast<int64_t>(begin_ticks * profiler->timestamp_period) + profiler->gpu_offset_ns);
+        sample.end_ns = sample.begin_ns + static_cast<uint64_t>((end_ticks - begin_ticks) * profiler->timestamp_period);
+        sample.frame_number = frame->frame_number;
+        sample.kind = Profile_Sample_Kind::Gpu;
+
+        profiler_push(profiler, sample);
+    }
+}
+
+void
+vk_profiler_destroy_gpu(Profiler *profiler)
+{
+    // NOTE(gr3yknigh1): Device is expected to be idle, so the last frames' results are collected too. [2025/03/29]
+    for (auto &frame : profiler->gpu_frames) {
+        vk_profiler_read_frame(profiler, &frame);
+        vkDestroyQueryPool(profiler->device, frame.query_pool, nullptr);
+    }
+
+    profiler->gpu_frames.clear();
+    profiler->is_gpu_enabled = false;
+}
+
+void
+vk_profiler_begin_frame(Profiler *profiler, uint32_t frame_index, VkCommandBuffer command_buffer, uint64_t frame_number)
+{
+    if (profiler == nullptr || !profiler->is_gpu_enabled) {
+        return;
+    }
+
+    Gpu_Profiler_Frame &frame = profiler->gpu_frames[frame_index];
+    vk_profiler_read_frame(profiler, &frame);
+
+    vkCmdResetQueryPool(command_buffer, frame.query_pool, 0, profiler->max_gpu_scopes_count * 2);
+
+    frame.scope_names.clear();
+    frame.frame_number = frame_number;
+    frame.is_pending = true;
+}
+
+uint32_t
+vk_profiler_begin_scope(Profiler *profiler, uint32_t frame_index, VkCommandBuffer command_buffer, const char *name)
+{
+    if (profiler == nullptr || !profiler->is_gpu_enabled) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+
+    Gpu_Profiler_Frame &frame = profiler->gpu_frames[frame_index];
+    if (frame.scope_names.size() >= profiler->max_gpu_scopes_count) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+
+    uint32_t scope = static_cast<uint32_t>(frame.scope_names.size());
+    frame.scope_names.push_back(name);
+
+    vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.query_pool, scope * 2);
+    return scope;
+}
+
+void
+vk_profiler_end_scope(Profiler *profiler, uint32_t frame_index, VkCommandBuffer command_buffer, uint32_t scope)
+{
+    if (scope == std::numeric_limits<uint32_t>::max()) {
+        return;
+    }
+
+    Gpu_Profiler_Frame &frame = profiler->gpu_frames[frame_index];
+    vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.query_pool, scope * 2 + 1);
+}
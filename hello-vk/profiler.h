@@ -0,0 +1,121 @@
+#pragma once
+///
+/// @brief CPU scopes and GPU timestamp queries, collected into one timeline and exported as Chrome trace
+/// (chrome://tracing, Perfetto) or CSV.
+///
+/// Any thread pushes samples into lock-free bounded ring, the thread which renders frames drains it once per frame.
+/// GPU timestamps are read back when frame's fence is already signaled, so reading never stalls.
+///
+
+enum class Profile_Sample_Kind : uint8_t {
+    Cpu,
+    Gpu,
+};
+
+struct Profile_Sample {
+    const char *name         = nullptr; // Must outlive profiler, string literals are expected.
+    uint64_t    begin_ns     = 0;
+    uint64_t    end_ns       = 0;
+    uint64_t    frame_number = 0;
+    uint32_t    thread_id    = 0;
+
+    Profile_Sample_Kind kind = Profile_Sample_Kind::Cpu;
+};
+
+struct Gpu_Profiler_Frame {
+    VkQueryPool query_pool = VK_NULL_HANDLE;
+
+    std::vector<const char *> scope_names;
+    uint64_t frame_number = 0;
+    bool     is_pending   = false; // Queries are written by submitted command buffer.
+};
+
+// NOTE(gr3yknigh1): Enough for a few frames of every thread's scopes between two collects. [2025/03/29]
+constexpr uint64_t s_profile_ring_capacity = 1 << 16;
+
+struct Profiler {
+    Mpsc_Ring<Profile_Sample, s_profile_ring_capacity> ring;
+    std::atomic<uint64_t> dropped_count = 0;
+
+    uint64_t start_counter = 0;
+    uint64_t frequency     = 0;
+
+    // NOTE(gr3yknigh1): Stamped into every CPU sample. Written by the rendering thread, read by others. [2025/03/29]
+    std::atomic<uint64_t> frame_number = 0;
+
+    // NOTE(gr3yknigh1): Drained samples, kept for export. Capped, so long runs don't grow forever. [2025/03/29]
+    std::vector<Profile_Sample> samples;
+    size_t                      max_samples_count = 0;
+
+    //
+    // GPU:
+    //
+    VkDevice device           = VK_NULL_HANDLE;
+    bool     is_gpu_enabled   = false;
+    double   timestamp_period = 0.0; // Nanoseconds per tick.
+    uint64_t timestamp_mask   = 0;
+    int64_t  gpu_offset_ns    = 0;   // GPU time + offset = profiler time.
+
+    std::vector<Gpu_Profiler_Frame> gpu_frames;
+    uint32_t                        max_gpu_scopes_count = 0;
+};
+
+void profiler_init(Profiler *profiler, size_t max_samples_count);
+void profiler_destroy(Profiler *profiler);
+
+uint64_t profiler_now_ns(const Profiler *profiler);
+
+///
+/// @brief Thread safe, lock-free. Sample is dropped (and counted) if ring is full.
+///
+void profiler_push(Profiler *profiler, const Profile_Sample &sample);
+
+///
+/// @brief Drains ring into `profiler->samples`. Only one thread at a time, the one which renders frames.
+///
+void profiler_collect(Profiler *profiler);
+
+void profiler_log_summary(const Profiler *profiler);
+bool profiler_export_chrome_trace(const Profiler *profiler, const char *file_path);
+bool profiler_export_csv(const Profiler *profiler, const char *file_path);
+
+///
+/// @brief Measures CPU time between construction and destruction. Does nothing if `profiler` is nullptr.
+///
+struct Profile_Scope {
+    Profiler   *profiler = nullptr;
+    const char *name     = nullptr;
+    uint64_t    begin_ns = 0;
+
+    Profile_Scope(Profiler *profiler, const char *name);
+    ~Profile_Scope(void);
+};
+
+#define PROFILE_1(x, y) x##y
+#define PROFILE_2(x, y) PROFILE_1(x, y)
+#define profile_scope(profiler, name) Profile_Scope PROFILE_2(_profile_scope_, __COUNTER__)(profiler, name)
+
+///
+/// @brief Creates timestamp query pool per frame in flight and calibrates GPU clock against CPU one with a single
+/// blocking submit.
+///
+/// @note GPU profiling is left disabled (not an error) if queue family has no timestamp support.
+///
+VkResult vk_profiler_init_gpu(
+    Profiler *profiler, const Vk_Device_Capabilities &capabilities, VkDevice device, VkQueue queue, uint32_t queue_index,
+    uint32_t frames_count, uint32_t max_scopes_count);
+void vk_profiler_destroy_gpu(Profiler *profiler);
+
+///
+/// @brief Reads results of the previous use of `frame_index` slot and resets its queries. Frame's fence must be
+/// already waited. Must be recorded outside of render pass.
+///
+/// @note GPU scope functions do nothing if `profiler` is nullptr.
+///
+void vk_profiler_begin_frame(Profiler *profiler, uint32_t frame_index, VkCommandBuffer command_buffer, uint64_t frame_number);
+
+///
+/// @return Scope index for `vk_profiler_end_scope`, UINT32_MAX if GPU profiling is disabled or out of queries.
+///
+uint32_t vk_profiler_begin_scope(Profiler *profiler, uint32_t frame_index, VkCommandBuffer command_buffer, const char *name);
+void vk_profiler_end_scope(Profiler *profiler, uint32_t frame_index, VkCommandBuffer command_buffer, uint32_t scope);
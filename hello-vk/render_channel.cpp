@@ -0,0 +1,148 @@
+#include "stdafx.h"
+
+#include "spsc_queue.h"
+#include "render_channel.h"
+
+bool
+render_channel_init(Render_Channel *channel)
+{
+    channel->pump_event_type = SDL_RegisterEvents(1);
+
+    if (channel->pump_event_type == static_cast<uint32_t>(-1)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RegisterEvents() = %s", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+static void
+render_channel_wake_event_thread(Render_Channel *channel, uint64_t number)
+{
+    SDL_Event event = {};
+    event.type = channel->pump_event_type;
+    event.user.data1 = reinterpret_cast<void *>(static_cast<uintptr_t>(number));
+
+    // NOTE(gr3yknigh1): Thread-safe, and wakes up `SDL_WaitEvent` of the event thread. [2025/04/14]
+    if (SDL_PushEvent(&event) < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "SDL_PushEvent() = %s", SDL_GetError());
+    }
+}
+
+void
+render_channel_stop(Render_Channel *channel)
+{
+    channel->should_stop.store(true);
+
+    {
+        std::lock_guard<std::mutex> lock(channel->mutex);
+    }
+    channel->condition.notify_all();
+
+    if (channel->pump_event_type != 0) {
+        render_channel_wake_event_thread(channel, 0);
+    }
+}
+
+bool
+render_channel_push(Render_Channel *channel, const Render_Input &input)
+{
+    if (!spsc_queue_push(&channel->inputs, input)) {
+        return false;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Taking the mutex before notifying makes sure render thread is either before its check of
+    // the queue or already asleep, so the wake up isn't lost. Inputs come at human rate, popping them stays lock-free.
+    // [2025/04/14]
+    //
+    {
+        std::lock_guard<std::mutex> lock(channel->mutex);
+    }
+    channel->condition.notify_all();
+    return true;
+}
+
+uint64_t
+render_channel_pump_number(const Render_Channel &channel, const SDL_Event &event)
+{
+    if (channel.pump_event_type == 0 || event.type != channel.pump_event_type) {
+        return 0;
+    }
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(event.user.data1));
+}
+
+void
+render_channel_pump_done(Render_Channel *channel, uint64_t number)
+{
+    {
+        std::lock_guard<std::mutex> lock(channel->mutex);
+        channel->pump_done_number = std::max(channel->pump_done_number, number);
+    }
+    channel->condition.notify_all();
+}
+
+bool
+render_channel_sync(Render_Channel *channel, uint32_t timeout_ms)
+{
+    uint64_t start_counter = SDL_GetPerformanceCounter();
+    uint64_t number = 0;
+
+    ++channel->syncs_count;
+
+    {
+        std::lock_guard<std::mutex> lock(channel->mutex);
+
+        if (channel->pump_done_number < channel->pump_requested_number) {
+            ++channel->late_syncs_count;
+            return false;
+        }
+
+        number = ++channel->pump_requested_number;
+    }
+
+    render_channel_wake_event_thread(channel, number);
+
+    bool is_pumped = false;
+    {
+        std::unique_lock<std::mutex> lock(channel->mutex);
+        is_pumped = channel->condition.wait_for(lock, std::chrono::milliseconds(timeout_ms), [channel, number] {
+            return channel->pump_done_number >= number || channel->should_stop.load();
+        });
+    }
+
+    channel->sync_wait_ticks += SDL_GetPerformanceCounter() - start_counter;
+
+    if (!is_pumped) {
+        ++channel->late_syncs_count;
+    }
+    return is_pumped;
+}
+
+bool
+render_channel_pop(Render_Channel *channel, Render_Input *input)
+{
+    return spsc_queue_pop(&channel->inputs, input);
+}
+
+void
+render_channel_wait_input(Render_Channel *channel)
+{
+    std::unique_lock<std::mutex> lock(channel->mutex);
+    channel->condition.wait(lock, [channel] {
+        return !spsc_queue_is_empty(channel->inputs) || channel->should_stop.load();
+    });
+}
+
+void
+render_channel_report_run(const Render_Channel &channel)
+{
+    if (channel.syncs_count == 0) {
+        return;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Render thread: waited for event thread %.3f ms/frame, %llu of %llu frames sampled input without it",
+        static_cast<double>(channel.sync_wait_ticks) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency())
+            / static_cast<double>(channel.syncs_count),
+        static_cast<unsigned long long>(channel.late_syncs_count), static_cast<unsigned long long>(channel.syncs_count));
+}
@@ -0,0 +1,97 @@
+#pragma once
+///
+/// @brief Link between the event thread, which owns the window and pumps SDL events, and the render thread.
+///
+/// Event thread turns window events into inputs and pushes them into a lock-free queue, render thread drains it once
+/// per frame and never touches SDL event or window functions. Window manager stalling the event thread (modal
+/// move/resize loop, slow event handling) then stalls only the event thread, rendering goes on.
+///
+/// Frame pacing handshake: right before frame samples input, render thread asks event thread to pump (by an SDL
+/// user event, which wakes it up) and waits for the answer for a bounded time. So every frame sees events which
+/// arrived before it started, and input latency is bounded by the timeout when event thread is late. While previous
+/// request is unanswered, no new one is made and render thread doesn't wait at all.
+///
+/// @note One event thread and one render thread, inputs queue is single-producer single-consumer.
+///
+
+enum class Render_Input_Kind : uint8_t {
+    Resized, // Drawable size changed, `width` and `height` hold the new one.
+    Minimized,
+    Restored,
+    Next_Present_Mode,
+};
+
+struct Render_Input {
+    Render_Input_Kind kind   = Render_Input_Kind::Resized;
+    int32_t           width  = 0;
+    int32_t           height = 0;
+};
+
+struct Render_Channel {
+    Spsc_Queue<Render_Input, 256> inputs; // Event thread to render thread.
+
+    std::atomic<bool> should_stop = false; // Set by either thread via `render_channel_stop`.
+
+    uint32_t pump_event_type = 0; // SDL user event which asks event thread to pump.
+
+    std::mutex              mutex;
+    std::condition_variable condition;
+
+    // NOTE(gr3yknigh1): Guarded by `mutex`. Request numbers only grow, 0 is no request. [2025/04/14]
+    uint64_t pump_requested_number = 0;
+    uint64_t pump_done_number      = 0;
+
+    // NOTE(gr3yknigh1): Render thread only. [2025/04/14]
+    uint64_t syncs_count      = 0;
+    uint64_t late_syncs_count = 0; // Frames which sampled input without waiting for the event thread.
+    uint64_t sync_wait_ticks  = 0;
+};
+
+///
+/// @brief Registers SDL user event of the channel. Call after `SDL_Init`.
+///
+bool render_channel_init(Render_Channel *channel);
+
+///
+/// @brief Stops both threads: render thread sees it before the next frame, event thread is woken up.
+///
+void render_channel_stop(Render_Channel *channel);
+
+//
+// Event thread:
+//
+
+///
+/// @return False if the queue is full, so render thread is far behind. Push the input again later.
+///
+bool render_channel_push(Render_Channel *channel, const Render_Input &input);
+
+///
+/// @return Number of pump request carried by `event`, 0 if it isn't one.
+///
+uint64_t render_channel_pump_number(const Render_Channel &channel, const SDL_Event &event);
+
+///
+/// @brief Answers pump request `number`. Call once events which arrived before the request are pushed.
+///
+void render_channel_pump_done(Render_Channel *channel, uint64_t number);
+
+//
+// Render thread:
+//
+
+///
+/// @brief Frame pacing handshake, see above. Call right before input is sampled.
+///
+/// @return False if event thread didn't pump in `timeout_ms` or hasn't answered the previous request yet.
+///
+bool render_channel_sync(Render_Channel *channel, uint32_t timeout_ms);
+
+bool render_channel_pop(Render_Channel *channel, Render_Input *input);
+
+///
+/// @brief Sleeps until there is an input or channel is stopped. Used while there is nothing to render to.
+///
+void render_channel_wait_input(Render_Channel *channel);
+
+void render_channel_report_run(const Render_Channel &channel);
@@ -0,0 +1,137 @@
+#include "stdafx.h"
+
+#include "mapped_file.h"
+#include "scene_format.h"
+#include "scene.h"
+
+///
+/// @brief Finds the only section of `kind` and checks it lies inside the file and holds whole elements.
+///
+static bool
+scene_find_section(
+    const Scene *scene, const Scene_Section *sections, uint32_t sections_count, Scene_Section_Kind kind,
+    uint64_t element_size, const uint8_t **data, uint64_t *size)
+{
+    const Scene_Section *found = nullptr;
+
+    for (uint32_t index = 0; index < sections_count; ++index) {
+        if (sections[index].kind != kind) {
+            continue;
+        }
+        if (found != nullptr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene: section %u is duplicated", static_cast<uint32_t>(kind));
+            return false;
+        }
+        found = &sections[index];
+    }
+
+    if (found == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene: section %u is missing", static_cast<uint32_t>(kind));
+        return false;
+    }
+
+    if (found->offset % s_scene_section_alignment != 0 || found->offset > scene->file.size
+        || found->size > scene->file.size - found->offset || found->size % element_size != 0) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION, "Scene: section %u is out of file bounds or misaligned", static_cast<uint32_t>(kind));
+        return false;
+    }
+
+    *data = scene->file.data + found->offset;
+    *size = found->size;
+    return true;
+}
+
+static bool
+scene_validate_meshes(const Scene *scene)
+{
+    for (uint32_t index = 0; index < scene->meshes_count; ++index) {
+        const Scene_Mesh &mesh = scene->meshes[index];
+
+        bool is_valid = (mesh.index_size == 2 || mesh.index_size == 4)
+            && mesh.indices_offset % 4 == 0
+            && mesh.indices_count % 3 == 0
+            && static_cast<uint64_t>(mesh.first_vertex) + mesh.vertices_count <= scene->vertices_count
+            && mesh.indices_offset <= scene->indices_size
+            && static_cast<uint64_t>(mesh.indices_count) * mesh.index_size <= scene->indices_size - mesh.indices_offset
+            && static_cast<uint64_t>(mesh.first_meshlet) + mesh.meshlets_count <= scene->meshlets_count;
+
+        if (!is_valid) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene: mesh %u has invalid ranges", index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+scene_open(const char *path, Scene *scene)
+{
+    *scene = {};
+
+    if (!mapped_file_open(path, &scene->file)) {
+        return false;
+    }
+
+    const Scene_Header *header = reinterpret_cast<const Scene_Header *>(scene->file.data);
+
+    bool is_header_valid = scene->file.size >= sizeof(Scene_Header)
+        && header->magic == s_scene_magic
+        && header->version == s_scene_version
+        && header->file_size == scene->file.size
+        && header->sections_offset % alignof(Scene_Section) == 0
+        && header->sections_offset <= scene->file.size
+        && static_cast<uint64_t>(header->sections_count) * sizeof(Scene_Section) <= scene->file.size - header->sections_offset;
+
+    if (!is_header_valid) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION, "Scene: %s isn't a scene of version %u, or it is truncated", path, s_scene_version);
+        scene_close(scene);
+        return false;
+    }
+
+    const Scene_Section *sections = reinterpret_cast<const Scene_Section *>(scene->file.data + header->sections_offset);
+
+    const uint8_t *meshes = nullptr;
+    const uint8_t *vertices = nullptr;
+    const uint8_t *meshlets = nullptr;
+    uint64_t meshes_size = 0;
+    uint64_t vertices_size = 0;
+    uint64_t meshlets_size = 0;
+
+    uint32_t count = header->sections_count;
+
+    bool are_sections_valid =
+        scene_find_section(scene, sections, count, Scene_Section_Kind::Meshes, sizeof(Scene_Mesh), &meshes, &meshes_size)
+        && scene_find_section(scene, sections, count, Scene_Section_Kind::Vertices, sizeof(Scene_Vertex), &vertices, &vertices_size)
+        && scene_find_section(scene, sections, count, Scene_Section_Kind::Indices, 1, &scene->indices, &scene->indices_size)
+        && scene_find_section(scene, sections, count, Scene_Section_Kind::Meshlets, sizeof(Scene_Meshlet), &meshlets, &meshlets_size);
+
+    if (!are_sections_valid || meshes_size / sizeof(Scene_Mesh) > std::numeric_limits<uint32_t>::max()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene: %s has invalid sections", path);
+        scene_close(scene);
+        return false;
+    }
+
+    scene->meshes = reinterpret_cast<const Scene_Mesh *>(meshes);
+    scene->meshes_count = static_cast<uint32_t>(meshes_size / sizeof(Scene_Mesh));
+    scene->vertices = reinterpret_cast<const Scene_Vertex *>(vertices);
+    scene->vertices_count = vertices_size / sizeof(Scene_Vertex);
+    scene->meshlets = reinterpret_cast<const Scene_Meshlet *>(meshlets);
+    scene->meshlets_count = meshlets_size / sizeof(Scene_Meshlet);
+
+    if (!scene_validate_meshes(scene)) {
+        scene_close(scene);
+        return false;
+    }
+
+    return true;
+}
+
+void
+scene_close(Scene *scene)
+{
+    mapped_file_close(&scene->file);
+    *scene = {};
+}
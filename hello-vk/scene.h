@@ -0,0 +1,36 @@
+#pragma once
+///
+/// @brief Scene file of `scene_format.h`, mapped into memory. Opening validates header, sections and mesh ranges, the
+/// streams themselves are never parsed: pointers below point straight into the mapping.
+///
+/// @note Index values aren't checked, that would read every page of the file just to open it. Files are expected
+/// to come from scene-convert.
+///
+
+struct Scene {
+    Mapped_File file;
+
+    const Scene_Mesh *meshes       = nullptr;
+    uint32_t          meshes_count = 0;
+
+    const Scene_Vertex *vertices       = nullptr;
+    uint64_t            vertices_count = 0;
+
+    const uint8_t *indices      = nullptr;
+    uint64_t       indices_size = 0; // Bytes, index size differs per mesh.
+
+    const Scene_Meshlet *meshlets       = nullptr;
+    uint64_t             meshlets_count = 0;
+};
+
+bool scene_open(const char *path, Scene *scene);
+void scene_close(Scene *scene);
+
+///
+/// @return Offset of `pointer` inside the mapping, for `mapped_file_will_read`.
+///
+inline uint64_t
+scene_offset_of(const Scene *scene, const void *pointer)
+{
+    return static_cast<uint64_t>(static_cast<const uint8_t *>(pointer) - scene->file.data);
+}
@@ -0,0 +1,81 @@
+#pragma once
+///
+/// @brief Binary scene format. Written offline by scene-convert, mapped by the app and used as is.
+///
+/// File is `Scene_Header`, table of `Scene_Section` and the sections. Every section starts at
+/// `s_scene_section_alignment`, so mapped sections are page aligned and go to staging memory with a plain copy: vertex
+/// stream is already in the layout of vertex input, index stream in the one of index buffer. Integers are
+/// little-endian.
+///
+/// Meshes are laid out in order, the first one starts at offset 0 of both streams. Index buffer of a mesh is ordered
+/// by its meshlets, so cluster culling (or mesh shaders) can consume it without reordering.
+///
+/// @note Included by scene-convert, which is built without stdafx.h: only <stdint.h> types are used here.
+///
+
+constexpr uint32_t s_scene_magic   = 0x534B5648; // "HVKS"
+constexpr uint32_t s_scene_version = 1;
+
+// NOTE(gr3yknigh1): Page size, so mapped sections can be prefetched and evicted on their own. [2025/04/11]
+constexpr uint64_t s_scene_section_alignment = 4096;
+
+// NOTE(gr3yknigh1): Limits commonly recommended for mesh shaders, meshlet fits in one workgroup. [2025/04/11]
+constexpr uint32_t s_scene_meshlet_vertices_max  = 64;
+constexpr uint32_t s_scene_meshlet_triangles_max = 124;
+
+enum class Scene_Section_Kind : uint32_t {
+    Meshes   = 1, // Scene_Mesh[]
+    Vertices = 2, // Scene_Vertex[] of all meshes.
+    Indices  = 3, // Indices of all meshes, each mesh starts at 4-byte boundary.
+    Meshlets = 4, // Scene_Meshlet[] of all meshes.
+};
+
+struct Scene_Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t file_size; // Truncated files are rejected.
+    uint32_t sections_count;
+    uint32_t sections_offset;
+    uint32_t reserved[2];
+};
+
+struct Scene_Section {
+    Scene_Section_Kind kind;
+    uint32_t           reserved;
+    uint64_t           offset;
+    uint64_t           size;
+};
+
+///
+/// @brief Pre-quantized vertex: 8 bytes instead of 20 of floats.
+///
+struct Scene_Vertex {
+    int16_t position[2]; // SNORM, mesh positions divided by mesh's `position_scale`.
+    uint8_t color[4];    // UNORM, alpha is unused.
+};
+
+struct Scene_Mesh {
+    uint32_t first_vertex;   // In Vertices section. Indices are relative to it.
+    uint32_t vertices_count;
+    uint64_t indices_offset; // Bytes, in Indices section.
+    uint32_t indices_count;
+    uint32_t index_size;     // 2 or 4 bytes.
+    uint32_t first_meshlet;  // In Meshlets section.
+    uint32_t meshlets_count;
+    float    position_scale; // Dequantization scale of positions.
+    float    radius;         // Bounding circle around origin, in units of SNORM positions.
+};
+
+struct Scene_Meshlet {
+    uint32_t first_index;     // In mesh's indices.
+    uint32_t triangles_count;
+    uint32_t vertices_count;  // Distinct vertices referenced by the meshlet.
+    float    center[2];       // Bounding circle, in units of SNORM positions.
+    float    radius;
+};
+
+static_assert(sizeof(Scene_Header) == 32);
+static_assert(sizeof(Scene_Section) == 24);
+static_assert(sizeof(Scene_Vertex) == 8);
+static_assert(sizeof(Scene_Mesh) == 40);
+static_assert(sizeof(Scene_Meshlet) == 24);
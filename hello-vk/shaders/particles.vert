@@ -0,0 +1,20 @@
+#version 450
+
+struct Particle {
+    vec2 position;
+    vec2 velocity;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Particles {
+    Particle particles[];
+};
+
+layout(location = 0) out vec3 out_color;
+
+void main() {
+    Particle particle = particles[gl_VertexIndex];
+
+    gl_Position = vec4(particle.position, 0.0, 1.0);
+    gl_PointSize = 1.0;
+    out_color = mix(vec3(1.0, 0.6, 0.2), vec3(0.2, 0.6, 1.0), clamp(length(particle.velocity), 0.0, 1.0));
+}
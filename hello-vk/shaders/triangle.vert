@@ -0,0 +1,35 @@
+#version 450
+
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec3 in_color;
+
+// NOTE(gr3yknigh1): Storage buffers of the bindless table, sized by `vk_bindless_specialization`. [2025/04/17]
+layout(constant_id = 1) const uint s_bindless_buffers_capacity = 1;
+
+// NOTE(gr3yknigh1): Scalars only, so the stride is 12 bytes, the same as of `Draw_Command`. [2025/04/17]
+struct Draw {
+    float offset_x;
+    float offset_y;
+    float scale;
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer Draws {
+    Draw draws[];
+} bindless_buffers[s_bindless_buffers_capacity];
+
+layout(push_constant) uniform Draw_Push_Constants {
+    uint draws_buffer; // Bindless index of the buffer with draws.
+    uint draw;
+    layout(offset = 16) vec2 camera_position; // NOTE(gr3yknigh1): See `s_camera_push_constant_offset`. [2025/04/01]
+    float camera_zoom;
+} push;
+
+layout(location = 0) out vec3 out_color;
+
+void main() {
+    Draw draw = bindless_buffers[push.draws_buffer].draws[push.draw];
+    vec2 position = in_position * draw.scale + vec2(draw.offset_x, draw.offset_y);
+
+    gl_Position = vec4((position - push.camera_position) * push.camera_zoom, 0.0, 1.0);
+    out_color = in_color;
+}
@@ -0,0 +1,31 @@
+#version 450
+
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec3 in_color;
+
+struct Object {
+    vec2  offset;
+    float scale;
+    float radius;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer Objects {
+    Object objects[];
+};
+
+layout(push_constant) uniform Camera {
+    vec2  position;
+    float zoom;
+} camera;
+
+layout(location = 0) out vec3 out_color;
+
+void main() {
+    // NOTE(gr3yknigh1): Culling stores object index as `firstInstance` of its draw. Draw queue writes visible
+    // objects in sorted order and draws each batch from its first one. [2025/04/08]
+    Object object = objects[gl_InstanceIndex];
+    vec2 position = in_position * object.scale + object.offset;
+
+    gl_Position = vec4((position - camera.position) * camera.zoom, 0.0, 1.0);
+    out_color = in_color;
+}
@@ -0,0 +1,68 @@
+#pragma once
+///
+/// @brief Bounded lock-free queue between exactly one producer thread and one consumer thread.
+///
+/// Positions only grow, slot is `position % Capacity`. Producer owns write position and consumer owns read position,
+/// each reads the other's one to see how many slots are taken. Push and pop never block and never allocate.
+///
+
+template <typename T, uint32_t Capacity>
+struct Spsc_Queue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    std::array<T, Capacity> items = {};
+
+    // NOTE(gr3yknigh1): Separate cache lines, so producer and consumer don't bounce one line between cores. [2025/04/14]
+    alignas(64) std::atomic<uint64_t> write_position = 0;
+    alignas(64) std::atomic<uint64_t> read_position  = 0;
+};
+
+///
+/// @brief Producer only.
+///
+/// @return False if the queue is full, item isn't pushed then.
+///
+template <typename T, uint32_t Capacity>
+bool
+spsc_queue_push(Spsc_Queue<T, Capacity> *queue, const T &item)
+{
+    uint64_t write_position = queue->write_position.load(std::memory_order_relaxed);
+
+    if (write_position - queue->read_position.load(std::memory_order_acquire) == Capacity) {
+        return false;
+    }
+
+    queue->items[write_position % Capacity] = item;
+    queue->write_position.store(write_position + 1, std::memory_order_release);
+    return true;
+}
+
+///
+/// @brief Consumer only.
+///
+/// @return False if the queue is empty.
+///
+template <typename T, uint32_t Capacity>
+bool
+spsc_queue_pop(Spsc_Queue<T, Capacity> *queue, T *item)
+{
+    uint64_t read_position = queue->read_position.load(std::memory_order_relaxed);
+
+    if (read_position == queue->write_position.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    *item = queue->items[read_position % Capacity];
+    queue->read_position.store(read_position + 1, std::memory_order_release);
+    return true;
+}
+
+///
+/// @note Exact only on the consumer thread, elsewhere it is a snapshot.
+///
+template <typename T, uint32_t Capacity>
+bool
+spsc_queue_is_empty(const Spsc_Queue<T, Capacity> &queue)
+{
+    return queue.read_position.load(std::memory_order_acquire) == queue.write_position.load(std::memory_order_acquire);
+}
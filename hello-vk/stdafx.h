@@ -3,6 +3,9 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
 
 #include <array>
 #include <limits>
@@ -10,26 +13,45 @@
 #include <vector>
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <set>
+#include <filesystem>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 
 #if !defined(NOMINMAX)
     #define NOMINMAX
 #endif
 
-#define VK_USE_PLATFORM_WIN32_KHR
+// NOTE(gr3yknigh1): Surface is created by SDL, platform headers are only pulled in for Win32, where they are harmless.
+// CMake build defines platform itself, see HELLO_VK_PLATFORM. [2025/04/06]
+#if defined(_WIN32) && !defined(VK_USE_PLATFORM_WIN32_KHR)
+    #define VK_USE_PLATFORM_WIN32_KHR
+#endif
 #include <vulkan/vulkan.h>
 #include <vulkan/vk_enum_string_helper.h>
 
+// NOTE(gr3yknigh1): Startup calls Vulkan inside `SDL_assert`, which SDL compiles out in release by default. [2025/04/06]
+#if !defined(SDL_ASSERT_LEVEL)
+    #define SDL_ASSERT_LEVEL 2
+#endif
+
 #define SDL_MAIN_HANDLED
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
 
-#if defined(_DEBUG)
-#pragma comment(lib, "SDL2d.lib")
-#else
-#pragma comment(lib, "SDL2.lib")
-#endif
+// NOTE(gr3yknigh1): Visual Studio project links through these, CMake build links its targets itself. [2025/04/06]
+#if defined(_MSC_VER) && !defined(HELLO_VK_CMAKE_BUILD)
+    #if defined(_DEBUG)
+        #pragma comment(lib, "SDL2d.lib")
+    #else
+        #pragma comment(lib, "SDL2.lib")
+    #endif
 
-#pragma comment(lib, "vulkan-1.lib")
+    #pragma comment(lib, "vulkan-1.lib")
+#endif
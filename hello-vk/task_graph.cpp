@@ -0,0 +1,257 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "mpsc_ring.h"
+#include "profiler.h"
+#include "task_graph.h"
+
+uint32_t
+task_graph_add(
+    Task_Graph *graph, const char *name, Task_Function function, void *user_data,
+    const std::vector<uint32_t> &dependencies, bool is_main_thread)
+{
+    SDL_assert(!graph->is_started);
+
+    uint32_t index = static_cast<uint32_t>(graph->tasks.size());
+
+    Task task = {};
+    task.name = name;
+    task.function = function;
+    task.user_data = user_data;
+    task.is_main_thread = is_main_thread;
+
+    for (uint32_t dependency : dependencies) {
+        // NOTE(gr3yknigh1): Itself or a later task, the only way to make a cycle. Task would never become ready
+        // and waiting for the graph would hang, so it is skipped instead. [2025/04/16]
+        if (dependency >= index) {
+            SDL_LogError(
+                SDL_LOG_CATEGORY_APPLICATION, "Task graph: %s depends on task %u, which isn't added before it, it is skipped",
+                name, dependency);
+            task.is_skipped = true;
+            continue;
+        }
+
+        graph->tasks[dependency].dependents.push_back(index);
+        task.pending_dependencies_count++;
+    }
+
+    graph->tasks.push_back(std::move(task));
+    return index;
+}
+
+///
+/// @brief Records result of the task and releases its dependents. Graph's mutex must be held.
+///
+static void
+task_graph_finish(Task_Graph *graph, uint32_t index, Task_State state)
+{
+    Task &task = graph->tasks[index];
+    task.state = state;
+    ++graph->finished_count;
+
+    for (uint32_t dependent_index : task.dependents) {
+        Task &dependent = graph->tasks[dependent_index];
+        dependent.is_skipped = dependent.is_skipped || state != Task_State::Succeeded;
+
+        if (--dependent.pending_dependencies_count > 0) {
+            continue;
+        }
+
+        if (dependent.is_skipped) {
+            task_graph_finish(graph, dependent_index, Task_State::Skipped);
+        } else if (dependent.is_main_thread) {
+            graph->ready_main_tasks.push_back(dependent_index);
+        } else {
+            graph->ready_tasks.push_back(dependent_index);
+        }
+    }
+}
+
+static uint32_t
+task_graph_earliest(const std::vector<uint32_t> &ready)
+{
+    return ready.empty() ? UINT32_MAX : *std::min_element(ready.begin(), ready.end());
+}
+
+///
+/// @brief Takes the earliest added task of `ready`, so a single thread runs tasks in the order they were added.
+///
+static bool
+task_graph_pop(std::vector<uint32_t> *ready, uint32_t *index)
+{
+    if (ready->empty()) {
+        return false;
+    }
+
+    *index = task_graph_earliest(*ready);
+    ready->erase(std::find(ready->begin(), ready->end(), *index));
+    return true;
+}
+
+static void
+task_graph_execute(Task_Graph *graph, uint32_t index, uint32_t thread_index)
+{
+    // NOTE(gr3yknigh1): Tasks aren't added once graph is started, so the reference stays valid. [2025/04/13]
+    Task &task = graph->tasks[index];
+    task.thread_index = thread_index;
+    task.start_counter = SDL_GetPerformanceCounter();
+
+    bool is_succeeded = false;
+    {
+        profile_scope(graph->profiler, task.name);
+        is_succeeded = task.function(task.user_data);
+    }
+
+    task.end_counter = SDL_GetPerformanceCounter();
+
+    if (!is_succeeded) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Task graph: %s failed, tasks depending on it are skipped", task.name);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(graph->mutex);
+        task_graph_finish(graph, index, is_succeeded ? Task_State::Succeeded : Task_State::Failed);
+    }
+    graph->condition.notify_all();
+}
+
+static void
+task_graph_worker_main(Task_Graph *graph, uint32_t thread_index)
+{
+    for (;;) {
+        uint32_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(graph->mutex);
+            graph->condition.wait(lock, [graph] {
+                return !graph->ready_tasks.empty() || graph->finished_count == graph->tasks.size();
+            });
+
+            if (!task_graph_pop(&graph->ready_tasks, &index)) {
+                return;
+            }
+            graph->tasks[index].state = Task_State::Running;
+        }
+
+        task_graph_execute(graph, index, thread_index);
+    }
+}
+
+void
+task_graph_start(Task_Graph *graph, uint32_t workers_count, Profiler *profiler)
+{
+    SDL_assert(!graph->is_started);
+
+    graph->is_started = true;
+    graph->profiler = profiler;
+    graph->start_counter = SDL_GetPerformanceCounter();
+
+    {
+        // NOTE(gr3yknigh1): No workers yet, the lock is only there because `task_graph_finish` needs it. [2025/04/16]
+        std::lock_guard<std::mutex> lock(graph->mutex);
+
+        for (uint32_t index = 0; index < graph->tasks.size(); ++index) {
+            const Task &task = graph->tasks[index];
+
+            // NOTE(gr3yknigh1): Dependents of a skipped task may be finished by it already. [2025/04/16]
+            if (task.pending_dependencies_count != 0 || task.state != Task_State::Pending) {
+                continue;
+            }
+
+            if (task.is_skipped) {
+                task_graph_finish(graph, index, Task_State::Skipped);
+            } else {
+                (task.is_main_thread ? graph->ready_main_tasks : graph->ready_tasks).push_back(index);
+            }
+        }
+    }
+
+    // NOTE(gr3yknigh1): More workers than there are tasks would only sleep. [2025/04/13]
+    workers_count = std::min(workers_count, static_cast<uint32_t>(graph->tasks.size()));
+
+    for (uint32_t thread_index = 1; thread_index <= workers_count; ++thread_index) {
+        graph->workers.emplace_back(task_graph_worker_main, graph, thread_index);
+    }
+}
+
+bool
+task_graph_wait(Task_Graph *graph)
+{
+    if (graph->is_started && graph->end_counter == 0) {
+        for (;;) {
+            uint32_t index = 0;
+            {
+                std::unique_lock<std::mutex> lock(graph->mutex);
+                graph->condition.wait(lock, [graph] {
+                    return !graph->ready_tasks.empty() || !graph->ready_main_tasks.empty()
+                        || graph->finished_count == graph->tasks.size();
+                });
+
+                if (graph->finished_count == graph->tasks.size()) {
+                    break;
+                }
+
+                // NOTE(gr3yknigh1): Waiting thread helps with any task, not only with its own ones. [2025/04/13]
+                bool is_main_earlier = task_graph_earliest(graph->ready_main_tasks) < task_graph_earliest(graph->ready_tasks);
+                task_graph_pop(is_main_earlier ? &graph->ready_main_tasks : &graph->ready_tasks, &index);
+                graph->tasks[index].state = Task_State::Running;
+            }
+
+            task_graph_execute(graph, index, 0);
+        }
+
+        for (std::thread &worker : graph->workers) {
+            worker.join();
+        }
+
+        graph->end_counter = SDL_GetPerformanceCounter();
+    }
+
+    for (const Task &task : graph->tasks) {
+        if (task.state != Task_State::Succeeded) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+task_graph_run(Task_Graph *graph, uint32_t workers_count, Profiler *profiler)
+{
+    task_graph_start(graph, workers_count, profiler);
+    return task_graph_wait(graph);
+}
+
+void
+task_graph_log_report(const Task_Graph &graph, const char *title, uint64_t origin_counter)
+{
+    double ms_per_tick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    double tasks_ms = 0.0;
+    for (uint32_t index = 0; index < graph.tasks.size(); ++index) {
+        if (graph.tasks[index].state != Task_State::Skipped) {
+            tasks_ms += task_graph_task_ms(graph, index);
+        }
+    }
+
+    double wall_ms = static_cast<double>(graph.end_counter - graph.start_counter) * ms_per_tick;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Startup: %s took %.2f ms on %zu threads, tasks took %.2f ms together (%.2fx overlap)",
+        title, wall_ms, graph.workers.size() + 1, tasks_ms, wall_ms > 0.0 ? tasks_ms / wall_ms : 1.0);
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    %-24s %9s %9s %9s  %s", "task", "start ms", "end ms", "took ms", "thread (0 is main)");
+
+    for (uint32_t index = 0; index < graph.tasks.size(); ++index) {
+        const Task &task = graph.tasks[index];
+
+        if (task.state == Task_State::Skipped) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    %-24s %9s %9s %9s  skipped", task.name, "-", "-", "-");
+            continue;
+        }
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "    %-24s %9.2f %9.2f %9.2f  %u%s", task.name,
+            static_cast<double>(task.start_counter - origin_counter) * ms_per_tick,
+            static_cast<double>(task.end_counter - origin_counter) * ms_per_tick, task_graph_task_ms(graph, index),
+            task.thread_index, task.state == Task_State::Failed ? ", failed" : "");
+    }
+}
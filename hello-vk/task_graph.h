@@ -0,0 +1,106 @@
+#pragma once
+///
+/// @brief One-shot graph of dependent tasks, used to overlap independent parts of startup.
+///
+/// Task becomes ready once all of its dependencies succeeded. Ready tasks are run by short-lived worker threads and
+/// by the thread which waits for the graph, tasks marked `is_main_thread` only by the latter (window system calls
+/// have to be made from the main thread on some platforms). Task which fails skips everything depending on it, so
+/// the graph always finishes and the caller sees the first failure.
+///
+/// Graph is built up front: a task may depend only on tasks added before it, so there are no cycles. Task which
+/// depends on itself or on a later one is skipped, along with everything depending on it.
+///
+/// @note Tasks share state through their `user_data`. Field written by a task may be read by tasks depending on
+/// it, finishing a task publishes its writes to them.
+///
+
+using Task_Function = bool (*)(void *user_data);
+
+enum class Task_State {
+    Pending,
+    Running,
+    Succeeded,
+    Failed,
+    Skipped, // Some dependency failed, was skipped or wasn't added before the task.
+};
+
+struct Task {
+    const char   *name           = nullptr; // String literal, it is also profile scope name.
+    Task_Function function       = nullptr;
+    void         *user_data      = nullptr;
+    bool          is_main_thread = false;
+
+    std::vector<uint32_t> dependents;
+    uint32_t              pending_dependencies_count = 0;
+    bool                  is_skipped                 = false;
+
+    Task_State state = Task_State::Pending;
+
+    uint64_t start_counter = 0;
+    uint64_t end_counter   = 0;
+    uint32_t thread_index  = 0; // 0 is the waiting thread, workers are 1..N.
+};
+
+struct Task_Graph {
+    std::vector<Task> tasks;
+
+    Profiler *profiler = nullptr;
+
+    std::vector<std::thread> workers;
+
+    std::mutex              mutex;
+    std::condition_variable condition;
+
+    // NOTE(gr3yknigh1): Guarded by `mutex`. [2025/04/13]
+    std::vector<uint32_t> ready_tasks;
+    std::vector<uint32_t> ready_main_tasks;
+    uint32_t              finished_count = 0;
+
+    uint64_t start_counter = 0;
+    uint64_t end_counter   = 0;
+    bool     is_started    = false;
+};
+
+///
+/// @param dependencies Indices returned by previous calls.
+/// @param is_main_thread Task runs only on the thread which calls `task_graph_wait`.
+///
+/// @return Index of the task.
+///
+uint32_t task_graph_add(
+    Task_Graph *graph, const char *name, Task_Function function, void *user_data,
+    const std::vector<uint32_t> &dependencies = {}, bool is_main_thread = false);
+
+///
+/// @brief Spawns workers and lets them run ready tasks. Tasks can't be added after that.
+///
+/// @param workers_count 0 runs every task on the waiting thread, one by one, in the order they were added.
+/// @param profiler Optional, every task is recorded as its CPU scope.
+///
+void task_graph_start(Task_Graph *graph, uint32_t workers_count, Profiler *profiler);
+
+///
+/// @brief Runs ready tasks on the calling thread until the whole graph is finished, then joins workers. Does nothing
+/// if graph isn't started or is already waited for, so it may be deferred as a guard.
+///
+/// @return False if any task failed.
+///
+bool task_graph_wait(Task_Graph *graph);
+
+///
+/// @brief `task_graph_start` and `task_graph_wait` in one go.
+///
+bool task_graph_run(Task_Graph *graph, uint32_t workers_count, Profiler *profiler);
+
+inline double
+task_graph_task_ms(const Task_Graph &graph, uint32_t task)
+{
+    return static_cast<double>(graph.tasks[task].end_counter - graph.tasks[task].start_counter) * 1000.0
+        / static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
+///
+/// @brief Logs when every task started and ended relative to `origin_counter`, on which thread, and how much of
+/// the work overlapped.
+///
+void task_graph_log_report(const Task_Graph &graph, const char *title, uint64_t origin_counter);
@@ -0,0 +1,34 @@
+#pragma once
+///
+/// @brief Frames of the renderer as benchmarks of GPU modules see them.
+///
+/// Module's benchmark decides what happens around the frame and measures it, renderer records and submits the frame
+/// itself. So a module doesn't depend on how frames are built, and the renderer doesn't know what is measured.
+///
+/// @note Headless only: frames render into offscreen targets, nothing is presented.
+///
+
+struct Vk_Benchmark_Frame {
+    uint32_t               frame_index  = 0;       // Frame in flight.
+    uint64_t               frame_number = 0;       // Value graphics timeline gets on submit.
+    const Vk_Submit_Waits *waits        = nullptr; // Graphics submit waits for these. May be nullptr.
+    const Camera          *camera       = nullptr; // Replaces renderer's camera if not nullptr.
+};
+
+///
+/// @brief Blocks until the last submit of frame in flight `frame_index` is completed, so its resources can be reused.
+///
+typedef VkResult (*Vk_Benchmark_Wait_Proc)(void *user_data, uint32_t frame_index);
+
+///
+/// @brief Records the frame and submits it to graphics queue.
+///
+typedef VkResult (*Vk_Benchmark_Submit_Proc)(void *user_data, const Vk_Benchmark_Frame &frame);
+
+struct Vk_Benchmark_Frames {
+    uint32_t frames_count = 0; // In flight.
+
+    Vk_Benchmark_Wait_Proc   wait      = nullptr;
+    Vk_Benchmark_Submit_Proc submit    = nullptr;
+    void                    *user_data = nullptr;
+};
@@ -0,0 +1,424 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_bindless.h"
+
+constexpr uint32_t s_slot_bits       = 20;
+constexpr uint32_t s_slot_mask       = (1u << s_slot_bits) - 1;
+constexpr uint32_t s_generation_bits = 11;
+constexpr uint32_t s_generation_mask = (1u << s_generation_bits) - 1;
+constexpr uint32_t s_kind_shift      = s_slot_bits + s_generation_bits;
+
+// NOTE(gr3yknigh1): Pooled mode allocates sets in chunks, so pool creation doesn't show up per resource. [2025/04/02]
+constexpr uint32_t s_pooled_sets_per_pool = 64;
+
+static Vk_Bindless_Handle
+vk_bindless_make_handle(Vk_Bindless_Kind kind, uint32_t slot, uint16_t generation)
+{
+    Vk_Bindless_Handle handle = {};
+    handle.value = (static_cast<uint32_t>(kind) << s_kind_shift) | (static_cast<uint32_t>(generation) << s_slot_bits) | slot;
+    return handle;
+}
+
+static Vk_Bindless_Kind
+vk_bindless_handle_kind(Vk_Bindless_Handle handle)
+{
+    return static_cast<Vk_Bindless_Kind>(handle.value >> s_kind_shift);
+}
+
+static uint32_t
+vk_bindless_handle_slot(Vk_Bindless_Handle handle)
+{
+    return handle.value & s_slot_mask;
+}
+
+static uint16_t
+vk_bindless_handle_generation(Vk_Bindless_Handle handle)
+{
+    return static_cast<uint16_t>((handle.value >> s_slot_bits) & s_generation_mask);
+}
+
+bool
+vk_bindless_is_supported(const Vk_Device_Capabilities &capabilities)
+{
+    const VkPhysicalDeviceDescriptorIndexingFeatures &features = capabilities.descriptor_indexing_features;
+
+    return vk_device_has_extension(capabilities, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)
+        && vk_device_has_extension(capabilities, VK_KHR_MAINTENANCE_3_EXTENSION_NAME)
+        && capabilities.features.shaderSampledImageArrayDynamicIndexing
+        && capabilities.features.shaderStorageBufferArrayDynamicIndexing
+        && features.descriptorBindingSampledImageUpdateAfterBind
+        && features.descriptorBindingStorageBufferUpdateAfterBind
+        && features.descriptorBindingUpdateUnusedWhilePending
+        && features.descriptorBindingPartiallyBound;
+}
+
+void
+vk_bindless_fill_features(VkPhysicalDeviceDescriptorIndexingFeatures *features)
+{
+    *features = {};
+    features->sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+    features->descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    features->descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+    features->descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+    features->descriptorBindingPartiallyBound = VK_TRUE;
+}
+
+static VkResult
+vk_bindless_add_pool(Vk_Bindless_Table *table)
+{
+    std::array<VkDescriptorPoolSize, s_vk_bindless_kinds_count> pool_sizes = {};
+    pool_sizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    pool_sizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+
+    VkDescriptorPoolCreateInfo pool_create_info = {};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_create_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+    pool_create_info.pPoolSizes = pool_sizes.data();
+
+    if (table->is_bindless) {
+        pool_sizes[0].descriptorCount = table->slots[0].capacity;
+        pool_sizes[1].descriptorCount = table->slots[1].capacity;
+
+        pool_create_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        pool_create_info.maxSets = 1;
+    } else {
+        pool_sizes[0].descriptorCount = s_pooled_sets_per_pool;
+        pool_sizes[1].descriptorCount = s_pooled_sets_per_pool;
+
+        pool_create_info.maxSets = s_pooled_sets_per_pool;
+    }
+
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkResult result = vkCreateDescriptorPool(table->device, &pool_create_info, nullptr, &pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    table->descriptor_pools.push_back(pool);
+    table->pool_sets_left = pool_create_info.maxSets;
+
+    return VK_SUCCESS;
+}
+
+static VkResult
+vk_bindless_allocate_set(Vk_Bindless_Table *table, VkDescriptorSet *result)
+{
+    if (table->pool_sets_left == 0) {
+        VkResult pool_result = vk_bindless_add_pool(table);
+        if (pool_result != VK_SUCCESS) {
+            return pool_result;
+        }
+    }
+
+    VkDescriptorSetAllocateInfo set_allocate_info = {};
+    set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    set_allocate_info.descriptorPool = table->descriptor_pools.back();
+    set_allocate_info.descriptorSetCount = 1;
+    set_allocate_info.pSetLayouts = &table->set_layout;
+
+    table->pool_sets_left--;
+
+    return vkAllocateDescriptorSets(table->device, &set_allocate_info, result);
+}
+
+VkResult
+vk_bindless_init(
+    Vk_Bindless_Table *table, VkDevice device, const Vk_Device_Capabilities &capabilities, bool is_bindless,
+    uint32_t textures_capacity, uint32_t buffers_capacity)
+{
+    VkResult result = VK_SUCCESS;
+
+    table->device = device;
+    table->is_bindless = is_bindless;
+
+    if (is_bindless) {
+        const VkPhysicalDeviceDescriptorIndexingProperties &properties = capabilities.descriptor_indexing_properties;
+
+        // NOTE(gr3yknigh1): Bindings are visible to all stages, so per-stage limits apply as well. [2025/04/02]
+        textures_capacity = std::min({
+            textures_capacity, properties.maxDescriptorSetUpdateAfterBindSampledImages,
+            properties.maxDescriptorSetUpdateAfterBindSamplers, properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+            properties.maxPerStageDescriptorUpdateAfterBindSamplers });
+        buffers_capacity = std::min({
+            buffers_capacity, properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+            properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers });
+    }
+
+    std::array<uint32_t, s_vk_bindless_kinds_count> capacities = {
+        std::min(textures_capacity, s_slot_mask + 1), std::min(buffers_capacity, s_slot_mask + 1) };
+
+    for (uint32_t kind = 0; kind < s_vk_bindless_kinds_count; ++kind) {
+        Vk_Bindless_Slots &slots = table->slots[kind];
+
+        slots.capacity = capacities[kind];
+        slots.used_count = 0;
+        slots.generations.assign(slots.capacity, 1);
+        slots.free_slots.resize(slots.capacity);
+
+        for (uint32_t slot = 0; slot < slots.capacity; ++slot) {
+            slots.free_slots[slot] = slots.capacity - 1 - slot;
+        }
+
+        if (!is_bindless) {
+            slots.sets.assign(slots.capacity, VK_NULL_HANDLE);
+        }
+    }
+
+    //
+    // Set layout:
+    //
+    std::array<VkDescriptorSetLayoutBinding, s_vk_bindless_kinds_count> bindings = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[0].descriptorCount = is_bindless ? capacities[0] : 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = is_bindless ? capacities[1] : 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+    //
+    // NOTE(gr3yknigh1): Update-after-bind lets resources be added while the set is bound in recorded command buffers,
+    // partially bound lets most of the slots stay empty. Slots being read by frames in flight are never rewritten,
+    // see `vk_bindless_remove`. [2025/04/02]
+    //
+    std::array<VkDescriptorBindingFlags, s_vk_bindless_kinds_count> binding_flags = {};
+    binding_flags.fill(
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT
+        | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT);
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_create_info = {};
+    binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    binding_flags_create_info.bindingCount = static_cast<uint32_t>(binding_flags.size());
+    binding_flags_create_info.pBindingFlags = binding_flags.data();
+
+    VkDescriptorSetLayoutCreateInfo set_layout_create_info = {};
+    set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_layout_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    set_layout_create_info.pBindings = bindings.data();
+
+    if (is_bindless) {
+        set_layout_create_info.pNext = &binding_flags_create_info;
+        set_layout_create_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    }
+
+    result = vkCreateDescriptorSetLayout(device, &set_layout_create_info, nullptr, &table->set_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    //
+    // Set (bindless mode), pooled mode allocates sets per resource.
+    //
+    if (is_bindless) {
+        result = vk_bindless_allocate_set(table, &table->set);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Bindless: %s, %u textures, %u buffers",
+        is_bindless ? "descriptor indexing" : "pooled sets (no descriptor indexing)", capacities[0], capacities[1]);
+
+    return VK_SUCCESS;
+}
+
+void
+vk_bindless_destroy(Vk_Bindless_Table *table)
+{
+    if (table->device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Bindless: %llu descriptor writes, %zu pools",
+        static_cast<unsigned long long>(table->descriptor_writes_count), table->descriptor_pools.size());
+
+    for (VkDescriptorPool pool : table->descriptor_pools) {
+        vkDestroyDescriptorPool(table->device, pool, nullptr);
+    }
+
+    vkDestroyDescriptorSetLayout(table->device, table->set_layout, nullptr);
+
+    *table = {};
+}
+
+///
+/// @brief Takes free slot of `kind` and writes descriptor into it. Exactly one of the infos is set.
+///
+static Vk_Bindless_Handle
+vk_bindless_add(
+    Vk_Bindless_Table *table, Vk_Bindless_Kind kind, const VkDescriptorImageInfo *image_info,
+    const VkDescriptorBufferInfo *buffer_info)
+{
+    Vk_Bindless_Slots &slots = table->slots[static_cast<uint32_t>(kind)];
+
+    if (slots.free_slots.empty()) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION, "Bindless: all %u %s slots are used", slots.capacity,
+            kind == Vk_Bindless_Kind::Texture ? "texture" : "buffer");
+        return {};
+    }
+
+    uint32_t slot = slots.free_slots.back();
+
+    VkWriteDescriptorSet write = {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.descriptorCount = 1;
+    write.descriptorType = kind == Vk_Bindless_Kind::Texture ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.dstBinding = static_cast<uint32_t>(kind);
+    write.pImageInfo = image_info;
+    write.pBufferInfo = buffer_info;
+
+    if (table->is_bindless) {
+        write.dstSet = table->set;
+        write.dstArrayElement = slot;
+    } else {
+        if (slots.sets[slot] == VK_NULL_HANDLE) {
+            VkResult result = vk_bindless_allocate_set(table, &slots.sets[slot]);
+            if (result != VK_SUCCESS) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bindless: set allocation failed, %s", string_VkResult(result));
+                return {};
+            }
+        }
+
+        write.dstSet = slots.sets[slot];
+        write.dstArrayElement = 0;
+    }
+
+    vkUpdateDescriptorSets(table->device, 1, &write, 0, nullptr);
+
+    slots.free_slots.pop_back();
+    slots.used_count++;
+    table->descriptor_writes_count++;
+
+    return vk_bindless_make_handle(kind, slot, slots.generations[slot]);
+}
+
+Vk_Bindless_Handle
+vk_bindless_add_texture(Vk_Bindless_Table *table, VkImageView image_view, VkSampler sampler, VkImageLayout layout)
+{
+    VkDescriptorImageInfo image_info = {};
+    image_info.sampler = sampler;
+    image_info.imageView = image_view;
+    image_info.imageLayout = layout;
+
+    return vk_bindless_add(table, Vk_Bindless_Kind::Texture, &image_info, nullptr);
+}
+
+Vk_Bindless_Handle
+vk_bindless_add_buffer(Vk_Bindless_Table *table, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+{
+    VkDescriptorBufferInfo buffer_info = {};
+    buffer_info.buffer = buffer;
+    buffer_info.offset = offset;
+    buffer_info.range = range;
+
+    return vk_bindless_add(table, Vk_Bindless_Kind::Buffer, nullptr, &buffer_info);
+}
+
+void
+vk_bindless_remove(Vk_Bindless_Table *table, Vk_Bindless_Handle handle, uint64_t frame_number)
+{
+    if (!vk_bindless_is_valid(*table, handle)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Bindless: removing stale handle 0x%08x", handle.value);
+        return;
+    }
+
+    Vk_Bindless_Kind kind = vk_bindless_handle_kind(handle);
+    uint32_t slot = vk_bindless_handle_slot(handle);
+
+    Vk_Bindless_Slots &slots = table->slots[static_cast<uint32_t>(kind)];
+
+    // NOTE(gr3yknigh1): Generation never becomes 0, so handle value 0 stays invalid. [2025/04/02]
+    uint16_t generation = static_cast<uint16_t>((slots.generations[slot] + 1) & s_generation_mask);
+    slots.generations[slot] = generation == 0 ? 1 : generation;
+    slots.used_count--;
+
+    Vk_Bindless_Retired_Slot retired = {};
+    retired.kind = kind;
+    retired.slot = slot;
+    retired.last_frame_number = frame_number;
+    table->retired.push_back(retired);
+}
+
+void
+vk_bindless_collect(Vk_Bindless_Table *table, uint64_t completed_frame_number)
+{
+    auto is_completed = [completed_frame_number](const Vk_Bindless_Retired_Slot &retired) {
+        return retired.last_frame_number <= completed_frame_number;
+    };
+
+    for (const auto &retired : table->retired) {
+        if (is_completed(retired)) {
+            table->slots[static_cast<uint32_t>(retired.kind)].free_slots.push_back(retired.slot);
+        }
+    }
+
+    table->retired.erase(std::remove_if(table->retired.begin(), table->retired.end(), is_completed), table->retired.end());
+}
+
+bool
+vk_bindless_is_valid(const Vk_Bindless_Table &table, Vk_Bindless_Handle handle)
+{
+    if (handle.value == 0) {
+        return false;
+    }
+
+    const Vk_Bindless_Slots &slots = table.slots[static_cast<uint32_t>(vk_bindless_handle_kind(handle))];
+    uint32_t slot = vk_bindless_handle_slot(handle);
+
+    return slot < slots.capacity && slots.generations[slot] == vk_bindless_handle_generation(handle);
+}
+
+uint32_t
+vk_bindless_shader_index(const Vk_Bindless_Table &table, Vk_Bindless_Handle handle)
+{
+    SDL_assert(vk_bindless_is_valid(table, handle));
+    return table.is_bindless ? vk_bindless_handle_slot(handle) : 0;
+}
+
+void
+vk_bindless_bind_table(
+    const Vk_Bindless_Table &table, VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout layout,
+    uint32_t set_index)
+{
+    if (table.is_bindless) {
+        vkCmdBindDescriptorSets(command_buffer, bind_point, layout, set_index, 1, &table.set, 0, nullptr);
+    }
+}
+
+void
+vk_bindless_bind_resource(
+    const Vk_Bindless_Table &table, VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout layout,
+    uint32_t set_index, Vk_Bindless_Handle handle)
+{
+    if (table.is_bindless) {
+        return;
+    }
+
+    SDL_assert(vk_bindless_is_valid(table, handle));
+
+    const Vk_Bindless_Slots &slots = table.slots[static_cast<uint32_t>(vk_bindless_handle_kind(handle))];
+    vkCmdBindDescriptorSets(command_buffer, bind_point, layout, set_index, 1, &slots.sets[vk_bindless_handle_slot(handle)], 0, nullptr);
+}
+
+void
+vk_bindless_specialization(const Vk_Bindless_Table &table, Vk_Bindless_Specialization *result)
+{
+    for (uint32_t kind = 0; kind < s_vk_bindless_kinds_count; ++kind) {
+        result->entries[kind].constantID = kind;
+        result->entries[kind].offset = kind * sizeof(uint32_t);
+        result->entries[kind].size = sizeof(uint32_t);
+
+        result->data[kind] = table.is_bindless ? table.slots[kind].capacity : 1;
+    }
+
+    result->info.mapEntryCount = static_cast<uint32_t>(result->entries.size());
+    result->info.pMapEntries = result->entries.data();
+    result->info.dataSize = sizeof(result->data);
+    result->info.pData = result->data.data();
+}
@@ -0,0 +1,145 @@
+#pragma once
+///
+/// @brief Bindless resource table. Every texture and storage buffer gets a slot in one big descriptor set, which is
+/// bound once per command buffer, and draws pass slot index (e.g. in push constants) instead of binding sets.
+///
+/// Needs VK_EXT_descriptor_indexing (update-after-bind, partially bound bindings). Without it the table falls back
+/// to pooled mode: every resource gets its own small set of the same shape, bound per draw.
+///
+/// Set layout in both modes:
+///     binding 0: combined image samplers, array of `textures_capacity` (1 in pooled mode);
+///     binding 1: storage buffers, array of `buffers_capacity` (1 in pooled mode).
+///
+/// Shaders size both arrays with specialization constants 0 and 1 (see `vk_bindless_specialization`) and index them
+/// with `vk_bindless_shader_index`, so the same SPIR-V works in both modes.
+///
+/// @note In pooled mode resource's set has only the binding of its kind written, so pipeline which reads a texture
+/// and a buffer from the table at once needs bindless mode.
+/// @note Not thread safe.
+///
+
+enum class Vk_Bindless_Kind : uint32_t {
+    Texture = 0,
+    Buffer  = 1,
+};
+
+constexpr uint32_t s_vk_bindless_kinds_count = 2;
+
+///
+/// @brief Slot index in low 20 bits, slot's generation in next 11 bits, kind in the top one. Generation is bumped
+/// when slot is freed, so stale handle of a reused slot is caught. 0 is never valid.
+///
+struct Vk_Bindless_Handle {
+    uint32_t value = 0;
+};
+
+struct Vk_Bindless_Slots {
+    uint32_t capacity   = 0;
+    uint32_t used_count = 0;
+
+    std::vector<uint16_t> generations;
+    std::vector<uint32_t> free_slots; // Popped from the back, lowest slots first.
+
+    // NOTE(gr3yknigh1): Pooled mode only: set per slot, allocated on first use and rewritten on reuse. [2025/04/02]
+    std::vector<VkDescriptorSet> sets;
+};
+
+///
+/// @brief Freed slot which may still be read by frames in flight.
+///
+struct Vk_Bindless_Retired_Slot {
+    Vk_Bindless_Kind kind              = Vk_Bindless_Kind::Texture;
+    uint32_t         slot              = 0;
+    uint64_t         last_frame_number = 0;
+};
+
+struct Vk_Bindless_Table {
+    VkDevice device      = VK_NULL_HANDLE;
+    bool     is_bindless = false; // Otherwise pooled mode.
+
+    VkDescriptorSetLayout set_layout = VK_NULL_HANDLE;
+    VkDescriptorSet       set        = VK_NULL_HANDLE; // Bindless mode only.
+
+    // NOTE(gr3yknigh1): Bindless mode has one pool, pooled mode adds a pool once the last one is exhausted. [2025/04/02]
+    std::vector<VkDescriptorPool> descriptor_pools;
+    uint32_t                      pool_sets_left = 0;
+
+    std::array<Vk_Bindless_Slots, s_vk_bindless_kinds_count> slots;
+    std::vector<Vk_Bindless_Retired_Slot>                    retired;
+
+    uint64_t descriptor_writes_count = 0;
+};
+
+///
+/// @brief Array sizes for specialization constants 0 (textures) and 1 (buffers) of shaders which use the table.
+///
+struct Vk_Bindless_Specialization {
+    std::array<VkSpecializationMapEntry, s_vk_bindless_kinds_count> entries = {};
+    std::array<uint32_t, s_vk_bindless_kinds_count>                 data    = {};
+    VkSpecializationInfo                                            info    = {};
+};
+
+///
+/// @return True if device has every descriptor indexing feature bindless mode relies on.
+///
+bool vk_bindless_is_supported(const Vk_Device_Capabilities &capabilities);
+
+///
+/// @brief Fills features which bindless mode needs, to be chained into `VkDeviceCreateInfo`. Device must also enable
+/// VK_EXT_descriptor_indexing, VK_KHR_maintenance3 and dynamic indexing of sampled image and storage buffer arrays.
+///
+void vk_bindless_fill_features(VkPhysicalDeviceDescriptorIndexingFeatures *features);
+
+///
+/// @param is_bindless Device was created with `vk_bindless_fill_features`. Otherwise table works in pooled mode.
+/// @param textures_capacity Clamped to update-after-bind limits of the device in bindless mode.
+///
+VkResult vk_bindless_init(
+    Vk_Bindless_Table *table, VkDevice device, const Vk_Device_Capabilities &capabilities, bool is_bindless,
+    uint32_t textures_capacity, uint32_t buffers_capacity);
+void vk_bindless_destroy(Vk_Bindless_Table *table);
+
+///
+/// @return Invalid handle (0) if the table is full.
+///
+Vk_Bindless_Handle vk_bindless_add_texture(Vk_Bindless_Table *table, VkImageView image_view, VkSampler sampler, VkImageLayout layout);
+Vk_Bindless_Handle vk_bindless_add_buffer(Vk_Bindless_Table *table, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+
+///
+/// @brief Invalidates `handle` right away. Its slot is reused only after frame `frame_number` completes, see
+/// `vk_bindless_collect`.
+///
+/// @param frame_number The last frame which may read the resource.
+///
+void vk_bindless_remove(Vk_Bindless_Table *table, Vk_Bindless_Handle handle, uint64_t frame_number);
+
+///
+/// @brief Returns slots retired by frame <= `completed_frame_number` to the free lists.
+///
+void vk_bindless_collect(Vk_Bindless_Table *table, uint64_t completed_frame_number);
+
+bool vk_bindless_is_valid(const Vk_Bindless_Table &table, Vk_Bindless_Handle handle);
+
+///
+/// @return Array index shader reads the resource at: its slot in bindless mode, 0 in pooled mode.
+///
+uint32_t vk_bindless_shader_index(const Vk_Bindless_Table &table, Vk_Bindless_Handle handle);
+
+///
+/// @brief Binds the table's set. Once per command buffer and layout, does nothing in pooled mode.
+///
+void vk_bindless_bind_table(
+    const Vk_Bindless_Table &table, VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout layout,
+    uint32_t set_index);
+
+///
+/// @brief Binds resource's own set. Per draw, does nothing in bindless mode.
+///
+void vk_bindless_bind_resource(
+    const Vk_Bindless_Table &table, VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout layout,
+    uint32_t set_index, Vk_Bindless_Handle handle);
+
+///
+/// @note `result->info` points into `result` itself, so it must stay in place until pipeline is created.
+///
+void vk_bindless_specialization(const Vk_Bindless_Table &table, Vk_Bindless_Specialization *result);
@@ -0,0 +1,119 @@
+#include "stdafx.h"
+
+#include "vk_timeline.h"
+#include "vk_compute.h"
+
+VkResult
+vk_compute_init(
+    Vk_Compute_Context *context, VkDevice device, VkQueue queue, uint32_t queue_index, uint32_t graphics_queue_index,
+    uint32_t frames_count, bool use_timeline_semaphore)
+{
+    VkResult result = VK_SUCCESS;
+
+    context->device = device;
+    context->queue = queue;
+    context->queue_index = queue_index;
+    context->is_async = queue_index != graphics_queue_index;
+    context->frames.resize(frames_count);
+
+    result = vk_timeline_init(&context->timeline, device, use_timeline_semaphore, "compute");
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    for (auto &frame : context->frames) {
+        VkCommandPoolCreateInfo command_pool_create_info = {};
+        command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        command_pool_create_info.queueFamilyIndex = queue_index;
+
+        result = vkCreateCommandPool(device, &command_pool_create_info, nullptr, &frame.command_pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        VkCommandBufferAllocateInfo command_buffer_allocate_info = {};
+        command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocate_info.commandPool = frame.command_pool;
+        command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_allocate_info.commandBufferCount = 1;
+
+        result = vkAllocateCommandBuffers(device, &command_buffer_allocate_info, &frame.command_buffer);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        if (use_timeline_semaphore) {
+            continue;
+        }
+
+        VkSemaphoreCreateInfo semaphore_create_info = {};
+        semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        result = vkCreateSemaphore(device, &semaphore_create_info, nullptr, &frame.finished);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Compute: queue family %u (%s)", queue_index,
+        context->is_async ? "async" : "shared with graphics");
+
+    return VK_SUCCESS;
+}
+
+void
+vk_compute_destroy(Vk_Compute_Context *context)
+{
+    for (auto &frame : context->frames) {
+        vkDestroySemaphore(context->device, frame.finished, nullptr);
+        vkDestroyCommandPool(context->device, frame.command_pool, nullptr);
+    }
+
+    context->frames.clear();
+
+    vk_timeline_destroy(&context->timeline);
+}
+
+VkCommandBuffer
+vk_compute_begin(Vk_Compute_Context *context, uint32_t frame_index)
+{
+    Vk_Compute_Frame &frame = context->frames[frame_index];
+
+    VkResult result = vkResetCommandPool(context->device, frame.command_pool, 0);
+    SDL_assert(result == VK_SUCCESS);
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(frame.command_buffer, &begin_info);
+
+    return frame.command_buffer;
+}
+
+VkResult
+vk_compute_submit(
+    Vk_Compute_Context *context, uint32_t frame_index, VkPipelineStageFlags dst_stage, Vk_Submit_Waits *graphics_waits)
+{
+    Vk_Compute_Frame &frame = context->frames[frame_index];
+
+    vkEndCommandBuffer(frame.command_buffer);
+
+    uint64_t value = 0;
+    VkResult result = vk_timeline_submit(
+        &context->timeline, context->queue, &frame.command_buffer, 1, nullptr, frame.finished, &value);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    // NOTE(gr3yknigh1): Fence-backed timeline can't be waited by another queue, binary semaphore goes instead. [2025/04/10]
+    if (frame.finished != VK_NULL_HANDLE) {
+        vk_submit_waits_add_semaphore(graphics_waits, frame.finished, dst_stage);
+    } else {
+        vk_submit_waits_add_timeline(graphics_waits, &context->timeline, value, dst_stage);
+    }
+
+    return VK_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#pragma once
+///
+/// @brief Compute work submitted to its own queue, so it overlaps raster work of the graphics queue.
+///
+/// Each frame in flight owns a command pool. Compute submit signals the next value of compute timeline, graphics
+/// submit of the same frame waits for it only at the stage which consumes compute results. So compute of frame N+1
+/// runs while graphics queue still rasterizes frame N. Without timeline semaphores frame's binary semaphore is
+/// signaled and waited instead.
+///
+/// @note Frame's compute resources are reused once frame's graphics submit is completed: graphics waited for
+/// compute, so compute is finished too. Therefore every compute submit must be followed by graphics submit which
+/// waits for it.
+///
+
+struct Vk_Compute_Frame {
+    VkCommandPool   command_pool   = VK_NULL_HANDLE;
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+    VkSemaphore     finished       = VK_NULL_HANDLE; // Only without timeline semaphores.
+};
+
+struct Vk_Compute_Context {
+    VkDevice device      = VK_NULL_HANDLE;
+    VkQueue  queue       = VK_NULL_HANDLE;
+    uint32_t queue_index = 0;
+    bool     is_async    = false; // Queue family differs from graphics one.
+
+    Vk_Timeline timeline;
+
+    std::vector<Vk_Compute_Frame> frames;
+};
+
+///
+/// @param queue_index Compute-only family for async compute. Graphics family works too, but then compute is simply
+/// serialized with graphics on one queue.
+/// @param use_timeline_semaphore See `vk_timeline_init`.
+///
+VkResult vk_compute_init(
+    Vk_Compute_Context *context, VkDevice device, VkQueue queue, uint32_t queue_index, uint32_t graphics_queue_index,
+    uint32_t frames_count, bool use_timeline_semaphore);
+void vk_compute_destroy(Vk_Compute_Context *context);
+
+///
+/// @brief Resets frame's pool and begins its command buffer.
+///
+VkCommandBuffer vk_compute_begin(Vk_Compute_Context *context, uint32_t frame_index);
+
+///
+/// @brief Ends and submits frame's command buffer.
+///
+/// @param dst_stage Stage of graphics which consumes compute results.
+/// @param graphics_waits Wait for this submit is added there, graphics submit of this frame must use it.
+///
+VkResult vk_compute_submit(
+    Vk_Compute_Context *context, uint32_t frame_index, VkPipelineStageFlags dst_stage, Vk_Submit_Waits *graphics_waits);
@@ -0,0 +1,257 @@
+#include "stdafx.h"
+
+#include "mpsc_ring.h"
+#include "vk_debug_sink.h"
+
+// NOTE(gr3yknigh1): Validation layers use a few hundred distinct ids at most. [2025/04/15]
+constexpr uint32_t s_vk_debug_ids_capacity = 1024;
+
+static void
+vk_debug_sink_thread_main(Vk_Debug_Sink *sink);
+
+void
+vk_debug_sink_init(Vk_Debug_Sink *sink, uint32_t messages_per_second)
+{
+    mpsc_ring_init(&sink->ring);
+
+    sink->ids = std::make_unique<Vk_Debug_Id_Counters[]>(s_vk_debug_ids_capacity);
+    sink->ids_mask = s_vk_debug_ids_capacity - 1;
+    sink->id_names.assign(s_vk_debug_ids_capacity, {});
+    sink->id_texts.assign(s_vk_debug_ids_capacity, {});
+
+    sink->messages_per_second = messages_per_second;
+    sink->frequency = SDL_GetPerformanceFrequency();
+    sink->dropped_count = 0;
+    sink->untracked_count = 0;
+    sink->should_stop = false;
+
+    sink->thread = std::thread(vk_debug_sink_thread_main, sink);
+}
+
+static const char *
+vk_debug_severity_name(uint32_t severity)
+{
+    if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+        return "error";
+    }
+    if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+        return "warning";
+    }
+    if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT) {
+        return "info";
+    }
+    return "verbose";
+}
+
+static void
+vk_debug_sink_log(VkDebugUtilsMessageSeverityFlagBitsEXT severity, const char *text)
+{
+    if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: %s", text);
+    } else {
+        SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "Vulkan: %s", text);
+    }
+}
+
+static void
+vk_debug_sink_drain(Vk_Debug_Sink *sink)
+{
+    mpsc_ring_drain(&sink->ring, [sink](const Vk_Debug_Message &message) {
+        vk_debug_sink_log(message.severity, message.text);
+
+        if (message.id_slot != UINT32_MAX && sink->id_texts[message.id_slot].empty()) {
+            sink->id_names[message.id_slot] = message.name;
+            sink->id_texts[message.id_slot] = message.text;
+        }
+    });
+}
+
+static void
+vk_debug_sink_thread_main(Vk_Debug_Sink *sink)
+{
+    for (;;) {
+        bool should_stop = false;
+        {
+            // NOTE(gr3yknigh1): Polls instead of being woken up, so the callback never touches the mutex. [2025/04/15]
+            std::unique_lock<std::mutex> lock(sink->mutex);
+            should_stop = sink->condition.wait_for(lock, std::chrono::milliseconds(10), [sink] { return sink->should_stop; });
+        }
+
+        vk_debug_sink_drain(sink);
+
+        if (should_stop) {
+            return;
+        }
+    }
+}
+
+static void
+vk_debug_sink_log_summary(const Vk_Debug_Sink &sink)
+{
+    std::vector<uint32_t> slots;
+    uint64_t total_count = 0;
+    uint64_t suppressed_count = 0;
+
+    for (uint32_t slot = 0; slot <= sink.ids_mask; ++slot) {
+        const Vk_Debug_Id_Counters &counters = sink.ids[slot];
+
+        if (counters.key.load() != 0) {
+            slots.push_back(slot);
+            total_count += counters.count.load();
+            suppressed_count += counters.suppressed_count.load();
+        }
+    }
+
+    if (slots.empty() && sink.untracked_count == 0) {
+        return;
+    }
+
+    std::sort(slots.begin(), slots.end(), [&sink](uint32_t left, uint32_t right) {
+        return sink.ids[left].count.load() > sink.ids[right].count.load();
+    });
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Vulkan messages: %llu of %zu ids, %llu suppressed by rate limit, %llu dropped, %llu not counted",
+        static_cast<unsigned long long>(total_count), slots.size(), static_cast<unsigned long long>(suppressed_count),
+        static_cast<unsigned long long>(sink.dropped_count.load()), static_cast<unsigned long long>(sink.untracked_count.load()));
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    %11s %10s %10s  %-8s %s", "id", "count", "suppressed", "severity", "name: first message");
+
+    for (uint32_t slot : slots) {
+        const Vk_Debug_Id_Counters &counters = sink.ids[slot];
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "    %11d %10llu %10llu  %-8s %s: %.96s",
+            static_cast<int32_t>(counters.key.load() & 0xFFFFFFFFull), static_cast<unsigned long long>(counters.count.load()),
+            static_cast<unsigned long long>(counters.suppressed_count.load()), vk_debug_severity_name(counters.max_severity.load()),
+            sink.id_names[slot].empty() ? "-" : sink.id_names[slot].c_str(), sink.id_texts[slot].c_str());
+    }
+}
+
+void
+vk_debug_sink_destroy(Vk_Debug_Sink *sink)
+{
+    if (!sink->thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sink->mutex);
+        sink->should_stop = true;
+    }
+    sink->condition.notify_all();
+    sink->thread.join();
+
+    vk_debug_sink_log_summary(*sink);
+
+    mpsc_ring_destroy(&sink->ring);
+    sink->ids.reset();
+    sink->id_names.clear();
+    sink->id_texts.clear();
+}
+
+///
+/// @return Slot of `id`, claimed if it is seen for the first time. `UINT32_MAX` if the table is full.
+///
+static uint32_t
+vk_debug_sink_find_id(Vk_Debug_Sink *sink, int32_t id)
+{
+    uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(id)) | (1ull << 32);
+    uint32_t hash = static_cast<uint32_t>(id) * 2654435761u;
+
+    for (uint32_t probe = 0; probe <= sink->ids_mask; ++probe) {
+        uint32_t slot = (hash + probe) & sink->ids_mask;
+        std::atomic<uint64_t> &slot_key = sink->ids[slot].key;
+
+        uint64_t current_key = slot_key.load(std::memory_order_acquire);
+        if (current_key == 0 && slot_key.compare_exchange_strong(current_key, key, std::memory_order_acq_rel)) {
+            return slot;
+        }
+        if (current_key == key) {
+            return slot;
+        }
+    }
+    return UINT32_MAX;
+}
+
+static bool
+vk_debug_sink_is_allowed(const Vk_Debug_Sink &sink, Vk_Debug_Id_Counters *counters)
+{
+    if (sink.messages_per_second == 0) {
+        return true;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Threads which race into a new second may let a few extra messages through. Limit is there
+    // to keep frame time sane, it doesn't have to be exact. [2025/04/15]
+    //
+    uint64_t window = SDL_GetPerformanceCounter() / sink.frequency;
+    if (counters->window.load(std::memory_order_relaxed) != window && counters->window.exchange(window, std::memory_order_relaxed) != window) {
+        counters->window_count.store(0, std::memory_order_relaxed);
+    }
+
+    return counters->window_count.fetch_add(1, std::memory_order_relaxed) < sink.messages_per_second;
+}
+
+template <size_t Size>
+static void
+vk_debug_sink_copy(char (&destination)[Size], const char *source)
+{
+    if (source == nullptr) {
+        destination[0] = '\0';
+        return;
+    }
+
+    size_t length = strnlen(source, Size - 1);
+    memcpy(destination, source, length);
+    destination[length] = '\0';
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL
+vk_debug_sink_callback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT message_severity, VkDebugUtilsMessageTypeFlagsEXT message_types,
+    const VkDebugUtilsMessengerCallbackDataEXT *callback_data, void *user_data)
+{
+    Vk_Debug_Sink *sink = static_cast<Vk_Debug_Sink *>(user_data);
+
+    if (sink == nullptr || sink->ring.cells == nullptr) {
+        vk_debug_sink_log(message_severity, callback_data->pMessage);
+        return VK_FALSE;
+    }
+
+    uint32_t id_slot = vk_debug_sink_find_id(sink, callback_data->messageIdNumber);
+
+    if (id_slot != UINT32_MAX) {
+        Vk_Debug_Id_Counters &counters = sink->ids[id_slot];
+        counters.count.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t max_severity = counters.max_severity.load(std::memory_order_relaxed);
+        while (max_severity < static_cast<uint32_t>(message_severity)
+               && !counters.max_severity.compare_exchange_weak(max_severity, message_severity, std::memory_order_relaxed)) {
+        }
+
+        if (!vk_debug_sink_is_allowed(*sink, &counters)) {
+            counters.suppressed_count.fetch_add(1, std::memory_order_relaxed);
+            return VK_FALSE;
+        }
+    } else {
+        sink->untracked_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t position = 0;
+    Vk_Debug_Message *message = mpsc_ring_begin_push(&sink->ring, &position);
+
+    if (message == nullptr) {
+        sink->dropped_count.fetch_add(1, std::memory_order_relaxed);
+        return VK_FALSE;
+    }
+
+    message->severity = message_severity;
+    message->types = message_types;
+    message->id = callback_data->messageIdNumber;
+    message->id_slot = id_slot;
+    vk_debug_sink_copy(message->name, callback_data->pMessageIdName);
+    vk_debug_sink_copy(message->text, callback_data->pMessage);
+
+    mpsc_ring_end_push(&sink->ring, position);
+    return VK_FALSE;
+}
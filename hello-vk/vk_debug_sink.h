@@ -0,0 +1,80 @@
+#pragma once
+///
+/// @brief Asynchronous sink of `VK_EXT_debug_utils` messages.
+///
+/// Messenger callback runs on whatever thread made the Vulkan call, in the middle of it. Here it only counts the
+/// message under its `messageIdNumber` and copies text into a lock-free ring, background thread formats and logs it.
+/// Every id may log only `messages_per_second` messages a second, the rest are counted but not even copied, so one
+/// message repeated for every draw doesn't dominate frame time. Summary of every id is logged on destroy.
+///
+/// @note Nothing blocks the calling thread: message which doesn't fit into the full ring is dropped and counted.
+///
+
+struct Vk_Debug_Message {
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+    VkDebugUtilsMessageTypeFlagsEXT        types    = 0;
+    int32_t                                id       = 0;
+    uint32_t                               id_slot  = UINT32_MAX; // Index into `Vk_Debug_Sink::ids`, if tracked.
+
+    char name[64]   = {}; // `pMessageIdName`, truncated.
+    char text[1024] = {}; // `pMessage`, truncated.
+};
+
+///
+/// @brief Counters of one `messageIdNumber`. Slot is claimed by the first message with that id and never freed.
+///
+struct Vk_Debug_Id_Counters {
+    std::atomic<uint64_t> key = 0; // Id in the low 32 bits, bit 32 set once the slot is claimed.
+
+    std::atomic<uint64_t> count            = 0;
+    std::atomic<uint64_t> suppressed_count = 0; // Over the rate limit.
+    std::atomic<uint32_t> max_severity     = 0;
+
+    // NOTE(gr3yknigh1): Second the window counts, in performance counter ticks divided by frequency. [2025/04/15]
+    std::atomic<uint64_t> window       = 0;
+    std::atomic<uint32_t> window_count = 0;
+};
+
+// NOTE(gr3yknigh1): About a megabyte. Background thread drains it every 10 ms. [2025/04/15]
+constexpr uint64_t s_vk_debug_ring_capacity = 1024;
+
+struct Vk_Debug_Sink {
+    Mpsc_Ring<Vk_Debug_Message, s_vk_debug_ring_capacity> ring;
+
+    // NOTE(gr3yknigh1): Open addressing, linear probing, never grows. Ids which don't fit aren't limited. [2025/04/15]
+    std::unique_ptr<Vk_Debug_Id_Counters[]> ids;
+    uint32_t                                ids_mask = 0;
+
+    uint32_t messages_per_second = 0; // Per id, 0 logs everything.
+    uint64_t frequency           = 0;
+
+    std::atomic<uint64_t> dropped_count   = 0; // Ring was full.
+    std::atomic<uint64_t> untracked_count = 0; // Ids table was full.
+
+    // NOTE(gr3yknigh1): Background thread only. Name and first text of every id slot, for the summary. [2025/04/15]
+    std::vector<std::string> id_names;
+    std::vector<std::string> id_texts;
+
+    std::thread             thread;
+    std::mutex              mutex;
+    std::condition_variable condition;
+    bool                    should_stop = false; // Guarded by `mutex`.
+};
+
+///
+/// @param messages_per_second Logged messages per id per second, 0 logs everything.
+///
+void vk_debug_sink_init(Vk_Debug_Sink *sink, uint32_t messages_per_second);
+
+///
+/// @brief Logs what is left in the ring, stops the thread and logs summary table. Does nothing if sink isn't
+/// initialized. Call after the instance (and its messenger) is destroyed.
+///
+void vk_debug_sink_destroy(Vk_Debug_Sink *sink);
+
+///
+/// @brief `PFN_vkDebugUtilsMessengerCallbackEXT`, `pUserData` is `Vk_Debug_Sink *`.
+///
+VKAPI_ATTR VkBool32 VKAPI_CALL vk_debug_sink_callback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT message_severity, VkDebugUtilsMessageTypeFlagsEXT message_types,
+    const VkDebugUtilsMessengerCallbackDataEXT *callback_data, void *user_data);
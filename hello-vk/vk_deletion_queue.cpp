@@ -0,0 +1,138 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_deletion_queue.h"
+
+static void
+vk_deletion_destroy(Vk_Deletion_Queue *queue, Vk_Deletion *deletion)
+{
+    VkDevice device = queue->device;
+
+    switch (deletion->type) {
+    case VK_OBJECT_TYPE_UNKNOWN:
+        break;
+    case VK_OBJECT_TYPE_BUFFER:
+        vkDestroyBuffer(device, vk_handle_from_value<VkBuffer>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_BUFFER_VIEW:
+        vkDestroyBufferView(device, vk_handle_from_value<VkBufferView>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_IMAGE:
+        vkDestroyImage(device, vk_handle_from_value<VkImage>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_IMAGE_VIEW:
+        vkDestroyImageView(device, vk_handle_from_value<VkImageView>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_SAMPLER:
+        vkDestroySampler(device, vk_handle_from_value<VkSampler>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_FRAMEBUFFER:
+        vkDestroyFramebuffer(device, vk_handle_from_value<VkFramebuffer>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_PIPELINE:
+        vkDestroyPipeline(device, vk_handle_from_value<VkPipeline>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_PIPELINE_LAYOUT:
+        vkDestroyPipelineLayout(device, vk_handle_from_value<VkPipelineLayout>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_DESCRIPTOR_POOL:
+        vkDestroyDescriptorPool(device, vk_handle_from_value<VkDescriptorPool>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_SEMAPHORE:
+        vkDestroySemaphore(device, vk_handle_from_value<VkSemaphore>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_FENCE:
+        vkDestroyFence(device, vk_handle_from_value<VkFence>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_QUERY_POOL:
+        vkDestroyQueryPool(device, vk_handle_from_value<VkQueryPool>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_SWAPCHAIN_KHR:
+        vkDestroySwapchainKHR(device, vk_handle_from_value<VkSwapchainKHR>(deletion->handle), nullptr);
+        break;
+    case VK_OBJECT_TYPE_DEVICE_MEMORY:
+        vkFreeMemory(device, vk_handle_from_value<VkDeviceMemory>(deletion->handle), nullptr);
+        break;
+    default:
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Deletion queue: object type %d isn't supported, leaked", deletion->type);
+        SDL_assert(false);
+        break;
+    }
+
+    // NOTE(gr3yknigh1): Object goes first, memory can't be freed while something is still bound to it. [2025/04/09]
+    vk_allocator_free(queue->allocator, &deletion->allocation);
+
+    queue->destroyed_count++;
+}
+
+void
+vk_deletion_queue_init(Vk_Deletion_Queue *queue, VkDevice device, Vk_Allocator *allocator)
+{
+    *queue = {};
+    queue->device = device;
+    queue->allocator = allocator;
+
+    // NOTE(gr3yknigh1): Swapchain recreation alone pushes a few dozen objects, don't grow on the first resize. [2025/04/09]
+    queue->pending.reserve(64);
+}
+
+void
+vk_deletion_queue_destroy(Vk_Deletion_Queue *queue)
+{
+    for (auto &deletion : queue->pending) {
+        vk_deletion_destroy(queue, &deletion);
+    }
+    queue->pending.clear();
+
+    if (queue->destroyed_count > 0) {
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Deletion queue: %llu objects destroyed",
+            static_cast<unsigned long long>(queue->destroyed_count));
+    }
+
+    *queue = {};
+}
+
+void
+vk_deletion_queue_push(Vk_Deletion_Queue *queue, VkObjectType type, uint64_t handle, uint64_t last_frame_number)
+{
+    vk_deletion_queue_push(queue, type, handle, Vk_Allocation{}, last_frame_number);
+}
+
+void
+vk_deletion_queue_push(
+    Vk_Deletion_Queue *queue, VkObjectType type, uint64_t handle, const Vk_Allocation &allocation, uint64_t last_frame_number)
+{
+    if (handle == 0 && allocation.memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    Vk_Deletion deletion = {};
+    deletion.type = handle != 0 ? type : VK_OBJECT_TYPE_UNKNOWN;
+    deletion.handle = handle;
+    deletion.allocation = allocation;
+    deletion.last_frame_number = last_frame_number;
+
+    queue->pending.push_back(deletion);
+}
+
+void
+vk_deletion_queue_collect(Vk_Deletion_Queue *queue, uint64_t completed_frame_number)
+{
+    if (queue->pending.empty()) {
+        return;
+    }
+
+    auto is_done = [completed_frame_number](const Vk_Deletion &deletion) {
+        return deletion.last_frame_number <= completed_frame_number;
+    };
+
+    for (auto &deletion : queue->pending) {
+        if (is_done(deletion)) {
+            vk_deletion_destroy(queue, &deletion);
+        }
+    }
+
+    queue->pending.erase(std::remove_if(queue->pending.begin(), queue->pending.end(), is_done), queue->pending.end());
+}
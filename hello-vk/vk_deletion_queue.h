@@ -0,0 +1,78 @@
+#pragma once
+///
+/// @brief Deferred destruction of Vulkan objects.
+///
+/// Object replaced while running (swapchain on resize, pipeline on shader reload, transients on graph change) may
+/// still be used by frames in flight. Instead of waiting for the device it is pushed here with the number of the last
+/// frame which may use it, and `vk_deletion_queue_collect` destroys everything whose frame has completed in one go.
+///
+/// Objects are identified the same way as in VK_EXT_debug_utils: `VkObjectType` and handle as `uint64_t`.
+///
+/// @note Frame numbers are the ones frames are submitted with, completed number is the value graphics timeline reached.
+/// @note Not thread safe.
+///
+
+///
+/// @brief Handle as `uint64_t`, whether handles are pointers (64-bit) or integers (32-bit).
+///
+template <typename T>
+inline uint64_t
+vk_handle_value(T handle)
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Not a Vulkan handle");
+
+    uint64_t value = 0;
+    memcpy(&value, &handle, sizeof(T));
+    return value;
+}
+
+template <typename T>
+inline T
+vk_handle_from_value(uint64_t value)
+{
+    T handle = {};
+    memcpy(&handle, &value, sizeof(T));
+    return handle;
+}
+
+struct Vk_Deletion {
+    VkObjectType type   = VK_OBJECT_TYPE_UNKNOWN; // UNKNOWN frees only `allocation`.
+    uint64_t     handle = 0;
+
+    // NOTE(gr3yknigh1): Memory of `Vk_Allocator`, freed after the object. Empty if it has none. [2025/04/09]
+    Vk_Allocation allocation;
+
+    uint64_t last_frame_number = 0;
+};
+
+struct Vk_Deletion_Queue {
+    VkDevice      device    = VK_NULL_HANDLE;
+    Vk_Allocator *allocator = nullptr;
+
+    std::vector<Vk_Deletion> pending;
+
+    uint64_t destroyed_count = 0;
+};
+
+void vk_deletion_queue_init(Vk_Deletion_Queue *queue, VkDevice device, Vk_Allocator *allocator);
+
+///
+/// @brief Destroys everything still pending. Device must be idle.
+///
+void vk_deletion_queue_destroy(Vk_Deletion_Queue *queue);
+
+///
+/// @param last_frame_number The last frame which may use the object. 0 if no submitted frame did.
+///
+void vk_deletion_queue_push(Vk_Deletion_Queue *queue, VkObjectType type, uint64_t handle, uint64_t last_frame_number);
+
+///
+/// @brief Same, and frees `allocation` after the object is destroyed.
+///
+void vk_deletion_queue_push(
+    Vk_Deletion_Queue *queue, VkObjectType type, uint64_t handle, const Vk_Allocation &allocation, uint64_t last_frame_number);
+
+///
+/// @brief Destroys objects last used by frame <= `completed_frame_number`.
+///
+void vk_deletion_queue_collect(Vk_Deletion_Queue *queue, uint64_t completed_frame_number);
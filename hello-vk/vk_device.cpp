@@ -0,0 +1,415 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+
+///
+/// @brief Searches for indices of queue which supports `present` and `graphics`.
+///
+/// @note Without surface (headless mode) present index is the same as graphics one.
+///
+static void
+vk_find_queue_family_indices(Vk_Device_Capabilities *capabilities, bool has_surface)
+{
+    for (uint32_t index = 0; index < capabilities->queue_families.size(); ++index) {
+        const VkQueueFamilyProperties &queue_family = capabilities->queue_families[index];
+
+        bool is_graphics_supported = (queue_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+        bool is_surface_supported = has_surface ? capabilities->queue_families_present_support[index] == VK_TRUE : is_graphics_supported;
+
+        // NOTE(gr3yknigh1): Family which can do both is preferred, so swapchain images stay in exclusive mode.
+        // Some devices (e.g. lavapipe) expose only one family at all. [2025/03/22]
+        if (is_graphics_supported && is_surface_supported) {
+            capabilities->graphics_queue_index = index;
+            capabilities->present_queue_index = index;
+            break;
+        }
+
+        if (is_graphics_supported && !capabilities->graphics_queue_index.has_value()) {
+            capabilities->graphics_queue_index = index;
+        }
+
+        if (is_surface_supported && !capabilities->present_queue_index.has_value()) {
+            capabilities->present_queue_index = index;
+        }
+    }
+
+    // NOTE(gr3yknigh1): Transfer-only family is DMA engine on discrete GPUs, which runs copies alongside graphics. [2025/03/26]
+    for (uint32_t index = 0; index < capabilities->queue_families.size(); ++index) {
+        VkQueueFlags flags = capabilities->queue_families[index].queueFlags;
+
+        bool is_transfer_only = (flags & VK_QUEUE_TRANSFER_BIT) != 0 && (flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0;
+        if (is_transfer_only) {
+            capabilities->transfer_queue_index = index;
+            break;
+        }
+    }
+
+    // NOTE(gr3yknigh1): Async compute family runs dispatches alongside graphics one. [2025/03/31]
+    for (uint32_t index = 0; index < capabilities->queue_families.size(); ++index) {
+        VkQueueFlags flags = capabilities->queue_families[index].queueFlags;
+
+        bool is_async_compute = (flags & VK_QUEUE_COMPUTE_BIT) != 0 && (flags & VK_QUEUE_GRAPHICS_BIT) == 0;
+        if (is_async_compute) {
+            capabilities->compute_queue_index = index;
+            break;
+        }
+    }
+}
+
+VkResult
+vk_query_device_capabilities(
+    VkInstance instance, VkPhysicalDevice device, uint32_t index, VkSurfaceKHR surface, Vk_Device_Capabilities *result)
+{
+    VkResult vk_result = VK_SUCCESS;
+
+    *result = {};
+    result->handle = device;
+    result->index = index;
+
+    vkGetPhysicalDeviceProperties(device, &result->properties);
+    vkGetPhysicalDeviceFeatures(device, &result->features);
+    vkGetPhysicalDeviceMemoryProperties(device, &result->memory_properties);
+
+    for (uint32_t heap_index = 0; heap_index < result->memory_properties.memoryHeapCount; ++heap_index) {
+        const VkMemoryHeap &heap = result->memory_properties.memoryHeaps[heap_index];
+        if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0) {
+            result->device_local_size = std::max(result->device_local_size, heap.size);
+        }
+    }
+
+    uint32_t queue_families_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_families_count, nullptr);
+
+    result->queue_families.resize(queue_families_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &queue_families_count, result->queue_families.data());
+
+    uint32_t extensions_count = 0;
+    vk_result = vkEnumerateDeviceExtensionProperties(device, nullptr, &extensions_count, nullptr);
+    if (vk_result != VK_SUCCESS) {
+        return vk_result;
+    }
+
+    result->extensions.resize(extensions_count);
+    vk_result = vkEnumerateDeviceExtensionProperties(device, nullptr, &extensions_count, result->extensions.data());
+    if (vk_result != VK_SUCCESS) {
+        return vk_result;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Instance may be Vulkan 1.0, so extended structures are queried only through KHR entry points.
+    // Chains are cut after the query, so snapshot can be copied around. [2025/04/02]
+    //
+    auto get_features2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR"));
+    auto get_properties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2>(
+        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR"));
+
+    if (get_features2 != nullptr && get_properties2 != nullptr) {
+        VkPhysicalDeviceFeatures2 features2 = {};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+
+        VkPhysicalDeviceProperties2 properties2 = {};
+        properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+
+        if (vk_device_has_extension(*result, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+            result->descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+            result->descriptor_indexing_features.pNext = features2.pNext;
+            features2.pNext = &result->descriptor_indexing_features;
+
+            result->descriptor_indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+            result->descriptor_indexing_properties.pNext = properties2.pNext;
+            properties2.pNext = &result->descriptor_indexing_properties;
+        }
+
+        if (vk_device_has_extension(*result, VK_KHR_PRESENT_ID_EXTENSION_NAME)) {
+            result->present_id_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+            result->present_id_features.pNext = features2.pNext;
+            features2.pNext = &result->present_id_features;
+        }
+
+        if (vk_device_has_extension(*result, VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+            result->present_wait_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+            result->present_wait_features.pNext = features2.pNext;
+            features2.pNext = &result->present_wait_features;
+        }
+
+        bool is_vulkan_1_2 = result->properties.apiVersion >= VK_API_VERSION_1_2;
+        if (is_vulkan_1_2 || vk_device_has_extension(*result, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+            result->timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+            result->timeline_semaphore_features.pNext = features2.pNext;
+            features2.pNext = &result->timeline_semaphore_features;
+        }
+
+        if (features2.pNext != nullptr) {
+            get_features2(device, &features2);
+        }
+        if (properties2.pNext != nullptr) {
+            get_properties2(device, &properties2);
+        }
+
+        result->descriptor_indexing_features.pNext = nullptr;
+        result->descriptor_indexing_properties.pNext = nullptr;
+        result->present_id_features.pNext = nullptr;
+        result->present_wait_features.pNext = nullptr;
+        result->timeline_semaphore_features.pNext = nullptr;
+    }
+
+    if (vk_device_has_extension(*result, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+        result->get_memory_properties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties2KHR"));
+    }
+
+    if (result->get_memory_properties2 != nullptr) {
+        VkPhysicalDeviceMemoryProperties2 memory_properties2 = {};
+        memory_properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memory_properties2.pNext = &result->memory_budget;
+
+        result->memory_budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        result->get_memory_properties2(device, &memory_properties2);
+        result->memory_budget.pNext = nullptr;
+    }
+
+    if (surface != VK_NULL_HANDLE) {
+        result->queue_families_present_support.resize(queue_families_count, VK_FALSE);
+
+        for (uint32_t family_index = 0; family_index < queue_families_count; ++family_index) {
+            vk_result = vkGetPhysicalDeviceSurfaceSupportKHR(
+                device, family_index, surface, &result->queue_families_present_support[family_index]);
+            if (vk_result != VK_SUCCESS) {
+                return vk_result;
+            }
+        }
+
+        uint32_t surface_formats_count = 0;
+        vk_result = vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &surface_formats_count, nullptr);
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+
+        result->surface_formats.resize(surface_formats_count);
+        vk_result = vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &surface_formats_count, result->surface_formats.data());
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+
+        uint32_t present_modes_count = 0;
+        vk_result = vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &present_modes_count, nullptr);
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+
+        result->present_modes.resize(present_modes_count);
+        vk_result = vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &present_modes_count, result->present_modes.data());
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+    }
+
+    vk_find_queue_family_indices(result, surface != VK_NULL_HANDLE);
+
+    return VK_SUCCESS;
+}
+
+void
+vk_query_memory_budget(const Vk_Device_Capabilities &capabilities, Vk_Memory_Budget *result)
+{
+    *result = {};
+    result->heaps_count = capabilities.memory_properties.memoryHeapCount;
+
+    if (capabilities.get_memory_properties2 != nullptr) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT memory_budget = {};
+        memory_budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+        VkPhysicalDeviceMemoryProperties2 memory_properties2 = {};
+        memory_properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memory_properties2.pNext = &memory_budget;
+
+        capabilities.get_memory_properties2(capabilities.handle, &memory_properties2);
+
+        for (uint32_t heap_index = 0; heap_index < result->heaps_count; ++heap_index) {
+            result->budgets[heap_index] = memory_budget.heapBudget[heap_index];
+            result->usages[heap_index] = memory_budget.heapUsage[heap_index];
+        }
+
+        result->is_reported = true;
+        return;
+    }
+
+    // NOTE(gr3yknigh1): Leaves room for other processes and the compositor, as drivers which do report
+    // budget usually do. [2025/04/12]
+    for (uint32_t heap_index = 0; heap_index < result->heaps_count; ++heap_index) {
+        result->budgets[heap_index] = capabilities.memory_properties.memoryHeaps[heap_index].size / 5 * 4;
+    }
+}
+
+int64_t
+vk_score_physical_device(const Vk_Device_Capabilities &capabilities, const std::vector<const char *> &required_extensions)
+{
+    if (!capabilities.graphics_queue_index.has_value() || !capabilities.present_queue_index.has_value()) {
+        return -1;
+    }
+
+    for (const char *extension_name : required_extensions) {
+        if (!vk_device_has_extension(capabilities, extension_name)) {
+            return -1;
+        }
+    }
+
+    bool has_surface = !capabilities.queue_families_present_support.empty();
+    if (has_surface && (capabilities.surface_formats.empty() || capabilities.present_modes.empty())) {
+        return -1;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Device type dominates: any discrete GPU wins over any integrated one, VRAM and the rest only
+    // order devices of the same type. [2025/03/30]
+    //
+    int64_t score = 0;
+
+    switch (capabilities.properties.deviceType) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   score += 100000; break;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: score += 50000;  break;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    score += 20000;  break;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            score += 1000;   break;
+    default:                                     break;
+    }
+
+    // NOTE(gr3yknigh1): 100 points per GiB, capped so huge heap doesn't outweigh device type. [2025/03/30]
+    score += std::min<int64_t>(static_cast<int64_t>(capabilities.device_local_size >> 30) * 100, 10000);
+
+    const VkPhysicalDeviceLimits &limits = capabilities.properties.limits;
+    score += limits.maxImageDimension2D / 1024;
+    score += std::min<int64_t>(limits.maxPushConstantsSize, 256) / 16;
+
+    const VkPhysicalDeviceFeatures &features = capabilities.features;
+    if (features.multiDrawIndirect)         score += 200;
+    if (features.drawIndirectFirstInstance) score += 100;
+    if (features.samplerAnisotropy)         score += 100;
+    if (features.textureCompressionBC)      score += 50;
+
+    if (capabilities.transfer_queue_index.has_value()) {
+        score += 200;
+    }
+
+    if (capabilities.compute_queue_index.has_value()) {
+        score += 200;
+    }
+
+    if (capabilities.graphics_queue_index == capabilities.present_queue_index) {
+        score += 100;
+    }
+
+    return score;
+}
+
+///
+/// @return Device which `override_name` refers to (by index or part of name), nullptr if none.
+///
+static const Vk_Device_Capabilities *
+vk_find_override_device(const std::vector<Vk_Device_Capabilities> &devices, const char *override_name)
+{
+    char *end = nullptr;
+    unsigned long index = strtoul(override_name, &end, 10);
+    if (end != override_name && *end == '\0') {
+        return index < devices.size() ? &devices[index] : nullptr;
+    }
+
+    std::string needle(override_name);
+    std::transform(needle.begin(), needle.end(), needle.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+
+    for (const auto &device : devices) {
+        std::string name(device.properties.deviceName);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+
+        if (name.find(needle) != std::string::npos) {
+            return &device;
+        }
+    }
+
+    return nullptr;
+}
+
+VkResult
+vk_pick_physical_device(
+    VkInstance instance, VkSurfaceKHR surface, const std::vector<const char *> &required_extensions,
+    const char *override_name, Vk_Device_Capabilities *result)
+{
+    VkResult vk_result = VK_SUCCESS;
+
+    uint32_t devices_count = 0;
+    vk_result = vkEnumeratePhysicalDevices(instance, &devices_count, nullptr);
+    if (vk_result != VK_SUCCESS) {
+        return vk_result;
+    }
+
+    std::vector<VkPhysicalDevice> handles(devices_count);
+    vk_result = vkEnumeratePhysicalDevices(instance, &devices_count, handles.data());
+    if (vk_result != VK_SUCCESS) {
+        return vk_result;
+    }
+
+    std::vector<Vk_Device_Capabilities> devices(devices_count);
+    std::vector<int64_t> scores(devices_count, -1);
+
+    const Vk_Device_Capabilities *best = nullptr;
+    int64_t best_score = -1;
+
+    for (uint32_t index = 0; index < devices_count; ++index) {
+        vk_result = vk_query_device_capabilities(instance, handles[index], index, surface, &devices[index]);
+        if (vk_result != VK_SUCCESS) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Device #%u: query failed, %s", index, string_VkResult(vk_result));
+            continue;
+        }
+
+        scores[index] = vk_score_physical_device(devices[index], required_extensions);
+
+        const VkPhysicalDeviceProperties &properties = devices[index].properties;
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Device #%u: %s (%s, %llu MiB VRAM), score %lld%s", index, properties.deviceName,
+            string_VkPhysicalDeviceType(properties.deviceType),
+            static_cast<unsigned long long>(devices[index].device_local_size >> 20), static_cast<long long>(scores[index]),
+            scores[index] < 0 ? " [unsuitable]" : "");
+
+        if (scores[index] > best_score) {
+            best_score = scores[index];
+            best = &devices[index];
+        }
+    }
+
+    if (override_name != nullptr && *override_name != '\0') {
+        const Vk_Device_Capabilities *requested = vk_find_override_device(devices, override_name);
+
+        if (requested == nullptr) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Device override '%s' matches no device, ignored", override_name);
+        } else if (scores[requested->index] < 0) {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION, "Device override '%s': %s is unsuitable, ignored", override_name,
+                requested->properties.deviceName);
+        } else {
+            best = requested;
+        }
+    }
+
+    if (best == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "None of %u devices is suitable", devices_count);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Picked device #%u: %s", best->index, best->properties.deviceName);
+
+    Vk_Memory_Budget budget = {};
+    vk_query_memory_budget(*best, &budget);
+
+    for (uint32_t heap_index = 0; heap_index < budget.heaps_count; ++heap_index) {
+        const VkMemoryHeap &heap = best->memory_properties.memoryHeaps[heap_index];
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Heap #%u: %llu MiB%s, budget %llu MiB (%s), used %llu MiB", heap_index,
+            static_cast<unsigned long long>(heap.size >> 20),
+            (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0 ? " device local" : "",
+            static_cast<unsigned long long>(budget.budgets[heap_index] >> 20), budget.is_reported ? "reported" : "estimated",
+            static_cast<unsigned long long>(budget.usages[heap_index] >> 20));
+    }
+
+    *result = std::move(devices[best->index]);
+    return VK_SUCCESS;
+}
@@ -0,0 +1,126 @@
+#pragma once
+///
+/// @brief Physical device selection. Every device is queried once into `Vk_Device_Capabilities`, scored, and the
+/// snapshot of the picked one is kept for the rest of startup, so nothing re-queries the same data.
+///
+
+///
+/// @brief Snapshot of everything startup needs to know about physical device (and its support of the surface).
+///
+struct Vk_Device_Capabilities {
+    VkPhysicalDevice handle = VK_NULL_HANDLE;
+    uint32_t         index  = 0; // In order of vkEnumeratePhysicalDevices.
+
+    VkPhysicalDeviceProperties       properties        = {};
+    VkPhysicalDeviceFeatures         features          = {};
+    VkPhysicalDeviceMemoryProperties memory_properties = {};
+
+    std::vector<VkQueueFamilyProperties> queue_families;
+    std::vector<VkBool32>                queue_families_present_support; // Empty without surface.
+    std::vector<VkExtensionProperties>   extensions;
+
+    // NOTE(gr3yknigh1): Empty without surface (headless mode). [2025/03/30]
+    std::vector<VkSurfaceFormatKHR> surface_formats;
+    std::vector<VkPresentModeKHR>   present_modes;
+
+    std::optional<uint32_t> graphics_queue_index = std::nullopt;
+    std::optional<uint32_t> present_queue_index  = std::nullopt;
+    std::optional<uint32_t> transfer_queue_index = std::nullopt; // Transfer-only family, if any.
+    std::optional<uint32_t> compute_queue_index  = std::nullopt; // Compute family without graphics, if any.
+
+    VkDeviceSize device_local_size = 0; // Size of the largest DEVICE_LOCAL heap.
+
+    // NOTE(gr3yknigh1): Zeroed unless device has VK_EXT_descriptor_indexing and instance can query it. [2025/04/02]
+    VkPhysicalDeviceDescriptorIndexingFeatures   descriptor_indexing_features   = {};
+    VkPhysicalDeviceDescriptorIndexingProperties descriptor_indexing_properties = {};
+
+    // NOTE(gr3yknigh1): Zeroed unless device has VK_KHR_present_id / VK_KHR_present_wait. [2025/04/04]
+    VkPhysicalDevicePresentIdFeaturesKHR   present_id_features   = {};
+    VkPhysicalDevicePresentWaitFeaturesKHR present_wait_features = {};
+
+    // NOTE(gr3yknigh1): Zeroed unless device is Vulkan 1.2 or has VK_KHR_timeline_semaphore. [2025/04/10]
+    VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features = {};
+
+    // NOTE(gr3yknigh1): Zeroed unless device has VK_EXT_memory_budget. Snapshot at query time, use
+    // `vk_query_memory_budget` for current values. [2025/04/12]
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memory_budget = {};
+    PFN_vkGetPhysicalDeviceMemoryProperties2  get_memory_properties2 = nullptr;
+};
+
+///
+/// @brief Per-heap budget: how much the process can allocate before OS starts to evict or allocations fail.
+///
+struct Vk_Memory_Budget {
+    uint32_t heaps_count = 0;
+
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> budgets = {};
+    std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> usages  = {}; // Of the whole process. Zero if not reported.
+
+    bool is_reported = false; // Device reports budget via VK_EXT_memory_budget, estimated otherwise.
+};
+
+///
+/// @brief Queries all capabilities of `device`. Without surface present support is assumed for graphics family.
+///
+/// @note Extended features are queried only if `instance` enabled VK_KHR_get_physical_device_properties2.
+///
+VkResult vk_query_device_capabilities(
+    VkInstance instance, VkPhysicalDevice device, uint32_t index, VkSurfaceKHR surface, Vk_Device_Capabilities *result);
+
+///
+/// @brief Queries current budget of every heap. Without VK_EXT_memory_budget budget is estimated as 80% of
+/// heap size and usage isn't known.
+///
+/// @note Reported values change only once per frame (or so) on most drivers, there is no point to call it more often.
+///
+void vk_query_memory_budget(const Vk_Device_Capabilities &capabilities, Vk_Memory_Budget *result);
+
+//
+// NOTE(gr3yknigh1): Lookups in the snapshot are inline, so modules which only read it (e.g. bindless table in
+// hello-vk-tests) don't need vk_device.cpp and the instance functions it calls. [2025/04/17]
+//
+inline bool
+vk_device_has_extension(const Vk_Device_Capabilities &capabilities, const char *extension_name)
+{
+    for (const auto &extension : capabilities.extensions) {
+        if (strcmp(extension.extensionName, extension_name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool
+vk_device_has_surface_format(const Vk_Device_Capabilities &capabilities, VkSurfaceFormatKHR format)
+{
+    for (const auto &surface_format : capabilities.surface_formats) {
+        if (surface_format.format == format.format && surface_format.colorSpace == format.colorSpace) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool
+vk_device_has_present_mode(const Vk_Device_Capabilities &capabilities, VkPresentModeKHR present_mode)
+{
+    return std::find(capabilities.present_modes.begin(), capabilities.present_modes.end(), present_mode) != capabilities.present_modes.end();
+}
+
+///
+/// @return Score of the device, higher is better. Negative if device can't be used at all (no graphics or present
+/// queue, missing required extension, no surface formats or present modes).
+///
+int64_t vk_score_physical_device(const Vk_Device_Capabilities &capabilities, const std::vector<const char *> &required_extensions);
+
+///
+/// @brief Picks device with the highest score. Every candidate is logged together with its score.
+///
+/// @param override_name Device index ("1") or case-insensitive part of its name ("radeon"). Overrides the score,
+/// unless such device is missing or unsuitable. May be nullptr.
+///
+/// @return VK_ERROR_INITIALIZATION_FAILED if none of devices is suitable.
+///
+VkResult vk_pick_physical_device(
+    VkInstance instance, VkSurfaceKHR surface, const std::vector<const char *> &required_extensions,
+    const char *override_name, Vk_Device_Capabilities *result);
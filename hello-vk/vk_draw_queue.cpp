@@ -0,0 +1,406 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_draw_queue.h"
+
+VkResult
+vk_draw_queue_init(
+    Vk_Draw_Queue *queue, Vk_Allocator *allocator, uint32_t frames_count, uint32_t max_instances, uint32_t instance_size,
+    VkDescriptorSetLayout material_set_layout, uint32_t push_constants_size)
+{
+    VkResult result = VK_SUCCESS;
+
+    queue->device = allocator->device;
+    queue->allocator = allocator;
+    queue->max_instances = std::max(max_instances, 1u);
+    queue->instance_size = instance_size;
+    queue->push_constants_size = push_constants_size;
+    queue->frequency = SDL_GetPerformanceFrequency();
+    queue->report_counter = SDL_GetPerformanceCounter();
+
+    //
+    // Instance buffers:
+    //
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = static_cast<VkDeviceSize>(queue->max_instances) * instance_size;
+    buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    queue->instance_buffers.resize(frames_count, VK_NULL_HANDLE);
+    queue->instance_allocations.resize(frames_count);
+
+    for (uint32_t index = 0; index < frames_count; ++index) {
+        result = vk_allocator_make_buffer(
+            allocator, buffer_create_info, Vk_Memory_Usage::Cpu_To_Gpu, &queue->instance_buffers[index],
+            &queue->instance_allocations[index]);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    //
+    // Descriptors:
+    //
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo set_layout_create_info = {};
+    set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_layout_create_info.bindingCount = 1;
+    set_layout_create_info.pBindings = &binding;
+
+    result = vkCreateDescriptorSetLayout(queue->device, &set_layout_create_info, nullptr, &queue->set_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkDescriptorPoolSize pool_size = {};
+    pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pool_size.descriptorCount = frames_count;
+
+    VkDescriptorPoolCreateInfo pool_create_info = {};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_create_info.maxSets = frames_count;
+    pool_create_info.poolSizeCount = 1;
+    pool_create_info.pPoolSizes = &pool_size;
+
+    result = vkCreateDescriptorPool(queue->device, &pool_create_info, nullptr, &queue->descriptor_pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    std::vector<VkDescriptorSetLayout> set_layouts(frames_count, queue->set_layout);
+
+    VkDescriptorSetAllocateInfo set_allocate_info = {};
+    set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    set_allocate_info.descriptorPool = queue->descriptor_pool;
+    set_allocate_info.descriptorSetCount = frames_count;
+    set_allocate_info.pSetLayouts = set_layouts.data();
+
+    queue->sets.resize(frames_count, VK_NULL_HANDLE);
+    result = vkAllocateDescriptorSets(queue->device, &set_allocate_info, queue->sets.data());
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    for (uint32_t index = 0; index < frames_count; ++index) {
+        VkDescriptorBufferInfo buffer_info = {};
+        buffer_info.buffer = queue->instance_buffers[index];
+        buffer_info.range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = queue->sets[index];
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &buffer_info;
+
+        vkUpdateDescriptorSets(queue->device, 1, &write, 0, nullptr);
+    }
+
+    //
+    // Pipeline layout, shared by every pipeline of the queue:
+    //
+    std::array<VkDescriptorSetLayout, 2> pipeline_set_layouts = { queue->set_layout, material_set_layout };
+
+    VkPushConstantRange push_constant_range = {};
+    push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    push_constant_range.offset = 0;
+    push_constant_range.size = push_constants_size;
+
+    VkPipelineLayoutCreateInfo layout_create_info = {};
+    layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_create_info.setLayoutCount = material_set_layout != VK_NULL_HANDLE ? 2 : 1;
+    layout_create_info.pSetLayouts = pipeline_set_layouts.data();
+    layout_create_info.pushConstantRangeCount = push_constants_size > 0 ? 1 : 0;
+    layout_create_info.pPushConstantRanges = &push_constant_range;
+
+    result = vkCreatePipelineLayout(queue->device, &layout_create_info, nullptr, &queue->pipeline_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    // NOTE(gr3yknigh1): Scene is known up front, so steady state never grows these. [2025/04/08]
+    queue->items.reserve(queue->max_instances);
+    queue->sorted_scratch.reserve(queue->max_instances);
+    queue->instances.reserve(static_cast<size_t>(queue->max_instances) * instance_size);
+    queue->batches.reserve(64);
+
+    return VK_SUCCESS;
+}
+
+void
+vk_draw_queue_destroy(Vk_Draw_Queue *queue)
+{
+    if (queue->device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    vkDestroyPipelineLayout(queue->device, queue->pipeline_layout, nullptr);
+    vkDestroyDescriptorPool(queue->device, queue->descriptor_pool, nullptr);
+    vkDestroyDescriptorSetLayout(queue->device, queue->set_layout, nullptr);
+
+    for (size_t index = 0; index < queue->instance_buffers.size(); ++index) {
+        if (queue->instance_buffers[index] != VK_NULL_HANDLE) {
+            vk_allocator_destroy_buffer(queue->allocator, queue->instance_buffers[index], &queue->instance_allocations[index]);
+        }
+    }
+
+    *queue = {};
+}
+
+uint32_t
+vk_draw_queue_add_pipeline(Vk_Draw_Queue *queue, const VkPipeline *pipeline)
+{
+    SDL_assert(queue->pipelines.size() < (1u << s_draw_key_pipeline_bits));
+
+    queue->pipelines.push_back(pipeline);
+    return static_cast<uint32_t>(queue->pipelines.size() - 1);
+}
+
+uint32_t
+vk_draw_queue_add_material(Vk_Draw_Queue *queue, VkDescriptorSet set)
+{
+    SDL_assert(queue->materials.size() < (1u << s_draw_key_material_bits));
+
+    queue->materials.push_back(set);
+    return static_cast<uint32_t>(queue->materials.size() - 1);
+}
+
+uint32_t
+vk_draw_queue_add_mesh(Vk_Draw_Queue *queue, const Vk_Draw_Mesh &mesh)
+{
+    SDL_assert(queue->meshes.size() < (1u << s_draw_key_mesh_bits));
+
+    queue->meshes.push_back(mesh);
+    return static_cast<uint32_t>(queue->meshes.size() - 1);
+}
+
+static void
+vk_draw_queue_add_stats(Vk_Draw_Queue_Stats *total, const Vk_Draw_Queue_Stats &stats)
+{
+    total->draws_count += stats.draws_count;
+    total->draw_calls_count += stats.draw_calls_count;
+    total->pipeline_binds_count += stats.pipeline_binds_count;
+    total->descriptor_binds_count += stats.descriptor_binds_count;
+    total->buffer_binds_count += stats.buffer_binds_count;
+    total->dropped_count += stats.dropped_count;
+}
+
+void
+vk_draw_queue_begin(Vk_Draw_Queue *queue, uint32_t frame_index)
+{
+    vk_draw_queue_add_stats(&queue->report_stats, queue->stats);
+    queue->report_frames++;
+
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    // NOTE(gr3yknigh1): Report once per second, like frame time. [2025/04/08]
+    if (counter - queue->report_counter >= queue->frequency && queue->report_frames > 0) {
+        const Vk_Draw_Queue_Stats &report = queue->report_stats;
+        double frames = static_cast<double>(queue->report_frames);
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Draws: %.0f per frame in %.1f draw calls; binds per frame: %.1f pipeline, %.1f descriptor set, %.1f vertex buffer",
+            report.draws_count / frames, report.draw_calls_count / frames, report.pipeline_binds_count / frames,
+            report.descriptor_binds_count / frames, report.buffer_binds_count / frames);
+
+        if (report.dropped_count > 0) {
+            SDL_LogWarn(
+                SDL_LOG_CATEGORY_APPLICATION, "Draw queue: %llu draws over %u instances dropped",
+                static_cast<unsigned long long>(report.dropped_count), queue->max_instances);
+        }
+
+        queue->report_counter = counter;
+        queue->report_frames = 0;
+        queue->report_stats = {};
+    }
+
+    queue->frame_index = frame_index;
+    queue->stats = {};
+    queue->items.clear();
+    queue->instances.clear();
+    queue->batches.clear();
+}
+
+void
+vk_draw_queue_push(Vk_Draw_Queue *queue, uint64_t key, const void *instance)
+{
+    if (queue->items.size() >= queue->max_instances) {
+        queue->stats.dropped_count++;
+        return;
+    }
+
+    Vk_Draw_Item item = {};
+    item.key = key;
+    item.instance = static_cast<uint32_t>(queue->items.size());
+    queue->items.push_back(item);
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(instance);
+    queue->instances.insert(queue->instances.end(), bytes, bytes + queue->instance_size);
+}
+
+///
+/// @brief LSD radix sort by key, 8 bits per pass. Stable, so draws with equal keys stay in push order.
+///
+static void
+vk_draw_queue_sort(std::vector<Vk_Draw_Item> *items, std::vector<Vk_Draw_Item> *scratch)
+{
+    constexpr uint32_t digits_count = sizeof(uint64_t);
+
+    size_t count = items->size();
+    if (count < 2) {
+        return;
+    }
+
+    std::array<std::array<uint32_t, 256>, digits_count> histograms = {};
+    for (const Vk_Draw_Item &item : *items) {
+        for (uint32_t digit = 0; digit < digits_count; ++digit) {
+            histograms[digit][(item.key >> (digit * 8)) & 0xff]++;
+        }
+    }
+
+    scratch->resize(count);
+
+    Vk_Draw_Item *source = items->data();
+    Vk_Draw_Item *destination = scratch->data();
+
+    for (uint32_t digit = 0; digit < digits_count; ++digit) {
+        std::array<uint32_t, 256> &histogram = histograms[digit];
+
+        // NOTE(gr3yknigh1): Most keys share their upper bytes (few passes and pipelines), such pass would only copy. [2025/04/08]
+        if (histogram[(source[0].key >> (digit * 8)) & 0xff] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t &bucket : histogram) {
+            uint32_t bucket_count = bucket;
+            bucket = offset;
+            offset += bucket_count;
+        }
+
+        for (size_t index = 0; index < count; ++index) {
+            destination[histogram[(source[index].key >> (digit * 8)) & 0xff]++] = source[index];
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != items->data()) {
+        items->swap(*scratch);
+    }
+}
+
+void
+vk_draw_queue_end(Vk_Draw_Queue *queue)
+{
+    vk_draw_queue_sort(&queue->items, &queue->sorted_scratch);
+
+    uint8_t *mapped = static_cast<uint8_t *>(queue->instance_allocations[queue->frame_index].mapped);
+    uint32_t instance_size = queue->instance_size;
+
+    constexpr uint64_t state_mask = ~((1ull << s_draw_key_depth_bits) - 1);
+
+    for (uint32_t position = 0; position < queue->items.size(); ++position) {
+        const Vk_Draw_Item &item = queue->items[position];
+
+        memcpy(
+            mapped + static_cast<size_t>(position) * instance_size,
+            queue->instances.data() + static_cast<size_t>(item.instance) * instance_size, instance_size);
+
+        if (queue->batches.empty() || ((queue->batches.back().key ^ item.key) & state_mask) != 0) {
+            Vk_Draw_Batch batch = {};
+            batch.key = item.key;
+            batch.first_instance = position;
+            queue->batches.push_back(batch);
+        }
+
+        queue->batches.back().instances_count++;
+    }
+
+    queue->stats.draws_count = queue->items.size();
+}
+
+void
+vk_draw_queue_record(Vk_Draw_Queue *queue, VkCommandBuffer command_buffer, const void *push_constants)
+{
+    if (queue->batches.empty()) {
+        return;
+    }
+
+    Vk_Draw_Queue_Stats &stats = queue->stats;
+
+    // NOTE(gr3yknigh1): Layout is shared, so instances and push constants stay bound across pipeline changes. [2025/04/08]
+    vkCmdBindDescriptorSets(
+        command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, queue->pipeline_layout, 0, 1, &queue->sets[queue->frame_index], 0, nullptr);
+    stats.descriptor_binds_count++;
+
+    if (queue->push_constants_size > 0) {
+        vkCmdPushConstants(
+            command_buffer, queue->pipeline_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, queue->push_constants_size, push_constants);
+    }
+
+    VkPipeline bound_pipeline = VK_NULL_HANDLE;
+    uint32_t bound_material = UINT32_MAX;
+
+    // NOTE(gr3yknigh1): Meshes share buffers, so buffers are bound when they change, not when the mesh does. [2025/04/17]
+    VkBuffer bound_vertex_buffer = VK_NULL_HANDLE;
+    VkBuffer bound_index_buffer = VK_NULL_HANDLE;
+    VkIndexType bound_index_type = VK_INDEX_TYPE_MAX_ENUM;
+
+    for (const Vk_Draw_Batch &batch : queue->batches) {
+        uint32_t pipeline_id = static_cast<uint32_t>(batch.key >> s_draw_key_pipeline_shift) & ((1u << s_draw_key_pipeline_bits) - 1);
+        uint32_t material = static_cast<uint32_t>(batch.key >> s_draw_key_material_shift) & ((1u << s_draw_key_material_bits) - 1);
+        uint32_t mesh = static_cast<uint32_t>(batch.key >> s_draw_key_mesh_shift) & ((1u << s_draw_key_mesh_bits) - 1);
+
+        VkPipeline pipeline = *queue->pipelines[pipeline_id];
+        if (pipeline != bound_pipeline) {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            bound_pipeline = pipeline;
+            stats.pipeline_binds_count++;
+        }
+
+        if (material != bound_material) {
+            if (queue->materials[material] != VK_NULL_HANDLE) {
+                vkCmdBindDescriptorSets(
+                    command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, queue->pipeline_layout, 1, 1, &queue->materials[material],
+                    0, nullptr);
+                stats.descriptor_binds_count++;
+            }
+            bound_material = material;
+        }
+
+        const Vk_Draw_Mesh &draw_mesh = queue->meshes[mesh];
+        bool is_vertex_buffer_changed = draw_mesh.vertex_buffer != bound_vertex_buffer;
+        bool is_index_buffer_changed = draw_mesh.index_buffer != bound_index_buffer || draw_mesh.index_type != bound_index_type;
+
+        if (is_vertex_buffer_changed) {
+            VkDeviceSize vertex_buffer_offset = 0;
+            vkCmdBindVertexBuffers(command_buffer, 0, 1, &draw_mesh.vertex_buffer, &vertex_buffer_offset);
+            bound_vertex_buffer = draw_mesh.vertex_buffer;
+        }
+
+        if (is_index_buffer_changed) {
+            vkCmdBindIndexBuffer(command_buffer, draw_mesh.index_buffer, 0, draw_mesh.index_type);
+            bound_index_buffer = draw_mesh.index_buffer;
+            bound_index_type = draw_mesh.index_type;
+        }
+
+        if (is_vertex_buffer_changed || is_index_buffer_changed) {
+            stats.buffer_binds_count++;
+        }
+
+        vkCmdDrawIndexed(
+            command_buffer, draw_mesh.index_count, batch.instances_count, draw_mesh.first_index, draw_mesh.vertex_offset,
+            batch.first_instance);
+        stats.draw_calls_count++;
+    }
+}
@@ -0,0 +1,158 @@
+#pragma once
+///
+/// @brief Sort-key draw queue. Draws are pushed in any order with a 64-bit key, radix sorted, merged into instanced
+/// draws and recorded with only the state changes the sorted order needs.
+///
+/// Key, from the most significant bits:
+///     pass      4 bits - passes are recorded in this order;
+///     pipeline 10 bits - the most expensive change, so it is sorted first;
+///     material 12 bits - descriptor set at set 1;
+///     mesh     14 bits - vertex and index buffers;
+///     depth    24 bits - order inside the same state, e.g. front to back.
+///
+/// Draws whose keys differ only in depth become one instanced draw. Their instance data is written into the frame's
+/// instance buffer in sorted order, shader reads it with `gl_InstanceIndex` (set 0, binding 0, std430), so
+/// `firstInstance` of the draw is the first of them.
+///
+/// @note All pipelines share `pipeline_layout`: instances at set 0, materials at set 1 (if material set layout is
+/// given), push constants of the vertex stage at offset 0.
+/// @note Not thread safe.
+///
+
+constexpr uint32_t s_draw_key_depth_bits    = 24;
+constexpr uint32_t s_draw_key_mesh_bits     = 14;
+constexpr uint32_t s_draw_key_material_bits = 12;
+constexpr uint32_t s_draw_key_pipeline_bits = 10;
+constexpr uint32_t s_draw_key_pass_bits     = 4;
+
+constexpr uint32_t s_draw_key_mesh_shift     = s_draw_key_depth_bits;
+constexpr uint32_t s_draw_key_material_shift = s_draw_key_mesh_shift + s_draw_key_mesh_bits;
+constexpr uint32_t s_draw_key_pipeline_shift = s_draw_key_material_shift + s_draw_key_material_bits;
+constexpr uint32_t s_draw_key_pass_shift     = s_draw_key_pipeline_shift + s_draw_key_pipeline_bits;
+
+static_assert(s_draw_key_pass_shift + s_draw_key_pass_bits == 64, "Draw key must fill 64 bits");
+
+inline uint64_t
+vk_draw_key(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t depth)
+{
+    SDL_assert(pass < (1u << s_draw_key_pass_bits) && pipeline < (1u << s_draw_key_pipeline_bits));
+    SDL_assert(material < (1u << s_draw_key_material_bits) && mesh < (1u << s_draw_key_mesh_bits));
+    SDL_assert(depth < (1u << s_draw_key_depth_bits));
+
+    return (static_cast<uint64_t>(pass) << s_draw_key_pass_shift)
+        | (static_cast<uint64_t>(pipeline) << s_draw_key_pipeline_shift)
+        | (static_cast<uint64_t>(material) << s_draw_key_material_shift)
+        | (static_cast<uint64_t>(mesh) << s_draw_key_mesh_shift)
+        | static_cast<uint64_t>(depth);
+}
+
+struct Vk_Draw_Item {
+    uint64_t key      = 0;
+    uint32_t instance = 0; // Index of pushed instance data.
+};
+
+///
+/// @brief One instanced draw: instances [first_instance, first_instance + instances_count) of the frame's buffer.
+///
+struct Vk_Draw_Batch {
+    uint64_t key             = 0; // Of the first draw, depth bits aren't meaningful.
+    uint32_t first_instance  = 0;
+    uint32_t instances_count = 0;
+};
+
+///
+/// @brief Range of shared vertex and index buffers, so meshes of one scene differ only in the range they draw.
+///
+struct Vk_Draw_Mesh {
+    VkBuffer    vertex_buffer = VK_NULL_HANDLE;
+    VkBuffer    index_buffer  = VK_NULL_HANDLE;
+    VkIndexType index_type    = VK_INDEX_TYPE_UINT16;
+    uint32_t    index_count   = 0;
+    uint32_t    first_index   = 0; // In indices of `index_type`.
+    int32_t     vertex_offset = 0;
+};
+
+struct Vk_Draw_Queue_Stats {
+    uint64_t draws_count            = 0;
+    uint64_t draw_calls_count       = 0;
+    uint64_t pipeline_binds_count   = 0;
+    uint64_t descriptor_binds_count = 0;
+    uint64_t buffer_binds_count     = 0; // Vertex and index buffer pairs.
+    uint64_t dropped_count          = 0; // Pushed past `max_instances`.
+};
+
+struct Vk_Draw_Queue {
+    VkDevice      device    = VK_NULL_HANDLE;
+    Vk_Allocator *allocator = nullptr;
+
+    uint32_t max_instances       = 0;
+    uint32_t instance_size       = 0;
+    uint32_t push_constants_size = 0;
+
+    VkDescriptorSetLayout set_layout      = VK_NULL_HANDLE;
+    VkDescriptorPool      descriptor_pool = VK_NULL_HANDLE;
+    VkPipelineLayout      pipeline_layout = VK_NULL_HANDLE;
+
+    // NOTE(gr3yknigh1): Per frame in flight, written on CPU after the frame's timeline value is waited. [2025/04/08]
+    std::vector<VkBuffer>        instance_buffers;
+    std::vector<Vk_Allocation>   instance_allocations;
+    std::vector<VkDescriptorSet> sets;
+
+    // NOTE(gr3yknigh1): Pipelines are referenced, not copied, so handles swapped by shader reload are picked up. [2025/04/08]
+    std::vector<const VkPipeline *> pipelines;
+    std::vector<VkDescriptorSet>    materials; // VK_NULL_HANDLE binds nothing.
+    std::vector<Vk_Draw_Mesh>       meshes;
+
+    uint32_t                   frame_index = 0;
+    std::vector<Vk_Draw_Item>  items;
+    std::vector<Vk_Draw_Item>  sorted_scratch;
+    std::vector<uint8_t>       instances; // Instance data in push order.
+    std::vector<Vk_Draw_Batch> batches;
+
+    Vk_Draw_Queue_Stats stats; // Of the frame being built.
+
+    uint64_t            frequency      = 0;
+    uint64_t            report_counter = 0;
+    uint64_t            report_frames  = 0;
+    Vk_Draw_Queue_Stats report_stats; // Summed since the last report.
+};
+
+///
+/// @param max_instances Draws one frame can push, more are dropped.
+/// @param instance_size Per-draw data, as the shader's std430 array element.
+/// @param material_set_layout Layout of material sets, VK_NULL_HANDLE if pipelines don't use materials.
+///
+VkResult vk_draw_queue_init(
+    Vk_Draw_Queue *queue, Vk_Allocator *allocator, uint32_t frames_count, uint32_t max_instances, uint32_t instance_size,
+    VkDescriptorSetLayout material_set_layout, uint32_t push_constants_size);
+void vk_draw_queue_destroy(Vk_Draw_Queue *queue);
+
+///
+/// @param pipeline Created with `queue->pipeline_layout`, must outlive the queue.
+/// @return Pipeline id of the key.
+///
+uint32_t vk_draw_queue_add_pipeline(Vk_Draw_Queue *queue, const VkPipeline *pipeline);
+uint32_t vk_draw_queue_add_material(Vk_Draw_Queue *queue, VkDescriptorSet set);
+uint32_t vk_draw_queue_add_mesh(Vk_Draw_Queue *queue, const Vk_Draw_Mesh &mesh);
+
+///
+/// @brief Starts building draws of the frame. Frame's timeline value must be already waited.
+///
+void vk_draw_queue_begin(Vk_Draw_Queue *queue, uint32_t frame_index);
+
+///
+/// @param instance `instance_size` bytes, copied.
+///
+void vk_draw_queue_push(Vk_Draw_Queue *queue, uint64_t key, const void *instance);
+
+///
+/// @brief Sorts pushed draws, writes their instances into the frame's buffer and merges them into batches.
+///
+void vk_draw_queue_end(Vk_Draw_Queue *queue);
+
+///
+/// @brief Records batches. Viewport and scissor are left to the caller.
+///
+/// @param push_constants `push_constants_size` bytes, pushed once for all batches.
+///
+void vk_draw_queue_record(Vk_Draw_Queue *queue, VkCommandBuffer command_buffer, const void *push_constants);
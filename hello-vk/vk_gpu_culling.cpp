@@ -0,0 +1,399 @@
+#include "stdafx.h"
+
+#include "defer.h"
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_timeline.h"
+#include "vk_upload.h"
+#include "vk_deletion_queue.h"
+#include "vk_shader.h"
+#include "vk_pipeline.h"
+#include "vk_draw_queue.h"
+#include "camera.h"
+#include "vk_benchmark.h"
+#include "vk_gpu_culling.h"
+
+VkResult
+vk_make_gpu_culling(
+    const Vk_Device_Capabilities &capabilities, Vk_Allocator *allocator, Vk_Upload_Context *upload_context,
+    VkPipelineCache pipeline_cache, VkRenderPass render_pass, uint32_t frames_count, const Gpu_Object *objects,
+    uint32_t objects_count, uint32_t index_count, PFN_vkCmdDrawIndexedIndirectCountKHR draw_indexed_indirect_count,
+    Vk_Gpu_Culling *culling)
+{
+    VkResult result = VK_SUCCESS;
+    VkDevice device = allocator->device;
+
+    culling->objects_count = objects_count;
+    culling->index_count = index_count;
+    culling->draw_indexed_indirect_count = draw_indexed_indirect_count;
+
+    // NOTE(gr3yknigh1): Limit is at least 65535 with `multiDrawIndirect`. Compacted draw can't be split, since
+    // survivors count is known only on GPU, so such scenes are drawn in batches without compaction. [2025/04/01]
+    culling->max_draw_count = capabilities.properties.limits.maxDrawIndirectCount;
+    if (culling->draw_indexed_indirect_count != nullptr && culling->objects_count > culling->max_draw_count) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION, "Culling: %u objects exceed maxDrawIndirectCount %u, compaction is disabled",
+            culling->objects_count, culling->max_draw_count);
+        culling->draw_indexed_indirect_count = nullptr;
+    }
+
+    //
+    // Buffers:
+    //
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = static_cast<VkDeviceSize>(objects_count) * sizeof(Gpu_Object);
+    buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    result = vk_allocator_make_buffer(
+        allocator, buffer_create_info, Vk_Memory_Usage::Gpu_Only, &culling->objects_buffer, &culling->objects_allocation);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    culling->objects_buffer_ticket = vk_upload_buffer(
+        upload_context, culling->objects_buffer, 0, objects, buffer_create_info.size,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    if (culling->objects_buffer_ticket == 0) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    buffer_create_info.size = s_indirect_commands_offset + static_cast<VkDeviceSize>(culling->objects_count) * sizeof(VkDrawIndexedIndirectCommand);
+    buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    culling->indirect_buffers.resize(frames_count, VK_NULL_HANDLE);
+    culling->indirect_allocations.resize(frames_count);
+
+    for (uint32_t index = 0; index < frames_count; ++index) {
+        result = vk_allocator_make_buffer(
+            allocator, buffer_create_info, Vk_Memory_Usage::Gpu_Only, &culling->indirect_buffers[index],
+            &culling->indirect_allocations[index]);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    //
+    // Descriptors:
+    //
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo set_layout_create_info = {};
+    set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_layout_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    set_layout_create_info.pBindings = bindings.data();
+
+    result = vkCreateDescriptorSetLayout(device, &set_layout_create_info, nullptr, &culling->set_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkDescriptorPoolSize pool_size = {};
+    pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pool_size.descriptorCount = frames_count * static_cast<uint32_t>(bindings.size());
+
+    VkDescriptorPoolCreateInfo pool_create_info = {};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_create_info.maxSets = frames_count;
+    pool_create_info.poolSizeCount = 1;
+    pool_create_info.pPoolSizes = &pool_size;
+
+    result = vkCreateDescriptorPool(device, &pool_create_info, nullptr, &culling->descriptor_pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    std::vector<VkDescriptorSetLayout> set_layouts(frames_count, culling->set_layout);
+
+    VkDescriptorSetAllocateInfo set_allocate_info = {};
+    set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    set_allocate_info.descriptorPool = culling->descriptor_pool;
+    set_allocate_info.descriptorSetCount = frames_count;
+    set_allocate_info.pSetLayouts = set_layouts.data();
+
+    culling->sets.resize(frames_count, VK_NULL_HANDLE);
+    result = vkAllocateDescriptorSets(device, &set_allocate_info, culling->sets.data());
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    for (uint32_t index = 0; index < frames_count; ++index) {
+        std::array<VkDescriptorBufferInfo, 2> buffer_infos = {};
+        buffer_infos[0].buffer = culling->objects_buffer;
+        buffer_infos[0].range = VK_WHOLE_SIZE;
+        buffer_infos[1].buffer = culling->indirect_buffers[index];
+        buffer_infos[1].range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 2> writes = {};
+        for (uint32_t binding = 0; binding < writes.size(); ++binding) {
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = culling->sets[index];
+            writes[binding].dstBinding = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo = &buffer_infos[binding];
+        }
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    //
+    // Pipelines:
+    //
+    VkShaderModule compute_shader = vk_load_shader_module(device, "shaders/cull.comp.spv");
+    if (compute_shader == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    defer(vkDestroyShaderModule(device, compute_shader, nullptr));
+
+    VkShaderModule vertex_shader = vk_load_shader_module(device, "shaders/triangle_indirect.vert.spv");
+    if (vertex_shader == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    defer(vkDestroyShaderModule(device, vertex_shader, nullptr));
+
+    VkShaderModule fragment_shader = vk_load_shader_module(device, "shaders/triangle.frag.spv");
+    if (fragment_shader == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    defer(vkDestroyShaderModule(device, fragment_shader, nullptr));
+
+    VkPushConstantRange push_constant_range = {};
+    push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    push_constant_range.offset = 0;
+    push_constant_range.size = sizeof(Gpu_Culling_Constants);
+
+    VkPipelineLayoutCreateInfo layout_create_info = {};
+    layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_create_info.setLayoutCount = 1;
+    layout_create_info.pSetLayouts = &culling->set_layout;
+    layout_create_info.pushConstantRangeCount = 1;
+    layout_create_info.pPushConstantRanges = &push_constant_range;
+
+    result = vkCreatePipelineLayout(device, &layout_create_info, nullptr, &culling->cull_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    push_constant_range.size = sizeof(Camera);
+
+    result = vkCreatePipelineLayout(device, &layout_create_info, nullptr, &culling->draw_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = vk_make_compute_pipeline(device, pipeline_cache, culling->cull_layout, compute_shader, &culling->cull_pipeline);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = vk_make_triangle_pipeline(
+        device, pipeline_cache, render_pass, culling->draw_layout, vertex_shader, fragment_shader, nullptr, &culling->draw_pipeline);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Culling: GPU, %u objects, %s", culling->objects_count,
+        culling->draw_indexed_indirect_count != nullptr ? "compacted with draw indirect count" : "not compacted");
+
+    return VK_SUCCESS;
+}
+
+void
+vk_destroy_gpu_culling(Vk_Allocator *allocator, Vk_Gpu_Culling *culling)
+{
+    VkDevice device = allocator->device;
+
+    vkDestroyPipeline(device, culling->draw_pipeline, nullptr);
+    vkDestroyPipeline(device, culling->cull_pipeline, nullptr);
+    vkDestroyPipelineLayout(device, culling->draw_layout, nullptr);
+    vkDestroyPipelineLayout(device, culling->cull_layout, nullptr);
+    vkDestroyDescriptorPool(device, culling->descriptor_pool, nullptr);
+    vkDestroyDescriptorSetLayout(device, culling->set_layout, nullptr);
+
+    for (size_t index = 0; index < culling->indirect_buffers.size(); ++index) {
+        if (culling->indirect_buffers[index] != VK_NULL_HANDLE) {
+            vk_allocator_destroy_buffer(allocator, culling->indirect_buffers[index], &culling->indirect_allocations[index]);
+        }
+    }
+
+    if (culling->objects_buffer != VK_NULL_HANDLE) {
+        vk_allocator_destroy_buffer(allocator, culling->objects_buffer, &culling->objects_allocation);
+    }
+
+    *culling = {};
+}
+
+void
+vk_record_gpu_culling_reset(const Vk_Gpu_Culling &culling, VkCommandBuffer command_buffer, uint32_t frame_index)
+{
+    // NOTE(gr3yknigh1): Only the counter needs reset: compute writes every command it is going to draw. [2025/04/01]
+    vkCmdFillBuffer(command_buffer, culling.indirect_buffers[frame_index], 0, sizeof(uint32_t), 0);
+}
+
+void
+vk_record_gpu_culling(const Vk_Gpu_Culling &culling, VkCommandBuffer command_buffer, uint32_t frame_index, const Camera &camera)
+{
+    bool is_compacting = culling.draw_indexed_indirect_count != nullptr;
+
+    Gpu_Culling_Constants constants = {};
+    constants.camera = camera;
+    constants.objects_count = culling.objects_count;
+    constants.index_count = culling.index_count;
+    constants.is_compacting = is_compacting ? 1 : 0;
+
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.cull_pipeline);
+    vkCmdBindDescriptorSets(
+        command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling.cull_layout, 0, 1, &culling.sets[frame_index], 0, nullptr);
+    vkCmdPushConstants(command_buffer, culling.cull_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+    vkCmdDispatch(command_buffer, (culling.objects_count + 255) / 256, 1, 1);
+}
+
+void
+vk_record_gpu_culling_draw(
+    const Vk_Gpu_Culling &culling, VkCommandBuffer command_buffer, uint32_t frame_index, const Vk_Draw_Mesh &mesh,
+    const Camera &camera, VkExtent2D extent)
+{
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, culling.draw_pipeline);
+
+    VkViewport viewport = {};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+
+    VkRect2D scissor = {};
+    scissor.offset = { 0, 0 };
+    scissor.extent = extent;
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+    vkCmdBindDescriptorSets(
+        command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, culling.draw_layout, 0, 1, &culling.sets[frame_index], 0, nullptr);
+    vkCmdPushConstants(command_buffer, culling.draw_layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Camera), &camera);
+
+    VkDeviceSize vertex_buffer_offset = 0;
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, &mesh.vertex_buffer, &vertex_buffer_offset);
+    vkCmdBindIndexBuffer(command_buffer, mesh.index_buffer, 0, mesh.index_type);
+
+    VkBuffer indirect_buffer = culling.indirect_buffers[frame_index];
+    constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+    if (culling.draw_indexed_indirect_count != nullptr) {
+        culling.draw_indexed_indirect_count(
+            command_buffer, indirect_buffer, s_indirect_commands_offset, indirect_buffer, 0, culling.objects_count, stride);
+        return;
+    }
+
+    for (uint32_t first = 0; first < culling.objects_count; first += culling.max_draw_count) {
+        uint32_t count = std::min(culling.max_draw_count, culling.objects_count - first);
+        vkCmdDrawIndexedIndirect(
+            command_buffer, indirect_buffer, s_indirect_commands_offset + static_cast<VkDeviceSize>(first) * stride, count, stride);
+    }
+}
+
+void
+vk_benchmark_culling(
+    const Vk_Benchmark_Frames &cpu_culled_frames, const Vk_Benchmark_Frames *gpu_culled_frames, VkDevice device,
+    Vk_Upload_Context *upload_context, const Gpu_Object *objects, uint32_t objects_count)
+{
+    constexpr uint32_t warmup_frames_count = 20;
+    constexpr uint32_t frames_count = 200;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Benchmark: culling %u draws, %u frames in flight, %u frames per mode",
+        objects_count, cpu_culled_frames.frames_count, frames_count);
+
+    // NOTE(gr3yknigh1): Both modes replay the same camera path, so they draw the same objects. [2025/04/01]
+    uint64_t visible_count = 0;
+    for (uint32_t iteration = warmup_frames_count; iteration < warmup_frames_count + frames_count; ++iteration) {
+        Camera camera = make_camera(iteration / 60.0f);
+
+        for (uint32_t index = 0; index < objects_count; ++index) {
+            visible_count += camera_is_circle_visible(camera, objects[index].offset, objects[index].radius) ? 1 : 0;
+        }
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Benchmark: %.1f%% of draws visible on average",
+        100.0 * static_cast<double>(visible_count) / (static_cast<double>(objects_count) * frames_count));
+
+    if (gpu_culled_frames == nullptr) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Benchmark: device can't draw indirect, measuring CPU culling only");
+    }
+
+    // NOTE(gr3yknigh1): Uploads must land before measuring, otherwise frames are recorded without draws. [2025/04/01]
+    vk_upload_flush(upload_context);
+    vkDeviceWaitIdle(device);
+
+    std::array<const Vk_Benchmark_Frames *, 2> modes = { &cpu_culled_frames, gpu_culled_frames };
+    std::array<const char *, 2> names = { "cpu", "gpu" };
+    std::array<double, 2> cpu_ms = {};
+
+    for (size_t mode = 0; mode < modes.size(); ++mode) {
+        if (modes[mode] == nullptr) {
+            break;
+        }
+
+        const Vk_Benchmark_Frames &frames = *modes[mode];
+
+        uint64_t cpu_ticks = 0;
+        uint64_t start_counter = 0;
+
+        for (uint32_t iteration = 0; iteration < warmup_frames_count + frames_count; ++iteration) {
+            if (iteration == warmup_frames_count) {
+                vkDeviceWaitIdle(device);
+                start_counter = SDL_GetPerformanceCounter();
+            }
+
+            uint32_t frame_index = iteration % frames.frames_count;
+
+            VkResult result = frames.wait(frames.user_data, frame_index);
+            SDL_assert(result == VK_SUCCESS);
+
+            uint64_t counter = SDL_GetPerformanceCounter();
+
+            Camera camera = make_camera(iteration / 60.0f);
+
+            Vk_Benchmark_Frame frame = {};
+            frame.frame_index = frame_index;
+            frame.frame_number = iteration + 1;
+            frame.camera = &camera;
+
+            result = frames.submit(frames.user_data, frame);
+            SDL_assert(result == VK_SUCCESS);
+
+            if (iteration >= warmup_frames_count) {
+                cpu_ticks += SDL_GetPerformanceCounter() - counter;
+            }
+        }
+
+        vkDeviceWaitIdle(device);
+
+        double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        double total_ms = static_cast<double>(SDL_GetPerformanceCounter() - start_counter) * 1000.0 / frequency / frames_count;
+        cpu_ms[mode] = static_cast<double>(cpu_ticks) * 1000.0 / frequency / frames_count;
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Benchmark: %s culling: CPU %8.3f ms/frame, total %8.3f ms/frame", names[mode],
+            cpu_ms[mode], total_ms);
+    }
+
+    if (gpu_culled_frames != nullptr) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Benchmark: GPU culling CPU time speedup %.2fx", cpu_ms[0] / cpu_ms[1]);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+///
+/// @brief GPU-driven path: compute pass culls objects against the camera and writes indirect command per object,
+/// main pass issues all of them with one indirect draw. CPU cost doesn't depend on objects count.
+///
+/// With `VK_KHR_draw_indirect_count` survivors are compacted and GPU reads their count from the buffer. Without it
+/// every object keeps its slot and culled ones get zero instances.
+///
+/// @note Objects all draw the same mesh, `vk_record_gpu_culling_draw` binds it.
+///
+
+///
+/// @brief Per-object data of GPU-driven path, indexed by `gl_InstanceIndex` in vertex shader.
+///
+struct Gpu_Object {
+    float offset[2];
+    float scale;
+    float radius; // Bounding circle radius, already scaled.
+};
+
+struct Gpu_Culling_Constants {
+    Camera   camera;
+    uint32_t objects_count = 0;
+    uint32_t index_count   = 0;
+    uint32_t is_compacting = 0;
+};
+
+// NOTE(gr3yknigh1): Indirect buffer starts with draw count, padded so commands are 16-byte aligned. [2025/04/01]
+constexpr VkDeviceSize s_indirect_commands_offset = 16;
+
+struct Vk_Gpu_Culling {
+    uint32_t objects_count  = 0;
+    uint32_t index_count    = 0;
+    uint32_t max_draw_count = 0; // `maxDrawIndirectCount`, draws without compaction are split by it.
+
+    VkBuffer      objects_buffer        = VK_NULL_HANDLE;
+    Vk_Allocation objects_allocation;
+    uint64_t      objects_buffer_ticket = 0;
+
+    // NOTE(gr3yknigh1): Per frame in flight, culling of the next frame never overwrites commands being drawn. [2025/04/01]
+    std::vector<VkBuffer>      indirect_buffers;
+    std::vector<Vk_Allocation> indirect_allocations;
+
+    VkDescriptorSetLayout        set_layout      = VK_NULL_HANDLE;
+    VkDescriptorPool             descriptor_pool = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> sets; // Per frame: objects at binding 0, frame's indirect buffer at binding 1.
+
+    VkPipelineLayout cull_layout   = VK_NULL_HANDLE;
+    VkPipeline       cull_pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout draw_layout   = VK_NULL_HANDLE;
+    VkPipeline       draw_pipeline = VK_NULL_HANDLE;
+
+    // NOTE(gr3yknigh1): nullptr if `VK_KHR_draw_indirect_count` isn't enabled, then commands aren't compacted. [2025/04/01]
+    PFN_vkCmdDrawIndexedIndirectCountKHR draw_indexed_indirect_count = nullptr;
+};
+
+///
+/// @note Objects are uploaded through `upload_context`, culling waits for `objects_buffer_ticket`.
+///
+/// @param capabilities Of the device's physical device, `maxDrawIndirectCount` is taken from it.
+/// @param index_count Index count of the mesh every object draws.
+/// @param draw_indexed_indirect_count Entry point of `VK_KHR_draw_indirect_count`, nullptr if it isn't enabled.
+///
+VkResult vk_make_gpu_culling(
+    const Vk_Device_Capabilities &capabilities, Vk_Allocator *allocator, Vk_Upload_Context *upload_context,
+    VkPipelineCache pipeline_cache, VkRenderPass render_pass, uint32_t frames_count, const Gpu_Object *objects,
+    uint32_t objects_count, uint32_t index_count, PFN_vkCmdDrawIndexedIndirectCountKHR draw_indexed_indirect_count,
+    Vk_Gpu_Culling *culling);
+void vk_destroy_gpu_culling(Vk_Allocator *allocator, Vk_Gpu_Culling *culling);
+
+///
+/// @brief Zeroes draw count of frame's indirect buffer. Only needed if commands are compacted.
+///
+void vk_record_gpu_culling_reset(const Vk_Gpu_Culling &culling, VkCommandBuffer command_buffer, uint32_t frame_index);
+
+///
+/// @brief Records culling dispatch of frame's objects. Must be recorded outside of render pass, before the draw.
+///
+/// @note Barriers around it (after the reset, before the indirect draw) are placed by the frame graph.
+///
+void vk_record_gpu_culling(const Vk_Gpu_Culling &culling, VkCommandBuffer command_buffer, uint32_t frame_index, const Camera &camera);
+
+///
+/// @brief Records indirect draw of objects which survived `vk_record_gpu_culling` of the same frame.
+///
+/// @param mesh Mesh every object draws, `index_count` of it is the one culling was made with.
+///
+void vk_record_gpu_culling_draw(
+    const Vk_Gpu_Culling &culling, VkCommandBuffer command_buffer, uint32_t frame_index, const Vk_Draw_Mesh &mesh,
+    const Camera &camera, VkExtent2D extent);
+
+///
+/// @brief Measures CPU time per frame (recording and submit, without frame waits) with culling on CPU and on GPU.
+/// Both replay the same camera path.
+///
+/// @param cpu_culled_frames, gpu_culled_frames Frames of the same objects, culled on CPU and by GPU. Latter is
+/// nullptr if device can't draw indirect.
+/// @param objects Objects the frames draw, for the share of visible ones.
+///
+void vk_benchmark_culling(
+    const Vk_Benchmark_Frames &cpu_culled_frames, const Vk_Benchmark_Frames *gpu_culled_frames, VkDevice device,
+    Vk_Upload_Context *upload_context, const Gpu_Object *objects, uint32_t objects_count);
@@ -0,0 +1,501 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_memory.h"
+
+static constexpr VkDeviceSize s_vk_large_heap_block_size = 64ull * 1024 * 1024;
+static constexpr VkDeviceSize s_vk_small_heap_size       = 1024ull * 1024 * 1024;
+
+static uint32_t
+vk_allocator_device_memory_count(const Vk_Allocator *allocator)
+{
+    uint32_t count = allocator->dedicated_count;
+    for (const auto &blocks : allocator->blocks) {
+        count += static_cast<uint32_t>(blocks.size());
+    }
+    return count;
+}
+
+static VkResult
+vk_allocator_allocate_device_memory(
+    Vk_Allocator *allocator, VkDeviceSize size, uint32_t memory_type, VkDeviceMemory *memory, void **mapped)
+{
+    uint32_t device_memory_count = vk_allocator_device_memory_count(allocator);
+    if (device_memory_count + 1 > allocator->max_memory_allocation_count) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION, "Vulkan memory: maxMemoryAllocationCount (%u) exceeded",
+            allocator->max_memory_allocation_count);
+    }
+
+    VkMemoryAllocateInfo allocate_info = {};
+    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocate_info.allocationSize = size;
+    allocate_info.memoryTypeIndex = memory_type;
+
+    VkResult result = vkAllocateMemory(allocator->device, &allocate_info, nullptr, memory);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkAllocateMemory(%llu) = %s", static_cast<unsigned long long>(size), string_VkResult(result));
+        return result;
+    }
+
+    *mapped = nullptr;
+    if (allocator->memory_properties.memoryTypes[memory_type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        result = vkMapMemory(allocator->device, *memory, 0, VK_WHOLE_SIZE, 0, mapped);
+        if (result != VK_SUCCESS) {
+            vkFreeMemory(allocator->device, *memory, nullptr);
+            *memory = VK_NULL_HANDLE;
+            return result;
+        }
+    }
+
+    allocator->peak_device_memory_count = std::max(allocator->peak_device_memory_count, device_memory_count + 1);
+    return VK_SUCCESS;
+}
+
+///
+/// @brief First-fit search in block's free list. Splits the found range into leading padding and tail.
+///
+static std::optional<VkDeviceSize>
+vk_memory_block_allocate(Vk_Memory_Block *block, VkDeviceSize size, VkDeviceSize alignment)
+{
+    for (size_t index = 0; index < block->free_ranges.size(); ++index) {
+        Vk_Memory_Range range = block->free_ranges[index];
+
+        VkDeviceSize offset = vk_align_up(range.offset, alignment);
+        VkDeviceSize padding = offset - range.offset;
+
+        if (padding + size > range.size) {
+            continue;
+        }
+
+        Vk_Memory_Range head = { range.offset, padding };
+        Vk_Memory_Range tail = { offset + size, range.size - padding - size };
+
+        block->free_ranges.erase(block->free_ranges.begin() + index);
+        if (tail.size > 0) {
+            block->free_ranges.insert(block->free_ranges.begin() + index, tail);
+        }
+        if (head.size > 0) {
+            block->free_ranges.insert(block->free_ranges.begin() + index, head);
+        }
+
+        block->used += size;
+        return offset;
+    }
+
+    return std::nullopt;
+}
+
+static void
+vk_memory_block_free(Vk_Memory_Block *block, VkDeviceSize offset, VkDeviceSize size)
+{
+    auto &ranges = block->free_ranges;
+
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), offset, [](const Vk_Memory_Range &range, VkDeviceSize value) {
+        return range.offset < value;
+    });
+    it = ranges.insert(it, Vk_Memory_Range{ offset, size });
+
+    auto next = it + 1;
+    if (next != ranges.end() && it->offset + it->size == next->offset) {
+        it->size += next->size;
+        ranges.erase(next);
+    }
+
+    if (it != ranges.begin()) {
+        auto previous = it - 1;
+        if (previous->offset + previous->size == it->offset) {
+            previous->size += it->size;
+            ranges.erase(it);
+        }
+    }
+
+    block->used -= size;
+}
+
+VkResult
+vk_allocator_init(Vk_Allocator *allocator, const Vk_Device_Capabilities &capabilities, VkDevice device)
+{
+    *allocator = {};
+    allocator->device = device;
+    allocator->memory_properties = capabilities.memory_properties;
+    allocator->max_memory_allocation_count = capabilities.properties.limits.maxMemoryAllocationCount;
+
+    for (uint32_t index = 0; index < allocator->memory_properties.memoryTypeCount; ++index) {
+        uint32_t heap_index = allocator->memory_properties.memoryTypes[index].heapIndex;
+        VkDeviceSize heap_size = allocator->memory_properties.memoryHeaps[heap_index].size;
+
+        allocator->block_sizes[index] = heap_size <= s_vk_small_heap_size
+            ? vk_align_up(heap_size / 8, 1024 * 1024)
+            : s_vk_large_heap_block_size;
+    }
+
+    return VK_SUCCESS;
+}
+
+void
+vk_allocator_destroy(Vk_Allocator *allocator)
+{
+    vk_allocator_log_stats(allocator);
+
+    if (allocator->allocations_count > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Vulkan memory: %u allocations leaked", allocator->allocations_count);
+    }
+
+    for (auto &blocks : allocator->blocks) {
+        for (auto &block : blocks) {
+            vkFreeMemory(allocator->device, block->memory, nullptr);
+        }
+        blocks.clear();
+    }
+}
+
+std::optional<uint32_t>
+vk_allocator_find_memory_type(const Vk_Allocator *allocator, uint32_t type_bits, Vk_Memory_Usage usage)
+{
+    VkMemoryPropertyFlags required = 0;
+    VkMemoryPropertyFlags preferred = 0;
+
+    switch (usage) {
+    case Vk_Memory_Usage::Gpu_Only:
+        required = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        break;
+    case Vk_Memory_Usage::Cpu_To_Gpu:
+        required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        break;
+    case Vk_Memory_Usage::Gpu_To_Cpu:
+        required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        preferred = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        break;
+    }
+
+    const VkPhysicalDeviceMemoryProperties &properties = allocator->memory_properties;
+
+    for (VkMemoryPropertyFlags flags : { required | preferred, required }) {
+        for (uint32_t index = 0; index < properties.memoryTypeCount; ++index) {
+            bool is_allowed = (type_bits & (1u << index)) != 0;
+            bool has_flags = (properties.memoryTypes[index].propertyFlags & flags) == flags;
+
+            if (is_allowed && has_flags) {
+                return index;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+VkResult
+vk_allocator_allocate(
+    Vk_Allocator *allocator, const VkMemoryRequirements &requirements, Vk_Memory_Usage usage, bool is_linear,
+    Vk_Allocation *result)
+{
+    VkResult vk_result = VK_SUCCESS;
+
+    std::optional<uint32_t> memory_type = vk_allocator_find_memory_type(allocator, requirements.memoryTypeBits, usage);
+    if (!memory_type.has_value()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Vulkan memory: no memory type for bits 0x%x", requirements.memoryTypeBits);
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    *result = {};
+    result->size = requirements.size;
+    result->memory_type = memory_type.value();
+
+    VkDeviceSize block_size = allocator->block_sizes[memory_type.value()];
+
+    //
+    // Dedicated allocation:
+    //
+    if (requirements.size > block_size / 2) {
+        vk_result = vk_allocator_allocate_device_memory(
+            allocator, requirements.size, memory_type.value(), &result->memory, &result->mapped);
+        if (vk_result != VK_SUCCESS) {
+            return vk_result;
+        }
+
+        allocator->dedicated_count++;
+        allocator->dedicated_bytes += requirements.size;
+        allocator->allocations_count++;
+        return VK_SUCCESS;
+    }
+
+    //
+    // Sub-allocation from existing block:
+    //
+    auto &blocks = allocator->blocks[memory_type.value()];
+
+    for (auto &block : blocks) {
+        if (block->is_linear != is_linear) {
+            continue;
+        }
+
+        std::optional<VkDeviceSize> offset = vk_memory_block_allocate(block.get(), requirements.size, requirements.alignment);
+        if (offset.has_value()) {
+            result->memory = block->memory;
+            result->offset = offset.value();
+            result->mapped = block->mapped ? static_cast<uint8_t *>(block->mapped) + offset.value() : nullptr;
+            result->block = block.get();
+
+            allocator->allocations_count++;
+            return VK_SUCCESS;
+        }
+    }
+
+    //
+    // New block:
+    //
+    auto block = std::make_unique<Vk_Memory_Block>();
+    block->size = block_size;
+    block->memory_type = memory_type.value();
+    block->is_linear = is_linear;
+    block->free_ranges.push_back(Vk_Memory_Range{ 0, block_size });
+
+    vk_result = vk_allocator_allocate_device_memory(allocator, block_size, memory_type.value(), &block->memory, &block->mapped);
+    if (vk_result != VK_SUCCESS) {
+        return vk_result;
+    }
+
+    std::optional<VkDeviceSize> offset = vk_memory_block_allocate(block.get(), requirements.size, requirements.alignment);
+    SDL_assert(offset.has_value());
+
+    result->memory = block->memory;
+    result->offset = offset.value();
+    result->mapped = block->mapped ? static_cast<uint8_t *>(block->mapped) + offset.value() : nullptr;
+    result->block = block.get();
+
+    blocks.push_back(std::move(block));
+
+    allocator->allocations_count++;
+    return VK_SUCCESS;
+}
+
+void
+vk_allocator_free(Vk_Allocator *allocator, Vk_Allocation *allocation)
+{
+    if (allocation->memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    allocator->allocations_count--;
+
+    if (allocation->block == nullptr) {
+        vkFreeMemory(allocator->device, allocation->memory, nullptr);
+
+        allocator->dedicated_count--;
+        allocator->dedicated_bytes -= allocation->size;
+
+        *allocation = {};
+        return;
+    }
+
+    Vk_Memory_Block *block = allocation->block;
+    vk_memory_block_free(block, allocation->offset, allocation->size);
+
+    //
+    // NOTE(gr3yknigh1): Empty block is released only if there is another one of the same kind, so alloc/free
+    // of a single resource doesn't hit `vkAllocateMemory` every time. [2025/03/25]
+    //
+    if (block->used == 0) {
+        auto &blocks = allocator->blocks[block->memory_type];
+
+        auto same_kind_count = std::count_if(blocks.begin(), blocks.end(), [block](const auto &other) {
+            return other->is_linear == block->is_linear;
+        });
+
+        if (same_kind_count > 1) {
+            vkFreeMemory(allocator->device, block->memory, nullptr);
+
+            blocks.erase(std::find_if(blocks.begin(), blocks.end(), [block](const auto &other) {
+                return other.get() == block;
+            }));
+        }
+    }
+
+    *allocation = {};
+}
+
+VkResult
+vk_allocator_make_buffer(
+    Vk_Allocator *allocator, const VkBufferCreateInfo &create_info, Vk_Memory_Usage usage,
+    VkBuffer *buffer, Vk_Allocation *allocation)
+{
+    VkResult result = vkCreateBuffer(allocator->device, &create_info, nullptr, buffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkMemoryRequirements requirements = {};
+    vkGetBufferMemoryRequirements(allocator->device, *buffer, &requirements);
+
+    result = vk_allocator_allocate(allocator, requirements, usage, true, allocation);
+    if (result == VK_SUCCESS) {
+        result = vkBindBufferMemory(allocator->device, *buffer, allocation->memory, allocation->offset);
+    }
+
+    if (result != VK_SUCCESS) {
+        vk_allocator_free(allocator, allocation);
+        vkDestroyBuffer(allocator->device, *buffer, nullptr);
+        *buffer = VK_NULL_HANDLE;
+    }
+
+    return result;
+}
+
+VkResult
+vk_allocator_make_image(
+    Vk_Allocator *allocator, const VkImageCreateInfo &create_info, Vk_Memory_Usage usage,
+    VkImage *image, Vk_Allocation *allocation)
+{
+    VkResult result = vkCreateImage(allocator->device, &create_info, nullptr, image);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkMemoryRequirements requirements = {};
+    vkGetImageMemoryRequirements(allocator->device, *image, &requirements);
+
+    bool is_linear = create_info.tiling == VK_IMAGE_TILING_LINEAR;
+
+    result = vk_allocator_allocate(allocator, requirements, usage, is_linear, allocation);
+    if (result == VK_SUCCESS) {
+        result = vkBindImageMemory(allocator->device, *image, allocation->memory, allocation->offset);
+    }
+
+    if (result != VK_SUCCESS) {
+        vk_allocator_free(allocator, allocation);
+        vkDestroyImage(allocator->device, *image, nullptr);
+        *image = VK_NULL_HANDLE;
+    }
+
+    return result;
+}
+
+void
+vk_allocator_destroy_buffer(Vk_Allocator *allocator, VkBuffer buffer, Vk_Allocation *allocation)
+{
+    vkDestroyBuffer(allocator->device, buffer, nullptr);
+    vk_allocator_free(allocator, allocation);
+}
+
+void
+vk_allocator_destroy_image(Vk_Allocator *allocator, VkImage image, Vk_Allocation *allocation)
+{
+    vkDestroyImage(allocator->device, image, nullptr);
+    vk_allocator_free(allocator, allocation);
+}
+
+Vk_Allocator_Stats
+vk_allocator_get_stats(const Vk_Allocator *allocator)
+{
+    Vk_Allocator_Stats stats = {};
+
+    VkDeviceSize free_bytes = 0;
+
+    for (const auto &blocks : allocator->blocks) {
+        for (const auto &block : blocks) {
+            stats.reserved_bytes += block->size;
+            stats.used_bytes += block->used;
+            stats.blocks_count++;
+
+            for (const auto &range : block->free_ranges) {
+                free_bytes += range.size;
+                stats.largest_free_range = std::max(stats.largest_free_range, range.size);
+            }
+        }
+    }
+
+    stats.reserved_bytes += allocator->dedicated_bytes;
+    stats.used_bytes += allocator->dedicated_bytes;
+    stats.dedicated_count = allocator->dedicated_count;
+    stats.allocations_count = allocator->allocations_count;
+    stats.device_memory_count = stats.blocks_count + stats.dedicated_count;
+
+    if (free_bytes > 0) {
+        stats.fragmentation = 1.0f - static_cast<float>(stats.largest_free_range) / static_cast<float>(free_bytes);
+    }
+
+    return stats;
+}
+
+void
+vk_allocator_log_stats(const Vk_Allocator *allocator)
+{
+    Vk_Allocator_Stats stats = vk_allocator_get_stats(allocator);
+
+    constexpr double mib = 1024.0 * 1024.0;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Vulkan memory: reserved %.2f MiB, used %.2f MiB, fragmentation %.2f",
+        stats.reserved_bytes / mib, stats.used_bytes / mib, stats.fragmentation);
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "Vulkan memory: %u allocations, %u device memory objects (peak %u, limit %u), %u blocks, %u dedicated",
+        stats.allocations_count, stats.device_memory_count, allocator->peak_device_memory_count,
+        allocator->max_memory_allocation_count, stats.blocks_count, stats.dedicated_count);
+
+    for (uint32_t index = 0; index < allocator->memory_properties.memoryTypeCount; ++index) {
+        const auto &blocks = allocator->blocks[index];
+        if (blocks.empty()) {
+            continue;
+        }
+
+        VkDeviceSize reserved = 0, used = 0;
+        for (const auto &block : blocks) {
+            reserved += block->size;
+            used += block->used;
+        }
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "    type %u (flags 0x%x): %zu blocks, %.2f / %.2f MiB",
+            index, allocator->memory_properties.memoryTypes[index].propertyFlags, blocks.size(), used / mib, reserved / mib);
+    }
+}
+
+VkResult
+vk_linear_arena_init(Vk_Allocator *allocator, VkDeviceSize size, VkBufferUsageFlags usage, Vk_Linear_Arena *arena)
+{
+    *arena = {};
+    arena->size = size;
+
+    VkBufferCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    create_info.size = size;
+    create_info.usage = usage;
+    create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    return vk_allocator_make_buffer(allocator, create_info, Vk_Memory_Usage::Cpu_To_Gpu, &arena->buffer, &arena->allocation);
+}
+
+void
+vk_linear_arena_destroy(Vk_Allocator *allocator, Vk_Linear_Arena *arena)
+{
+    if (arena->buffer != VK_NULL_HANDLE) {
+        vk_allocator_destroy_buffer(allocator, arena->buffer, &arena->allocation);
+    }
+    *arena = {};
+}
+
+std::optional<VkDeviceSize>
+vk_linear_arena_push(Vk_Linear_Arena *arena, VkDeviceSize size, VkDeviceSize alignment, void **mapped)
+{
+    VkDeviceSize offset = vk_align_up(arena->head, alignment);
+    if (offset + size > arena->size) {
+        return std::nullopt;
+    }
+
+    arena->head = offset + size;
+    arena->peak = std::max(arena->peak, arena->head);
+
+    if (mapped != nullptr) {
+        *mapped = static_cast<uint8_t *>(arena->allocation.mapped) + offset;
+    }
+
+    return offset;
+}
+
+void
+vk_linear_arena_reset(Vk_Linear_Arena *arena)
+{
+    arena->head = 0;
+}
@@ -0,0 +1,140 @@
+#pragma once
+///
+/// @brief Device memory sub-allocator.
+///
+/// Resources don't get their own `vkAllocateMemory`: they are placed into large per-memory-type blocks
+/// (first-fit free list with coalescing). Big resources get dedicated allocations. Buffers and images never
+/// share a block, so `bufferImageGranularity` doesn't need to be tracked.
+///
+/// @note Not thread safe.
+///
+
+inline VkDeviceSize
+vk_align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+    if (alignment <= 1) {
+        return value;
+    }
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+enum class Vk_Memory_Usage {
+    Gpu_Only,   // DEVICE_LOCAL.
+    Cpu_To_Gpu, // HOST_VISIBLE | HOST_COHERENT, persistently mapped. Staging and per-frame data.
+    Gpu_To_Cpu, // HOST_VISIBLE | HOST_COHERENT, HOST_CACHED preferred. Readback.
+};
+
+struct Vk_Memory_Range {
+    VkDeviceSize offset = 0;
+    VkDeviceSize size   = 0;
+};
+
+struct Vk_Memory_Block {
+    VkDeviceMemory memory      = VK_NULL_HANDLE;
+    VkDeviceSize   size        = 0;
+    VkDeviceSize   used        = 0;
+    void          *mapped      = nullptr;
+    uint32_t       memory_type = 0;
+    bool           is_linear   = false;
+
+    // NOTE(gr3yknigh1): Sorted by offset, neighbours are merged on free. [2025/03/25]
+    std::vector<Vk_Memory_Range> free_ranges;
+};
+
+struct Vk_Allocation {
+    VkDeviceMemory   memory      = VK_NULL_HANDLE;
+    VkDeviceSize     offset      = 0;
+    VkDeviceSize     size        = 0;
+    void            *mapped      = nullptr; // Already offset. nullptr if memory isn't host visible.
+    uint32_t         memory_type = 0;
+    Vk_Memory_Block *block       = nullptr; // nullptr for dedicated allocation.
+};
+
+struct Vk_Allocator_Stats {
+    VkDeviceSize reserved_bytes     = 0; // Sum of all `VkDeviceMemory` sizes.
+    VkDeviceSize used_bytes         = 0;
+    VkDeviceSize largest_free_range = 0;
+
+    uint32_t allocations_count   = 0; // Live sub-allocations and dedicated allocations.
+    uint32_t device_memory_count = 0; // Live `VkDeviceMemory` objects, limited by `maxMemoryAllocationCount`.
+    uint32_t blocks_count        = 0;
+    uint32_t dedicated_count     = 0;
+
+    // NOTE(gr3yknigh1): 0 - all free space in blocks is one range, close to 1 - free space is scattered. [2025/03/25]
+    float fragmentation = 0.0f;
+};
+
+struct Vk_Allocator {
+    VkDevice device = VK_NULL_HANDLE;
+
+    VkPhysicalDeviceMemoryProperties memory_properties = {};
+    uint32_t max_memory_allocation_count = 0;
+
+    // NOTE(gr3yknigh1): Picked per heap: 1/8 of small heaps, 64 MiB otherwise. Requests bigger than half a block
+    // go to dedicated allocations. [2025/03/25]
+    std::array<VkDeviceSize, VK_MAX_MEMORY_TYPES> block_sizes = {};
+
+    std::array<std::vector<std::unique_ptr<Vk_Memory_Block>>, VK_MAX_MEMORY_TYPES> blocks;
+
+    uint32_t     dedicated_count = 0;
+    VkDeviceSize dedicated_bytes = 0;
+    uint32_t     allocations_count = 0;
+    uint32_t     peak_device_memory_count = 0;
+};
+
+///
+/// @param capabilities Of the device's physical device, memory types and limits are taken from it.
+///
+VkResult vk_allocator_init(Vk_Allocator *allocator, const Vk_Device_Capabilities &capabilities, VkDevice device);
+
+///
+/// @brief Frees all blocks. Logs statistics and reports leaked allocations.
+///
+void vk_allocator_destroy(Vk_Allocator *allocator);
+
+std::optional<uint32_t> vk_allocator_find_memory_type(const Vk_Allocator *allocator, uint32_t type_bits, Vk_Memory_Usage usage);
+
+///
+/// @param is_linear Buffer or linear-tiled image. Optimal-tiled images must pass `false`.
+///
+VkResult vk_allocator_allocate(
+    Vk_Allocator *allocator, const VkMemoryRequirements &requirements, Vk_Memory_Usage usage, bool is_linear,
+    Vk_Allocation *result);
+
+void vk_allocator_free(Vk_Allocator *allocator, Vk_Allocation *allocation);
+
+VkResult vk_allocator_make_buffer(
+    Vk_Allocator *allocator, const VkBufferCreateInfo &create_info, Vk_Memory_Usage usage,
+    VkBuffer *buffer, Vk_Allocation *allocation);
+
+VkResult vk_allocator_make_image(
+    Vk_Allocator *allocator, const VkImageCreateInfo &create_info, Vk_Memory_Usage usage,
+    VkImage *image, Vk_Allocation *allocation);
+
+void vk_allocator_destroy_buffer(Vk_Allocator *allocator, VkBuffer buffer, Vk_Allocation *allocation);
+void vk_allocator_destroy_image(Vk_Allocator *allocator, VkImage image, Vk_Allocation *allocation);
+
+Vk_Allocator_Stats vk_allocator_get_stats(const Vk_Allocator *allocator);
+void vk_allocator_log_stats(const Vk_Allocator *allocator);
+
+///
+/// @brief Bump allocator over one host-visible buffer, for per-frame transient data (uniforms, dynamic
+/// vertices, indirect args). Reset once the frame which used it is finished on GPU.
+///
+struct Vk_Linear_Arena {
+    VkBuffer      buffer = VK_NULL_HANDLE;
+    Vk_Allocation allocation;
+    VkDeviceSize  size = 0;
+    VkDeviceSize  head = 0;
+    VkDeviceSize  peak = 0;
+};
+
+VkResult vk_linear_arena_init(Vk_Allocator *allocator, VkDeviceSize size, VkBufferUsageFlags usage, Vk_Linear_Arena *arena);
+void vk_linear_arena_destroy(Vk_Allocator *allocator, Vk_Linear_Arena *arena);
+
+///
+/// @return Offset inside `arena->buffer`, std::nullopt if arena is out of space. `*mapped` points to the
+/// pushed range.
+///
+std::optional<VkDeviceSize> vk_linear_arena_push(Vk_Linear_Arena *arena, VkDeviceSize size, VkDeviceSize alignment, void **mapped);
+void vk_linear_arena_reset(Vk_Linear_Arena *arena);
@@ -0,0 +1,359 @@
+#include "stdafx.h"
+
+#include "defer.h"
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_timeline.h"
+#include "vk_compute.h"
+#include "vk_deletion_queue.h"
+#include "vk_shader.h"
+#include "vk_pipeline.h"
+#include "camera.h"
+#include "vk_benchmark.h"
+#include "vk_particles.h"
+
+VkResult
+vk_build_particles_draw_pipeline(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result)
+{
+    const Vk_Pipeline_Build_Args *args = static_cast<const Vk_Pipeline_Build_Args *>(user_data);
+
+    // NOTE(gr3yknigh1): Vertex shader fetches particles from storage buffer by vertex index. [2025/03/31]
+    VkPipelineVertexInputStateCreateInfo vertex_input = {};
+    vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    return vk_make_graphics_pipeline(
+        device, args->pipeline_cache, args->render_pass, args->layout, shaders[0], shaders[1], vertex_input,
+        VK_PRIMITIVE_TOPOLOGY_POINT_LIST, args->vertex_specialization, result);
+}
+
+VkResult
+vk_make_particles(
+    Vk_Allocator *allocator, VkPipelineCache pipeline_cache, VkRenderPass render_pass, uint32_t compute_queue_index,
+    uint32_t graphics_queue_index, uint32_t frames_count, uint32_t count, Vk_Particles *particles)
+{
+    VkResult result = VK_SUCCESS;
+    VkDevice device = allocator->device;
+
+    particles->count = count;
+    particles->is_cleared = false;
+
+    //
+    // Buffers:
+    //
+    std::array<uint32_t, 2> queue_family_indices = { compute_queue_index, graphics_queue_index };
+
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = static_cast<VkDeviceSize>(count) * sizeof(Particle);
+    buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    if (compute_queue_index != graphics_queue_index) {
+        buffer_create_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        buffer_create_info.queueFamilyIndexCount = static_cast<uint32_t>(queue_family_indices.size());
+        buffer_create_info.pQueueFamilyIndices = queue_family_indices.data();
+    } else {
+        buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    particles->buffers.resize(frames_count, VK_NULL_HANDLE);
+    particles->allocations.resize(frames_count);
+
+    for (uint32_t index = 0; index < frames_count; ++index) {
+        result = vk_allocator_make_buffer(
+            allocator, buffer_create_info, Vk_Memory_Usage::Gpu_Only, &particles->buffers[index], &particles->allocations[index]);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    //
+    // Descriptors:
+    //
+    std::array<VkDescriptorSetLayoutBinding, 2> bindings = {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo set_layout_create_info = {};
+    set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    set_layout_create_info.bindingCount = static_cast<uint32_t>(bindings.size());
+    set_layout_create_info.pBindings = bindings.data();
+
+    result = vkCreateDescriptorSetLayout(device, &set_layout_create_info, nullptr, &particles->set_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkDescriptorPoolSize pool_size = {};
+    pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    pool_size.descriptorCount = frames_count * static_cast<uint32_t>(bindings.size());
+
+    VkDescriptorPoolCreateInfo pool_create_info = {};
+    pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    pool_create_info.maxSets = frames_count;
+    pool_create_info.poolSizeCount = 1;
+    pool_create_info.pPoolSizes = &pool_size;
+
+    result = vkCreateDescriptorPool(device, &pool_create_info, nullptr, &particles->descriptor_pool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    std::vector<VkDescriptorSetLayout> set_layouts(frames_count, particles->set_layout);
+
+    VkDescriptorSetAllocateInfo set_allocate_info = {};
+    set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    set_allocate_info.descriptorPool = particles->descriptor_pool;
+    set_allocate_info.descriptorSetCount = frames_count;
+    set_allocate_info.pSetLayouts = set_layouts.data();
+
+    particles->sets.resize(frames_count, VK_NULL_HANDLE);
+    result = vkAllocateDescriptorSets(device, &set_allocate_info, particles->sets.data());
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    for (uint32_t index = 0; index < frames_count; ++index) {
+        std::array<VkDescriptorBufferInfo, 2> buffer_infos = {};
+        buffer_infos[0].buffer = particles->buffers[(index + frames_count - 1) % frames_count];
+        buffer_infos[0].range = VK_WHOLE_SIZE;
+        buffer_infos[1].buffer = particles->buffers[index];
+        buffer_infos[1].range = VK_WHOLE_SIZE;
+
+        std::array<VkWriteDescriptorSet, 2> writes = {};
+        for (uint32_t binding = 0; binding < writes.size(); ++binding) {
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = particles->sets[index];
+            writes[binding].dstBinding = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[binding].pBufferInfo = &buffer_infos[binding];
+        }
+
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    //
+    // Pipelines:
+    //
+    VkShaderModule compute_shader = vk_load_shader_module(device, "shaders/particles.comp.spv");
+    if (compute_shader == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    defer(vkDestroyShaderModule(device, compute_shader, nullptr));
+
+    VkShaderModule vertex_shader = vk_load_shader_module(device, "shaders/particles.vert.spv");
+    if (vertex_shader == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    defer(vkDestroyShaderModule(device, vertex_shader, nullptr));
+
+    VkShaderModule fragment_shader = vk_load_shader_module(device, "shaders/triangle.frag.spv");
+    if (fragment_shader == VK_NULL_HANDLE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    defer(vkDestroyShaderModule(device, fragment_shader, nullptr));
+
+    VkPushConstantRange push_constant_range = {};
+    push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    push_constant_range.offset = 0;
+    push_constant_range.size = sizeof(Particle_Simulation_Constants);
+
+    VkPipelineLayoutCreateInfo layout_create_info = {};
+    layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layout_create_info.setLayoutCount = 1;
+    layout_create_info.pSetLayouts = &particles->set_layout;
+    layout_create_info.pushConstantRangeCount = 1;
+    layout_create_info.pPushConstantRanges = &push_constant_range;
+
+    result = vkCreatePipelineLayout(device, &layout_create_info, nullptr, &particles->simulate_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    layout_create_info.pushConstantRangeCount = 0;
+    layout_create_info.pPushConstantRanges = nullptr;
+
+    result = vkCreatePipelineLayout(device, &layout_create_info, nullptr, &particles->draw_layout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = vk_make_compute_pipeline(device, pipeline_cache, particles->simulate_layout, compute_shader, &particles->simulate_pipeline);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    Vk_Pipeline_Build_Args draw_build_args = {};
+    draw_build_args.pipeline_cache = pipeline_cache;
+    draw_build_args.render_pass = render_pass;
+    draw_build_args.layout = particles->draw_layout;
+
+    std::array<VkShaderModule, 2> draw_shaders = { vertex_shader, fragment_shader };
+
+    result = vk_build_particles_draw_pipeline(device, draw_shaders.data(), &draw_build_args, &particles->draw_pipeline);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Particles: %u, %.1f MiB per frame in flight", count,
+        static_cast<double>(buffer_create_info.size) / (1024.0 * 1024.0));
+
+    return VK_SUCCESS;
+}
+
+void
+vk_destroy_particles(Vk_Allocator *allocator, Vk_Particles *particles)
+{
+    VkDevice device = allocator->device;
+
+    vkDestroyPipeline(device, particles->draw_pipeline, nullptr);
+    vkDestroyPipeline(device, particles->simulate_pipeline, nullptr);
+    vkDestroyPipelineLayout(device, particles->draw_layout, nullptr);
+    vkDestroyPipelineLayout(device, particles->simulate_layout, nullptr);
+    vkDestroyDescriptorPool(device, particles->descriptor_pool, nullptr);
+    vkDestroyDescriptorSetLayout(device, particles->set_layout, nullptr);
+
+    for (size_t index = 0; index < particles->buffers.size(); ++index) {
+        if (particles->buffers[index] != VK_NULL_HANDLE) {
+            vk_allocator_destroy_buffer(allocator, particles->buffers[index], &particles->allocations[index]);
+        }
+    }
+
+    *particles = {};
+}
+
+void
+vk_record_particles_simulation(
+    Vk_Particles *particles, VkCommandBuffer command_buffer, uint32_t frame_index, float delta_time, float time)
+{
+    VkPipelineStageFlags src_stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    VkAccessFlags src_access = VK_ACCESS_SHADER_WRITE_BIT;
+
+    if (!particles->is_cleared) {
+        for (VkBuffer buffer : particles->buffers) {
+            vkCmdFillBuffer(command_buffer, buffer, 0, VK_WHOLE_SIZE, 0);
+        }
+
+        src_stage |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+        src_access |= VK_ACCESS_TRANSFER_WRITE_BIT;
+        particles->is_cleared = true;
+    }
+
+    // NOTE(gr3yknigh1): Previous frame's simulation was submitted to this queue earlier, its writes must land
+    // before they are read as source. [2025/03/31]
+    VkMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(
+        command_buffer, src_stage, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+    Particle_Simulation_Constants constants = {};
+    constants.delta_time = delta_time;
+    constants.time = time;
+    constants.count = particles->count;
+
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, particles->simulate_pipeline);
+    vkCmdBindDescriptorSets(
+        command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, particles->simulate_layout, 0, 1, &particles->sets[frame_index], 0, nullptr);
+    vkCmdPushConstants(
+        command_buffer, particles->simulate_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants), &constants);
+    vkCmdDispatch(command_buffer, (particles->count + 255) / 256, 1, 1);
+}
+
+void
+vk_record_particles_draw(const Vk_Particles &particles, VkCommandBuffer command_buffer, uint32_t frame_index, VkExtent2D extent)
+{
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particles.draw_pipeline);
+
+    VkViewport viewport = {};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+
+    VkRect2D scissor = {};
+    scissor.offset = { 0, 0 };
+    scissor.extent = extent;
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+    vkCmdBindDescriptorSets(
+        command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particles.draw_layout, 0, 1, &particles.sets[frame_index], 0, nullptr);
+    vkCmdDraw(command_buffer, particles.count, 1, 0, 0);
+}
+
+void
+vk_benchmark_compute(
+    const Vk_Benchmark_Frames &frames, VkDevice device, Vk_Particles *particles, Vk_Compute_Context *serialized_context,
+    Vk_Compute_Context *async_context)
+{
+    constexpr uint32_t warmup_frames_count = 20;
+    constexpr uint32_t frames_count = 200;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Benchmark: %u particles, %u frames in flight, %u frames per mode", particles->count,
+        frames.frames_count, frames_count);
+
+    if (!async_context->is_async) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Benchmark: device has no async compute family, both modes use graphics queue");
+    }
+
+    std::array<Vk_Compute_Context *, 2> contexts = { serialized_context, async_context };
+    std::array<const char *, 2> names = { "serialized", "overlapped" };
+    std::array<double, 2> average_ms = {};
+
+    for (size_t mode = 0; mode < contexts.size(); ++mode) {
+        uint64_t start_counter = 0;
+
+        for (uint32_t iteration = 0; iteration < warmup_frames_count + frames_count; ++iteration) {
+            if (iteration == warmup_frames_count) {
+                vkDeviceWaitIdle(device);
+                start_counter = SDL_GetPerformanceCounter();
+            }
+
+            uint32_t frame_index = iteration % frames.frames_count;
+
+            VkResult result = frames.wait(frames.user_data, frame_index);
+            SDL_assert(result == VK_SUCCESS);
+
+            // NOTE(gr3yknigh1): Fixed step, so both modes do exactly the same work. [2025/03/31]
+            VkCommandBuffer compute_command_buffer = vk_compute_begin(contexts[mode], frame_index);
+            vk_record_particles_simulation(particles, compute_command_buffer, frame_index, 1.0f / 60.0f, iteration / 60.0f);
+
+            Vk_Submit_Waits submit_waits = {};
+            result = vk_compute_submit(contexts[mode], frame_index, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, &submit_waits);
+            SDL_assert(result == VK_SUCCESS);
+
+            Vk_Benchmark_Frame frame = {};
+            frame.frame_index = frame_index;
+            frame.frame_number = iteration + 1;
+            frame.waits = &submit_waits;
+
+            result = frames.submit(frames.user_data, frame);
+            SDL_assert(result == VK_SUCCESS);
+        }
+
+        vkDeviceWaitIdle(device);
+
+        average_ms[mode] = static_cast<double>(SDL_GetPerformanceCounter() - start_counter) * 1000.0
+            / static_cast<double>(SDL_GetPerformanceFrequency()) / frames_count;
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Benchmark: %-10s %8.3f ms/frame, %7.1f fps", names[mode], average_ms[mode],
+            1000.0 / average_ms[mode]);
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Benchmark: overlapped speedup %.2fx", average_ms[0] / average_ms[1]);
+}
@@ -0,0 +1,67 @@
+#pragma once
+///
+/// @brief Particles simulated on compute queue and drawn as points by the main pass.
+///
+/// State is ping-ponged across one buffer per frame in flight: frame N reads buffer of frame N-1 and writes its own,
+/// so compute of the next frame never writes a buffer which graphics queue still reads.
+///
+/// @note Simulation of the frame is recorded into its compute context (see vk_compute.h), graphics submit of the
+/// frame must wait for it.
+///
+
+struct Particle {
+    float position[2];
+    float velocity[2];
+};
+
+struct Particle_Simulation_Constants {
+    float    delta_time = 0.0f;
+    float    time       = 0.0f;
+    uint32_t count      = 0;
+};
+
+struct Vk_Particles {
+    uint32_t count      = 0;
+    bool     is_cleared = false; // Buffers are zeroed by the first simulation.
+
+    std::vector<VkBuffer>      buffers;
+    std::vector<Vk_Allocation> allocations;
+
+    VkDescriptorSetLayout        set_layout      = VK_NULL_HANDLE;
+    VkDescriptorPool             descriptor_pool = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> sets; // Per frame: previous state at binding 0, own state at binding 1.
+
+    VkPipelineLayout simulate_layout   = VK_NULL_HANDLE;
+    VkPipeline       simulate_pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout draw_layout       = VK_NULL_HANDLE;
+    VkPipeline       draw_pipeline     = VK_NULL_HANDLE;
+};
+
+///
+/// @note If compute and graphics families differ, buffers are shared concurrently instead of transferring ownership
+/// twice per frame.
+///
+VkResult vk_make_particles(
+    Vk_Allocator *allocator, VkPipelineCache pipeline_cache, VkRenderPass render_pass, uint32_t compute_queue_index,
+    uint32_t graphics_queue_index, uint32_t frames_count, uint32_t count, Vk_Particles *particles);
+void vk_destroy_particles(Vk_Allocator *allocator, Vk_Particles *particles);
+
+void vk_record_particles_simulation(
+    Vk_Particles *particles, VkCommandBuffer command_buffer, uint32_t frame_index, float delta_time, float time);
+void vk_record_particles_draw(const Vk_Particles &particles, VkCommandBuffer command_buffer, uint32_t frame_index, VkExtent2D extent);
+
+///
+/// @brief `Vk_Pipeline_Build_Proc` of the draw pipeline, `user_data` is `Vk_Pipeline_Build_Args`.
+///
+VkResult vk_build_particles_draw_pipeline(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result);
+
+///
+/// @brief Measures GPU frame throughput with particle simulation on graphics queue (serialized) and on async
+/// compute queue (overlapped).
+///
+/// @param frames Must draw `particles`.
+/// @param serialized_context Context on graphics queue.
+///
+void vk_benchmark_compute(
+    const Vk_Benchmark_Frames &frames, VkDevice device, Vk_Particles *particles, Vk_Compute_Context *serialized_context,
+    Vk_Compute_Context *async_context);
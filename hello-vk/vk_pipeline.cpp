@@ -0,0 +1,144 @@
+#include "stdafx.h"
+
+#include "scene_format.h"
+#include "vk_pipeline.h"
+
+VkResult
+vk_make_triangle_pipeline(
+    VkDevice device, VkPipelineCache pipeline_cache, VkRenderPass render_pass, VkPipelineLayout layout,
+    VkShaderModule vertex_shader, VkShaderModule fragment_shader, const VkSpecializationInfo *vertex_specialization,
+    VkPipeline *result)
+{
+    VkVertexInputBindingDescription vertex_binding = {};
+    vertex_binding.binding = 0;
+    vertex_binding.stride = sizeof(Scene_Vertex);
+    vertex_binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    std::array<VkVertexInputAttributeDescription, 2> vertex_attributes = {};
+    vertex_attributes[0].location = 0;
+    vertex_attributes[0].binding = 0;
+    vertex_attributes[0].format = VK_FORMAT_R16G16_SNORM;
+    vertex_attributes[0].offset = offsetof(Scene_Vertex, position);
+
+    vertex_attributes[1].location = 1;
+    vertex_attributes[1].binding = 0;
+    vertex_attributes[1].format = VK_FORMAT_R8G8B8A8_UNORM;
+    vertex_attributes[1].offset = offsetof(Scene_Vertex, color);
+
+    VkPipelineVertexInputStateCreateInfo vertex_input = {};
+    vertex_input.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertex_input.vertexBindingDescriptionCount = 1;
+    vertex_input.pVertexBindingDescriptions = &vertex_binding;
+    vertex_input.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertex_attributes.size());
+    vertex_input.pVertexAttributeDescriptions = vertex_attributes.data();
+
+    return vk_make_graphics_pipeline(
+        device, pipeline_cache, render_pass, layout, vertex_shader, fragment_shader, vertex_input,
+        VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, vertex_specialization, result);
+}
+
+VkResult
+vk_make_compute_pipeline(
+    VkDevice device, VkPipelineCache pipeline_cache, VkPipelineLayout layout, VkShaderModule compute_shader, VkPipeline *result)
+{
+    VkComputePipelineCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    create_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    create_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    create_info.stage.module = compute_shader;
+    create_info.stage.pName = "main";
+    create_info.layout = layout;
+
+    return vkCreateComputePipelines(device, pipeline_cache, 1, &create_info, nullptr, result);
+}
+
+VkResult
+vk_build_triangle_pipeline(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result)
+{
+    const Vk_Pipeline_Build_Args *args = static_cast<const Vk_Pipeline_Build_Args *>(user_data);
+    return vk_make_triangle_pipeline(
+        device, args->pipeline_cache, args->render_pass, args->layout, shaders[0], shaders[1], args->vertex_specialization, result);
+}
+
+VkResult
+vk_build_compute_pipeline(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result)
+{
+    const Vk_Pipeline_Build_Args *args = static_cast<const Vk_Pipeline_Build_Args *>(user_data);
+    return vk_make_compute_pipeline(device, args->pipeline_cache, args->layout, shaders[0], result);
+}
+
+VkResult
+vk_make_graphics_pipeline(
+    VkDevice device, VkPipelineCache pipeline_cache, VkRenderPass render_pass, VkPipelineLayout layout,
+    VkShaderModule vertex_shader, VkShaderModule fragment_shader, const VkPipelineVertexInputStateCreateInfo &vertex_input,
+    VkPrimitiveTopology topology, const VkSpecializationInfo *vertex_specialization, VkPipeline *result)
+{
+    std::array<VkPipelineShaderStageCreateInfo, 2> stages = {};
+
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertex_shader;
+    stages[0].pName = "main";
+    stages[0].pSpecializationInfo = vertex_specialization;
+
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragment_shader;
+    stages[1].pName = "main";
+
+    VkPipelineInputAssemblyStateCreateInfo input_assembly = {};
+    input_assembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    input_assembly.topology = topology;
+    input_assembly.primitiveRestartEnable = VK_FALSE;
+
+    // NOTE(gr3yknigh1): Viewport and scissor are dynamic, so pipeline survives swapchain resize. [2025/03/22]
+    VkPipelineViewportStateCreateInfo viewport_state = {};
+    viewport_state.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport_state.viewportCount = 1;
+    viewport_state.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterization = {};
+    rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode = VK_CULL_MODE_NONE;
+    rasterization.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterization.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    VkPipelineColorBlendAttachmentState color_blend_attachment = {};
+    color_blend_attachment.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    color_blend_attachment.blendEnable = VK_FALSE;
+
+    VkPipelineColorBlendStateCreateInfo color_blend = {};
+    color_blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    color_blend.attachmentCount = 1;
+    color_blend.pAttachments = &color_blend_attachment;
+
+    std::array<VkDynamicState, 2> dynamic_states = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+    VkPipelineDynamicStateCreateInfo dynamic_state = {};
+    dynamic_state.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic_state.dynamicStateCount = static_cast<uint32_t>(dynamic_states.size());
+    dynamic_state.pDynamicStates = dynamic_states.data();
+
+    VkGraphicsPipelineCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    create_info.stageCount = static_cast<uint32_t>(stages.size());
+    create_info.pStages = stages.data();
+    create_info.pVertexInputState = &vertex_input;
+    create_info.pInputAssemblyState = &input_assembly;
+    create_info.pViewportState = &viewport_state;
+    create_info.pRasterizationState = &rasterization;
+    create_info.pMultisampleState = &multisample;
+    create_info.pColorBlendState = &color_blend;
+    create_info.pDynamicState = &dynamic_state;
+    create_info.layout = layout;
+    create_info.renderPass = render_pass;
+    create_info.subpass = 0;
+
+    return vkCreateGraphicsPipelines(device, pipeline_cache, 1, &create_info, nullptr, result);
+}
@@ -0,0 +1,40 @@
+#pragma once
+///
+/// @brief Pipelines shared by the passes: mesh triangles, points and compute, and their build procs for shader hot
+/// reload.
+///
+
+///
+/// @brief Creates single subpass pipeline with dynamic viewport and scissor, without blending and culling.
+///
+/// @param vertex_specialization Constants of the vertex shader, nullptr if it has none.
+///
+VkResult vk_make_graphics_pipeline(
+    VkDevice device, VkPipelineCache pipeline_cache, VkRenderPass render_pass, VkPipelineLayout layout,
+    VkShaderModule vertex_shader, VkShaderModule fragment_shader, const VkPipelineVertexInputStateCreateInfo &vertex_input,
+    VkPrimitiveTopology topology, const VkSpecializationInfo *vertex_specialization, VkPipeline *result);
+
+///
+/// @brief Pipeline which draws triangles of `Scene_Vertex`.
+///
+VkResult vk_make_triangle_pipeline(
+    VkDevice device, VkPipelineCache pipeline_cache, VkRenderPass render_pass, VkPipelineLayout layout,
+    VkShaderModule vertex_shader, VkShaderModule fragment_shader, const VkSpecializationInfo *vertex_specialization,
+    VkPipeline *result);
+
+VkResult vk_make_compute_pipeline(
+    VkDevice device, VkPipelineCache pipeline_cache, VkPipelineLayout layout, VkShaderModule compute_shader, VkPipeline *result);
+
+///
+/// @brief Everything but shaders shader hot reload needs to rebuild a pipeline. `user_data` of build procs below.
+///
+struct Vk_Pipeline_Build_Args {
+    VkPipelineCache  pipeline_cache = VK_NULL_HANDLE;
+    VkRenderPass     render_pass    = VK_NULL_HANDLE; // Graphics pipelines only.
+    VkPipelineLayout layout         = VK_NULL_HANDLE;
+
+    const VkSpecializationInfo *vertex_specialization = nullptr; // Graphics pipelines only.
+};
+
+VkResult vk_build_triangle_pipeline(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result);
+VkResult vk_build_compute_pipeline(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result);
@@ -0,0 +1,235 @@
+#include "stdafx.h"
+
+#include "defer.h"
+#include "fnv1a.h"
+#include "vk_pipeline_cache.h"
+
+static constexpr uint32_t s_vk_pipeline_cache_magic   = 0x43505648; // 'HVPC'
+static constexpr uint32_t s_vk_pipeline_cache_version = 1;
+
+std::vector<uint8_t>
+vk_pipeline_cache_read_file(const char *file_path)
+{
+    size_t file_size = 0;
+    void *file_data = SDL_LoadFile(file_path, &file_size);
+    if (file_data == nullptr) {
+        return {};
+    }
+    defer(SDL_free(file_data));
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(file_data);
+    return std::vector<uint8_t>(bytes, bytes + file_size);
+}
+
+///
+/// @return Blob stored in `file`, empty if file is missing or was written for another device or driver.
+///
+static std::vector<uint8_t>
+vk_pipeline_cache_load_blob(const VkPhysicalDeviceProperties &properties, const char *file_path, const std::vector<uint8_t> &file)
+{
+    if (file.empty()) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: %s not found, cold start", file_path);
+        return {};
+    }
+
+    const uint8_t *file_data = file.data();
+    size_t file_size = file.size();
+
+    Vk_Pipeline_Cache_File_Header header = {};
+    if (file_size < sizeof(header)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: %s is truncated, ignored", file_path);
+        return {};
+    }
+    memcpy(&header, file_data, sizeof(header));
+
+    const uint8_t *data = file_data + sizeof(header);
+
+    const char *reason = nullptr;
+    if (header.magic != s_vk_pipeline_cache_magic || header.version != s_vk_pipeline_cache_version) {
+        reason = "unknown format";
+    } else if (header.vendor_id != properties.vendorID || header.device_id != properties.deviceID) {
+        reason = "written for another device";
+    } else if (header.driver_version != properties.driverVersion) {
+        reason = "written by another driver version";
+    } else if (memcmp(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        reason = "pipelineCacheUUID mismatch";
+    } else if (header.data_size != file_size - sizeof(header) || fnv1a(data, header.data_size) != header.data_hash) {
+        reason = "corrupted";
+    }
+
+    if (reason != nullptr) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: %s is %s, ignored", file_path, reason);
+        return {};
+    }
+
+    return std::vector<uint8_t>(data, data + header.data_size);
+}
+
+VkResult
+vk_pipeline_cache_init(
+    Vk_Pipeline_Cache *cache, const VkPhysicalDeviceProperties &device_properties, VkDevice device, const char *file_path,
+    const std::vector<uint8_t> *file)
+{
+    cache->device = device;
+    cache->handle = VK_NULL_HANDLE;
+    cache->file_path = file_path;
+    cache->device_properties = device_properties;
+    cache->thread_caches.clear();
+    cache->is_warm = false;
+    cache->loaded_size = 0;
+
+    std::vector<uint8_t> blob;
+    if (file_path != nullptr) {
+        blob = file != nullptr
+            ? vk_pipeline_cache_load_blob(cache->device_properties, file_path, *file)
+            : vk_pipeline_cache_load_blob(cache->device_properties, file_path, vk_pipeline_cache_read_file(file_path));
+    }
+
+    VkPipelineCacheCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    create_info.initialDataSize = blob.size();
+    create_info.pInitialData = blob.empty() ? nullptr : blob.data();
+
+    VkResult result = vkCreatePipelineCache(device, &create_info, nullptr, &cache->handle);
+
+    if (result != VK_SUCCESS && !blob.empty()) {
+        // NOTE(gr3yknigh1): Driver may still reject the blob, e.g. header checks it does on its own. [2025/03/27]
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: vkCreatePipelineCache() = %s, retrying empty", string_VkResult(result));
+
+        blob.clear();
+        create_info.initialDataSize = 0;
+        create_info.pInitialData = nullptr;
+        result = vkCreatePipelineCache(device, &create_info, nullptr, &cache->handle);
+    }
+
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    cache->is_warm = !blob.empty();
+    cache->loaded_size = blob.size();
+
+    if (cache->is_warm) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: loaded %zu bytes from %s", blob.size(), file_path);
+    }
+
+    return VK_SUCCESS;
+}
+
+void
+vk_pipeline_cache_destroy(Vk_Pipeline_Cache *cache)
+{
+    if (cache->handle != VK_NULL_HANDLE) {
+        if (cache->file_path != nullptr) {
+            vk_pipeline_cache_save(cache);
+        }
+
+        // NOTE(gr3yknigh1): Save merges them too, this is for caches which live only in memory. [2025/03/27]
+        vk_pipeline_cache_merge_thread_caches(cache);
+        vkDestroyPipelineCache(cache->device, cache->handle, nullptr);
+    }
+
+    cache->handle = VK_NULL_HANDLE;
+    cache->is_warm = false;
+    cache->loaded_size = 0;
+}
+
+VkPipelineCache
+vk_pipeline_cache_make_thread_cache(Vk_Pipeline_Cache *cache)
+{
+    VkPipelineCacheCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    VkPipelineCache thread_cache = VK_NULL_HANDLE;
+    if (vkCreatePipelineCache(cache->device, &create_info, nullptr, &thread_cache) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    std::lock_guard<std::mutex> lock(cache->thread_caches_mutex);
+    cache->thread_caches.push_back(thread_cache);
+    return thread_cache;
+}
+
+VkResult
+vk_pipeline_cache_merge_thread_caches(Vk_Pipeline_Cache *cache)
+{
+    std::lock_guard<std::mutex> lock(cache->thread_caches_mutex);
+
+    if (cache->thread_caches.empty()) {
+        return VK_SUCCESS;
+    }
+
+    VkResult result = vkMergePipelineCaches(
+        cache->device, cache->handle, static_cast<uint32_t>(cache->thread_caches.size()), cache->thread_caches.data());
+
+    for (VkPipelineCache thread_cache : cache->thread_caches) {
+        vkDestroyPipelineCache(cache->device, thread_cache, nullptr);
+    }
+    cache->thread_caches.clear();
+
+    return result;
+}
+
+bool
+vk_pipeline_cache_save(Vk_Pipeline_Cache *cache)
+{
+    VkResult result = vk_pipeline_cache_merge_thread_caches(cache);
+    if (result != VK_SUCCESS) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: vkMergePipelineCaches() = %s", string_VkResult(result));
+    }
+
+    size_t data_size = 0;
+    result = vkGetPipelineCacheData(cache->device, cache->handle, &data_size, nullptr);
+    if (result != VK_SUCCESS) {
+        return false;
+    }
+
+    std::vector<uint8_t> data(data_size);
+    result = vkGetPipelineCacheData(cache->device, cache->handle, &data_size, data.data());
+    if (result != VK_SUCCESS) {
+        return false;
+    }
+    data.resize(data_size);
+
+    Vk_Pipeline_Cache_File_Header header = {};
+    header.magic = s_vk_pipeline_cache_magic;
+    header.version = s_vk_pipeline_cache_version;
+    header.vendor_id = cache->device_properties.vendorID;
+    header.device_id = cache->device_properties.deviceID;
+    header.driver_version = cache->device_properties.driverVersion;
+    memcpy(header.uuid, cache->device_properties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.data_size = data.size();
+    header.data_hash = fnv1a(data.data(), data.size());
+
+    std::string temporary_path = std::string(cache->file_path) + ".tmp";
+
+    {
+        SDL_RWops *file = SDL_RWFromFile(temporary_path.c_str(), "wb");
+        if (file == nullptr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RWFromFile(%s) = %s", temporary_path.c_str(), SDL_GetError());
+            return false;
+        }
+        defer(SDL_RWclose(file));
+
+        bool is_written =
+            SDL_RWwrite(file, &header, sizeof(header), 1) == 1 &&
+            (data.empty() || SDL_RWwrite(file, data.data(), 1, data.size()) == data.size());
+
+        if (!is_written) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: failed to write %s", temporary_path.c_str());
+            return false;
+        }
+    }
+
+    // NOTE(gr3yknigh1): Replaces existing file atomically, on Windows too (MoveFileEx with REPLACE_EXISTING). [2025/03/27]
+    std::error_code error;
+    std::filesystem::rename(temporary_path, cache->file_path, error);
+    if (error) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: rename to %s failed: %s", cache->file_path, error.message().c_str());
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Pipeline cache: saved %zu bytes to %s", data.size(), cache->file_path);
+    return true;
+}
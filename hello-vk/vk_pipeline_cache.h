@@ -0,0 +1,77 @@
+#pragma once
+///
+/// @brief `VkPipelineCache` persisted between runs.
+///
+/// Blob is stored behind our own header which carries device identity. Mismatch of vendor, device, driver version
+/// or `pipelineCacheUUID` (driver update, different GPU) means cold start with empty cache, never a broken one.
+///
+/// @note Pipelines created while other threads may create theirs (pipelines startup graph, shader reloader thread)
+/// go through their own caches from `vk_pipeline_cache_make_thread_cache`, so threads don't contend on the main
+/// one. Those are merged into it before it is saved.
+///
+
+struct Vk_Pipeline_Cache_File_Header {
+    uint32_t magic          = 0;
+    uint32_t version        = 0;
+    uint32_t vendor_id      = 0;
+    uint32_t device_id      = 0;
+    uint32_t driver_version = 0;
+    uint8_t  uuid[VK_UUID_SIZE] = {};
+    uint32_t padding        = 0;
+    uint64_t data_size      = 0;
+    uint64_t data_hash      = 0; // FNV-1a of the blob, catches truncated or corrupted files.
+};
+
+struct Vk_Pipeline_Cache {
+    VkDevice        device    = VK_NULL_HANDLE;
+    VkPipelineCache handle    = VK_NULL_HANDLE;
+    const char     *file_path = nullptr; // nullptr - cache lives only in memory.
+
+    VkPhysicalDeviceProperties device_properties = {};
+
+    std::mutex                   thread_caches_mutex;
+    std::vector<VkPipelineCache> thread_caches; // Guarded by `thread_caches_mutex`.
+
+    bool     is_warm     = false; // Blob from disk was accepted.
+    uint64_t loaded_size = 0;
+};
+
+///
+/// @brief Reads cache file without validating it, so it can be done before device exists.
+///
+/// @return Contents of `file_path`, empty if it can't be read.
+///
+std::vector<uint8_t> vk_pipeline_cache_read_file(const char *file_path);
+
+///
+/// @brief Creates cache, seeded from `file_path` if it holds a valid blob for this device.
+///
+/// @param device_properties Of the device's physical device, as in `Vk_Device_Capabilities`.
+/// @param file Contents of `file_path` from `vk_pipeline_cache_read_file`, nullptr reads it here.
+///
+VkResult vk_pipeline_cache_init(
+    Vk_Pipeline_Cache *cache, const VkPhysicalDeviceProperties &device_properties, VkDevice device, const char *file_path,
+    const std::vector<uint8_t> *file = nullptr);
+
+///
+/// @brief Merges thread caches, saves (if `file_path` was given) and destroys everything.
+///
+void vk_pipeline_cache_destroy(Vk_Pipeline_Cache *cache);
+
+///
+/// @brief Empty cache owned by `cache`, for one thread's pipeline creation. Thread safe.
+///
+/// @return VK_NULL_HANDLE if it can't be created, pipelines are still created without it, just not cached.
+///
+VkPipelineCache vk_pipeline_cache_make_thread_cache(Vk_Pipeline_Cache *cache);
+
+///
+/// @brief Merges thread caches into the main one and destroys them. Threads must be done with them.
+///
+VkResult vk_pipeline_cache_merge_thread_caches(Vk_Pipeline_Cache *cache);
+
+///
+/// @brief Merges thread caches, writes blob into `<file_path>.tmp` and renames it over `file_path`, so crash mid-write never leaves
+/// truncated cache behind.
+///
+bool vk_pipeline_cache_save(Vk_Pipeline_Cache *cache);
@@ -0,0 +1,1145 @@
+#include "stdafx.h"
+
+#include "defer.h"
+#include "fnv1a.h"
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_deletion_queue.h"
+#include "vk_render_graph.h"
+
+// NOTE(gr3yknigh1): Read bits in source access mask make nothing available, only writes are waited for. [2025/04/03]
+constexpr VkAccessFlags s_write_access_mask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+    | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+static const char *s_usage_names[] = {
+    "color attachment",
+    "depth attachment",
+    "sampled (fragment)",
+    "sampled (compute)",
+    "storage read (vertex)",
+    "storage read (compute)",
+    "storage write (compute)",
+    "indirect read",
+    "transfer read",
+    "transfer write",
+};
+
+Vk_Graph_State
+vk_graph_usage_state(Vk_Graph_Usage usage)
+{
+    Vk_Graph_State state = {};
+
+    switch (usage) {
+    case Vk_Graph_Usage::Color_Attachment:
+        state.stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        state.access = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        state.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        break;
+    case Vk_Graph_Usage::Depth_Attachment:
+        state.stage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        state.access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        state.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        break;
+    case Vk_Graph_Usage::Sampled_Fragment:
+        state.stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        state.access = VK_ACCESS_SHADER_READ_BIT;
+        state.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        break;
+    case Vk_Graph_Usage::Sampled_Compute:
+        state.stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        state.access = VK_ACCESS_SHADER_READ_BIT;
+        state.layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        break;
+    case Vk_Graph_Usage::Storage_Read_Vertex:
+        state.stage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+        state.access = VK_ACCESS_SHADER_READ_BIT;
+        state.layout = VK_IMAGE_LAYOUT_GENERAL;
+        break;
+    case Vk_Graph_Usage::Storage_Read_Compute:
+        state.stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        state.access = VK_ACCESS_SHADER_READ_BIT;
+        state.layout = VK_IMAGE_LAYOUT_GENERAL;
+        break;
+    case Vk_Graph_Usage::Storage_Write_Compute:
+        state.stage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        state.access = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        state.layout = VK_IMAGE_LAYOUT_GENERAL;
+        break;
+    case Vk_Graph_Usage::Indirect_Read:
+        state.stage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+        state.access = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        break;
+    case Vk_Graph_Usage::Transfer_Read:
+        state.stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        state.access = VK_ACCESS_TRANSFER_READ_BIT;
+        state.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        break;
+    case Vk_Graph_Usage::Transfer_Write:
+        state.stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        state.access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        state.layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        break;
+    }
+
+    return state;
+}
+
+bool
+vk_graph_usage_is_write(Vk_Graph_Usage usage)
+{
+    return usage == Vk_Graph_Usage::Color_Attachment
+        || usage == Vk_Graph_Usage::Depth_Attachment
+        || usage == Vk_Graph_Usage::Storage_Write_Compute
+        || usage == Vk_Graph_Usage::Transfer_Write;
+}
+
+static VkImageUsageFlags
+vk_graph_usage_image_flags(Vk_Graph_Usage usage)
+{
+    switch (usage) {
+    case Vk_Graph_Usage::Color_Attachment:      return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    case Vk_Graph_Usage::Depth_Attachment:      return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    case Vk_Graph_Usage::Sampled_Fragment:      return VK_IMAGE_USAGE_SAMPLED_BIT;
+    case Vk_Graph_Usage::Sampled_Compute:       return VK_IMAGE_USAGE_SAMPLED_BIT;
+    case Vk_Graph_Usage::Storage_Read_Vertex:   return VK_IMAGE_USAGE_STORAGE_BIT;
+    case Vk_Graph_Usage::Storage_Read_Compute:  return VK_IMAGE_USAGE_STORAGE_BIT;
+    case Vk_Graph_Usage::Storage_Write_Compute: return VK_IMAGE_USAGE_STORAGE_BIT;
+    case Vk_Graph_Usage::Indirect_Read:         return 0;
+    case Vk_Graph_Usage::Transfer_Read:         return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    case Vk_Graph_Usage::Transfer_Write:        return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
+    return 0;
+}
+
+static void
+vk_destroy_transients(Vk_Render_Graph *graph)
+{
+    for (auto &transient : graph->transients) {
+        if (transient.image_view != VK_NULL_HANDLE) {
+            vkDestroyImageView(graph->device, transient.image_view, nullptr);
+        }
+        if (transient.image != VK_NULL_HANDLE) {
+            vkDestroyImage(graph->device, transient.image, nullptr);
+        }
+    }
+
+    for (auto &block : graph->blocks) {
+        if (block.allocation.memory != VK_NULL_HANDLE) {
+            vk_allocator_free(graph->allocator, &block.allocation);
+        }
+    }
+
+    graph->transients.clear();
+    graph->blocks.clear();
+}
+
+static void
+vk_retire_transients(Vk_Render_Graph *graph, uint64_t last_frame_number)
+{
+    for (auto &transient : graph->transients) {
+        vk_deletion_queue_push(
+            graph->deletion_queue, VK_OBJECT_TYPE_IMAGE_VIEW, vk_handle_value(transient.image_view), last_frame_number);
+        vk_deletion_queue_push(graph->deletion_queue, VK_OBJECT_TYPE_IMAGE, vk_handle_value(transient.image), last_frame_number);
+    }
+
+    // NOTE(gr3yknigh1): Blocks are pushed after images, so they are freed after everything aliased in them. [2025/04/09]
+    for (auto &block : graph->blocks) {
+        vk_deletion_queue_push(graph->deletion_queue, VK_OBJECT_TYPE_UNKNOWN, 0, block.allocation, last_frame_number);
+    }
+
+    graph->transients.clear();
+    graph->blocks.clear();
+}
+
+void
+vk_render_graph_init(Vk_Render_Graph *graph, VkDevice device, Vk_Allocator *allocator, Vk_Deletion_Queue *deletion_queue)
+{
+    *graph = {};
+    graph->device = device;
+    graph->allocator = allocator;
+    graph->deletion_queue = deletion_queue;
+}
+
+void
+vk_render_graph_destroy(Vk_Render_Graph *graph)
+{
+    vk_destroy_transients(graph);
+
+    *graph = {};
+}
+
+void
+vk_render_graph_begin(Vk_Render_Graph *graph)
+{
+    graph->resources.clear();
+
+    for (auto &pass : graph->passes) {
+        pass.uses.clear();
+        graph->free_uses.push_back(std::move(pass.uses));
+    }
+    graph->passes.clear();
+}
+
+uint32_t
+vk_render_graph_import_image(
+    Vk_Render_Graph *graph, const char *name, VkImage image, VkImageView image_view, VkImageAspectFlags aspect,
+    const Vk_Graph_State &initial_state, const Vk_Graph_State &final_state, bool is_output)
+{
+    Vk_Graph_Resource resource = {};
+    resource.name = name;
+    resource.is_image = true;
+    resource.is_output = is_output;
+    resource.image = image;
+    resource.image_view = image_view;
+    resource.aspect = aspect;
+    resource.initial_state = initial_state;
+    resource.final_state = final_state;
+
+    graph->resources.push_back(resource);
+    return static_cast<uint32_t>(graph->resources.size() - 1);
+}
+
+uint32_t
+vk_render_graph_import_buffer(
+    Vk_Render_Graph *graph, const char *name, VkBuffer buffer, const Vk_Graph_State &initial_state, bool is_output)
+{
+    Vk_Graph_Resource resource = {};
+    resource.name = name;
+    resource.is_output = is_output;
+    resource.buffer = buffer;
+    resource.initial_state = initial_state;
+    resource.final_state = initial_state;
+
+    graph->resources.push_back(resource);
+    return static_cast<uint32_t>(graph->resources.size() - 1);
+}
+
+uint32_t
+vk_render_graph_create_image(Vk_Render_Graph *graph, const char *name, const Vk_Graph_Image_Desc &desc)
+{
+    Vk_Graph_Resource resource = {};
+    resource.name = name;
+    resource.is_image = true;
+    resource.is_transient = true;
+    resource.aspect = desc.aspect;
+    resource.desc = desc;
+
+    graph->resources.push_back(resource);
+    return static_cast<uint32_t>(graph->resources.size() - 1);
+}
+
+uint32_t
+vk_render_graph_add_pass(Vk_Render_Graph *graph, const char *name, Vk_Graph_Pass_Proc proc, void *user_data, bool has_side_effects)
+{
+    Vk_Graph_Pass pass = {};
+    pass.name = name;
+    pass.proc = proc;
+    pass.user_data = user_data;
+    pass.has_side_effects = has_side_effects;
+
+    if (!graph->free_uses.empty()) {
+        pass.uses = std::move(graph->free_uses.back());
+        graph->free_uses.pop_back();
+    }
+
+    graph->passes.push_back(std::move(pass));
+    return static_cast<uint32_t>(graph->passes.size() - 1);
+}
+
+void
+vk_render_graph_use(Vk_Render_Graph *graph, uint32_t pass, uint32_t resource, Vk_Graph_Usage usage)
+{
+    SDL_assert(pass < graph->passes.size() && resource < graph->resources.size());
+
+    Vk_Graph_Use use = {};
+    use.resource = resource;
+    use.usage = usage;
+
+    graph->passes[pass].uses.push_back(use);
+}
+
+//
+// NOTE(gr3yknigh1): FNV-1a over everything compile looks at. Handles and names are left out on purpose, they change
+// every frame without changing the compiled graph. [2025/04/03]
+//
+static void
+vk_hash_value(uint64_t *hash, uint64_t value)
+{
+    *hash = fnv1a(&value, sizeof(value), *hash);
+}
+
+static void
+vk_hash_state(uint64_t *hash, const Vk_Graph_State &state)
+{
+    vk_hash_value(hash, state.stage);
+    vk_hash_value(hash, state.access);
+    vk_hash_value(hash, static_cast<uint64_t>(state.layout));
+}
+
+static uint64_t
+vk_render_graph_hash(const Vk_Render_Graph &graph)
+{
+    uint64_t hash = s_fnv1a_offset_basis;
+
+    vk_hash_value(&hash, graph.resources.size());
+    for (const auto &resource : graph.resources) {
+        vk_hash_value(&hash, (resource.is_image ? 1 : 0) | (resource.is_transient ? 2 : 0) | (resource.is_output ? 4 : 0));
+        vk_hash_value(&hash, resource.aspect);
+        vk_hash_value(&hash, static_cast<uint64_t>(resource.desc.format));
+        vk_hash_value(&hash, (static_cast<uint64_t>(resource.desc.extent.width) << 32) | resource.desc.extent.height);
+        vk_hash_value(&hash, resource.desc.usage);
+        vk_hash_state(&hash, resource.initial_state);
+        vk_hash_state(&hash, resource.final_state);
+    }
+
+    vk_hash_value(&hash, graph.passes.size());
+    for (const auto &pass : graph.passes) {
+        vk_hash_value(&hash, pass.has_side_effects ? 1 : 0);
+        vk_hash_value(&hash, pass.uses.size());
+
+        for (const auto &use : pass.uses) {
+            vk_hash_value(&hash, (static_cast<uint64_t>(use.resource) << 32) | static_cast<uint64_t>(use.usage));
+        }
+    }
+
+    return hash;
+}
+
+///
+/// @brief Culls passes which don't contribute to outputs: every resource counts its readers, every pass counts
+/// resources it writes, and unreferenced resources release their writers until nothing changes.
+///
+static std::vector<bool>
+vk_render_graph_cull(const Vk_Render_Graph &graph)
+{
+    std::vector<bool> is_alive(graph.passes.size(), true);
+    std::vector<uint32_t> pass_references(graph.passes.size(), 0);
+    std::vector<uint32_t> resource_references(graph.resources.size(), 0);
+
+    for (uint32_t pass_index = 0; pass_index < graph.passes.size(); ++pass_index) {
+        for (const auto &use : graph.passes[pass_index].uses) {
+            if (vk_graph_usage_is_write(use.usage)) {
+                pass_references[pass_index]++;
+            } else {
+                resource_references[use.resource]++;
+            }
+        }
+    }
+
+    auto release_reads = [&](const Vk_Graph_Pass &pass, std::vector<uint32_t> *unreferenced) {
+        for (const auto &use : pass.uses) {
+            if (vk_graph_usage_is_write(use.usage)) {
+                continue;
+            }
+            if (--resource_references[use.resource] == 0 && !graph.resources[use.resource].is_output) {
+                unreferenced->push_back(use.resource);
+            }
+        }
+    };
+
+    std::vector<uint32_t> unreferenced;
+
+    // NOTE(gr3yknigh1): Pass which writes nothing can only matter through side effects. [2025/04/03]
+    for (uint32_t pass_index = 0; pass_index < graph.passes.size(); ++pass_index) {
+        if (pass_references[pass_index] == 0 && !graph.passes[pass_index].has_side_effects) {
+            is_alive[pass_index] = false;
+            release_reads(graph.passes[pass_index], &unreferenced);
+        }
+    }
+
+    // NOTE(gr3yknigh1): Resources released above are found by the scan, pushing them twice would release writers twice. [2025/04/03]
+    unreferenced.clear();
+    for (uint32_t resource_index = 0; resource_index < graph.resources.size(); ++resource_index) {
+        if (graph.resources[resource_index].is_output) {
+            resource_references[resource_index]++;
+        } else if (resource_references[resource_index] == 0) {
+            unreferenced.push_back(resource_index);
+        }
+    }
+
+    while (!unreferenced.empty()) {
+        uint32_t resource_index = unreferenced.back();
+        unreferenced.pop_back();
+
+        for (uint32_t pass_index = 0; pass_index < graph.passes.size(); ++pass_index) {
+            const Vk_Graph_Pass &pass = graph.passes[pass_index];
+            if (!is_alive[pass_index] || pass.has_side_effects) {
+                continue;
+            }
+
+            for (const auto &use : pass.uses) {
+                if (use.resource != resource_index || !vk_graph_usage_is_write(use.usage)) {
+                    continue;
+                }
+
+                if (--pass_references[pass_index] > 0) {
+                    continue;
+                }
+
+                is_alive[pass_index] = false;
+                release_reads(pass, &unreferenced);
+            }
+        }
+    }
+
+    return is_alive;
+}
+
+///
+/// @brief Topological sort of alive passes (Kahn). Reader depends on the previous writer, writer on the previous
+/// writer and readers since it. Of ready passes the one which doesn't depend on the pass just scheduled goes first, so
+/// producer and consumer get independent work between them and the barrier has something to overlap with.
+///
+static std::vector<uint32_t>
+vk_render_graph_sort(const Vk_Render_Graph &graph, const std::vector<bool> &is_alive)
+{
+    uint32_t passes_count = static_cast<uint32_t>(graph.passes.size());
+
+    std::vector<std::vector<uint32_t>> dependents(passes_count);
+    std::vector<uint32_t> dependencies_count(passes_count, 0);
+
+    auto add_edge = [&](uint32_t from, uint32_t to) {
+        if (std::find(dependents[from].begin(), dependents[from].end(), to) == dependents[from].end()) {
+            dependents[from].push_back(to);
+            dependencies_count[to]++;
+        }
+    };
+
+    for (uint32_t resource_index = 0; resource_index < graph.resources.size(); ++resource_index) {
+        uint32_t last_writer = UINT32_MAX;
+        std::vector<uint32_t> readers;
+
+        for (uint32_t pass_index = 0; pass_index < passes_count; ++pass_index) {
+            if (!is_alive[pass_index]) {
+                continue;
+            }
+
+            for (const auto &use : graph.passes[pass_index].uses) {
+                if (use.resource != resource_index) {
+                    continue;
+                }
+
+                if (vk_graph_usage_is_write(use.usage)) {
+                    if (last_writer != UINT32_MAX) {
+                        add_edge(last_writer, pass_index);
+                    }
+                    for (uint32_t reader : readers) {
+                        add_edge(reader, pass_index);
+                    }
+
+                    last_writer = pass_index;
+                    readers.clear();
+                } else {
+                    if (last_writer != UINT32_MAX) {
+                        add_edge(last_writer, pass_index);
+                    }
+                    readers.push_back(pass_index);
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> ready;
+    for (uint32_t pass_index = 0; pass_index < passes_count; ++pass_index) {
+        if (is_alive[pass_index] && dependencies_count[pass_index] == 0) {
+            ready.push_back(pass_index);
+        }
+    }
+
+    std::vector<uint32_t> order;
+    uint32_t previous = UINT32_MAX;
+
+    while (!ready.empty()) {
+        // NOTE(gr3yknigh1): `ready` is kept in declaration order, so ties keep the order passes were added in. [2025/04/03]
+        size_t picked = 0;
+        if (previous != UINT32_MAX) {
+            for (size_t index = 0; index < ready.size(); ++index) {
+                const auto &edges = dependents[previous];
+                if (std::find(edges.begin(), edges.end(), ready[index]) == edges.end()) {
+                    picked = index;
+                    break;
+                }
+            }
+        }
+
+        uint32_t pass_index = ready[picked];
+        ready.erase(ready.begin() + picked);
+        order.push_back(pass_index);
+        previous = pass_index;
+
+        for (uint32_t dependent : dependents[pass_index]) {
+            if (--dependencies_count[dependent] == 0) {
+                ready.insert(std::upper_bound(ready.begin(), ready.end(), dependent), dependent);
+            }
+        }
+    }
+
+    return order;
+}
+
+///
+/// @brief Places transients into memory blocks, biggest first. Image goes at the lowest offset of a compatible block
+/// where it doesn't overlap any image whose lifetime overlaps its own, a new block is added if there is none.
+///
+static void
+vk_render_graph_alias(std::vector<Vk_Graph_Transient> *transients, std::vector<Vk_Graph_Memory_Block> *blocks)
+{
+    std::vector<uint32_t> sorted(transients->size());
+    for (uint32_t index = 0; index < sorted.size(); ++index) {
+        sorted[index] = index;
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [transients](uint32_t a, uint32_t b) {
+        return (*transients)[a].requirements.size > (*transients)[b].requirements.size;
+    });
+
+    std::vector<std::vector<uint32_t>> residents;
+
+    for (uint32_t transient_index : sorted) {
+        Vk_Graph_Transient &transient = (*transients)[transient_index];
+        const VkMemoryRequirements &requirements = transient.requirements;
+
+        bool is_placed = false;
+
+        for (uint32_t block_index = 0; block_index < blocks->size() && !is_placed; ++block_index) {
+            Vk_Graph_Memory_Block &block = (*blocks)[block_index];
+            if ((block.memory_type_bits & requirements.memoryTypeBits) == 0) {
+                continue;
+            }
+
+            std::vector<VkDeviceSize> candidates = { 0 };
+            for (uint32_t resident : residents[block_index]) {
+                const Vk_Graph_Transient &other = (*transients)[resident];
+                candidates.push_back(vk_align_up(other.offset + other.requirements.size, requirements.alignment));
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (VkDeviceSize offset : candidates) {
+                if (offset + requirements.size > block.size) {
+                    break;
+                }
+
+                bool is_free = true;
+                for (uint32_t resident : residents[block_index]) {
+                    const Vk_Graph_Transient &other = (*transients)[resident];
+
+                    bool lifetimes_overlap = transient.first_pass <= other.last_pass && other.first_pass <= transient.last_pass;
+                    bool ranges_overlap = offset < other.offset + other.requirements.size && other.offset < offset + requirements.size;
+
+                    if (lifetimes_overlap && ranges_overlap) {
+                        is_free = false;
+                        break;
+                    }
+                }
+
+                if (is_free) {
+                    transient.block = block_index;
+                    transient.offset = offset;
+                    block.memory_type_bits &= requirements.memoryTypeBits;
+                    block.alignment = std::max(block.alignment, requirements.alignment);
+                    residents[block_index].push_back(transient_index);
+                    is_placed = true;
+                    break;
+                }
+            }
+        }
+
+        if (!is_placed) {
+            Vk_Graph_Memory_Block block = {};
+            block.size = requirements.size;
+            block.alignment = requirements.alignment;
+            block.memory_type_bits = requirements.memoryTypeBits;
+
+            transient.block = static_cast<uint32_t>(blocks->size());
+            transient.offset = 0;
+
+            blocks->push_back(block);
+            residents.push_back({ transient_index });
+        }
+    }
+}
+
+static VkResult
+vk_render_graph_make_transients(Vk_Render_Graph *graph)
+{
+    VkResult result = VK_SUCCESS;
+
+    for (auto &transient : graph->transients) {
+        const Vk_Graph_Resource &resource = graph->resources[transient.resource];
+
+        VkImageUsageFlags usage = resource.desc.usage;
+        for (uint32_t position = transient.first_pass; position <= transient.last_pass; ++position) {
+            for (const auto &use : graph->passes[graph->order[position]].uses) {
+                if (use.resource == transient.resource) {
+                    usage |= vk_graph_usage_image_flags(use.usage);
+                }
+            }
+        }
+
+        VkImageCreateInfo image_create_info = {};
+        image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_create_info.imageType = VK_IMAGE_TYPE_2D;
+        image_create_info.format = resource.desc.format;
+        image_create_info.extent = { resource.desc.extent.width, resource.desc.extent.height, 1 };
+        image_create_info.mipLevels = 1;
+        image_create_info.arrayLayers = 1;
+        image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+        image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_create_info.usage = usage;
+        image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        result = vkCreateImage(graph->device, &image_create_info, nullptr, &transient.image);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateImage(%s) = %s", resource.name, string_VkResult(result));
+            return result;
+        }
+
+        vkGetImageMemoryRequirements(graph->device, transient.image, &transient.requirements);
+    }
+
+    vk_render_graph_alias(&graph->transients, &graph->blocks);
+
+    for (auto &block : graph->blocks) {
+        VkMemoryRequirements requirements = {};
+        requirements.size = block.size;
+        requirements.alignment = block.alignment;
+        requirements.memoryTypeBits = block.memory_type_bits;
+
+        result = vk_allocator_allocate(graph->allocator, requirements, Vk_Memory_Usage::Gpu_Only, false, &block.allocation);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vk_allocator_allocate(transients) = %s", string_VkResult(result));
+            return result;
+        }
+    }
+
+    for (auto &transient : graph->transients) {
+        const Vk_Graph_Resource &resource = graph->resources[transient.resource];
+        const Vk_Allocation &allocation = graph->blocks[transient.block].allocation;
+
+        result = vkBindImageMemory(graph->device, transient.image, allocation.memory, allocation.offset + transient.offset);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkBindImageMemory(%s) = %s", resource.name, string_VkResult(result));
+            return result;
+        }
+
+        VkImageViewCreateInfo view_create_info = {};
+        view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        view_create_info.image = transient.image;
+        view_create_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_create_info.format = resource.desc.format;
+        view_create_info.subresourceRange.aspectMask = resource.desc.aspect;
+        view_create_info.subresourceRange.baseMipLevel = 0;
+        view_create_info.subresourceRange.levelCount = 1;
+        view_create_info.subresourceRange.baseArrayLayer = 0;
+        view_create_info.subresourceRange.layerCount = 1;
+
+        result = vkCreateImageView(graph->device, &view_create_info, nullptr, &transient.image_view);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateImageView(%s) = %s", resource.name, string_VkResult(result));
+            return result;
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+///
+/// @brief Tracked state of a resource while barriers are placed.
+///
+struct Vk_Graph_Track {
+    VkPipelineStageFlags write_stage  = 0; // Of the last write (or layout transition).
+    VkAccessFlags        write_access = 0;
+    VkImageLayout        layout       = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    // NOTE(gr3yknigh1): Stages and accesses the last write is already visible to. Also what a next write must wait
+    // for, since these reads happened after it. [2025/04/03]
+    VkPipelineStageFlags read_stages = 0;
+    VkAccessFlags        read_access = 0;
+};
+
+///
+/// @brief Transition of `track` into `dst`. Returns false if no barrier is needed.
+///
+static bool
+vk_render_graph_transition(const Vk_Graph_Resource &resource, Vk_Graph_Track *track, const Vk_Graph_State &dst, bool is_write, Vk_Graph_Barrier *barrier)
+{
+    bool is_layout_change = resource.is_image && dst.layout != track->layout;
+
+    barrier->src.layout = track->layout;
+    barrier->dst = dst;
+
+    if (is_write || is_layout_change) {
+        // NOTE(gr3yknigh1): Reads after the last write already waited for it, so the write only waits for them. [2025/04/03]
+        if (track->read_stages != 0) {
+            barrier->src.stage = track->read_stages;
+            barrier->src.access = 0;
+        } else {
+            barrier->src.stage = track->write_stage;
+            barrier->src.access = track->write_access;
+        }
+
+        track->write_stage = dst.stage;
+        track->write_access = is_write ? dst.access & s_write_access_mask : 0;
+        track->layout = dst.layout;
+        track->read_stages = is_write ? 0 : dst.stage;
+        track->read_access = is_write ? 0 : dst.access;
+
+        return is_layout_change || barrier->src.stage != VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT || barrier->src.access != 0;
+    }
+
+    bool is_visible = (dst.stage & ~track->read_stages) == 0 && (dst.access & ~track->read_access) == 0;
+
+    barrier->src.stage = track->write_stage;
+    barrier->src.access = track->write_access;
+
+    track->read_stages |= dst.stage;
+    track->read_access |= dst.access;
+
+    return !is_visible && (track->write_stage != VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT || track->write_access != 0);
+}
+
+static void
+vk_render_graph_place_barriers(Vk_Render_Graph *graph)
+{
+    std::vector<Vk_Graph_Track> tracks(graph->resources.size());
+
+    for (uint32_t resource_index = 0; resource_index < graph->resources.size(); ++resource_index) {
+        const Vk_Graph_Resource &resource = graph->resources[resource_index];
+        Vk_Graph_Track &track = tracks[resource_index];
+
+        if (!resource.is_transient) {
+            track.write_stage = resource.initial_state.stage;
+            track.write_access = resource.initial_state.access;
+            track.layout = resource.initial_state.layout;
+            continue;
+        }
+
+        uint32_t transient_index = graph->resource_transients[resource_index];
+        if (transient_index == UINT32_MAX) {
+            continue;
+        }
+
+        //
+        // NOTE(gr3yknigh1): Contents are never kept, but memory is: the first use waits for every use of images sharing
+        // the block, within the frame (aliasing) and in the previous frame on the same queue. [2025/04/03]
+        //
+        track.write_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        for (const auto &other : graph->transients) {
+            if (other.block != graph->transients[transient_index].block) {
+                continue;
+            }
+
+            for (uint32_t position = other.first_pass; position <= other.last_pass; ++position) {
+                for (const auto &use : graph->passes[graph->order[position]].uses) {
+                    if (use.resource != other.resource) {
+                        continue;
+                    }
+
+                    Vk_Graph_State state = vk_graph_usage_state(use.usage);
+                    track.write_stage |= state.stage;
+                    track.write_access |= state.access & s_write_access_mask;
+                }
+            }
+        }
+    }
+
+    graph->barriers.clear();
+    graph->batches.clear();
+
+    auto close_batch = [graph](uint32_t position, uint32_t barriers_begin) {
+        uint32_t barriers_count = static_cast<uint32_t>(graph->barriers.size()) - barriers_begin;
+        if (barriers_count > 0) {
+            Vk_Graph_Batch batch = {};
+            batch.position = position;
+            batch.barriers_begin = barriers_begin;
+            batch.barriers_count = barriers_count;
+            graph->batches.push_back(batch);
+        }
+    };
+
+    for (uint32_t position = 0; position < graph->order.size(); ++position) {
+        uint32_t barriers_begin = static_cast<uint32_t>(graph->barriers.size());
+
+        for (const auto &use : graph->passes[graph->order[position]].uses) {
+            const Vk_Graph_Resource &resource = graph->resources[use.resource];
+            bool is_write = vk_graph_usage_is_write(use.usage);
+
+            Vk_Graph_State dst = vk_graph_usage_state(use.usage);
+
+            // NOTE(gr3yknigh1): Following reads in the same layout are made visible by this barrier too. [2025/04/03]
+            if (!is_write) {
+                for (uint32_t next = position + 1; next < graph->order.size(); ++next) {
+                    bool is_stopped = false;
+
+                    for (const auto &next_use : graph->passes[graph->order[next]].uses) {
+                        if (next_use.resource != use.resource) {
+                            continue;
+                        }
+
+                        Vk_Graph_State next_state = vk_graph_usage_state(next_use.usage);
+                        if (vk_graph_usage_is_write(next_use.usage) || (resource.is_image && next_state.layout != dst.layout)) {
+                            is_stopped = true;
+                            break;
+                        }
+
+                        dst.stage |= next_state.stage;
+                        dst.access |= next_state.access;
+                    }
+
+                    if (is_stopped) {
+                        break;
+                    }
+                }
+            }
+
+            Vk_Graph_Barrier barrier = {};
+            barrier.resource = use.resource;
+
+            if (vk_render_graph_transition(resource, &tracks[use.resource], dst, is_write, &barrier)) {
+                graph->barriers.push_back(barrier);
+            }
+        }
+
+        close_batch(position, barriers_begin);
+    }
+
+    uint32_t barriers_begin = static_cast<uint32_t>(graph->barriers.size());
+
+    for (uint32_t resource_index = 0; resource_index < graph->resources.size(); ++resource_index) {
+        const Vk_Graph_Resource &resource = graph->resources[resource_index];
+        if (!resource.is_image || resource.is_transient || resource.final_state.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+            continue;
+        }
+
+        if (resource.final_state.layout == tracks[resource_index].layout && resource.final_state.access == 0) {
+            continue;
+        }
+
+        Vk_Graph_Barrier barrier = {};
+        barrier.resource = resource_index;
+
+        if (vk_render_graph_transition(resource, &tracks[resource_index], resource.final_state, false, &barrier)) {
+            graph->barriers.push_back(barrier);
+        }
+    }
+
+    close_batch(static_cast<uint32_t>(graph->order.size()), barriers_begin);
+}
+
+VkResult
+vk_render_graph_compile(Vk_Render_Graph *graph, uint64_t frame_number)
+{
+    uint64_t hash = vk_render_graph_hash(*graph);
+    if (graph->is_compiled && graph->hash == hash) {
+        return VK_SUCCESS;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Frames before this one may still use the old transients. Structure changes rarely (resize,
+    // mode switch), so they are just dropped and created again. [2025/04/03]
+    //
+    if (!graph->transients.empty() || !graph->blocks.empty()) {
+        vk_retire_transients(graph, frame_number > 0 ? frame_number - 1 : 0);
+    }
+
+    graph->is_compiled = false;
+    graph->hash = hash;
+
+    std::vector<bool> is_alive = vk_render_graph_cull(*graph);
+    graph->order = vk_render_graph_sort(*graph, is_alive);
+
+    graph->resource_transients.assign(graph->resources.size(), UINT32_MAX);
+
+    for (uint32_t position = 0; position < graph->order.size(); ++position) {
+        for (const auto &use : graph->passes[graph->order[position]].uses) {
+            if (!graph->resources[use.resource].is_transient) {
+                continue;
+            }
+
+            uint32_t &transient_index = graph->resource_transients[use.resource];
+            if (transient_index == UINT32_MAX) {
+                transient_index = static_cast<uint32_t>(graph->transients.size());
+
+                Vk_Graph_Transient transient = {};
+                transient.resource = use.resource;
+                transient.first_pass = position;
+                graph->transients.push_back(transient);
+            }
+
+            graph->transients[transient_index].last_pass = position;
+        }
+    }
+
+    VkResult result = vk_render_graph_make_transients(graph);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    vk_render_graph_place_barriers(graph);
+
+    Vk_Render_Graph_Stats &stats = graph->stats;
+    stats.passes_count = static_cast<uint32_t>(graph->order.size());
+    stats.culled_passes_count = static_cast<uint32_t>(graph->passes.size() - graph->order.size());
+    stats.uses_count = 0;
+    for (uint32_t pass_index : graph->order) {
+        stats.uses_count += static_cast<uint32_t>(graph->passes[pass_index].uses.size());
+    }
+    stats.barriers_count = static_cast<uint32_t>(graph->barriers.size());
+    stats.batches_count = static_cast<uint32_t>(graph->batches.size());
+    stats.transients_count = static_cast<uint32_t>(graph->transients.size());
+    stats.transient_bytes = 0;
+    for (const auto &transient : graph->transients) {
+        stats.transient_bytes += transient.requirements.size;
+    }
+    stats.aliased_bytes = 0;
+    for (const auto &block : graph->blocks) {
+        stats.aliased_bytes += block.size;
+    }
+    stats.compiles_count++;
+
+    graph->is_compiled = true;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "Render graph: %u passes (%u culled), %u barriers in %u batches for %u uses, %u transients in %.2f MiB (%.2f MiB without aliasing)",
+        stats.passes_count, stats.culled_passes_count, stats.barriers_count, stats.batches_count, stats.uses_count,
+        stats.transients_count, static_cast<double>(stats.aliased_bytes) / (1024.0 * 1024.0),
+        static_cast<double>(stats.transient_bytes) / (1024.0 * 1024.0));
+
+    return VK_SUCCESS;
+}
+
+VkImage
+vk_render_graph_image(const Vk_Render_Graph &graph, uint32_t resource)
+{
+    if (!graph.resources[resource].is_transient) {
+        return graph.resources[resource].image;
+    }
+
+    uint32_t transient_index = graph.resource_transients[resource];
+    return transient_index != UINT32_MAX ? graph.transients[transient_index].image : VK_NULL_HANDLE;
+}
+
+VkImageView
+vk_render_graph_image_view(const Vk_Render_Graph &graph, uint32_t resource)
+{
+    if (!graph.resources[resource].is_transient) {
+        return graph.resources[resource].image_view;
+    }
+
+    uint32_t transient_index = graph.resource_transients[resource];
+    return transient_index != UINT32_MAX ? graph.transients[transient_index].image_view : VK_NULL_HANDLE;
+}
+
+static void
+vk_render_graph_record_batch(const Vk_Render_Graph &graph, VkCommandBuffer command_buffer, const Vk_Graph_Batch &batch)
+{
+    VkPipelineStageFlags src_stages = 0;
+    VkPipelineStageFlags dst_stages = 0;
+
+    VkMemoryBarrier memory_barrier = {};
+    memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    bool has_memory_barrier = false;
+
+    std::array<VkImageMemoryBarrier, 16> image_barriers = {};
+    uint32_t image_barriers_count = 0;
+
+    for (uint32_t index = batch.barriers_begin; index < batch.barriers_begin + batch.barriers_count; ++index) {
+        const Vk_Graph_Barrier &barrier = graph.barriers[index];
+        const Vk_Graph_Resource &resource = graph.resources[barrier.resource];
+
+        src_stages |= barrier.src.stage;
+        dst_stages |= barrier.dst.stage;
+
+        if (!resource.is_image) {
+            memory_barrier.srcAccessMask |= barrier.src.access;
+            memory_barrier.dstAccessMask |= barrier.dst.access;
+            has_memory_barrier = true;
+            continue;
+        }
+
+        SDL_assert(image_barriers_count < image_barriers.size());
+
+        VkImageMemoryBarrier &image_barrier = image_barriers[image_barriers_count++];
+        image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_barrier.srcAccessMask = barrier.src.access;
+        image_barrier.dstAccessMask = barrier.dst.access;
+        image_barrier.oldLayout = barrier.src.layout;
+        image_barrier.newLayout = barrier.dst.layout;
+        image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.image = vk_render_graph_image(graph, barrier.resource);
+        image_barrier.subresourceRange.aspectMask = resource.aspect;
+        image_barrier.subresourceRange.baseMipLevel = 0;
+        image_barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        image_barrier.subresourceRange.baseArrayLayer = 0;
+        image_barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    }
+
+    vkCmdPipelineBarrier(
+        command_buffer, src_stages, dst_stages, 0, has_memory_barrier ? 1 : 0, &memory_barrier, 0, nullptr,
+        image_barriers_count, image_barriers.data());
+}
+
+void
+vk_render_graph_execute(const Vk_Render_Graph &graph, VkCommandBuffer command_buffer)
+{
+    SDL_assert(graph.is_compiled);
+
+    size_t batch_index = 0;
+
+    for (uint32_t position = 0; position <= graph.order.size(); ++position) {
+        if (batch_index < graph.batches.size() && graph.batches[batch_index].position == position) {
+            vk_render_graph_record_batch(graph, command_buffer, graph.batches[batch_index]);
+            batch_index++;
+        }
+
+        if (position < graph.order.size()) {
+            const Vk_Graph_Pass &pass = graph.passes[graph.order[position]];
+            pass.proc(command_buffer, pass.user_data);
+        }
+    }
+}
+
+static std::string
+vk_render_graph_describe_barrier(const Vk_Render_Graph &graph, const Vk_Graph_Barrier &barrier)
+{
+    const Vk_Graph_Resource &resource = graph.resources[barrier.resource];
+
+    char line[256] = {};
+    if (resource.is_image) {
+        snprintf(
+            line, sizeof(line), "%s: stages 0x%x -> 0x%x, %s -> %s", resource.name, barrier.src.stage, barrier.dst.stage,
+            string_VkImageLayout(barrier.src.layout), string_VkImageLayout(barrier.dst.layout));
+    } else {
+        snprintf(
+            line, sizeof(line), "%s: stages 0x%x -> 0x%x, access 0x%x -> 0x%x", resource.name, barrier.src.stage,
+            barrier.dst.stage, barrier.src.access, barrier.dst.access);
+    }
+
+    return line;
+}
+
+void
+vk_render_graph_log(const Vk_Render_Graph &graph)
+{
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Render graph (compile #%llu):", static_cast<unsigned long long>(graph.stats.compiles_count));
+
+    size_t batch_index = 0;
+
+    for (uint32_t position = 0; position <= graph.order.size(); ++position) {
+        if (batch_index < graph.batches.size() && graph.batches[batch_index].position == position) {
+            const Vk_Graph_Batch &batch = graph.batches[batch_index++];
+
+            for (uint32_t index = batch.barriers_begin; index < batch.barriers_begin + batch.barriers_count; ++index) {
+                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "        barrier %s", vk_render_graph_describe_barrier(graph, graph.barriers[index]).c_str());
+            }
+        }
+
+        if (position < graph.order.size()) {
+            const Vk_Graph_Pass &pass = graph.passes[graph.order[position]];
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    %u: %s", position, pass.name);
+
+            for (const auto &use : pass.uses) {
+                SDL_LogInfo(
+                    SDL_LOG_CATEGORY_APPLICATION, "        %s %s (%s)", vk_graph_usage_is_write(use.usage) ? "writes" : "reads ",
+                    graph.resources[use.resource].name, s_usage_names[static_cast<uint32_t>(use.usage)]);
+            }
+        }
+    }
+
+    for (uint32_t pass_index = 0; pass_index < graph.passes.size(); ++pass_index) {
+        if (std::find(graph.order.begin(), graph.order.end(), pass_index) == graph.order.end()) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "    culled: %s", graph.passes[pass_index].name);
+        }
+    }
+
+    for (const auto &transient : graph.transients) {
+        const Vk_Graph_Resource &resource = graph.resources[transient.resource];
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "    transient %s: %ux%u %s, passes %u..%u, block %u at %llu, %.2f MiB",
+            resource.name, resource.desc.extent.width, resource.desc.extent.height, string_VkFormat(resource.desc.format),
+            transient.first_pass, transient.last_pass, transient.block, static_cast<unsigned long long>(transient.offset),
+            static_cast<double>(transient.requirements.size) / (1024.0 * 1024.0));
+    }
+}
+
+bool
+vk_render_graph_dump(const Vk_Render_Graph &graph, const char *file_path)
+{
+    std::string content;
+    char line[512] = {};
+
+    content += "digraph render_graph {\n";
+    content += "    rankdir=LR;\n";
+    content += "    node [fontname=\"Consolas\", fontsize=10];\n";
+    content += "    edge [fontname=\"Consolas\", fontsize=9];\n";
+
+    for (uint32_t resource_index = 0; resource_index < graph.resources.size(); ++resource_index) {
+        const Vk_Graph_Resource &resource = graph.resources[resource_index];
+        uint32_t transient_index = graph.resource_transients.size() > resource_index ? graph.resource_transients[resource_index] : UINT32_MAX;
+
+        if (transient_index != UINT32_MAX) {
+            const Vk_Graph_Transient &transient = graph.transients[transient_index];
+            snprintf(
+                line, sizeof(line),
+                "    r%u [shape=ellipse, style=filled, fillcolor=lightyellow, label=\"%s\\n%ux%u %s\\nblock %u at %llu\"];\n",
+                resource_index, resource.name, resource.desc.extent.width, resource.desc.extent.height,
+                string_VkFormat(resource.desc.format), transient.block, static_cast<unsigned long long>(transient.offset));
+        } else {
+            snprintf(
+                line, sizeof(line), "    r%u [shape=ellipse, %slabel=\"%s\\n%s\"];\n", resource_index,
+                resource.is_output ? "peripheries=2, " : "", resource.name,
+                resource.is_transient ? "transient (unused)" : resource.is_image ? "imported image" : "imported buffer");
+        }
+        content += line;
+    }
+
+    for (uint32_t pass_index = 0; pass_index < graph.passes.size(); ++pass_index) {
+        const Vk_Graph_Pass &pass = graph.passes[pass_index];
+
+        auto it = std::find(graph.order.begin(), graph.order.end(), pass_index);
+        if (it == graph.order.end()) {
+            snprintf(line, sizeof(line), "    p%u [shape=box, style=dashed, label=\"%s\\n(culled)\"];\n", pass_index, pass.name);
+            content += line;
+        } else {
+            uint32_t position = static_cast<uint32_t>(it - graph.order.begin());
+
+            // NOTE(gr3yknigh1): Barriers are listed in the pass they are recorded before. [2025/04/03]
+            std::string label = std::to_string(position) + ": " + pass.name;
+            for (const auto &batch : graph.batches) {
+                if (batch.position != position) {
+                    continue;
+                }
+
+                for (uint32_t index = batch.barriers_begin; index < batch.barriers_begin + batch.barriers_count; ++index) {
+                    label += "\\lbarrier " + vk_render_graph_describe_barrier(graph, graph.barriers[index]);
+                }
+                label += "\\l";
+            }
+
+            content += "    p" + std::to_string(pass_index) + " [shape=box, style=bold, label=\"" + label + "\"];\n";
+        }
+
+        for (const auto &use : pass.uses) {
+            const char *usage_name = s_usage_names[static_cast<uint32_t>(use.usage)];
+            if (vk_graph_usage_is_write(use.usage)) {
+                snprintf(line, sizeof(line), "    p%u -> r%u [label=\"%s\"];\n", pass_index, use.resource, usage_name);
+            } else {
+                snprintf(line, sizeof(line), "    r%u -> p%u [label=\"%s\"];\n", use.resource, pass_index, usage_name);
+            }
+            content += line;
+        }
+    }
+
+    content += "}\n";
+
+    SDL_RWops *file = SDL_RWFromFile(file_path, "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_RWFromFile(%s) = %s", file_path, SDL_GetError());
+        return false;
+    }
+    defer(SDL_RWclose(file));
+
+    return SDL_RWwrite(file, content.data(), 1, content.size()) == content.size();
+}
@@ -0,0 +1,234 @@
+#pragma once
+///
+/// @brief Frame render graph. Passes declare which resources they read and write and how, the graph orders them,
+/// drops passes whose results nobody uses, places barriers and layout transitions, and backs transient images with
+/// memory shared between images whose lifetimes don't overlap.
+///
+/// Graph is declared from scratch every frame (`vk_render_graph_begin`, then imports, transients and passes). Compile
+/// is skipped while the structure is the same as the last compiled one, so steady state costs a hash of a few passes.
+/// Imported handles (swapchain image of the frame, per-frame buffers) aren't part of the structure and may change
+/// every frame.
+///
+/// Barriers are batched: one `vkCmdPipelineBarrier` before a pass at most, buffer hazards merged into one global
+/// memory barrier. Consecutive reads of the same layout share the barrier placed before the first of them.
+///
+/// @note All passes are recorded into one command buffer of one queue. Cross-queue work (async compute, uploads) is
+/// still synchronized by its owner.
+/// @note Not thread safe.
+///
+
+///
+/// @brief How a pass uses a resource: pipeline stage, access and image layout of the use.
+///
+enum class Vk_Graph_Usage : uint32_t {
+    Color_Attachment,      // Write.
+    Depth_Attachment,      // Write.
+    Sampled_Fragment,
+    Sampled_Compute,
+    Storage_Read_Vertex,
+    Storage_Read_Compute,
+    Storage_Write_Compute, // Write, may read as well.
+    Indirect_Read,
+    Transfer_Read,
+    Transfer_Write,        // Write.
+};
+
+struct Vk_Graph_State {
+    VkPipelineStageFlags stage  = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkAccessFlags        access = 0;
+    VkImageLayout        layout = VK_IMAGE_LAYOUT_UNDEFINED; // Ignored for buffers.
+};
+
+Vk_Graph_State vk_graph_usage_state(Vk_Graph_Usage usage);
+bool vk_graph_usage_is_write(Vk_Graph_Usage usage);
+
+///
+/// @brief Image created and owned by the graph, alive only between its first and last use within a frame.
+///
+struct Vk_Graph_Image_Desc {
+    VkFormat           format = VK_FORMAT_UNDEFINED;
+    VkExtent2D         extent = {};
+    VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    VkImageUsageFlags  usage  = 0; // Extra usage, the one implied by passes' usages is added by the graph.
+};
+
+struct Vk_Graph_Resource {
+    const char *name         = nullptr;
+    bool        is_image     = false;
+    bool        is_transient = false;
+
+    // NOTE(gr3yknigh1): Consumed after the graph (presented, copied out), so passes writing it are never culled. [2025/04/03]
+    bool is_output = false;
+
+    VkImage            image      = VK_NULL_HANDLE;
+    VkImageView        image_view = VK_NULL_HANDLE;
+    VkImageAspectFlags aspect     = VK_IMAGE_ASPECT_COLOR_BIT;
+    VkBuffer           buffer     = VK_NULL_HANDLE;
+
+    Vk_Graph_Image_Desc desc; // Transient only.
+
+    // NOTE(gr3yknigh1): Imported only. Final state with UNDEFINED layout leaves image as the last pass left it. [2025/04/03]
+    Vk_Graph_State initial_state;
+    Vk_Graph_State final_state;
+};
+
+typedef void (*Vk_Graph_Pass_Proc)(VkCommandBuffer command_buffer, void *user_data);
+
+struct Vk_Graph_Use {
+    uint32_t       resource = 0;
+    Vk_Graph_Usage usage    = Vk_Graph_Usage::Color_Attachment;
+};
+
+struct Vk_Graph_Pass {
+    const char        *name      = nullptr;
+    Vk_Graph_Pass_Proc proc      = nullptr;
+    void              *user_data = nullptr;
+
+    // NOTE(gr3yknigh1): Does something outside of declared resources (readback, timestamps), never culled. [2025/04/03]
+    bool has_side_effects = false;
+
+    std::vector<Vk_Graph_Use> uses;
+};
+
+struct Vk_Graph_Barrier {
+    uint32_t       resource = 0;
+    Vk_Graph_State src;
+    Vk_Graph_State dst;
+};
+
+///
+/// @brief Barriers recorded with one `vkCmdPipelineBarrier`, before pass `order[position]` (or after the last pass
+/// if `position == order.size()`).
+///
+struct Vk_Graph_Batch {
+    uint32_t position       = 0;
+    uint32_t barriers_begin = 0;
+    uint32_t barriers_count = 0;
+};
+
+///
+/// @brief Memory shared by transient images with non-overlapping lifetimes.
+///
+struct Vk_Graph_Memory_Block {
+    Vk_Allocation allocation;
+    VkDeviceSize  size             = 0;
+    VkDeviceSize  alignment        = 1;
+    uint32_t      memory_type_bits = 0;
+};
+
+///
+/// @note Pass indices are positions in `Vk_Render_Graph::order`.
+///
+struct Vk_Graph_Transient {
+    uint32_t             resource     = 0;
+    VkImage              image        = VK_NULL_HANDLE;
+    VkImageView          image_view   = VK_NULL_HANDLE;
+    VkMemoryRequirements requirements = {};
+    uint32_t             block        = 0;
+    VkDeviceSize         offset       = 0;
+    uint32_t             first_pass   = 0;
+    uint32_t             last_pass    = 0;
+};
+
+struct Vk_Render_Graph_Stats {
+    uint32_t passes_count        = 0;
+    uint32_t culled_passes_count = 0;
+    uint32_t uses_count          = 0; // Barriers hand-written passes would record, one per use.
+    uint32_t barriers_count      = 0;
+    uint32_t batches_count       = 0; // `vkCmdPipelineBarrier` calls per frame.
+    uint32_t transients_count    = 0;
+    uint64_t compiles_count      = 0;
+
+    VkDeviceSize transient_bytes = 0; // Sum of transient image sizes, what they would take without aliasing.
+    VkDeviceSize aliased_bytes   = 0; // Memory actually allocated for them.
+};
+
+struct Vk_Render_Graph {
+    VkDevice           device         = VK_NULL_HANDLE;
+    Vk_Allocator      *allocator      = nullptr;
+    Vk_Deletion_Queue *deletion_queue = nullptr; // Transients of replaced compiles go there.
+
+    std::vector<Vk_Graph_Resource> resources;
+    std::vector<Vk_Graph_Pass>     passes;
+
+    // NOTE(gr3yknigh1): Use lists of the previous frame's passes, handed to new passes so a graph which is declared
+    // anew every frame doesn't allocate them every frame. [2025/04/07]
+    std::vector<std::vector<Vk_Graph_Use>> free_uses;
+
+    // NOTE(gr3yknigh1): Everything below is the compiled graph, reused while `hash` stays the same. [2025/04/03]
+    uint64_t hash        = 0;
+    bool     is_compiled = false;
+
+    std::vector<uint32_t>         order;               // Indices of alive passes, in execution order.
+    std::vector<uint32_t>         resource_transients; // Per resource, UINT32_MAX unless it is alive transient.
+    std::vector<Vk_Graph_Barrier> barriers;
+    std::vector<Vk_Graph_Batch>   batches;
+
+    std::vector<Vk_Graph_Transient>    transients;
+    std::vector<Vk_Graph_Memory_Block> blocks;
+
+    Vk_Render_Graph_Stats stats;
+};
+
+void vk_render_graph_init(Vk_Render_Graph *graph, VkDevice device, Vk_Allocator *allocator, Vk_Deletion_Queue *deletion_queue);
+
+///
+/// @brief Destroys transients of the compiled graph. Device must be idle.
+///
+void vk_render_graph_destroy(Vk_Render_Graph *graph);
+
+///
+/// @brief Starts declaration of the next frame's graph. Compiled graph is kept until `vk_render_graph_compile`.
+///
+void vk_render_graph_begin(Vk_Render_Graph *graph);
+
+///
+/// @param initial_state Last use of the image before the graph. Contents are discarded if its layout is UNDEFINED.
+/// @param final_state Image is transitioned into it after the last pass.
+///
+uint32_t vk_render_graph_import_image(
+    Vk_Render_Graph *graph, const char *name, VkImage image, VkImageView image_view, VkImageAspectFlags aspect,
+    const Vk_Graph_State &initial_state, const Vk_Graph_State &final_state, bool is_output);
+
+uint32_t vk_render_graph_import_buffer(
+    Vk_Render_Graph *graph, const char *name, VkBuffer buffer, const Vk_Graph_State &initial_state, bool is_output);
+
+uint32_t vk_render_graph_create_image(Vk_Render_Graph *graph, const char *name, const Vk_Graph_Image_Desc &desc);
+
+///
+/// @param proc Records the pass. Called by `vk_render_graph_execute` in compiled order, after pass' barriers.
+///
+uint32_t vk_render_graph_add_pass(
+    Vk_Render_Graph *graph, const char *name, Vk_Graph_Pass_Proc proc, void *user_data, bool has_side_effects = false);
+
+///
+/// @note One use per resource per pass. Pass which reads and writes the same resource declares the write.
+///
+void vk_render_graph_use(Vk_Render_Graph *graph, uint32_t pass, uint32_t resource, Vk_Graph_Usage usage);
+
+///
+/// @brief Orders and culls passes, computes barriers and (re)creates transients. Does nothing if the graph has the same
+/// structure as the compiled one.
+///
+/// @param frame_number Number of the frame being recorded. Replaced transients are pushed into the deletion queue,
+/// to be destroyed once frames before it complete.
+///
+VkResult vk_render_graph_compile(Vk_Render_Graph *graph, uint64_t frame_number);
+
+///
+/// @brief Records barriers and passes of the compiled graph.
+///
+void vk_render_graph_execute(const Vk_Render_Graph &graph, VkCommandBuffer command_buffer);
+
+///
+/// @brief Image of imported or transient resource, valid inside pass procs.
+///
+VkImage vk_render_graph_image(const Vk_Render_Graph &graph, uint32_t resource);
+VkImageView vk_render_graph_image_view(const Vk_Render_Graph &graph, uint32_t resource);
+
+void vk_render_graph_log(const Vk_Render_Graph &graph);
+
+///
+/// @brief Writes compiled graph as Graphviz DOT: passes (culled ones dashed), resources, and barriers on the edges.
+///
+bool vk_render_graph_dump(const Vk_Render_Graph &graph, const char *file_path);
@@ -0,0 +1,93 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_timeline.h"
+#include "vk_upload.h"
+#include "mapped_file.h"
+#include "scene_format.h"
+#include "scene.h"
+#include "vk_scene.h"
+
+///
+/// @brief Creates buffer of `size` and stages `data` (pointer into the mapping) into it.
+///
+static VkResult
+vk_scene_upload_stream(
+    Vk_Allocator *allocator, Vk_Upload_Context *upload_context, const Scene &scene, const void *data, uint64_t size,
+    VkBufferUsageFlags usage, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access, VkBuffer *buffer,
+    Vk_Allocation *allocation, uint64_t *ticket)
+{
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = size;
+    buffer_create_info.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkResult result = vk_allocator_make_buffer(allocator, buffer_create_info, Vk_Memory_Usage::Gpu_Only, buffer, allocation);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    // NOTE(gr3yknigh1): Section is read once, front to back, by the copy into staging ring. Built-in scenes
+    // aren't mapped. [2025/04/11]
+    if (scene.file.data != nullptr) {
+        mapped_file_will_read(&scene.file, scene_offset_of(&scene, data), size);
+    }
+
+    *ticket = vk_upload_buffer(upload_context, *buffer, 0, data, size, dst_stage, dst_access);
+    return *ticket != 0 ? VK_SUCCESS : VK_ERROR_OUT_OF_DEVICE_MEMORY;
+}
+
+VkResult
+vk_scene_upload(Vk_Allocator *allocator, Vk_Upload_Context *upload_context, const Scene &scene, Vk_Scene *result)
+{
+    *result = {};
+
+    if (scene.vertices_count == 0 || scene.indices_size == 0) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    uint64_t vertices_size = scene.vertices_count * sizeof(Scene_Vertex);
+
+    VkResult status = vk_scene_upload_stream(
+        allocator, upload_context, scene, scene.vertices, vertices_size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, &result->vertex_buffer,
+        &result->vertex_allocation, &result->vertex_buffer_ticket);
+    if (status != VK_SUCCESS) {
+        return status;
+    }
+
+    status = vk_scene_upload_stream(
+        allocator, upload_context, scene, scene.indices, scene.indices_size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT, &result->index_buffer, &result->index_allocation,
+        &result->index_buffer_ticket);
+    if (status != VK_SUCCESS) {
+        return status;
+    }
+
+    result->uploaded_bytes = vertices_size + scene.indices_size;
+    result->staging_ms = static_cast<double>(SDL_GetPerformanceCounter() - counter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    double megabytes = static_cast<double>(result->uploaded_bytes) / (1024.0 * 1024.0);
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Scene: %u meshes, %.1f MiB staged in %.2f ms (%.0f MiB/s)", scene.meshes_count,
+        megabytes, result->staging_ms, result->staging_ms > 0.0 ? megabytes * 1000.0 / result->staging_ms : 0.0);
+
+    return VK_SUCCESS;
+}
+
+void
+vk_scene_destroy(Vk_Allocator *allocator, Vk_Scene *scene)
+{
+    if (scene->vertex_buffer != VK_NULL_HANDLE) {
+        vk_allocator_destroy_buffer(allocator, scene->vertex_buffer, &scene->vertex_allocation);
+    }
+    if (scene->index_buffer != VK_NULL_HANDLE) {
+        vk_allocator_destroy_buffer(allocator, scene->index_buffer, &scene->index_allocation);
+    }
+
+    *scene = {};
+}
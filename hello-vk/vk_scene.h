@@ -0,0 +1,32 @@
+#pragma once
+///
+/// @brief GPU buffers of a mapped scene. Streams are copied from the mapping into the staging ring and nowhere
+/// else, so loading is bound by how fast pages come from disk, not by the CPU.
+///
+
+struct Vk_Scene {
+    VkBuffer      vertex_buffer = VK_NULL_HANDLE;
+    Vk_Allocation vertex_allocation;
+    uint64_t      vertex_buffer_ticket = 0;
+
+    VkBuffer      index_buffer = VK_NULL_HANDLE;
+    Vk_Allocation index_allocation;
+    uint64_t      index_buffer_ticket = 0;
+
+    uint64_t uploaded_bytes = 0;
+    double   staging_ms     = 0.0; // CPU time of staging, including page faults of the mapping.
+};
+
+///
+/// @brief Creates vertex and index buffers of all meshes and stages both streams through `upload_context`.
+///
+/// @note Blocks only while the ring is full, so scenes bigger than the ring stream through it.
+///
+VkResult vk_scene_upload(Vk_Allocator *allocator, Vk_Upload_Context *upload_context, const Scene &scene, Vk_Scene *result);
+void vk_scene_destroy(Vk_Allocator *allocator, Vk_Scene *scene);
+
+inline VkIndexType
+vk_scene_index_type(const Scene_Mesh &mesh)
+{
+    return mesh.index_size == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
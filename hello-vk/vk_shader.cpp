@@ -0,0 +1,420 @@
+#include "stdafx.h"
+
+#include "defer.h"
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_deletion_queue.h"
+#include "vk_shader.h"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// NOTE(gr3yknigh1): How long source must stay unchanged before it is compiled. [2025/04/05]
+constexpr double s_reload_quiet_ms = 100.0;
+
+// NOTE(gr3yknigh1): Without change notifications sources are polled, a handful of stat calls each time. [2025/04/05]
+constexpr uint32_t s_reload_poll_ms = 100;
+
+VkShaderModule
+vk_load_shader_module(VkDevice device, const char *file_path)
+{
+    std::vector<uint32_t> code;
+    if (!vk_read_shader_code(file_path, &code)) {
+        return VK_NULL_HANDLE;
+    }
+
+    return vk_make_shader_module(device, code, file_path);
+}
+
+bool
+vk_read_shader_code(const char *file_path, std::vector<uint32_t> *code)
+{
+    size_t code_size = 0;
+    void *data = SDL_LoadFile(file_path, &code_size);
+    if (data == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_LoadFile(%s) = %s", file_path, SDL_GetError());
+        return false;
+    }
+    defer(SDL_free(data));
+
+    if (code_size == 0 || code_size % sizeof(uint32_t) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Shader %s: invalid SPIR-V size %zu", file_path, code_size);
+        return false;
+    }
+
+    code->resize(code_size / sizeof(uint32_t));
+    memcpy(code->data(), data, code_size);
+    return true;
+}
+
+VkShaderModule
+vk_make_shader_module(VkDevice device, const std::vector<uint32_t> &code, const char *name)
+{
+    VkShaderModuleCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    create_info.codeSize = code.size() * sizeof(uint32_t);
+    create_info.pCode = code.data();
+
+    VkShaderModule shader_module = VK_NULL_HANDLE;
+    VkResult result = vkCreateShaderModule(device, &create_info, nullptr, &shader_module);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "vkCreateShaderModule(%s) = %s", name, string_VkResult(result));
+        return VK_NULL_HANDLE;
+    }
+
+    return shader_module;
+}
+
+void
+vk_shader_reload_init(Vk_Shader_Reloader *reloader, VkDevice device, Vk_Deletion_Queue *deletion_queue)
+{
+    reloader->device = device;
+    reloader->deletion_queue = deletion_queue;
+
+#if defined(HELLO_VK_GLSLC)
+    // NOTE(gr3yknigh1): CMake build passes glslc it compiles shaders with. [2025/04/06]
+    reloader->compiler = HELLO_VK_GLSLC;
+#else
+    const char *sdk_path = SDL_getenv("VK_SDK_PATH");
+    if (sdk_path != nullptr) {
+    #if defined(_WIN32)
+        reloader->compiler = std::string(sdk_path) + "\\Bin\\glslc.exe";
+    #else
+        reloader->compiler = std::string(sdk_path) + "/bin/glslc";
+    #endif
+    } else {
+        reloader->compiler = "glslc";
+    }
+#endif
+}
+
+void
+vk_shader_reload_destroy(Vk_Shader_Reloader *reloader)
+{
+    {
+        std::lock_guard<std::mutex> lock(reloader->mutex);
+        reloader->should_stop = true;
+    }
+    reloader->stop_condition.notify_all();
+
+    if (reloader->worker.joinable()) {
+        reloader->worker.join();
+    }
+
+    for (const auto &swap : reloader->swaps) {
+        vkDestroyPipeline(reloader->device, swap.handle, nullptr);
+    }
+    reloader->swaps.clear();
+
+    if (reloader->reloads_count > 0) {
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Shader reload: %llu pipelines rebuilt during run",
+            static_cast<unsigned long long>(reloader->reloads_count));
+    }
+}
+
+void
+vk_shader_reload_register(
+    Vk_Shader_Reloader *reloader, const char *name, std::initializer_list<const char *> shader_paths,
+    Vk_Pipeline_Build_Proc build, void *user_data, VkPipeline *target)
+{
+    SDL_assert(!reloader->worker.joinable());
+
+    Vk_Reloadable_Pipeline pipeline = {};
+    pipeline.name = name;
+    pipeline.build = build;
+    pipeline.user_data = user_data;
+    pipeline.target = target;
+
+    for (const char *shader_path : shader_paths) {
+        pipeline.shader_paths.push_back(shader_path);
+
+        auto is_same = [shader_path](const Vk_Shader_Source &source) {
+            return source.spirv_path == shader_path;
+        };
+        if (std::find_if(reloader->sources.begin(), reloader->sources.end(), is_same) != reloader->sources.end()) {
+            continue;
+        }
+
+        std::string_view spirv_path(shader_path);
+        SDL_assert(spirv_path.size() > 4 && spirv_path.substr(spirv_path.size() - 4) == ".spv");
+
+        Vk_Shader_Source source = {};
+        source.spirv_path = shader_path;
+        source.path = std::string(spirv_path.substr(0, spirv_path.size() - 4));
+
+        reloader->sources.push_back(std::move(source));
+    }
+
+    reloader->pipelines.push_back(std::move(pipeline));
+}
+
+///
+/// @brief Runs compiler with output captured, so errors end up in the log.
+///
+/// @return Exit status of the compiler, -1 if it couldn't be started.
+///
+static int
+vk_shader_reload_run(const std::string &arguments, std::string *output)
+{
+#if defined(_WIN32)
+    // NOTE(gr3yknigh1): `cmd /c` strips the first and the last quote of the line, the extra pair protects quoted
+    // compiler path. [2025/04/05]
+    std::string command = "\"" + arguments + " 2>&1\"";
+    FILE *pipe = _popen(command.c_str(), "r");
+#else
+    std::string command = arguments + " 2>&1";
+    FILE *pipe = popen(command.c_str(), "r");
+#endif
+    if (pipe == nullptr) {
+        return -1;
+    }
+
+    char buffer[512];
+    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+        output->append(buffer);
+    }
+
+#if defined(_WIN32)
+    return _pclose(pipe);
+#else
+    return pclose(pipe);
+#endif
+}
+
+static bool
+vk_shader_reload_compile(const Vk_Shader_Reloader *reloader, const Vk_Shader_Source &source)
+{
+    // NOTE(gr3yknigh1): Compiled into temporary file and renamed over the old one, so failed compile leaves
+    // previous SPIR-V intact for the next startup. [2025/04/05]
+    std::string temporary_path = source.spirv_path + ".tmp";
+
+    std::string output;
+    int status = vk_shader_reload_run(
+        "\"" + reloader->compiler + "\" \"" + source.path + "\" -o \"" + temporary_path + "\"", &output);
+
+    if (status != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: %s failed to compile:\n%s", source.path.c_str(), output.c_str());
+
+        std::error_code error;
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_path, source.spirv_path, error);
+    if (error) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION, "Shader reload: can't replace %s: %s", source.spirv_path.c_str(), error.message().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+///
+/// @brief Rebuilds pipelines which use any of `compiled` SPIR-V files and queues them for `vk_shader_reload_apply`.
+///
+static void
+vk_shader_reload_rebuild(Vk_Shader_Reloader *reloader, const std::vector<std::string> &compiled, uint64_t changed_counter)
+{
+    for (uint32_t pipeline_index = 0; pipeline_index < reloader->pipelines.size(); ++pipeline_index) {
+        const Vk_Reloadable_Pipeline &pipeline = reloader->pipelines[pipeline_index];
+
+        bool is_affected = false;
+        for (const auto &shader_path : pipeline.shader_paths) {
+            is_affected = is_affected || std::find(compiled.begin(), compiled.end(), shader_path) != compiled.end();
+        }
+
+        if (!is_affected) {
+            continue;
+        }
+
+        std::vector<VkShaderModule> shaders;
+        defer(for (VkShaderModule shader : shaders) vkDestroyShaderModule(reloader->device, shader, nullptr));
+
+        for (const auto &shader_path : pipeline.shader_paths) {
+            VkShaderModule shader = vk_load_shader_module(reloader->device, shader_path.c_str());
+            if (shader == VK_NULL_HANDLE) {
+                break;
+            }
+            shaders.push_back(shader);
+        }
+
+        if (shaders.size() != pipeline.shader_paths.size()) {
+            continue;
+        }
+
+        VkPipeline handle = VK_NULL_HANDLE;
+        VkResult result = pipeline.build(reloader->device, shaders.data(), pipeline.user_data, &handle);
+        if (result != VK_SUCCESS) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: %s pipeline build = %s", pipeline.name, string_VkResult(result));
+            continue;
+        }
+
+        Vk_Pipeline_Swap swap = {};
+        swap.pipeline = pipeline_index;
+        swap.handle = handle;
+        swap.changed_counter = changed_counter;
+
+        std::lock_guard<std::mutex> lock(reloader->mutex);
+        reloader->swaps.push_back(swap);
+    }
+}
+
+static void
+vk_shader_reload_worker_main(Vk_Shader_Reloader *reloader)
+{
+    std::string version;
+    if (vk_shader_reload_run("\"" + reloader->compiler + "\" --version", &version) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: can't run %s, hot reload disabled", reloader->compiler.c_str());
+        return;
+    }
+
+#if defined(__linux__)
+    // NOTE(gr3yknigh1): Directories are watched rather than files, editors commonly save by renaming a new file over
+    // the old one, which would silently end a watch on the file itself. [2025/04/05]
+    int notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notify_fd < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: inotify_init1() failed, polling sources instead");
+    }
+    defer(if (notify_fd >= 0) close(notify_fd));
+
+    std::set<std::string> directories;
+    for (const auto &source : reloader->sources) {
+        std::string directory = std::filesystem::path(source.path).parent_path().string();
+        directories.insert(directory.empty() ? "." : directory);
+    }
+
+    for (const auto &directory : directories) {
+        if (notify_fd >= 0 && inotify_add_watch(notify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: can't watch %s", directory.c_str());
+        }
+    }
+#endif
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: watching %zu sources", reloader->sources.size());
+
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+
+    while (!reloader->should_stop.load(std::memory_order_relaxed)) {
+        bool is_waiting_quiet = std::any_of(reloader->sources.begin(), reloader->sources.end(), [](const Vk_Shader_Source &source) {
+            return source.changed_counter != 0;
+        });
+
+        bool should_check = true;
+
+#if defined(__linux__)
+        if (notify_fd >= 0) {
+            pollfd poll_fd = {};
+            poll_fd.fd = notify_fd;
+            poll_fd.events = POLLIN;
+
+            // NOTE(gr3yknigh1): Timeout only bounds how long stop request waits, sources are checked on events. [2025/04/05]
+            should_check = poll(&poll_fd, 1, static_cast<int>(s_reload_poll_ms)) > 0;
+
+            alignas(inotify_event) char buffer[4096];
+            while (read(notify_fd, buffer, sizeof(buffer)) > 0) {
+            }
+        } else
+#endif
+        {
+            std::unique_lock<std::mutex> lock(reloader->mutex);
+            reloader->stop_condition.wait_for(lock, std::chrono::milliseconds(s_reload_poll_ms), [reloader] {
+                return reloader->should_stop.load();
+            });
+        }
+
+        if (!should_check && !is_waiting_quiet) {
+            continue;
+        }
+
+        uint64_t counter = SDL_GetPerformanceCounter();
+
+        std::vector<std::string> compiled;
+        uint64_t changed_counter = counter;
+
+        for (auto &source : reloader->sources) {
+            std::error_code error;
+            std::filesystem::file_time_type write_time = std::filesystem::last_write_time(source.path, error);
+
+            if (!error && write_time != source.write_time) {
+                source.write_time = write_time;
+                source.changed_counter = counter;
+                continue;
+            }
+
+            if (source.changed_counter == 0) {
+                continue;
+            }
+
+            double quiet_ms = static_cast<double>(counter - source.changed_counter) * 1000.0 / static_cast<double>(frequency);
+            if (quiet_ms < s_reload_quiet_ms) {
+                continue;
+            }
+
+            uint64_t source_changed_counter = source.changed_counter;
+            source.changed_counter = 0;
+
+            if (vk_shader_reload_compile(reloader, source)) {
+                SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: %s compiled", source.path.c_str());
+
+                compiled.push_back(source.spirv_path);
+                changed_counter = std::min(changed_counter, source_changed_counter);
+            }
+        }
+
+        if (!compiled.empty()) {
+            vk_shader_reload_rebuild(reloader, compiled, changed_counter);
+        }
+    }
+}
+
+void
+vk_shader_reload_start(Vk_Shader_Reloader *reloader)
+{
+    SDL_assert(!reloader->worker.joinable());
+
+    // NOTE(gr3yknigh1): Timestamps are taken here, so only edits made after start trigger a reload. [2025/04/05]
+    for (auto &source : reloader->sources) {
+        std::error_code error;
+        source.write_time = std::filesystem::last_write_time(source.path, error);
+        if (error) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Shader reload: source %s not found", source.path.c_str());
+        }
+    }
+
+    reloader->should_stop = false;
+    reloader->worker = std::thread(vk_shader_reload_worker_main, reloader);
+}
+
+void
+vk_shader_reload_apply(Vk_Shader_Reloader *reloader, uint64_t frame_number)
+{
+    std::vector<Vk_Pipeline_Swap> swaps;
+    {
+        std::lock_guard<std::mutex> lock(reloader->mutex);
+        if (reloader->swaps.empty()) {
+            return;
+        }
+        swaps.swap(reloader->swaps);
+    }
+
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    for (const auto &swap : swaps) {
+        const Vk_Reloadable_Pipeline &pipeline = reloader->pipelines[swap.pipeline];
+
+        vk_deletion_queue_push(reloader->deletion_queue, VK_OBJECT_TYPE_PIPELINE, vk_handle_value(*pipeline.target), frame_number);
+        *pipeline.target = swap.handle;
+
+        reloader->reloads_count++;
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Shader reload: %s pipeline swapped in %.1f ms after source change", pipeline.name,
+            static_cast<double>(counter - swap.changed_counter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()));
+    }
+}
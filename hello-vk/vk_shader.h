@@ -0,0 +1,118 @@
+#pragma once
+///
+/// @brief Shader modules and shader hot reload.
+///
+/// Reloader watches GLSL sources of registered pipelines' shaders. Changed sources are recompiled to SPIR-V with glslc
+/// on a background thread, and pipelines using them are rebuilt there as well. Main thread only swaps finished
+/// pipelines in at a frame boundary (`vk_shader_reload_apply`), so a shader edit never stalls the render loop. Replaced
+/// pipelines are destroyed once frames which used them complete.
+///
+/// @note Source of `shaders/name.vert.spv` is `shaders/name.vert`, same as the project build step compiles it.
+/// Sources pulled in by `#include` aren't tracked.
+/// @note Failed compile or pipeline build is logged and the current pipeline is kept.
+///
+
+///
+/// @brief Loads SPIR-V binary from disk and wraps it into shader module.
+///
+/// @return VK_NULL_HANDLE if file can't be read or module creation failed.
+///
+VkShaderModule vk_load_shader_module(VkDevice device, const char *file_path);
+
+///
+/// @brief First half of `vk_load_shader_module`, doesn't need device.
+///
+/// @return False if file can't be read or isn't SPIR-V sized.
+///
+bool vk_read_shader_code(const char *file_path, std::vector<uint32_t> *code);
+
+///
+/// @brief Second half of `vk_load_shader_module`.
+///
+/// @param name Logged on failure.
+///
+VkShaderModule vk_make_shader_module(VkDevice device, const std::vector<uint32_t> &code, const char *name);
+
+///
+/// @brief Creates pipeline from fresh shader modules. Called on the reloader thread.
+///
+/// @param shaders One module per registered shader path, in the same order.
+///
+typedef VkResult (*Vk_Pipeline_Build_Proc)(VkDevice device, const VkShaderModule *shaders, void *user_data, VkPipeline *result);
+
+struct Vk_Reloadable_Pipeline {
+    const char              *name = nullptr;
+    std::vector<std::string> shader_paths; // SPIR-V.
+
+    Vk_Pipeline_Build_Proc build     = nullptr;
+    void                  *user_data = nullptr; // Must stay valid and unchanged while reloader runs.
+
+    // NOTE(gr3yknigh1): Pipeline stays owned by whoever created it, reloader only swaps the handle. [2025/04/05]
+    VkPipeline *target = nullptr;
+};
+
+struct Vk_Shader_Source {
+    std::string path; // GLSL.
+    std::string spirv_path;
+
+    std::filesystem::file_time_type write_time = {};
+
+    // NOTE(gr3yknigh1): Editors often save in a few writes, compile waits until source is quiet for a bit. [2025/04/05]
+    uint64_t changed_counter = 0; // 0 unless change waits for compile.
+};
+
+struct Vk_Pipeline_Swap {
+    uint32_t   pipeline        = 0;
+    VkPipeline handle          = VK_NULL_HANDLE;
+    uint64_t   changed_counter = 0; // When change of the source was noticed.
+};
+
+struct Vk_Shader_Reloader {
+    VkDevice           device         = VK_NULL_HANDLE;
+    Vk_Deletion_Queue *deletion_queue = nullptr; // Replaced pipelines go there.
+    std::string        compiler;                 // glslc.
+
+    std::vector<Vk_Reloadable_Pipeline> pipelines; // Not changed after `vk_shader_reload_start`.
+    std::vector<Vk_Shader_Source>       sources;   // Reloader thread only after `vk_shader_reload_start`.
+
+    std::thread       worker;
+    std::atomic<bool> should_stop = false;
+
+    std::mutex                    mutex;
+    std::condition_variable       stop_condition;
+    std::vector<Vk_Pipeline_Swap> swaps; // Built, not applied yet. Guarded by `mutex`.
+
+    uint64_t reloads_count = 0;
+};
+
+///
+/// @brief Picks compiler: glslc found by CMake build, else `$VK_SDK_PATH/Bin/glslc` if Vulkan SDK is set up, else
+/// `glslc` from PATH.
+///
+void vk_shader_reload_init(Vk_Shader_Reloader *reloader, VkDevice device, Vk_Deletion_Queue *deletion_queue);
+
+///
+/// @brief Stops the reloader thread and destroys pipelines it built but didn't swap in.
+///
+void vk_shader_reload_destroy(Vk_Shader_Reloader *reloader);
+
+///
+/// @param shader_paths SPIR-V files, passed to `build` as modules in the same order.
+/// @param target Current pipeline, replaced with rebuilt one by `vk_shader_reload_apply`.
+///
+void vk_shader_reload_register(
+    Vk_Shader_Reloader *reloader, const char *name, std::initializer_list<const char *> shader_paths,
+    Vk_Pipeline_Build_Proc build, void *user_data, VkPipeline *target);
+
+///
+/// @brief Starts watching sources of registered pipelines.
+///
+void vk_shader_reload_start(Vk_Shader_Reloader *reloader);
+
+///
+/// @brief Swaps rebuilt pipelines in. Call between frames, before recording.
+///
+/// @param frame_number Number of the last submitted frame, the last one which may use replaced pipelines. They are
+/// pushed into the deletion queue with it.
+///
+void vk_shader_reload_apply(Vk_Shader_Reloader *reloader, uint64_t frame_number);
@@ -0,0 +1,425 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_timeline.h"
+#include "vk_upload.h"
+#include "vk_deletion_queue.h"
+#include "vk_bindless.h"
+#include "mapped_file.h"
+#include "ktx2.h"
+#include "vk_texture_streamer.h"
+
+// NOTE(gr3yknigh1): Budget reported by the driver changes slowly, there is no point to query it every frame. [2025/04/12]
+constexpr uint64_t s_vk_texture_budget_period = 60;
+
+///
+/// @return Bytes of mips [`level`, levels_count) as they are stored in the file.
+///
+static VkDeviceSize
+vk_texture_levels_size(const Vk_Streamed_Texture &texture, uint32_t level)
+{
+    VkDeviceSize size = 0;
+    for (uint32_t index = level; index < texture.file.levels_count; ++index) {
+        size += texture.file.levels[index].size;
+    }
+    return size;
+}
+
+///
+/// @return Staging ring space mips [`level`, levels_count) take, see `vk_upload_image_levels`.
+///
+static VkDeviceSize
+vk_texture_staging_size(const Vk_Texture_Streamer *streamer, const Vk_Streamed_Texture &texture, uint32_t level)
+{
+    VkDeviceSize alignment = streamer->upload_context->ring_alignment;
+    return vk_texture_levels_size(texture, level) + (texture.file.levels_count - level) * alignment;
+}
+
+///
+/// @brief Creates image of mips [`level`, levels_count) and stages them from the mapping. Image becomes `texture`'s
+/// pending one.
+///
+static bool
+vk_texture_streamer_stage(Vk_Texture_Streamer *streamer, Vk_Streamed_Texture *texture, uint32_t level)
+{
+    SDL_assert(texture->pending_image == VK_NULL_HANDLE);
+
+    const Ktx2_File &file = texture->file;
+    uint32_t levels_count = file.levels_count - level;
+
+    VkImageCreateInfo image_create_info = {};
+    image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_create_info.imageType = VK_IMAGE_TYPE_2D;
+    image_create_info.format = file.format;
+    image_create_info.extent = ktx2_level_extent(file, level);
+    image_create_info.mipLevels = levels_count;
+    image_create_info.arrayLayers = 1;
+    image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image_create_info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkImage image = VK_NULL_HANDLE;
+    Vk_Allocation allocation = {};
+
+    VkResult result = vk_allocator_make_image(streamer->allocator, image_create_info, Vk_Memory_Usage::Gpu_Only, &image, &allocation);
+    if (result != VK_SUCCESS) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Textures: image of mip %u can't be allocated, %s", level, string_VkResult(result));
+        return false;
+    }
+
+    std::array<Vk_Upload_Image_Level, s_vk_upload_image_levels_max> levels = {};
+    for (uint32_t index = 0; index < levels_count; ++index) {
+        levels[index].data = file.levels[level + index].data;
+        levels[index].size = file.levels[level + index].size;
+    }
+
+    // NOTE(gr3yknigh1): KTX2 stores the smallest mip first, so requested mips are one range ending at `level`. [2025/04/12]
+    const uint8_t *first = file.levels[file.levels_count - 1].data;
+    const uint8_t *last = file.levels[level].data + file.levels[level].size;
+    if (first < last) {
+        mapped_file_will_read(&file.file, static_cast<uint64_t>(first - file.file.data), static_cast<uint64_t>(last - first));
+    }
+
+    uint64_t ticket = vk_upload_image_levels(
+        streamer->upload_context, image, image_create_info.extent, levels.data(), levels_count,
+        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    if (ticket == 0) {
+        vk_allocator_destroy_image(streamer->allocator, image, &allocation);
+        return false;
+    }
+
+    streamer->committed_bytes = streamer->committed_bytes + allocation.size - texture->allocation.size;
+    streamer->stats.uploaded_bytes += vk_texture_levels_size(*texture, level);
+
+    texture->pending_image = image;
+    texture->pending_allocation = allocation;
+    texture->pending_level = level;
+    texture->pending_ticket = ticket;
+
+    return true;
+}
+
+///
+/// @brief Replaces resident image with the pending one, whose upload is acquired by graphics queue.
+///
+static void
+vk_texture_streamer_swap(Vk_Texture_Streamer *streamer, Vk_Streamed_Texture *texture, uint64_t frame_number)
+{
+    VkImageViewCreateInfo view_create_info = {};
+    view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view_create_info.image = texture->pending_image;
+    view_create_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_create_info.format = texture->file.format;
+    view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    view_create_info.subresourceRange.levelCount = texture->file.levels_count - texture->pending_level;
+    view_create_info.subresourceRange.layerCount = 1;
+
+    VkImageView image_view = VK_NULL_HANDLE;
+    VkResult result = vkCreateImageView(streamer->device, &view_create_info, nullptr, &image_view);
+
+    Vk_Bindless_Handle handle = {};
+    if (result == VK_SUCCESS) {
+        handle = vk_bindless_add_texture(streamer->bindless_table, image_view, streamer->sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+
+    // NOTE(gr3yknigh1): Acquire barrier of the pending image is in a submitted frame, so it is retired the same way
+    // as the resident one would be. [2025/04/12]
+    if (handle.value == 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Textures: view of mip %u can't be made, residency is kept", texture->pending_level);
+
+        if (image_view != VK_NULL_HANDLE) {
+            vkDestroyImageView(streamer->device, image_view, nullptr);
+        }
+
+        streamer->committed_bytes = streamer->committed_bytes + texture->allocation.size - texture->pending_allocation.size;
+        vk_deletion_queue_push(
+            streamer->deletion_queue, VK_OBJECT_TYPE_IMAGE, vk_handle_value(texture->pending_image),
+            texture->pending_allocation, frame_number);
+    } else {
+        if (texture->image != VK_NULL_HANDLE) {
+            vk_bindless_remove(streamer->bindless_table, texture->handle, frame_number);
+            vk_deletion_queue_push(streamer->deletion_queue, VK_OBJECT_TYPE_IMAGE_VIEW, vk_handle_value(texture->image_view), frame_number);
+            vk_deletion_queue_push(
+                streamer->deletion_queue, VK_OBJECT_TYPE_IMAGE, vk_handle_value(texture->image), texture->allocation, frame_number);
+        }
+
+        texture->image = texture->pending_image;
+        texture->allocation = texture->pending_allocation;
+        texture->image_view = image_view;
+        texture->handle = handle;
+        texture->resident_level = texture->pending_level;
+    }
+
+    texture->pending_image = VK_NULL_HANDLE;
+    texture->pending_allocation = {};
+    texture->pending_ticket = 0;
+}
+
+static void
+vk_texture_streamer_refresh_budget(Vk_Texture_Streamer *streamer, uint64_t frame_number)
+{
+    streamer->budget_frame_number = frame_number;
+
+    if (streamer->budget_override != 0) {
+        streamer->budget = streamer->budget_override;
+        return;
+    }
+
+    Vk_Memory_Budget memory_budget = {};
+    vk_query_memory_budget(*streamer->capabilities, &memory_budget);
+
+    // NOTE(gr3yknigh1): Without reported usage everything the allocator holds is counted, host memory too, so
+    // the estimate errs on the safe side. [2025/04/12]
+    VkDeviceSize usage = memory_budget.is_reported
+        ? memory_budget.usages[streamer->heap_index]
+        : vk_allocator_get_stats(streamer->allocator).reserved_bytes;
+
+    VkDeviceSize others_usage = usage > streamer->committed_bytes ? usage - streamer->committed_bytes : 0;
+    VkDeviceSize heap_budget = memory_budget.budgets[streamer->heap_index];
+    VkDeviceSize available = heap_budget > others_usage ? heap_budget - others_usage : 0;
+
+    // NOTE(gr3yknigh1): Reported usage lags behind allocations, and other resources may grow meanwhile. [2025/04/12]
+    streamer->budget = available / 10 * 9;
+}
+
+///
+/// @brief Demotes the least recently requested textures which are more detailed than requested, until `needed`
+/// more bytes fit into the budget.
+///
+/// @return False if nothing is left to demote.
+///
+static bool
+vk_texture_streamer_evict(Vk_Texture_Streamer *streamer, VkDeviceSize needed)
+{
+    while (streamer->committed_bytes + needed > streamer->budget) {
+        Vk_Streamed_Texture *victim = nullptr;
+
+        for (auto &texture : streamer->textures) {
+            bool is_demotable = texture.pending_image == VK_NULL_HANDLE && texture.image != VK_NULL_HANDLE
+                && texture.wanted_level > texture.resident_level;
+
+            if (is_demotable && (victim == nullptr || texture.last_request_frame < victim->last_request_frame)) {
+                victim = &texture;
+            }
+        }
+
+        if (victim == nullptr || !vk_texture_streamer_stage(streamer, victim, victim->wanted_level)) {
+            return false;
+        }
+
+        streamer->stats.evictions_count++;
+    }
+
+    return true;
+}
+
+VkResult
+vk_texture_streamer_init(
+    Vk_Texture_Streamer *streamer, const Vk_Device_Capabilities &capabilities, VkDevice device, Vk_Allocator *allocator,
+    Vk_Upload_Context *upload_context, Vk_Bindless_Table *bindless_table, Vk_Deletion_Queue *deletion_queue,
+    VkDeviceSize budget_override, VkDeviceSize upload_bytes_per_frame)
+{
+    *streamer = {};
+    streamer->device = device;
+    streamer->allocator = allocator;
+    streamer->upload_context = upload_context;
+    streamer->bindless_table = bindless_table;
+    streamer->deletion_queue = deletion_queue;
+    streamer->capabilities = &capabilities;
+    streamer->budget_override = budget_override;
+    streamer->upload_bytes_per_frame = upload_bytes_per_frame;
+
+    const VkPhysicalDeviceMemoryProperties &memory_properties = capabilities.memory_properties;
+    for (uint32_t heap_index = 0; heap_index < memory_properties.memoryHeapCount; ++heap_index) {
+        const VkMemoryHeap &heap = memory_properties.memoryHeaps[heap_index];
+        if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0 && heap.size == capabilities.device_local_size) {
+            streamer->heap_index = heap_index;
+            break;
+        }
+    }
+
+    VkSamplerCreateInfo sampler_create_info = {};
+    sampler_create_info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_create_info.magFilter = VK_FILTER_LINEAR;
+    sampler_create_info.minFilter = VK_FILTER_LINEAR;
+    sampler_create_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    sampler_create_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    sampler_create_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    sampler_create_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    sampler_create_info.maxLod = VK_LOD_CLAMP_NONE;
+
+    VkResult result = vkCreateSampler(device, &sampler_create_info, nullptr, &streamer->sampler);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    vk_texture_streamer_refresh_budget(streamer, 0);
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Textures: budget %llu MiB (%s) in heap #%u, %llu KiB uploads per frame",
+        static_cast<unsigned long long>(streamer->budget >> 20), budget_override != 0 ? "override" : "heap budget",
+        streamer->heap_index, static_cast<unsigned long long>(upload_bytes_per_frame >> 10));
+
+    return VK_SUCCESS;
+}
+
+void
+vk_texture_streamer_destroy(Vk_Texture_Streamer *streamer)
+{
+    if (streamer->device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    vk_texture_streamer_log_stats(*streamer);
+
+    for (auto &texture : streamer->textures) {
+        if (texture.pending_image != VK_NULL_HANDLE) {
+            vk_allocator_destroy_image(streamer->allocator, texture.pending_image, &texture.pending_allocation);
+        }
+
+        if (texture.image != VK_NULL_HANDLE) {
+            vk_bindless_remove(streamer->bindless_table, texture.handle, 0);
+            vkDestroyImageView(streamer->device, texture.image_view, nullptr);
+            vk_allocator_destroy_image(streamer->allocator, texture.image, &texture.allocation);
+        }
+
+        ktx2_close(&texture.file);
+    }
+
+    vkDestroySampler(streamer->device, streamer->sampler, nullptr);
+
+    *streamer = {};
+}
+
+std::optional<uint32_t>
+vk_texture_streamer_add(Vk_Texture_Streamer *streamer, const char *path)
+{
+    Vk_Streamed_Texture texture = {};
+    if (!ktx2_open(path, &texture.file)) {
+        return std::nullopt;
+    }
+
+    VkFormatProperties format_properties = {};
+    vkGetPhysicalDeviceFormatProperties(streamer->capabilities->handle, texture.file.format, &format_properties);
+
+    if ((format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) == 0) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_APPLICATION, "Textures: %s is skipped, device can't sample %s", path,
+            string_VkFormat(texture.file.format));
+        ktx2_close(&texture.file);
+        return std::nullopt;
+    }
+
+    uint32_t tail_level = 0;
+    while (tail_level + 1 < texture.file.levels_count
+        && std::max(texture.file.width, texture.file.height) >> tail_level > s_vk_texture_tail_size) {
+        ++tail_level;
+    }
+
+    texture.tail_level = tail_level;
+    texture.resident_level = texture.file.levels_count;
+    texture.wanted_level = tail_level;
+
+    streamer->textures.push_back(texture);
+
+    uint32_t index = static_cast<uint32_t>(streamer->textures.size() - 1);
+    if (!vk_texture_streamer_stage(streamer, &streamer->textures[index], tail_level)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Textures: %s is skipped, its tail can't be uploaded", path);
+        ktx2_close(&streamer->textures[index].file);
+        streamer->textures.pop_back();
+        return std::nullopt;
+    }
+
+    return index;
+}
+
+void
+vk_texture_streamer_request(Vk_Texture_Streamer *streamer, uint32_t texture_index, float footprint, uint64_t frame_number)
+{
+    Vk_Streamed_Texture &texture = streamer->textures[texture_index];
+
+    // NOTE(gr3yknigh1): Mip whose size is the closest one not smaller than the footprint. [2025/04/12]
+    uint32_t level = texture.tail_level;
+    if (footprint >= 1.0f) {
+        float ratio = static_cast<float>(std::max(texture.file.width, texture.file.height)) / footprint;
+        level = ratio > 1.0f ? static_cast<uint32_t>(floorf(log2f(ratio))) : 0;
+    }
+
+    texture.wanted_level = std::min(texture.wanted_level, std::min(level, texture.tail_level));
+    texture.last_request_frame = frame_number;
+}
+
+void
+vk_texture_streamer_update(Vk_Texture_Streamer *streamer, uint64_t frame_number)
+{
+    for (auto &texture : streamer->textures) {
+        if (texture.pending_image != VK_NULL_HANDLE && vk_upload_is_ready(streamer->upload_context, texture.pending_ticket)) {
+            vk_texture_streamer_swap(streamer, &texture, frame_number);
+        }
+    }
+
+    if (frame_number >= streamer->budget_frame_number + s_vk_texture_budget_period) {
+        vk_texture_streamer_refresh_budget(streamer, frame_number);
+    }
+
+    VkDeviceSize staged_bytes = 0;
+
+    for (auto &texture : streamer->textures) {
+        if (texture.pending_image != VK_NULL_HANDLE || texture.wanted_level >= texture.resident_level) {
+            continue;
+        }
+
+        if (staged_bytes >= streamer->upload_bytes_per_frame) {
+            streamer->stats.deferred_count++;
+            continue;
+        }
+
+        // NOTE(gr3yknigh1): All mips of the replacement are staged at once, so they must fit into the ring. [2025/04/12]
+        uint32_t level = texture.wanted_level;
+        while (level < texture.resident_level && vk_texture_staging_size(streamer, texture, level) > streamer->upload_context->ring_size) {
+            ++level;
+        }
+
+        for (; level < texture.resident_level; ++level) {
+            VkDeviceSize size = vk_texture_levels_size(texture, level);
+            VkDeviceSize needed = size > texture.allocation.size ? size - texture.allocation.size : 0;
+
+            if (vk_texture_streamer_evict(streamer, needed)) {
+                break;
+            }
+        }
+
+        if (level != texture.wanted_level) {
+            streamer->stats.denied_count++;
+        }
+
+        if (level < texture.resident_level && vk_texture_streamer_stage(streamer, &texture, level)) {
+            streamer->stats.promotions_count++;
+            staged_bytes += vk_texture_levels_size(texture, level);
+        }
+    }
+
+    for (auto &texture : streamer->textures) {
+        texture.wanted_level = texture.tail_level;
+    }
+}
+
+void
+vk_texture_streamer_log_stats(const Vk_Texture_Streamer &streamer)
+{
+    constexpr double mib = 1024.0 * 1024.0;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION,
+        "Textures: %zu streamed, %.2f / %.2f MiB committed, %llu promotions, %llu evictions, %.2f MiB uploaded",
+        streamer.textures.size(), streamer.committed_bytes / mib, streamer.budget / mib,
+        static_cast<unsigned long long>(streamer.stats.promotions_count),
+        static_cast<unsigned long long>(streamer.stats.evictions_count), streamer.stats.uploaded_bytes / mib);
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Textures: %llu promotions deferred by upload limit, %llu cut short by budget",
+        static_cast<unsigned long long>(streamer.stats.deferred_count),
+        static_cast<unsigned long long>(streamer.stats.denied_count));
+}
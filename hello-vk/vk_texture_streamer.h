@@ -0,0 +1,136 @@
+#pragma once
+///
+/// @brief Mip streaming of KTX2 textures under a device memory budget.
+///
+/// Texture stays mapped for its whole life. Resident image holds mips [`resident_level`, levels_count), registration
+/// uploads only the tail (mips not bigger than `s_vk_texture_tail_size`), so the lowest mips are there right away.
+/// More detailed mips are requested from screen-space footprint of the texture (`vk_texture_streamer_request`).
+///
+/// Residency changes by replacing the image: a fresh one with the new set of mips is uploaded from the mapping through
+/// the transfer ring, and once the upload is acquired by graphics queue it takes place of the old one, which goes to
+/// the deletion queue. Fresh image is never used by graphics queue before, so transfer queue can write it, and frames
+/// in flight keep reading the old one through its own bindless slot.
+///
+/// If textures need more than the budget, the least recently requested ones are demoted: to the mip they are requested
+/// at now, or back to their tail if they aren't.
+///
+/// @note Not thread safe.
+///
+
+// NOTE(gr3yknigh1): 64x64 BC7 with its mips is ~5.5 KiB, so the tails of thousands of textures stay resident. [2025/04/12]
+constexpr uint32_t s_vk_texture_tail_size = 64;
+
+struct Vk_Streamed_Texture {
+    Ktx2_File file;
+
+    uint32_t tail_level = 0; // Never demoted below it.
+
+    VkImage            image      = VK_NULL_HANDLE;
+    Vk_Allocation      allocation;
+    VkImageView        image_view = VK_NULL_HANDLE;
+    Vk_Bindless_Handle handle;
+    uint32_t           resident_level = 0; // Most detailed mip in `image`, its mip 0.
+
+    // NOTE(gr3yknigh1): Replacement being uploaded, VK_NULL_HANDLE if none. At most one per texture. [2025/04/12]
+    VkImage       pending_image = VK_NULL_HANDLE;
+    Vk_Allocation pending_allocation;
+    uint32_t      pending_level  = 0;
+    uint64_t      pending_ticket = 0;
+
+    uint32_t wanted_level       = 0; // Most detailed mip requested since the last update.
+    uint64_t last_request_frame = 0; // Order of LRU eviction.
+};
+
+struct Vk_Texture_Streamer_Stats {
+    uint64_t promotions_count = 0;
+    uint64_t evictions_count  = 0;
+    uint64_t uploaded_bytes   = 0;
+    uint64_t deferred_count   = 0; // Promotions postponed by per-frame upload limit.
+    uint64_t denied_count     = 0; // Promotions cut short by the budget, nothing could be evicted.
+};
+
+struct Vk_Texture_Streamer {
+    VkDevice           device         = VK_NULL_HANDLE;
+    Vk_Allocator      *allocator      = nullptr;
+    Vk_Upload_Context *upload_context = nullptr;
+    Vk_Bindless_Table *bindless_table = nullptr;
+    Vk_Deletion_Queue *deletion_queue = nullptr;
+
+    const Vk_Device_Capabilities *capabilities = nullptr;
+
+    VkSampler sampler = VK_NULL_HANDLE;
+
+    std::vector<Vk_Streamed_Texture> textures;
+
+    // NOTE(gr3yknigh1): Largest DEVICE_LOCAL heap, where images go. [2025/04/12]
+    uint32_t heap_index = 0;
+
+    VkDeviceSize budget_override        = 0; // 0 derives budget from the heap's one.
+    VkDeviceSize budget                 = 0;
+    VkDeviceSize upload_bytes_per_frame = 0;
+    uint64_t     budget_frame_number    = 0;
+
+    // NOTE(gr3yknigh1): Memory of images textures end up with: pending ones instead of those they replace. Old
+    // images are freed a few frames later, by the deletion queue. [2025/04/12]
+    VkDeviceSize committed_bytes = 0;
+
+    Vk_Texture_Streamer_Stats stats;
+};
+
+///
+/// @param budget_override Bytes textures may take, 0 to use what is left of the heap's budget.
+/// @param upload_bytes_per_frame Limit of promotions staged per update, so streaming doesn't take the whole ring.
+///
+VkResult vk_texture_streamer_init(
+    Vk_Texture_Streamer *streamer, const Vk_Device_Capabilities &capabilities, VkDevice device, Vk_Allocator *allocator,
+    Vk_Upload_Context *upload_context, Vk_Bindless_Table *bindless_table, Vk_Deletion_Queue *deletion_queue,
+    VkDeviceSize budget_override, VkDeviceSize upload_bytes_per_frame);
+
+///
+/// @brief Destroys all textures and logs statistics. Device must be idle.
+///
+void vk_texture_streamer_destroy(Vk_Texture_Streamer *streamer);
+
+///
+/// @brief Maps KTX2 texture and uploads its tail.
+///
+/// @return Index of the texture, std::nullopt if file can't be used (see `ktx2_open`) or device can't sample its format.
+///
+std::optional<uint32_t> vk_texture_streamer_add(Vk_Texture_Streamer *streamer, const char *path);
+
+///
+/// @brief Records that `texture` is drawn `footprint` pixels big (along its bigger side) in frame `frame_number`.
+///
+/// @note Cheap, meant to be called for every visible draw of the frames feedback is gathered in.
+///
+void vk_texture_streamer_request(Vk_Texture_Streamer *streamer, uint32_t texture, float footprint, uint64_t frame_number);
+
+///
+/// @brief Swaps in finished replacements, refreshes the budget, promotes requested textures and evicts the least
+/// recently requested ones if needed. Once per frame, before the frame is recorded.
+///
+/// @param frame_number The last submitted frame, the last one which may read replaced images.
+///
+void vk_texture_streamer_update(Vk_Texture_Streamer *streamer, uint64_t frame_number);
+
+///
+/// @return False until the tail uploaded by `vk_texture_streamer_add` is swapped in.
+///
+inline bool
+vk_texture_streamer_is_resident(const Vk_Texture_Streamer &streamer, uint32_t texture)
+{
+    return streamer.textures[texture].image != VK_NULL_HANDLE;
+}
+
+///
+/// @return Index shaders read the texture at. Changes when residency does, so it is fetched every frame.
+///
+/// @note Texture must be resident.
+///
+inline uint32_t
+vk_texture_streamer_shader_index(const Vk_Texture_Streamer &streamer, uint32_t texture)
+{
+    return vk_bindless_shader_index(*streamer.bindless_table, streamer.textures[texture].handle);
+}
+
+void vk_texture_streamer_log_stats(const Vk_Texture_Streamer &streamer);
@@ -0,0 +1,292 @@
+#include "stdafx.h"
+
+#include "vk_timeline.h"
+
+static VkResult
+vk_timeline_take_fence(Vk_Timeline *timeline, VkFence *fence)
+{
+    if (!timeline->free_fences.empty()) {
+        *fence = timeline->free_fences.back();
+        timeline->free_fences.pop_back();
+        return VK_SUCCESS;
+    }
+
+    VkFenceCreateInfo fence_create_info = {};
+    fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkResult result = vkCreateFence(timeline->device, &fence_create_info, nullptr, fence);
+    if (result == VK_SUCCESS) {
+        timeline->fences_count++;
+    }
+    return result;
+}
+
+VkResult
+vk_timeline_init(Vk_Timeline *timeline, VkDevice device, bool use_semaphore, const char *name)
+{
+    *timeline = {};
+    timeline->device = device;
+    timeline->name = name;
+
+    if (!use_semaphore) {
+        // NOTE(gr3yknigh1): Frames in flight plus a few, so steady state neither creates fences nor grows. [2025/04/10]
+        timeline->pending_fences.reserve(16);
+        timeline->free_fences.reserve(16);
+        return VK_SUCCESS;
+    }
+
+    // NOTE(gr3yknigh1): Core names on Vulkan 1.2 device, KHR ones if only the extension is there. [2025/04/10]
+    timeline->wait_semaphores = reinterpret_cast<PFN_vkWaitSemaphores>(vkGetDeviceProcAddr(device, "vkWaitSemaphores"));
+    if (timeline->wait_semaphores == nullptr) {
+        timeline->wait_semaphores = reinterpret_cast<PFN_vkWaitSemaphores>(vkGetDeviceProcAddr(device, "vkWaitSemaphoresKHR"));
+    }
+
+    timeline->get_semaphore_counter_value = reinterpret_cast<PFN_vkGetSemaphoreCounterValue>(
+        vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValue"));
+    if (timeline->get_semaphore_counter_value == nullptr) {
+        timeline->get_semaphore_counter_value = reinterpret_cast<PFN_vkGetSemaphoreCounterValue>(
+            vkGetDeviceProcAddr(device, "vkGetSemaphoreCounterValueKHR"));
+    }
+
+    if (timeline->wait_semaphores == nullptr || timeline->get_semaphore_counter_value == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sync: %s timeline: timeline semaphore entry points are missing", name);
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    VkSemaphoreTypeCreateInfo semaphore_type_create_info = {};
+    semaphore_type_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    semaphore_type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    semaphore_type_create_info.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphore_create_info = {};
+    semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphore_create_info.pNext = &semaphore_type_create_info;
+
+    return vkCreateSemaphore(device, &semaphore_create_info, nullptr, &timeline->semaphore);
+}
+
+void
+vk_timeline_destroy(Vk_Timeline *timeline)
+{
+    if (timeline->device == VK_NULL_HANDLE) {
+        return;
+    }
+
+    if (timeline->semaphore != VK_NULL_HANDLE) {
+        vkDestroySemaphore(timeline->device, timeline->semaphore, nullptr);
+    }
+
+    for (const auto &pending : timeline->pending_fences) {
+        vkDestroyFence(timeline->device, pending.fence, nullptr);
+    }
+    for (VkFence fence : timeline->free_fences) {
+        vkDestroyFence(timeline->device, fence, nullptr);
+    }
+
+    if (timeline->submits_count > 0) {
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Sync: %s timeline (%s), %llu submits, %llu host waits, %llu fences, %llu fence resets",
+            timeline->name, timeline->semaphore != VK_NULL_HANDLE ? "semaphore" : "fences",
+            static_cast<unsigned long long>(timeline->submits_count), static_cast<unsigned long long>(timeline->host_waits_count),
+            static_cast<unsigned long long>(timeline->fences_count), static_cast<unsigned long long>(timeline->fence_resets_count));
+    }
+
+    *timeline = {};
+}
+
+VkResult
+vk_timeline_submit(
+    Vk_Timeline *timeline, VkQueue queue, const VkCommandBuffer *command_buffers, uint32_t command_buffers_count,
+    const Vk_Submit_Waits *waits, VkSemaphore signal_semaphore, uint64_t *value)
+{
+    VkResult result = VK_SUCCESS;
+
+    std::array<VkSemaphore, s_submit_waits_max * 2>          wait_semaphores = {};
+    std::array<uint64_t, s_submit_waits_max * 2>             wait_values     = {};
+    std::array<VkPipelineStageFlags, s_submit_waits_max * 2> wait_stages     = {};
+    uint32_t                                                 waits_count     = 0;
+
+    //
+    // NOTE(gr3yknigh1): Fence-backed timeline may wait on a semaphore-backed one, so values are chained whenever any
+    // semaphore of the submit is a timeline one, not only when this timeline is. Without them the wait is invalid.
+    // [2025/04/16]
+    //
+    bool has_timeline_semaphores = timeline->semaphore != VK_NULL_HANDLE;
+
+    if (waits != nullptr) {
+        for (uint32_t index = 0; index < waits->semaphores_count; ++index) {
+            wait_semaphores[waits_count] = waits->semaphores[index];
+            wait_stages[waits_count] = waits->semaphore_stages[index];
+            waits_count++;
+        }
+
+        for (uint32_t index = 0; index < waits->timelines_count; ++index) {
+            Vk_Timeline *other = waits->timelines[index];
+            uint64_t other_value = waits->timeline_values[index];
+
+            if (other->semaphore == VK_NULL_HANDLE) {
+                result = vk_timeline_wait(other, other_value);
+                if (result != VK_SUCCESS) {
+                    return result;
+                }
+                continue;
+            }
+
+            wait_semaphores[waits_count] = other->semaphore;
+            wait_values[waits_count] = other_value;
+            wait_stages[waits_count] = waits->timeline_stages[index];
+            waits_count++;
+
+            has_timeline_semaphores = true;
+        }
+    }
+
+    uint64_t next_value = timeline->submitted_value + 1;
+
+    std::array<VkSemaphore, 2> signal_semaphores = {};
+    std::array<uint64_t, 2>    signal_values     = {};
+    uint32_t                   signals_count     = 0;
+
+    if (signal_semaphore != VK_NULL_HANDLE) {
+        signal_semaphores[signals_count++] = signal_semaphore;
+    }
+
+    if (timeline->semaphore != VK_NULL_HANDLE) {
+        signal_semaphores[signals_count] = timeline->semaphore;
+        signal_values[signals_count] = next_value;
+        signals_count++;
+    }
+
+    // NOTE(gr3yknigh1): Values of binary semaphores in these arrays are ignored. [2025/04/10]
+    VkTimelineSemaphoreSubmitInfo timeline_submit_info = {};
+    timeline_submit_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timeline_submit_info.waitSemaphoreValueCount = waits_count;
+    timeline_submit_info.pWaitSemaphoreValues = wait_values.data();
+    timeline_submit_info.signalSemaphoreValueCount = signals_count;
+    timeline_submit_info.pSignalSemaphoreValues = signal_values.data();
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.pNext = has_timeline_semaphores ? &timeline_submit_info : nullptr;
+    submit_info.waitSemaphoreCount = waits_count;
+    submit_info.pWaitSemaphores = wait_semaphores.data();
+    submit_info.pWaitDstStageMask = wait_stages.data();
+    submit_info.commandBufferCount = command_buffers_count;
+    submit_info.pCommandBuffers = command_buffers;
+    submit_info.signalSemaphoreCount = signals_count;
+    submit_info.pSignalSemaphores = signal_semaphores.data();
+
+    VkFence fence = VK_NULL_HANDLE;
+    if (timeline->semaphore == VK_NULL_HANDLE) {
+        result = vk_timeline_take_fence(timeline, &fence);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    result = vkQueueSubmit(queue, 1, &submit_info, fence);
+    if (result != VK_SUCCESS) {
+        if (fence != VK_NULL_HANDLE) {
+            timeline->free_fences.push_back(fence);
+        }
+        return result;
+    }
+
+    if (fence != VK_NULL_HANDLE) {
+        timeline->pending_fences.push_back({ fence, next_value });
+    }
+
+    timeline->submitted_value = next_value;
+    timeline->submits_count++;
+
+    if (value != nullptr) {
+        *value = next_value;
+    }
+
+    return VK_SUCCESS;
+}
+
+uint64_t
+vk_timeline_poll(Vk_Timeline *timeline)
+{
+    if (timeline->completed_value == timeline->submitted_value) {
+        return timeline->completed_value;
+    }
+
+    if (timeline->semaphore != VK_NULL_HANDLE) {
+        uint64_t value = 0;
+        if (timeline->get_semaphore_counter_value(timeline->device, timeline->semaphore, &value) == VK_SUCCESS) {
+            timeline->completed_value = std::max(timeline->completed_value, value);
+        }
+        return timeline->completed_value;
+    }
+
+    // NOTE(gr3yknigh1): Newest signaled fence wins, everything before it is completed too. [2025/04/10]
+    size_t signaled_count = 0;
+    for (const auto &pending : timeline->pending_fences) {
+        if (vkGetFenceStatus(timeline->device, pending.fence) != VK_SUCCESS) {
+            break;
+        }
+        signaled_count++;
+    }
+
+    if (signaled_count == 0) {
+        return timeline->completed_value;
+    }
+
+    for (size_t index = 0; index < signaled_count; ++index) {
+        timeline->free_fences.push_back(timeline->pending_fences[index].fence);
+    }
+
+    VkFence *signaled_fences = timeline->free_fences.data() + timeline->free_fences.size() - signaled_count;
+    vkResetFences(timeline->device, static_cast<uint32_t>(signaled_count), signaled_fences);
+    timeline->fence_resets_count += signaled_count;
+
+    timeline->completed_value = timeline->pending_fences[signaled_count - 1].value;
+    timeline->pending_fences.erase(timeline->pending_fences.begin(), timeline->pending_fences.begin() + signaled_count);
+
+    return timeline->completed_value;
+}
+
+VkResult
+vk_timeline_wait(Vk_Timeline *timeline, uint64_t value)
+{
+    if (value <= timeline->completed_value || value <= vk_timeline_poll(timeline)) {
+        return VK_SUCCESS;
+    }
+
+    SDL_assert(value <= timeline->submitted_value);
+
+    timeline->host_waits_count++;
+
+    if (timeline->semaphore != VK_NULL_HANDLE) {
+        VkSemaphoreWaitInfo wait_info = {};
+        wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        wait_info.semaphoreCount = 1;
+        wait_info.pSemaphores = &timeline->semaphore;
+        wait_info.pValues = &value;
+
+        VkResult result = timeline->wait_semaphores(timeline->device, &wait_info, std::numeric_limits<uint64_t>::max());
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        timeline->completed_value = std::max(timeline->completed_value, value);
+        return VK_SUCCESS;
+    }
+
+    for (const auto &pending : timeline->pending_fences) {
+        if (pending.value < value) {
+            continue;
+        }
+
+        VkResult result = vkWaitForFences(timeline->device, 1, &pending.fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        break;
+    }
+
+    vk_timeline_poll(timeline);
+    return VK_SUCCESS;
+}
@@ -0,0 +1,115 @@
+#pragma once
+///
+/// @brief Monotonic timeline of one submitting stream: every submit signals the next value, CPU and other queues
+/// wait for values instead of juggling fences.
+///
+/// Backed by timeline semaphore (Vulkan 1.2 or VK_KHR_timeline_semaphore): no fences, no resets, other queues wait
+/// on it directly. Without it every submit gets a fence from a small pool. Fence signal covers all earlier work of
+/// the queue, so the newest signaled fence gives completed value just the same, but other queues can't wait on it:
+/// cross-queue waits then need a binary semaphore from the caller (see `vk_compute_submit`), or are done on host.
+///
+/// @note Not thread safe. Queue may carry a few timelines (e.g. uploads on graphics queue without transfer family).
+///
+
+struct Vk_Timeline_Fence {
+    VkFence  fence = VK_NULL_HANDLE;
+    uint64_t value = 0;
+};
+
+struct Vk_Timeline {
+    VkDevice    device    = VK_NULL_HANDLE;
+    VkSemaphore semaphore = VK_NULL_HANDLE; // VK_NULL_HANDLE if fences are used.
+    const char *name      = nullptr;
+
+    PFN_vkWaitSemaphores           wait_semaphores             = nullptr;
+    PFN_vkGetSemaphoreCounterValue get_semaphore_counter_value = nullptr;
+
+    uint64_t submitted_value = 0;
+    uint64_t completed_value = 0; // Cached, the newest value seen completed.
+
+    // NOTE(gr3yknigh1): Fence fallback only. Pending are in submit order, queue signals them in the same order. [2025/04/10]
+    std::vector<Vk_Timeline_Fence> pending_fences;
+    std::vector<VkFence>           free_fences;
+
+    uint64_t submits_count      = 0;
+    uint64_t host_waits_count   = 0; // Waits which actually blocked.
+    uint64_t fences_count       = 0; // Created.
+    uint64_t fence_resets_count = 0;
+};
+
+constexpr uint32_t s_submit_waits_max = 4;
+
+///
+/// @brief Waits of one submit: binary semaphores (swapchain acquire, cross-queue without timeline semaphores) and
+/// values of other timelines.
+///
+struct Vk_Submit_Waits {
+    std::array<VkSemaphore, s_submit_waits_max>          semaphores       = {};
+    std::array<VkPipelineStageFlags, s_submit_waits_max> semaphore_stages = {};
+    uint32_t                                             semaphores_count = 0;
+
+    std::array<Vk_Timeline *, s_submit_waits_max>        timelines       = {};
+    std::array<uint64_t, s_submit_waits_max>             timeline_values = {};
+    std::array<VkPipelineStageFlags, s_submit_waits_max> timeline_stages = {};
+    uint32_t                                             timelines_count = 0;
+};
+
+inline void
+vk_submit_waits_add_semaphore(Vk_Submit_Waits *waits, VkSemaphore semaphore, VkPipelineStageFlags stage)
+{
+    SDL_assert(waits->semaphores_count < s_submit_waits_max);
+
+    waits->semaphores[waits->semaphores_count] = semaphore;
+    waits->semaphore_stages[waits->semaphores_count] = stage;
+    waits->semaphores_count++;
+}
+
+inline void
+vk_submit_waits_add_timeline(Vk_Submit_Waits *waits, Vk_Timeline *timeline, uint64_t value, VkPipelineStageFlags stage)
+{
+    SDL_assert(waits->timelines_count < s_submit_waits_max);
+
+    waits->timelines[waits->timelines_count] = timeline;
+    waits->timeline_values[waits->timelines_count] = value;
+    waits->timeline_stages[waits->timelines_count] = stage;
+    waits->timelines_count++;
+}
+
+///
+/// @param use_semaphore Device has timeline semaphores enabled. Otherwise fences are used.
+/// @param name For statistics, logged on destroy.
+///
+VkResult vk_timeline_init(Vk_Timeline *timeline, VkDevice device, bool use_semaphore, const char *name);
+
+///
+/// @brief Logs statistics and frees everything. Device must be idle.
+///
+void vk_timeline_destroy(Vk_Timeline *timeline);
+
+///
+/// @brief Submits command buffers which signal the next value of the timeline.
+///
+/// @param waits May be nullptr. Timeline waits of fence-backed timelines are done on host before submit.
+/// @param signal_semaphore Binary semaphore to signal too (present, cross-queue without timeline semaphores). May
+/// be VK_NULL_HANDLE.
+/// @param value Signaled value. May be nullptr.
+///
+VkResult vk_timeline_submit(
+    Vk_Timeline *timeline, VkQueue queue, const VkCommandBuffer *command_buffers, uint32_t command_buffers_count,
+    const Vk_Submit_Waits *waits, VkSemaphore signal_semaphore, uint64_t *value);
+
+///
+/// @return Completed value, refreshed from device. Never blocks.
+///
+uint64_t vk_timeline_poll(Vk_Timeline *timeline);
+
+///
+/// @brief Blocks until `value` is completed. 0 and already completed values return right away.
+///
+VkResult vk_timeline_wait(Vk_Timeline *timeline, uint64_t value);
+
+inline bool
+vk_timeline_is_completed(Vk_Timeline *timeline, uint64_t value)
+{
+    return value <= timeline->completed_value || value <= vk_timeline_poll(timeline);
+}
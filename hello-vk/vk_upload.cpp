@@ -0,0 +1,469 @@
+#include "stdafx.h"
+
+#include "vk_device.h"
+#include "vk_memory.h"
+#include "vk_timeline.h"
+#include "vk_upload.h"
+
+static bool
+vk_upload_has_ownership_transfer(const Vk_Upload_Context *context)
+{
+    return context->transfer_queue_index != context->graphics_queue_index;
+}
+
+///
+/// @brief Moves acquire barriers of the oldest submitted batch to pending list and releases its ring space.
+///
+/// @param wait If not set, returns `false` when the oldest batch isn't finished yet.
+/// @return `false` if nothing was retired.
+///
+static bool
+vk_upload_retire_oldest(Vk_Upload_Context *context, bool wait)
+{
+    Vk_Upload_Batch *oldest = nullptr;
+    for (auto &batch : context->batches) {
+        if (batch.state == Vk_Upload_Batch_State::Submitted && (oldest == nullptr || batch.ticket < oldest->ticket)) {
+            oldest = &batch;
+        }
+    }
+
+    if (oldest == nullptr) {
+        return false;
+    }
+
+    if (!vk_timeline_is_completed(&context->timeline, oldest->ticket)) {
+        if (!wait) {
+            return false;
+        }
+
+        context->stalls_count++;
+
+        VkResult result = vk_timeline_wait(&context->timeline, oldest->ticket);
+        SDL_assert(result == VK_SUCCESS);
+    }
+
+    context->pending_buffer_acquires.insert(
+        context->pending_buffer_acquires.end(), oldest->buffer_acquires.begin(), oldest->buffer_acquires.end());
+    context->pending_image_acquires.insert(
+        context->pending_image_acquires.end(), oldest->image_acquires.begin(), oldest->image_acquires.end());
+    context->pending_acquire_stages |= oldest->acquire_stages;
+
+    context->ring_tail = oldest->ring_end;
+    context->completed_ticket = oldest->ticket;
+
+    oldest->buffer_acquires.clear();
+    oldest->image_acquires.clear();
+    oldest->acquire_stages = 0;
+    oldest->state = Vk_Upload_Batch_State::Free;
+
+    return true;
+}
+
+///
+/// @return Batch which is being recorded. Starts a new one (waiting for the slot to free up) if needed.
+///
+static Vk_Upload_Batch *
+vk_upload_begin_batch(Vk_Upload_Context *context)
+{
+    Vk_Upload_Batch *batch = &context->batches[context->batch_index];
+    if (batch->state == Vk_Upload_Batch_State::Recording) {
+        return batch;
+    }
+
+    // NOTE(gr3yknigh1): Slots are used round-robin, so the slot is the oldest submitted batch if it's busy. [2025/03/26]
+    while (batch->state == Vk_Upload_Batch_State::Submitted) {
+        vk_upload_retire_oldest(context, true);
+    }
+
+    VkDevice device = context->allocator->device;
+    vkResetCommandPool(device, batch->command_pool, 0);
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(batch->command_buffer, &begin_info);
+
+    batch->state = Vk_Upload_Batch_State::Recording;
+    batch->ticket = context->next_ticket++;
+    batch->ring_end = context->ring_head;
+
+    return batch;
+}
+
+///
+/// @brief Reserves `size` bytes in the ring. Retires (or flushes and then retires) batches while there is no room.
+///
+/// @return Offset inside ring buffer, std::nullopt if `size` is bigger than the whole ring.
+///
+static std::optional<VkDeviceSize>
+vk_upload_reserve(Vk_Upload_Context *context, VkDeviceSize size)
+{
+    if (size > context->ring_size) {
+        return std::nullopt;
+    }
+
+    for (;;) {
+        uint64_t offset = context->ring_head % context->ring_size;
+        uint64_t aligned_offset = vk_align_up(offset, context->ring_alignment);
+
+        // NOTE(gr3yknigh1): Reservation never wraps around the end of the ring, the tail is skipped instead. [2025/03/26]
+        uint64_t position = aligned_offset + size <= context->ring_size
+            ? context->ring_head + (aligned_offset - offset)
+            : context->ring_head + (context->ring_size - offset);
+
+        if (position + size - context->ring_tail <= context->ring_size) {
+            context->ring_head = position + size;
+            context->peak_ring_usage = std::max(context->peak_ring_usage, context->ring_head - context->ring_tail);
+            return position % context->ring_size;
+        }
+
+        if (vk_upload_retire_oldest(context, true)) {
+            continue;
+        }
+
+        // NOTE(gr3yknigh1): Nothing is in flight, so the room is taken by the batch which is being recorded. [2025/03/26]
+        SDL_assert(context->batches[context->batch_index].state == Vk_Upload_Batch_State::Recording);
+
+        VkResult result = vk_upload_flush(context);
+        SDL_assert(result == VK_SUCCESS);
+    }
+}
+
+VkResult
+vk_upload_init(
+    Vk_Upload_Context *context, const Vk_Device_Capabilities &capabilities, Vk_Allocator *allocator, VkQueue queue,
+    uint32_t transfer_queue_index, uint32_t graphics_queue_index, VkDeviceSize ring_size, uint32_t batches_count,
+    bool use_timeline_semaphore)
+{
+    VkResult result = VK_SUCCESS;
+
+    *context = {};
+    context->allocator = allocator;
+    context->queue = queue;
+    context->transfer_queue_index = transfer_queue_index;
+    context->graphics_queue_index = graphics_queue_index;
+
+    // NOTE(gr3yknigh1): 16 covers texel block size of any uncompressed format. [2025/03/26]
+    context->ring_alignment = std::max<VkDeviceSize>(16, capabilities.properties.limits.optimalBufferCopyOffsetAlignment);
+    context->ring_size = vk_align_up(ring_size, context->ring_alignment);
+
+    VkBufferCreateInfo buffer_create_info = {};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = context->ring_size;
+    buffer_create_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    result = vk_allocator_make_buffer(
+        allocator, buffer_create_info, Vk_Memory_Usage::Cpu_To_Gpu, &context->ring_buffer, &context->ring_allocation);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkDevice device = allocator->device;
+
+    result = vk_timeline_init(&context->timeline, device, use_timeline_semaphore, "transfer");
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    context->batches.resize(batches_count);
+    for (auto &batch : context->batches) {
+        VkCommandPoolCreateInfo command_pool_create_info = {};
+        command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        command_pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        command_pool_create_info.queueFamilyIndex = transfer_queue_index;
+
+        result = vkCreateCommandPool(device, &command_pool_create_info, nullptr, &batch.command_pool);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+
+        VkCommandBufferAllocateInfo command_buffer_allocate_info = {};
+        command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        command_buffer_allocate_info.commandPool = batch.command_pool;
+        command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        command_buffer_allocate_info.commandBufferCount = 1;
+
+        result = vkAllocateCommandBuffers(device, &command_buffer_allocate_info, &batch.command_buffer);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Upload: %.2f MiB staging ring, %u batches, transfer family %u (%s)",
+        context->ring_size / (1024.0 * 1024.0), batches_count, transfer_queue_index,
+        vk_upload_has_ownership_transfer(context) ? "dedicated" : "shared with graphics");
+
+    return VK_SUCCESS;
+}
+
+void
+vk_upload_destroy(Vk_Upload_Context *context)
+{
+    VkDevice device = context->allocator->device;
+
+    vk_timeline_wait(&context->timeline, context->timeline.submitted_value);
+
+    for (auto &batch : context->batches) {
+        if (batch.state == Vk_Upload_Batch_State::Recording) {
+            vkEndCommandBuffer(batch.command_buffer);
+        }
+
+        vkDestroyCommandPool(device, batch.command_pool, nullptr);
+    }
+
+    vk_timeline_destroy(&context->timeline);
+
+    if (context->ring_buffer != VK_NULL_HANDLE) {
+        vk_allocator_destroy_buffer(context->allocator, context->ring_buffer, &context->ring_allocation);
+    }
+
+    constexpr double mib = 1024.0 * 1024.0;
+
+    SDL_LogInfo(
+        SDL_LOG_CATEGORY_APPLICATION, "Upload: %.2f MiB in %llu batches, peak ring usage %.2f / %.2f MiB, %llu stalls",
+        context->uploaded_bytes / mib, static_cast<unsigned long long>(context->submitted_batches),
+        context->peak_ring_usage / mib, context->ring_size / mib, static_cast<unsigned long long>(context->stalls_count));
+
+    *context = {};
+}
+
+uint64_t
+vk_upload_buffer(
+    Vk_Upload_Context *context, VkBuffer buffer, VkDeviceSize offset, const void *data, VkDeviceSize size,
+    VkPipelineStageFlags dst_stage, VkAccessFlags dst_access)
+{
+    // NOTE(gr3yknigh1): Quarter of the ring, so the next chunk is staged while the previous one is copied. [2025/03/26]
+    VkDeviceSize chunk_size = context->ring_size / 4;
+
+    Vk_Upload_Batch *batch = nullptr;
+
+    for (VkDeviceSize done = 0; done < size;) {
+        VkDeviceSize copy_size = std::min(chunk_size, size - done);
+
+        std::optional<VkDeviceSize> ring_offset = vk_upload_reserve(context, copy_size);
+        SDL_assert(ring_offset.has_value());
+
+        memcpy(
+            static_cast<uint8_t *>(context->ring_allocation.mapped) + ring_offset.value(),
+            static_cast<const uint8_t *>(data) + done, copy_size);
+
+        batch = vk_upload_begin_batch(context);
+        batch->ring_end = context->ring_head;
+
+        VkBufferCopy region = {};
+        region.srcOffset = ring_offset.value();
+        region.dstOffset = offset + done;
+        region.size = copy_size;
+        vkCmdCopyBuffer(batch->command_buffer, context->ring_buffer, buffer, 1, &region);
+
+        done += copy_size;
+    }
+
+    if (batch == nullptr) {
+        return 0;
+    }
+
+    //
+    // NOTE(gr3yknigh1): One release/acquire pair for the whole range. Barrier's first scope covers copies of
+    // previous batches too, since they were submitted earlier to the same queue. [2025/03/26]
+    //
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.buffer = buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+
+    if (vk_upload_has_ownership_transfer(context)) {
+        barrier.srcQueueFamilyIndex = context->transfer_queue_index;
+        barrier.dstQueueFamilyIndex = context->graphics_queue_index;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+
+        vkCmdPipelineBarrier(
+            batch->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+            0, nullptr, 1, &barrier, 0, nullptr);
+
+        barrier.srcAccessMask = 0;
+    } else {
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+    barrier.dstAccessMask = dst_access;
+
+    batch->buffer_acquires.push_back(barrier);
+    batch->acquire_stages |= dst_stage;
+
+    context->uploaded_bytes += size;
+    return batch->ticket;
+}
+
+uint64_t
+vk_upload_image_levels(
+    Vk_Upload_Context *context, VkImage image, VkExtent3D extent, const Vk_Upload_Image_Level *levels,
+    uint32_t levels_count, VkImageLayout final_layout, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access)
+{
+    SDL_assert(levels_count > 0 && levels_count <= s_vk_upload_image_levels_max);
+
+    // NOTE(gr3yknigh1): All levels go into one reservation, each one starts at ring alignment, which covers
+    // texel block size of BCn formats too. [2025/04/12]
+    VkDeviceSize reserved_size = 0;
+    for (uint32_t level = 0; level < levels_count; ++level) {
+        reserved_size = vk_align_up(reserved_size, context->ring_alignment) + levels[level].size;
+    }
+
+    std::optional<VkDeviceSize> ring_offset = vk_upload_reserve(context, reserved_size);
+    if (!ring_offset.has_value()) {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION, "Upload: image of %llu bytes doesn't fit into staging ring",
+            static_cast<unsigned long long>(reserved_size));
+        return 0;
+    }
+
+    std::array<VkBufferImageCopy, s_vk_upload_image_levels_max> regions = {};
+
+    VkDeviceSize level_offset = 0;
+    for (uint32_t level = 0; level < levels_count; ++level) {
+        level_offset = vk_align_up(level_offset, context->ring_alignment);
+
+        memcpy(
+            static_cast<uint8_t *>(context->ring_allocation.mapped) + ring_offset.value() + level_offset,
+            levels[level].data, levels[level].size);
+
+        VkBufferImageCopy &region = regions[level];
+        region.bufferOffset = ring_offset.value() + level_offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.mipLevel = level;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = { std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u), 1 };
+
+        level_offset += levels[level].size;
+    }
+
+    Vk_Upload_Batch *batch = vk_upload_begin_batch(context);
+    batch->ring_end = context->ring_head;
+
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = levels_count;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(
+        batch->command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+        0, nullptr, 0, nullptr, 1, &barrier);
+
+    vkCmdCopyBufferToImage(
+        batch->command_buffer, context->ring_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, levels_count,
+        regions.data());
+
+    // NOTE(gr3yknigh1): Layout transition is the same in release and acquire barriers and happens once. [2025/03/26]
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = final_layout;
+
+    if (vk_upload_has_ownership_transfer(context)) {
+        barrier.srcQueueFamilyIndex = context->transfer_queue_index;
+        barrier.dstQueueFamilyIndex = context->graphics_queue_index;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = 0;
+
+        vkCmdPipelineBarrier(
+            batch->command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+            0, nullptr, 0, nullptr, 1, &barrier);
+
+        barrier.srcAccessMask = 0;
+    } else {
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+    barrier.dstAccessMask = dst_access;
+
+    batch->image_acquires.push_back(barrier);
+    batch->acquire_stages |= dst_stage;
+
+    context->uploaded_bytes += level_offset;
+    return batch->ticket;
+}
+
+uint64_t
+vk_upload_image(
+    Vk_Upload_Context *context, VkImage image, VkExtent3D extent, const void *data, VkDeviceSize size,
+    VkImageLayout final_layout, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access)
+{
+    Vk_Upload_Image_Level level = { data, size };
+    return vk_upload_image_levels(context, image, extent, &level, 1, final_layout, dst_stage, dst_access);
+}
+
+VkResult
+vk_upload_flush(Vk_Upload_Context *context)
+{
+    Vk_Upload_Batch *batch = &context->batches[context->batch_index];
+    if (batch->state != Vk_Upload_Batch_State::Recording) {
+        return VK_SUCCESS;
+    }
+
+    VkResult result = vkEndCommandBuffer(batch->command_buffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    uint64_t value = 0;
+    result = vk_timeline_submit(&context->timeline, context->queue, &batch->command_buffer, 1, nullptr, VK_NULL_HANDLE, &value);
+    if (result != VK_SUCCESS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Upload: vkQueueSubmit() = %s", string_VkResult(result));
+        return result;
+    }
+
+    // NOTE(gr3yknigh1): Tickets are handed out in submit order, so they are exactly values of transfer timeline. [2025/04/10]
+    SDL_assert(value == batch->ticket);
+
+    batch->state = Vk_Upload_Batch_State::Submitted;
+    context->batch_index = (context->batch_index + 1) % static_cast<uint32_t>(context->batches.size());
+    context->submitted_batches++;
+
+    return VK_SUCCESS;
+}
+
+void
+vk_upload_acquire(Vk_Upload_Context *context, VkCommandBuffer command_buffer)
+{
+    VkResult result = vk_upload_flush(context);
+    SDL_assert(result == VK_SUCCESS);
+
+    while (vk_upload_retire_oldest(context, false)) {
+    }
+
+    if (context->pending_buffer_acquires.empty() && context->pending_image_acquires.empty()) {
+        context->acquired_ticket = context->completed_ticket;
+        return;
+    }
+
+    //
+    // NOTE(gr3yknigh1): Batch value was already observed completed on host, so no semaphore is needed between
+    // release on transfer queue and acquire here. Without ownership transfer this is a plain transfer -> use
+    // barrier. [2025/03/26]
+    //
+    VkPipelineStageFlags src_stage = vk_upload_has_ownership_transfer(context)
+        ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+        : VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+    vkCmdPipelineBarrier(
+        command_buffer, src_stage, context->pending_acquire_stages, 0,
+        0, nullptr,
+        static_cast<uint32_t>(context->pending_buffer_acquires.size()), context->pending_buffer_acquires.data(),
+        static_cast<uint32_t>(context->pending_image_acquires.size()), context->pending_image_acquires.data());
+
+    context->pending_buffer_acquires.clear();
+    context->pending_image_acquires.clear();
+    context->pending_acquire_stages = 0;
+
+    context->acquired_ticket = context->completed_ticket;
+}
@@ -0,0 +1,143 @@
+#pragma once
+///
+/// @brief Streaming uploads through persistently mapped staging ring.
+///
+/// Data is copied into the ring on CPU, copies are recorded into batch command buffer and submitted on transfer
+/// queue: dedicated transfer-only family if device exposes one, graphics queue otherwise. Render thread never waits
+/// for uploads: finished batches are picked up by `vk_upload_acquire`, which records queue family ownership
+/// acquire barriers into frame's command buffer.
+///
+/// @note Not thread safe.
+/// @note Destination resources must be fresh (not yet used by graphics queue): ownership is transferred only
+/// from transfer family to graphics one.
+///
+
+// NOTE(gr3yknigh1): Enough for 32K x 32K image. [2025/04/12]
+constexpr uint32_t s_vk_upload_image_levels_max = 16;
+
+struct Vk_Upload_Image_Level {
+    const void  *data = nullptr;
+    VkDeviceSize size = 0;
+};
+
+enum class Vk_Upload_Batch_State {
+    Free,
+    Recording,
+    Submitted,
+};
+
+struct Vk_Upload_Batch {
+    VkCommandPool   command_pool   = VK_NULL_HANDLE;
+    VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+
+    Vk_Upload_Batch_State state = Vk_Upload_Batch_State::Free;
+
+    uint64_t ticket   = 0; // Transfer timeline value signaled by the batch's submit.
+    uint64_t ring_end = 0; // Ring position right after the last byte staged by this batch.
+
+    std::vector<VkBufferMemoryBarrier> buffer_acquires;
+    std::vector<VkImageMemoryBarrier>  image_acquires;
+    VkPipelineStageFlags               acquire_stages = 0;
+};
+
+struct Vk_Upload_Context {
+    Vk_Allocator *allocator = nullptr;
+
+    VkQueue  queue                = VK_NULL_HANDLE;
+    uint32_t transfer_queue_index = 0;
+    uint32_t graphics_queue_index = 0;
+
+    VkBuffer      ring_buffer = VK_NULL_HANDLE;
+    Vk_Allocation ring_allocation;
+    VkDeviceSize  ring_size      = 0;
+    VkDeviceSize  ring_alignment = 0;
+
+    // NOTE(gr3yknigh1): Monotonic positions, offset inside ring is `position % ring_size`. Bytes in
+    // [ring_tail, ring_head) are owned by batches which aren't finished on GPU yet. [2025/03/26]
+    uint64_t ring_head = 0;
+    uint64_t ring_tail = 0;
+
+    std::vector<Vk_Upload_Batch> batches;
+    uint32_t batch_index = 0;
+
+    Vk_Timeline timeline;
+
+    // NOTE(gr3yknigh1): Batches are submitted to single queue, so they complete in ticket order. [2025/03/26]
+    uint64_t next_ticket      = 1;
+    uint64_t completed_ticket = 0; // Finished on transfer queue, acquire barriers may still be pending.
+    uint64_t acquired_ticket  = 0; // Acquire barriers are recorded, resources are usable by graphics.
+
+    std::vector<VkBufferMemoryBarrier> pending_buffer_acquires;
+    std::vector<VkImageMemoryBarrier>  pending_image_acquires;
+    VkPipelineStageFlags               pending_acquire_stages = 0;
+
+    uint64_t uploaded_bytes    = 0;
+    uint64_t submitted_batches = 0;
+    uint64_t stalls_count      = 0; // Times CPU had to wait for transfer queue to free ring space.
+    uint64_t peak_ring_usage   = 0;
+};
+
+///
+/// @param transfer_queue_index Family of `queue`. If it differs from `graphics_queue_index`, ownership
+/// transfer barriers are recorded.
+/// @param use_timeline_semaphore See `vk_timeline_init`.
+///
+VkResult vk_upload_init(
+    Vk_Upload_Context *context, const Vk_Device_Capabilities &capabilities, Vk_Allocator *allocator, VkQueue queue,
+    uint32_t transfer_queue_index, uint32_t graphics_queue_index, VkDeviceSize ring_size, uint32_t batches_count,
+    bool use_timeline_semaphore);
+
+///
+/// @brief Waits for submitted batches, logs statistics and frees everything.
+///
+void vk_upload_destroy(Vk_Upload_Context *context);
+
+///
+/// @brief Stages `size` bytes for `buffer` at `offset`. Uploads bigger than the ring are split into chunks.
+///
+/// @note Blocks only if the ring is full, until the oldest batch finishes on transfer queue.
+///
+/// @return Ticket to check with `vk_upload_is_ready`, 0 on failure.
+///
+uint64_t vk_upload_buffer(
+    Vk_Upload_Context *context, VkBuffer buffer, VkDeviceSize offset, const void *data, VkDeviceSize size,
+    VkPipelineStageFlags dst_stage, VkAccessFlags dst_access);
+
+///
+/// @brief Stages tightly packed pixels of the first mip level and layer of color image. Image ends up in
+/// `final_layout`.
+///
+/// @note Whole-image copy only, so any `minImageTransferGranularity` of transfer queue is satisfied.
+///
+/// @return Ticket to check with `vk_upload_is_ready`, 0 on failure (e.g. data doesn't fit into the ring).
+///
+uint64_t vk_upload_image(
+    Vk_Upload_Context *context, VkImage image, VkExtent3D extent, const void *data, VkDeviceSize size,
+    VkImageLayout final_layout, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access);
+
+///
+/// @brief Same as `vk_upload_image`, but stages mip levels [0, `levels_count`) at once. Level `i` holds tightly
+/// packed texels (or blocks) of `extent` shifted down by `i`.
+///
+/// @note All levels are staged in one reservation, so they must fit into the ring together.
+///
+uint64_t vk_upload_image_levels(
+    Vk_Upload_Context *context, VkImage image, VkExtent3D extent, const Vk_Upload_Image_Level *levels,
+    uint32_t levels_count, VkImageLayout final_layout, VkPipelineStageFlags dst_stage, VkAccessFlags dst_access);
+
+///
+/// @brief Submits batch which is being recorded, if any.
+///
+VkResult vk_upload_flush(Vk_Upload_Context *context);
+
+///
+/// @brief Flushes staged uploads, then records acquire barriers of all batches finished so far into
+/// `command_buffer`. Never blocks, meant to be called once per frame before the render pass.
+///
+void vk_upload_acquire(Vk_Upload_Context *context, VkCommandBuffer command_buffer);
+
+inline bool
+vk_upload_is_ready(const Vk_Upload_Context *context, uint64_t ticket)
+{
+    return ticket != 0 && ticket <= context->acquired_ticket;
+}
@@ -0,0 +1,462 @@
+///
+/// @brief Offline converter of Wavefront OBJ meshes into scene file of `scene_format.h`.
+///
+/// Usage: scene-convert <output> <input.obj>...
+///
+/// Every input becomes one mesh. Only what the app draws is kept: X and Y of positions and vertex colors (the common
+/// `v x y z r g b` extension, white if missing). Y is flipped, OBJ is Y-up and clip space is Y-down. Polygons are
+/// triangulated as fans, texture coordinates and normals are dropped.
+///
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../hello-vk/scene_format.h"
+
+struct Obj_Vertex {
+    float position[2];
+    float color[3];
+};
+
+struct Converted_Mesh {
+    std::vector<Scene_Vertex>  vertices;
+    std::vector<uint32_t>      indices; // Ordered by meshlets.
+    std::vector<Scene_Meshlet> meshlets;
+    float                      position_scale = 1.0f;
+    float                      radius         = 0.0f;
+};
+
+///
+/// @brief Parses index of `f` element: `v`, `v/t`, `v//n` or `v/t/n`, 1-based or negative (relative to the end).
+///
+/// @return 0-based vertex index, -1 if it's out of range.
+///
+static int64_t
+obj_parse_face_index(const char *token, size_t vertices_count)
+{
+    long value = strtol(token, nullptr, 10);
+
+    if (value > 0 && static_cast<size_t>(value) <= vertices_count) {
+        return value - 1;
+    }
+    if (value < 0 && static_cast<size_t>(-value) <= vertices_count) {
+        return static_cast<int64_t>(vertices_count) + value;
+    }
+    return -1;
+}
+
+static bool
+obj_load(const char *path, std::vector<Obj_Vertex> *vertices, std::vector<uint32_t> *indices)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "scene-convert: can't open %s\n", path);
+        return false;
+    }
+
+    char line[4096];
+    uint64_t line_number = 0;
+    std::vector<uint32_t> polygon;
+
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        line_number++;
+
+        if (line[0] == 'v' && line[1] == ' ') {
+            Obj_Vertex vertex = { { 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+            float z = 0.0f;
+
+            int count = sscanf(
+                line + 2, "%f %f %f %f %f %f", &vertex.position[0], &vertex.position[1], &z, &vertex.color[0],
+                &vertex.color[1], &vertex.color[2]);
+            if (count < 2) {
+                fprintf(stderr, "scene-convert: %s:%llu: malformed vertex\n", path, static_cast<unsigned long long>(line_number));
+                fclose(file);
+                return false;
+            }
+
+            vertex.position[1] = -vertex.position[1];
+            vertices->push_back(vertex);
+        } else if (line[0] == 'f' && line[1] == ' ') {
+            polygon.clear();
+
+            const char *separators = " \t\r\n";
+            for (const char *token = line + 2 + strspn(line + 2, separators); *token != '\0';
+                 token += strcspn(token, separators), token += strspn(token, separators)) {
+                int64_t index = obj_parse_face_index(token, vertices->size());
+                if (index < 0) {
+                    fprintf(
+                        stderr, "scene-convert: %s:%llu: face refers to missing vertex\n", path,
+                        static_cast<unsigned long long>(line_number));
+                    fclose(file);
+                    return false;
+                }
+                polygon.push_back(static_cast<uint32_t>(index));
+            }
+
+            for (size_t index = 2; index < polygon.size(); ++index) {
+                indices->push_back(polygon[0]);
+                indices->push_back(polygon[index - 1]);
+                indices->push_back(polygon[index]);
+            }
+        }
+    }
+
+    fclose(file);
+
+    if (indices->empty()) {
+        fprintf(stderr, "scene-convert: %s has no faces\n", path);
+        return false;
+    }
+
+    return true;
+}
+
+static int16_t
+quantize_snorm16(float value)
+{
+    return static_cast<int16_t>(lroundf(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+static uint8_t
+quantize_unorm8(float value)
+{
+    return static_cast<uint8_t>(lroundf(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+///
+/// @brief Greedy meshlets: grows the current meshlet by triangles which share vertices with it, so meshlets are
+/// compact, then falls back to the next unused triangle in file order.
+///
+static void
+build_meshlets(const std::vector<uint32_t> &triangle_indices, size_t vertices_count, Converted_Mesh *mesh)
+{
+    size_t triangles_count = triangle_indices.size() / 3;
+
+    // NOTE(gr3yknigh1): Vertex to triangles adjacency, as offsets into one flat array. [2025/04/11]
+    std::vector<uint32_t> adjacency_offsets(vertices_count + 1, 0);
+    for (uint32_t index : triangle_indices) {
+        adjacency_offsets[index + 1]++;
+    }
+    for (size_t index = 0; index < vertices_count; ++index) {
+        adjacency_offsets[index + 1] += adjacency_offsets[index];
+    }
+
+    std::vector<uint32_t> adjacency(triangle_indices.size());
+    std::vector<uint32_t> adjacency_fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+    for (size_t triangle = 0; triangle < triangles_count; ++triangle) {
+        for (size_t corner = 0; corner < 3; ++corner) {
+            adjacency[adjacency_fill[triangle_indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+        }
+    }
+
+    std::vector<bool> is_emitted(triangles_count, false);
+    std::vector<uint32_t> meshlet_vertices;
+    meshlet_vertices.reserve(s_scene_meshlet_vertices_max);
+
+    auto new_vertices_count = [&](size_t triangle) {
+        uint32_t count = 0;
+        for (size_t corner = 0; corner < 3; ++corner) {
+            uint32_t vertex = triangle_indices[triangle * 3 + corner];
+            if (std::find(meshlet_vertices.begin(), meshlet_vertices.end(), vertex) == meshlet_vertices.end()) {
+                count++;
+            }
+        }
+        return count;
+    };
+
+    auto close_meshlet = [&](Scene_Meshlet *meshlet) {
+        float min[2] = { 1.0f, 1.0f };
+        float max[2] = { -1.0f, -1.0f };
+        for (uint32_t vertex : meshlet_vertices) {
+            for (size_t axis = 0; axis < 2; ++axis) {
+                float value = static_cast<float>(mesh->vertices[vertex].position[axis]) / 32767.0f;
+                min[axis] = std::min(min[axis], value);
+                max[axis] = std::max(max[axis], value);
+            }
+        }
+
+        meshlet->center[0] = (min[0] + max[0]) * 0.5f;
+        meshlet->center[1] = (min[1] + max[1]) * 0.5f;
+        meshlet->vertices_count = static_cast<uint32_t>(meshlet_vertices.size());
+
+        for (uint32_t vertex : meshlet_vertices) {
+            float dx = static_cast<float>(mesh->vertices[vertex].position[0]) / 32767.0f - meshlet->center[0];
+            float dy = static_cast<float>(mesh->vertices[vertex].position[1]) / 32767.0f - meshlet->center[1];
+            meshlet->radius = std::max(meshlet->radius, sqrtf(dx * dx + dy * dy));
+        }
+
+        mesh->meshlets.push_back(*meshlet);
+        meshlet_vertices.clear();
+    };
+
+    size_t seed = 0;
+    Scene_Meshlet meshlet = {};
+
+    while (true) {
+        size_t candidate = triangles_count;
+
+        // NOTE(gr3yknigh1): Linear scans are fine, meshlet has at most 64 vertices. [2025/04/11]
+        for (size_t index = 0; index < meshlet_vertices.size() && candidate == triangles_count; ++index) {
+            uint32_t vertex = meshlet_vertices[index];
+            for (uint32_t offset = adjacency_offsets[vertex]; offset < adjacency_offsets[vertex + 1]; ++offset) {
+                uint32_t triangle = adjacency[offset];
+                if (!is_emitted[triangle] && meshlet_vertices.size() + new_vertices_count(triangle) <= s_scene_meshlet_vertices_max) {
+                    candidate = triangle;
+                    break;
+                }
+            }
+        }
+
+        if (candidate == triangles_count) {
+            while (seed < triangles_count && is_emitted[seed]) {
+                seed++;
+            }
+            if (seed == triangles_count) {
+                break;
+            }
+            if (meshlet_vertices.size() + new_vertices_count(seed) <= s_scene_meshlet_vertices_max) {
+                candidate = seed;
+            }
+        }
+
+        if (candidate == triangles_count) {
+            close_meshlet(&meshlet);
+            meshlet = {};
+            meshlet.first_index = static_cast<uint32_t>(mesh->indices.size());
+            continue;
+        }
+
+        for (size_t corner = 0; corner < 3; ++corner) {
+            uint32_t vertex = triangle_indices[candidate * 3 + corner];
+            if (std::find(meshlet_vertices.begin(), meshlet_vertices.end(), vertex) == meshlet_vertices.end()) {
+                meshlet_vertices.push_back(vertex);
+            }
+            mesh->indices.push_back(vertex);
+        }
+
+        is_emitted[candidate] = true;
+        meshlet.triangles_count++;
+
+        if (meshlet.triangles_count == s_scene_meshlet_triangles_max) {
+            close_meshlet(&meshlet);
+            meshlet = {};
+            meshlet.first_index = static_cast<uint32_t>(mesh->indices.size());
+        }
+    }
+
+    if (meshlet.triangles_count > 0) {
+        close_meshlet(&meshlet);
+    }
+}
+
+static bool
+convert_mesh(const char *path, Converted_Mesh *mesh)
+{
+    std::vector<Obj_Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    if (!obj_load(path, &vertices, &indices)) {
+        return false;
+    }
+
+    // NOTE(gr3yknigh1): Positions are divided by the largest coordinate, so SNORM range is used fully. [2025/04/11]
+    float extent = 0.0f;
+    for (const Obj_Vertex &vertex : vertices) {
+        extent = std::max({ extent, fabsf(vertex.position[0]), fabsf(vertex.position[1]) });
+    }
+    mesh->position_scale = extent > 0.0f ? extent : 1.0f;
+
+    mesh->vertices.resize(vertices.size());
+    for (size_t index = 0; index < vertices.size(); ++index) {
+        const Obj_Vertex &source = vertices[index];
+        Scene_Vertex &vertex = mesh->vertices[index];
+
+        vertex.position[0] = quantize_snorm16(source.position[0] / mesh->position_scale);
+        vertex.position[1] = quantize_snorm16(source.position[1] / mesh->position_scale);
+        vertex.color[0] = quantize_unorm8(source.color[0]);
+        vertex.color[1] = quantize_unorm8(source.color[1]);
+        vertex.color[2] = quantize_unorm8(source.color[2]);
+        vertex.color[3] = 255;
+
+        float x = static_cast<float>(vertex.position[0]) / 32767.0f;
+        float y = static_cast<float>(vertex.position[1]) / 32767.0f;
+        mesh->radius = std::max(mesh->radius, sqrtf(x * x + y * y));
+    }
+
+    mesh->indices.reserve(indices.size());
+    build_meshlets(indices, vertices.size(), mesh);
+
+    printf(
+        "scene-convert: %s: %zu vertices, %zu triangles, %zu meshlets\n", path, mesh->vertices.size(),
+        mesh->indices.size() / 3, mesh->meshlets.size());
+    return true;
+}
+
+static uint64_t
+align_up(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool
+write_padding(FILE *file, uint64_t *position, uint64_t target)
+{
+    static const std::array<uint8_t, 4096> zeros = {};
+
+    while (*position < target) {
+        size_t size = static_cast<size_t>(std::min<uint64_t>(target - *position, zeros.size()));
+        if (fwrite(zeros.data(), 1, size, file) != size) {
+            return false;
+        }
+        *position += size;
+    }
+    return true;
+}
+
+static bool
+write_bytes(FILE *file, uint64_t *position, const void *data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, file) != size) {
+        return false;
+    }
+    *position += size;
+    return true;
+}
+
+static bool
+write_scene(const char *path, const std::vector<Converted_Mesh> &converted)
+{
+    std::vector<Scene_Mesh> meshes(converted.size());
+    uint64_t vertices_count = 0;
+    uint64_t indices_size = 0;
+    uint64_t meshlets_count = 0;
+
+    for (size_t index = 0; index < converted.size(); ++index) {
+        const Converted_Mesh &source = converted[index];
+        Scene_Mesh &mesh = meshes[index];
+
+        if (vertices_count + source.vertices.size() > std::numeric_limits<uint32_t>::max()) {
+            fprintf(stderr, "scene-convert: too many vertices\n");
+            return false;
+        }
+
+        mesh.first_vertex = static_cast<uint32_t>(vertices_count);
+        mesh.vertices_count = static_cast<uint32_t>(source.vertices.size());
+        mesh.indices_offset = indices_size;
+        mesh.indices_count = static_cast<uint32_t>(source.indices.size());
+        mesh.index_size = source.vertices.size() <= 65536 ? 2 : 4;
+        mesh.first_meshlet = static_cast<uint32_t>(meshlets_count);
+        mesh.meshlets_count = static_cast<uint32_t>(source.meshlets.size());
+        mesh.position_scale = source.position_scale;
+        mesh.radius = source.radius;
+
+        vertices_count += source.vertices.size();
+        indices_size = align_up(indices_size + static_cast<uint64_t>(mesh.indices_count) * mesh.index_size, 4);
+        meshlets_count += source.meshlets.size();
+    }
+
+    std::array<Scene_Section, 4> sections = {};
+    sections[0] = { Scene_Section_Kind::Meshes, 0, 0, meshes.size() * sizeof(Scene_Mesh) };
+    sections[1] = { Scene_Section_Kind::Vertices, 0, 0, vertices_count * sizeof(Scene_Vertex) };
+    sections[2] = { Scene_Section_Kind::Indices, 0, 0, indices_size };
+    sections[3] = { Scene_Section_Kind::Meshlets, 0, 0, meshlets_count * sizeof(Scene_Meshlet) };
+
+    uint64_t offset = sizeof(Scene_Header) + sizeof(sections);
+    for (Scene_Section &section : sections) {
+        section.offset = align_up(offset, s_scene_section_alignment);
+        offset = section.offset + section.size;
+    }
+
+    Scene_Header header = {};
+    header.magic = s_scene_magic;
+    header.version = s_scene_version;
+    header.file_size = offset;
+    header.sections_count = static_cast<uint32_t>(sections.size());
+    header.sections_offset = sizeof(Scene_Header);
+
+    // NOTE(gr3yknigh1): Written into temporary file and renamed, so failed run leaves no truncated scene. [2025/04/11]
+    std::string temporary_path = std::string(path) + ".tmp";
+
+    FILE *file = fopen(temporary_path.c_str(), "wb");
+    if (file == nullptr) {
+        fprintf(stderr, "scene-convert: can't create %s\n", temporary_path.c_str());
+        return false;
+    }
+
+    uint64_t position = 0;
+    bool is_written = write_bytes(file, &position, &header, sizeof(header))
+        && write_bytes(file, &position, sections.data(), sizeof(sections))
+        && write_padding(file, &position, sections[0].offset)
+        && write_bytes(file, &position, meshes.data(), meshes.size() * sizeof(Scene_Mesh))
+        && write_padding(file, &position, sections[1].offset);
+
+    for (size_t index = 0; index < converted.size() && is_written; ++index) {
+        is_written = write_bytes(file, &position, converted[index].vertices.data(), converted[index].vertices.size() * sizeof(Scene_Vertex));
+    }
+
+    is_written = is_written && write_padding(file, &position, sections[2].offset);
+
+    for (size_t index = 0; index < converted.size() && is_written; ++index) {
+        const Converted_Mesh &source = converted[index];
+
+        if (meshes[index].index_size == 2) {
+            std::vector<uint16_t> narrow(source.indices.begin(), source.indices.end());
+            is_written = write_bytes(file, &position, narrow.data(), narrow.size() * sizeof(uint16_t));
+        } else {
+            is_written = write_bytes(file, &position, source.indices.data(), source.indices.size() * sizeof(uint32_t));
+        }
+
+        is_written = is_written && write_padding(file, &position, sections[2].offset + align_up(position - sections[2].offset, 4));
+    }
+
+    is_written = is_written && write_padding(file, &position, sections[3].offset);
+
+    for (size_t index = 0; index < converted.size() && is_written; ++index) {
+        is_written = write_bytes(file, &position, converted[index].meshlets.data(), converted[index].meshlets.size() * sizeof(Scene_Meshlet));
+    }
+
+    is_written = fclose(file) == 0 && is_written && position == header.file_size;
+
+    if (!is_written) {
+        fprintf(stderr, "scene-convert: can't write %s\n", temporary_path.c_str());
+        remove(temporary_path.c_str());
+        return false;
+    }
+
+    remove(path);
+    if (rename(temporary_path.c_str(), path) != 0) {
+        fprintf(stderr, "scene-convert: can't rename %s to %s\n", temporary_path.c_str(), path);
+        return false;
+    }
+
+    printf(
+        "scene-convert: %s: %zu meshes, %llu KiB\n", path, meshes.size(),
+        static_cast<unsigned long long>(header.file_size / 1024));
+    return true;
+}
+
+int
+main(int argc, char **argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "Usage: scene-convert <output> <input.obj>...\n");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Converted_Mesh> meshes(static_cast<size_t>(argc - 2));
+    for (int index = 2; index < argc; ++index) {
+        if (!convert_mesh(argv[index], &meshes[static_cast<size_t>(index - 2)])) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return write_scene(argv[1], meshes) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,596 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/vk_memory.h"
+#include "fake_vulkan.h"
+
+Fake_Vulkan g_fake_vulkan;
+
+struct Fake_Fence {
+    uint64_t submit_number = 0; // Submit which signals the fence, 0 if none since it was reset.
+    bool     is_signaled   = false;
+};
+
+struct Fake_Buffer {
+    VkDeviceSize size = 0;
+};
+
+struct Fake_Image {
+    VkDeviceSize size = 0;
+};
+
+// NOTE(gr3yknigh1): Dispatchable handles are never dereferenced by the modules, any unique address works. [2025/04/16]
+static uint8_t s_fake_physical_device;
+static uint8_t s_fake_device;
+static uint8_t s_fake_queue;
+
+void
+fake_vulkan_reset(bool has_timeline_semaphores)
+{
+    g_fake_vulkan = {};
+    g_fake_vulkan.has_timeline_semaphores = has_timeline_semaphores;
+}
+
+void
+fake_vulkan_complete_submits(uint64_t submit_number)
+{
+    SDL_assert(submit_number <= g_fake_vulkan.submits_count);
+    g_fake_vulkan.completed_submits_count = std::max(g_fake_vulkan.completed_submits_count, submit_number);
+}
+
+VkDevice
+fake_vulkan_device(void)
+{
+    return reinterpret_cast<VkDevice>(&s_fake_device);
+}
+
+VkQueue
+fake_vulkan_queue(void)
+{
+    return reinterpret_cast<VkQueue>(&s_fake_queue);
+}
+
+//
+// Physical device. Modules take it from the capability snapshot, vkGetPhysicalDevice* functions aren't faked, so
+// a module which queries them again fails to link.
+//
+const Vk_Device_Capabilities &
+fake_vulkan_capabilities(void)
+{
+    static Vk_Device_Capabilities s_capabilities = [] {
+        Vk_Device_Capabilities capabilities = {};
+        capabilities.handle = reinterpret_cast<VkPhysicalDevice>(&s_fake_physical_device);
+
+        VkPhysicalDeviceProperties &properties = capabilities.properties;
+        properties.apiVersion = VK_API_VERSION_1_0;
+        properties.deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+        properties.limits.maxMemoryAllocationCount = 4096;
+        properties.limits.timestampPeriod = 1.0f;
+        snprintf(properties.deviceName, sizeof(properties.deviceName), "hello-vk fake device");
+
+        VkPhysicalDeviceMemoryProperties &memory = capabilities.memory_properties;
+        memory.memoryHeapCount = 1;
+        memory.memoryHeaps[0].size = s_fake_vulkan_heap_size;
+        memory.memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+
+        memory.memoryTypeCount = 3;
+        memory.memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        memory.memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        memory.memoryTypes[2].propertyFlags =
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+
+        VkQueueFamilyProperties queue_family = {};
+        queue_family.queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+        queue_family.queueCount = 1;
+        queue_family.timestampValidBits = 64;
+        capabilities.queue_families.push_back(queue_family);
+        capabilities.graphics_queue_index = 0;
+
+        capabilities.device_local_size = s_fake_vulkan_heap_size;
+        return capabilities;
+    }();
+
+    return s_capabilities;
+}
+
+static VkResult VKAPI_CALL
+fake_vulkan_wait_semaphores(VkDevice device, const VkSemaphoreWaitInfo *wait_info, uint64_t timeout)
+{
+    return VK_SUCCESS;
+}
+
+static VkResult VKAPI_CALL
+fake_vulkan_get_semaphore_counter_value(VkDevice device, VkSemaphore semaphore, uint64_t *value)
+{
+    *value = 0;
+    return VK_SUCCESS;
+}
+
+PFN_vkVoidFunction
+vkGetDeviceProcAddr(VkDevice device, const char *name)
+{
+    if (!g_fake_vulkan.has_timeline_semaphores) {
+        return nullptr;
+    }
+
+    if (strcmp(name, "vkWaitSemaphores") == 0 || strcmp(name, "vkWaitSemaphoresKHR") == 0) {
+        return reinterpret_cast<PFN_vkVoidFunction>(fake_vulkan_wait_semaphores);
+    }
+    if (strcmp(name, "vkGetSemaphoreCounterValue") == 0 || strcmp(name, "vkGetSemaphoreCounterValueKHR") == 0) {
+        return reinterpret_cast<PFN_vkVoidFunction>(fake_vulkan_get_semaphore_counter_value);
+    }
+    return nullptr;
+}
+
+//
+// Memory, buffers and images:
+//
+VkResult
+vkAllocateMemory(VkDevice device, const VkMemoryAllocateInfo *allocate_info, const VkAllocationCallbacks *allocator, VkDeviceMemory *memory)
+{
+    void *data = calloc(1, static_cast<size_t>(allocate_info->allocationSize));
+    if (data == nullptr) {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    g_fake_vulkan.device_memory_count++;
+    *memory = reinterpret_cast<VkDeviceMemory>(data);
+    return VK_SUCCESS;
+}
+
+void
+vkFreeMemory(VkDevice device, VkDeviceMemory memory, const VkAllocationCallbacks *allocator)
+{
+    if (memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    g_fake_vulkan.device_memory_count--;
+    free(reinterpret_cast<void *>(memory));
+}
+
+VkResult
+vkMapMemory(VkDevice device, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize size, VkMemoryMapFlags flags, void **data)
+{
+    *data = reinterpret_cast<uint8_t *>(memory) + offset;
+    return VK_SUCCESS;
+}
+
+VkResult
+vkCreateBuffer(VkDevice device, const VkBufferCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkBuffer *buffer)
+{
+    *buffer = reinterpret_cast<VkBuffer>(new Fake_Buffer{ create_info->size });
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *allocator)
+{
+    delete reinterpret_cast<Fake_Buffer *>(buffer);
+}
+
+void
+vkGetBufferMemoryRequirements(VkDevice device, VkBuffer buffer, VkMemoryRequirements *requirements)
+{
+    requirements->size = vk_align_up(reinterpret_cast<Fake_Buffer *>(buffer)->size, 256);
+    requirements->alignment = 256;
+    requirements->memoryTypeBits = 0x7;
+}
+
+VkResult
+vkBindBufferMemory(VkDevice device, VkBuffer buffer, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    return VK_SUCCESS;
+}
+
+VkResult
+vkCreateImage(VkDevice device, const VkImageCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkImage *image)
+{
+    VkDeviceSize size = static_cast<VkDeviceSize>(create_info->extent.width) * create_info->extent.height * 4;
+    *image = reinterpret_cast<VkImage>(new Fake_Image{ size });
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyImage(VkDevice device, VkImage image, const VkAllocationCallbacks *allocator)
+{
+    delete reinterpret_cast<Fake_Image *>(image);
+}
+
+void
+vkGetImageMemoryRequirements(VkDevice device, VkImage image, VkMemoryRequirements *requirements)
+{
+    requirements->size = vk_align_up(reinterpret_cast<Fake_Image *>(image)->size, 4096);
+    requirements->alignment = 4096;
+    requirements->memoryTypeBits = 0x1;
+}
+
+VkResult
+vkBindImageMemory(VkDevice device, VkImage image, VkDeviceMemory memory, VkDeviceSize offset)
+{
+    return VK_SUCCESS;
+}
+
+//
+// Synchronization:
+//
+static bool
+fake_vulkan_is_fence_signaled(Fake_Fence *fence)
+{
+    if (fence->submit_number != 0 && fence->submit_number <= g_fake_vulkan.completed_submits_count) {
+        fence->is_signaled = true;
+    }
+    return fence->is_signaled;
+}
+
+VkResult
+vkCreateFence(VkDevice device, const VkFenceCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkFence *fence)
+{
+    Fake_Fence *fake_fence = new Fake_Fence;
+    fake_fence->is_signaled = (create_info->flags & VK_FENCE_CREATE_SIGNALED_BIT) != 0;
+
+    g_fake_vulkan.fences_count++;
+    *fence = reinterpret_cast<VkFence>(fake_fence);
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyFence(VkDevice device, VkFence fence, const VkAllocationCallbacks *allocator)
+{
+    if (fence == VK_NULL_HANDLE) {
+        return;
+    }
+
+    g_fake_vulkan.fences_count--;
+    delete reinterpret_cast<Fake_Fence *>(fence);
+}
+
+VkResult
+vkGetFenceStatus(VkDevice device, VkFence fence)
+{
+    return fake_vulkan_is_fence_signaled(reinterpret_cast<Fake_Fence *>(fence)) ? VK_SUCCESS : VK_NOT_READY;
+}
+
+VkResult
+vkResetFences(VkDevice device, uint32_t fences_count, const VkFence *fences)
+{
+    for (uint32_t index = 0; index < fences_count; ++index) {
+        *reinterpret_cast<Fake_Fence *>(fences[index]) = {};
+    }
+    return VK_SUCCESS;
+}
+
+VkResult
+vkWaitForFences(VkDevice device, uint32_t fences_count, const VkFence *fences, VkBool32 wait_all, uint64_t timeout)
+{
+    g_fake_vulkan.fence_waits_count++;
+
+    for (uint32_t index = 0; index < fences_count; ++index) {
+        Fake_Fence *fence = reinterpret_cast<Fake_Fence *>(fences[index]);
+
+        if (fake_vulkan_is_fence_signaled(fence)) {
+            continue;
+        }
+
+        // NOTE(gr3yknigh1): Fence nobody is going to signal would hang a real device. [2025/04/16]
+        if (fence->submit_number == 0) {
+            return VK_TIMEOUT;
+        }
+
+        fake_vulkan_complete_submits(fence->submit_number);
+        fake_vulkan_is_fence_signaled(fence);
+    }
+    return VK_SUCCESS;
+}
+
+VkResult
+vkCreateSemaphore(
+    VkDevice device, const VkSemaphoreCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkSemaphore *semaphore)
+{
+    g_fake_vulkan.semaphores_count++;
+    *semaphore = reinterpret_cast<VkSemaphore>(new uint8_t);
+    return VK_SUCCESS;
+}
+
+void
+vkDestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks *allocator)
+{
+    if (semaphore == VK_NULL_HANDLE) {
+        return;
+    }
+
+    g_fake_vulkan.semaphores_count--;
+    delete reinterpret_cast<uint8_t *>(semaphore);
+}
+
+VkResult
+vkQueueSubmit(VkQueue queue, uint32_t submits_count, const VkSubmitInfo *submits, VkFence fence)
+{
+    for (uint32_t index = 0; index < submits_count; ++index) {
+        const VkSubmitInfo &submit = submits[index];
+
+        g_fake_vulkan.submits_count++;
+        g_fake_vulkan.last_submit_waits_count = submit.waitSemaphoreCount;
+        g_fake_vulkan.last_submit_has_timeline_info = false;
+        g_fake_vulkan.last_submit_wait_values.clear();
+
+        for (const VkBaseInStructure *next = static_cast<const VkBaseInStructure *>(submit.pNext); next != nullptr; next = next->pNext) {
+            if (next->sType != VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+                continue;
+            }
+
+            const VkTimelineSemaphoreSubmitInfo *timeline_info = reinterpret_cast<const VkTimelineSemaphoreSubmitInfo *>(next);
+            g_fake_vulkan.last_submit_has_timeline_info = true;
+            g_fake_vulkan.last_submit_wait_values.assign(
+                timeline_info->pWaitSemaphoreValues, timeline_info->pWaitSemaphoreValues + timeline_info->waitSemaphoreValueCount);
+        }
+    }
+
+    if (fence != VK_NULL_HANDLE) {
+        reinterpret_cast<Fake_Fence *>(fence)->submit_number = g_fake_vulkan.submits_count;
+    }
+    return VK_SUCCESS;
+}
+
+//
+// NOTE(gr3yknigh1): GPU profiler is linked through the task graph, but no test creates it. Creation fails, so
+// nothing else of it can be reached. [2025/04/16]
+//
+VkResult
+vkCreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkQueryPool *query_pool)
+{
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+}
+
+void
+vkDestroyQueryPool(VkDevice device, VkQueryPool query_pool, const VkAllocationCallbacks *allocator)
+{
+}
+
+VkResult
+vkGetQueryPoolResults(
+    VkDevice device, VkQueryPool query_pool, uint32_t first_query, uint32_t query_count, size_t data_size, void *data,
+    VkDeviceSize stride, VkQueryResultFlags flags)
+{
+    return VK_ERROR_DEVICE_LOST;
+}
+
+VkResult
+vkCreateCommandPool(
+    VkDevice device, const VkCommandPoolCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkCommandPool *command_pool)
+{
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+}
+
+void
+vkDestroyCommandPool(VkDevice device, VkCommandPool command_pool, const VkAllocationCallbacks *allocator)
+{
+}
+
+VkResult
+vkAllocateCommandBuffers(VkDevice device, const VkCommandBufferAllocateInfo *allocate_info, VkCommandBuffer *command_buffers)
+{
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+}
+
+VkResult
+vkBeginCommandBuffer(VkCommandBuffer command_buffer, const VkCommandBufferBeginInfo *begin_info)
+{
+    return VK_ERROR_DEVICE_LOST;
+}
+
+VkResult
+vkEndCommandBuffer(VkCommandBuffer command_buffer)
+{
+    return VK_ERROR_DEVICE_LOST;
+}
+
+void
+vkCmdResetQueryPool(VkCommandBuffer command_buffer, VkQueryPool query_pool, uint32_t first_query, uint32_t query_count)
+{
+}
+
+void
+vkCmdWriteTimestamp(VkCommandBuffer command_buffer, VkPipelineStageFlagBits pipeline_stage, VkQueryPool query_pool, uint32_t query)
+{
+}
+
+//
+// Image views, descriptors and pipeline layouts, only counted. Sets are freed with their pool.
+//
+static uint64_t
+fake_vulkan_make_object(void)
+{
+    g_fake_vulkan.objects_count++;
+    return reinterpret_cast<uint64_t>(new uint8_t);
+}
+
+static void
+fake_vulkan_destroy_object(uint64_t object)
+{
+    if (object == 0) {
+        return;
+    }
+
+    SDL_assert(g_fake_vulkan.objects_count > 0);
+    g_fake_vulkan.objects_count--;
+    delete reinterpret_cast<uint8_t *>(object);
+}
+
+VkResult
+vkCreateImageView(VkDevice device, const VkImageViewCreateInfo *create_info, const VkAllocationCallbacks *allocator, VkImageView *image_view)
+{
+    *image_view = reinterpret_cast<VkImageView>(fake_vulkan_make_object());
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyImageView(VkDevice device, VkImageView image_view, const VkAllocationCallbacks *allocator)
+{
+    fake_vulkan_destroy_object(reinterpret_cast<uint64_t>(image_view));
+}
+
+VkResult
+vkCreateDescriptorSetLayout(
+    VkDevice device, const VkDescriptorSetLayoutCreateInfo *create_info, const VkAllocationCallbacks *allocator,
+    VkDescriptorSetLayout *set_layout)
+{
+    *set_layout = reinterpret_cast<VkDescriptorSetLayout>(fake_vulkan_make_object());
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyDescriptorSetLayout(VkDevice device, VkDescriptorSetLayout set_layout, const VkAllocationCallbacks *allocator)
+{
+    fake_vulkan_destroy_object(reinterpret_cast<uint64_t>(set_layout));
+}
+
+VkResult
+vkCreateDescriptorPool(
+    VkDevice device, const VkDescriptorPoolCreateInfo *create_info, const VkAllocationCallbacks *allocator,
+    VkDescriptorPool *descriptor_pool)
+{
+    *descriptor_pool = reinterpret_cast<VkDescriptorPool>(fake_vulkan_make_object());
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyDescriptorPool(VkDevice device, VkDescriptorPool descriptor_pool, const VkAllocationCallbacks *allocator)
+{
+    fake_vulkan_destroy_object(reinterpret_cast<uint64_t>(descriptor_pool));
+}
+
+VkResult
+vkAllocateDescriptorSets(VkDevice device, const VkDescriptorSetAllocateInfo *allocate_info, VkDescriptorSet *sets)
+{
+    // NOTE(gr3yknigh1): Never dereferenced, unique non-null values are enough. [2025/04/16]
+    static uint64_t s_next_set = 0;
+
+    for (uint32_t index = 0; index < allocate_info->descriptorSetCount; ++index) {
+        sets[index] = reinterpret_cast<VkDescriptorSet>(++s_next_set);
+    }
+    return VK_SUCCESS;
+}
+
+void
+vkUpdateDescriptorSets(
+    VkDevice device, uint32_t writes_count, const VkWriteDescriptorSet *writes, uint32_t copies_count,
+    const VkCopyDescriptorSet *copies)
+{
+}
+
+VkResult
+vkCreatePipelineLayout(
+    VkDevice device, const VkPipelineLayoutCreateInfo *create_info, const VkAllocationCallbacks *allocator,
+    VkPipelineLayout *pipeline_layout)
+{
+    *pipeline_layout = reinterpret_cast<VkPipelineLayout>(fake_vulkan_make_object());
+    return VK_SUCCESS;
+}
+
+void
+vkDestroyPipelineLayout(VkDevice device, VkPipelineLayout pipeline_layout, const VkAllocationCallbacks *allocator)
+{
+    fake_vulkan_destroy_object(reinterpret_cast<uint64_t>(pipeline_layout));
+}
+
+//
+// Draw commands. Binds only update what a later draw records.
+//
+void
+vkCmdBindPipeline(VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipeline pipeline)
+{
+    g_fake_vulkan.bound_pipeline = pipeline;
+}
+
+void
+vkCmdBindDescriptorSets(
+    VkCommandBuffer command_buffer, VkPipelineBindPoint bind_point, VkPipelineLayout layout, uint32_t first_set,
+    uint32_t sets_count, const VkDescriptorSet *sets, uint32_t dynamic_offsets_count, const uint32_t *dynamic_offsets)
+{
+    g_fake_vulkan.bound_descriptor_set = sets[0];
+    g_fake_vulkan.descriptor_set_binds_count++;
+}
+
+void
+vkCmdPushConstants(
+    VkCommandBuffer command_buffer, VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size,
+    const void *values)
+{
+}
+
+void
+vkCmdBindVertexBuffers(
+    VkCommandBuffer command_buffer, uint32_t first_binding, uint32_t bindings_count, const VkBuffer *buffers,
+    const VkDeviceSize *offsets)
+{
+}
+
+void
+vkCmdBindIndexBuffer(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize offset, VkIndexType index_type)
+{
+    g_fake_vulkan.bound_index_buffer = buffer;
+}
+
+void
+vkCmdDrawIndexed(
+    VkCommandBuffer command_buffer, uint32_t index_count, uint32_t instances_count, uint32_t first_index, int32_t vertex_offset,
+    uint32_t first_instance)
+{
+    Fake_Draw draw = {};
+    draw.pipeline = g_fake_vulkan.bound_pipeline;
+    draw.index_buffer = g_fake_vulkan.bound_index_buffer;
+    draw.index_count = index_count;
+    draw.instances_count = instances_count;
+    draw.first_index = first_index;
+    draw.vertex_offset = vertex_offset;
+    draw.first_instance = first_instance;
+    g_fake_vulkan.draws.push_back(draw);
+}
+
+//
+// Barriers:
+//
+void
+vkCmdPipelineBarrier(
+    VkCommandBuffer command_buffer, VkPipelineStageFlags src_stages, VkPipelineStageFlags dst_stages,
+    VkDependencyFlags dependency_flags, uint32_t memory_barriers_count, const VkMemoryBarrier *memory_barriers,
+    uint32_t buffer_barriers_count, const VkBufferMemoryBarrier *buffer_barriers, uint32_t image_barriers_count,
+    const VkImageMemoryBarrier *image_barriers)
+{
+    Fake_Pipeline_Barrier barrier = {};
+    barrier.src_stages = src_stages;
+    barrier.dst_stages = dst_stages;
+    barrier.memory_barriers_count = memory_barriers_count;
+    barrier.image_barriers.assign(image_barriers, image_barriers + image_barriers_count);
+
+    g_fake_vulkan.pipeline_barriers.push_back(barrier);
+}
+
+//
+// Objects tested modules never create, only the deletion queue can destroy them.
+//
+void
+vkDestroyPipeline(VkDevice device, VkPipeline pipeline, const VkAllocationCallbacks *allocator)
+{
+}
+
+void
+vkDestroySampler(VkDevice device, VkSampler sampler, const VkAllocationCallbacks *allocator)
+{
+}
+
+void
+vkDestroyFramebuffer(VkDevice device, VkFramebuffer framebuffer, const VkAllocationCallbacks *allocator)
+{
+}
+
+void
+vkDestroyBufferView(VkDevice device, VkBufferView buffer_view, const VkAllocationCallbacks *allocator)
+{
+}
+
+void
+vkDestroySwapchainKHR(VkDevice device, VkSwapchainKHR swapchain, const VkAllocationCallbacks *allocator)
+{
+}
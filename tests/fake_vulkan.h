@@ -0,0 +1,89 @@
+#pragma once
+///
+/// @brief Fake Vulkan device, hello-vk-tests link against it instead of the loader.
+///
+/// Only what the tested modules can observe is modeled. Device memory is zeroed host memory, every memory type
+/// can be mapped. The one queue finishes submits in order, but only when a test says so, and fences follow it:
+/// `vkWaitForFences` is the GPU catching up to the fence. Commands are recorded, not executed, descriptors are
+/// never written.
+///
+/// @note Any handle works as device or queue, there is only one of each.
+///
+
+///
+/// @brief Recorded `vkCmdDrawIndexed`, with the pipeline and index buffer bound at the moment.
+///
+struct Fake_Draw {
+    VkPipeline pipeline        = VK_NULL_HANDLE;
+    VkBuffer   index_buffer    = VK_NULL_HANDLE;
+    uint32_t   index_count     = 0;
+    uint32_t   instances_count = 0;
+    uint32_t   first_index     = 0;
+    int32_t    vertex_offset   = 0;
+    uint32_t   first_instance  = 0;
+};
+
+///
+/// @brief Recorded `vkCmdPipelineBarrier`. Image barriers are copied, `pNext` isn't followed.
+///
+struct Fake_Pipeline_Barrier {
+    VkPipelineStageFlags src_stages            = 0;
+    VkPipelineStageFlags dst_stages            = 0;
+    uint32_t             memory_barriers_count = 0;
+
+    std::vector<VkImageMemoryBarrier> image_barriers;
+};
+
+struct Fake_Vulkan {
+    bool has_timeline_semaphores = false; // `vkGetDeviceProcAddr` resolves vkWaitSemaphores and friends.
+
+    // NOTE(gr3yknigh1): Live objects, so tests can see what was leaked or released. [2025/04/16]
+    uint32_t device_memory_count = 0;
+    uint32_t fences_count        = 0;
+    uint32_t semaphores_count    = 0;
+    uint32_t objects_count       = 0; // Image views, descriptor set layouts, descriptor pools and pipeline layouts.
+
+    uint64_t submits_count           = 0;
+    uint64_t completed_submits_count = 0; // Queue has finished submits [1, completed_submits_count].
+    uint64_t fence_waits_count       = 0;
+
+    // NOTE(gr3yknigh1): Of the last `vkQueueSubmit`. [2025/04/16]
+    bool                  last_submit_has_timeline_info = false;
+    std::vector<uint64_t> last_submit_wait_values;
+    uint32_t              last_submit_waits_count = 0;
+
+    // NOTE(gr3yknigh1): Of every command buffer, in recording order. [2025/04/16]
+    VkPipeline             bound_pipeline     = VK_NULL_HANDLE;
+    VkBuffer               bound_index_buffer = VK_NULL_HANDLE;
+    std::vector<Fake_Draw> draws;
+
+    VkDescriptorSet bound_descriptor_set       = VK_NULL_HANDLE; // First set of the last bind.
+    uint32_t        descriptor_set_binds_count = 0;
+
+    std::vector<Fake_Pipeline_Barrier> pipeline_barriers;
+};
+
+extern Fake_Vulkan g_fake_vulkan;
+
+///
+/// @brief Forgets all state, objects still alive are leaked.
+///
+void fake_vulkan_reset(bool has_timeline_semaphores);
+
+///
+/// @brief Queue finishes submits up to `submit_number` (1-based, in submit order).
+///
+void fake_vulkan_complete_submits(uint64_t submit_number);
+
+VkDevice fake_vulkan_device(void);
+VkQueue fake_vulkan_queue(void);
+
+///
+/// @brief Snapshot of the fake physical device: one queue family with timestamps, three memory types in one heap.
+///
+const Vk_Device_Capabilities &fake_vulkan_capabilities(void);
+
+///
+/// @brief Memory heap of the fake device, every memory type lives in it.
+///
+constexpr VkDeviceSize s_fake_vulkan_heap_size = 64ull * 1024 * 1024;
@@ -0,0 +1,95 @@
+#include "../hello-vk/stdafx.h"
+
+#include "test.h"
+
+struct Test_Suite {
+    const char         *name;
+    Test_Suite_Function function;
+};
+
+static const Test_Suite s_test_suites[] = {
+    { "vk_memory", test_vk_memory },
+    { "spsc_queue", test_spsc_queue },
+    { "job_system", test_job_system },
+    { "task_graph", test_task_graph },
+    { "frame_arena", test_frame_arena },
+    { "scene", test_scene },
+    { "ktx2", test_ktx2 },
+    { "vk_timeline", test_vk_timeline },
+    { "vk_draw_queue", test_vk_draw_queue },
+    { "vk_bindless", test_vk_bindless },
+    { "vk_render_graph", test_vk_render_graph },
+};
+
+bool
+test_check(Test_Context *context, bool is_passed, const char *expression, const char *file, int line)
+{
+    context->checks_count++;
+
+    if (!is_passed) {
+        context->failures_count++;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s:%d: %s: check failed: %s", file, line, context->suite, expression);
+    }
+    return is_passed;
+}
+
+std::string
+test_temp_path(const char *name)
+{
+    // NOTE(gr3yknigh1): ctest may run suites in parallel (-j), each one is its own process. [2025/04/16]
+    static const std::string s_prefix = "hello-vk-tests-" + std::to_string(SDL_GetPerformanceCounter());
+
+    return (std::filesystem::temp_directory_path() / (s_prefix + "-" + name)).string();
+}
+
+bool
+test_write_file(const char *path, const void *data, size_t size)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Tests: can't create %s", path);
+        return false;
+    }
+
+    bool is_written = fwrite(data, 1, size, file) == size;
+    return fclose(file) == 0 && is_written;
+}
+
+///
+/// Usage: hello-vk-tests [suite]
+///
+int
+main(int argc, char **argv)
+{
+    const char *suite_name = argc > 1 ? argv[1] : nullptr;
+    uint32_t runs_count = 0;
+    uint32_t failed_count = 0;
+
+    for (const Test_Suite &suite : s_test_suites) {
+        if (suite_name != nullptr && strcmp(suite_name, suite.name) != 0) {
+            continue;
+        }
+
+        Test_Context context = {};
+        context.suite = suite.name;
+
+        uint64_t start_counter = SDL_GetPerformanceCounter();
+        suite.function(&context);
+        double ms = static_cast<double>(SDL_GetPerformanceCounter() - start_counter) * 1000.0
+            / static_cast<double>(SDL_GetPerformanceFrequency());
+
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_APPLICATION, "Tests: %s: %u of %u checks failed (%.2f ms)", suite.name, context.failures_count,
+            context.checks_count, ms);
+
+        runs_count++;
+        failed_count += context.failures_count > 0 || context.checks_count == 0 ? 1 : 0;
+    }
+
+    if (runs_count == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Tests: no suite named %s", suite_name);
+        return EXIT_FAILURE;
+    }
+
+    return failed_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
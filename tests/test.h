@@ -0,0 +1,47 @@
+#pragma once
+///
+/// @brief Unit tests of the app's CPU-side modules, built as hello-vk-tests. Every suite is one ctest test:
+/// `hello-vk-tests <suite>`, without a suite all of them run.
+///
+/// Failed check is logged with its location and the suite goes on, so one run reports every failure. Modules are
+/// linked against fake Vulkan device of `fake_vulkan.h` instead of the loader, tests need neither GPU nor driver.
+///
+
+struct Test_Context {
+    const char *suite = nullptr;
+
+    uint32_t checks_count   = 0;
+    uint32_t failures_count = 0;
+};
+
+using Test_Suite_Function = void (*)(Test_Context *context);
+
+///
+/// @return `is_passed`, so a check may guard the rest of the test.
+///
+bool test_check(Test_Context *context, bool is_passed, const char *expression, const char *file, int line);
+
+#define test_expect(context, expression) test_check((context), static_cast<bool>(expression), #expression, __FILE__, __LINE__)
+
+///
+/// @return Path of `name` in the temporary directory, unique to this process.
+///
+std::string test_temp_path(const char *name);
+
+bool test_write_file(const char *path, const void *data, size_t size);
+
+void test_vk_memory(Test_Context *context);
+void test_spsc_queue(Test_Context *context);
+void test_job_system(Test_Context *context);
+void test_task_graph(Test_Context *context);
+void test_frame_arena(Test_Context *context);
+void test_ktx2(Test_Context *context);
+void test_vk_timeline(Test_Context *context);
+void test_vk_draw_queue(Test_Context *context);
+void test_vk_bindless(Test_Context *context);
+void test_vk_render_graph(Test_Context *context);
+
+///
+/// @note Runs scene-convert, CMake build gives its path in `HELLO_VK_SCENE_CONVERT`.
+///
+void test_scene(Test_Context *context);
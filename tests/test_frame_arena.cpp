@@ -0,0 +1,126 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/frame_arena.h"
+#include "test.h"
+
+static bool
+test_is_aligned(const void *pointer, size_t alignment)
+{
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+static bool
+test_is_inside(const Frame_Arena &arena, const void *pointer, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(pointer);
+    return bytes >= arena.base && bytes + size <= arena.base + arena.capacity;
+}
+
+static void
+test_frame_arena_push(Test_Context *context)
+{
+    Frame_Arena arena;
+    frame_arena_init(&arena, 1024);
+
+    void *a = frame_arena_push(&arena, 3, 1);
+    void *b = frame_arena_push(&arena, 16, 16);
+    void *c = frame_arena_push(&arena, 8, 8);
+
+    test_expect(context, a == arena.base);
+    test_expect(context, test_is_aligned(b, 16) && test_is_inside(arena, b, 16));
+    test_expect(context, static_cast<uint8_t *>(b) >= static_cast<uint8_t *>(a) + 3);
+    test_expect(context, static_cast<uint8_t *>(c) == static_cast<uint8_t *>(b) + 16);
+    test_expect(context, arena.offset == static_cast<size_t>(static_cast<uint8_t *>(c) + 8 - arena.base));
+
+    VkImageMemoryBarrier *barriers = frame_arena_push_array<VkImageMemoryBarrier>(&arena, 4);
+    test_expect(context, test_is_aligned(barriers, alignof(VkImageMemoryBarrier)));
+    test_expect(context, barriers[3].sType == 0 && barriers[3].image == VK_NULL_HANDLE);
+
+    // NOTE(gr3yknigh1): Reset hands out the same memory again, nothing is freed or allocated. [2025/04/16]
+    uint64_t heap_count = heap_allocations_count();
+    frame_arena_reset(&arena);
+
+    test_expect(context, arena.offset == 0);
+    test_expect(context, frame_arena_push(&arena, 3, 1) == a);
+    test_expect(context, heap_allocations_count() == heap_count);
+    test_expect(context, arena.capacity == 1024 && arena.grows_count == 0);
+
+    frame_arena_destroy(&arena);
+}
+
+///
+/// @brief Frame which pushes past capacity falls back to heap blocks, next reset grows arena to its high water mark.
+///
+static void
+test_frame_arena_overflow(Test_Context *context)
+{
+    Frame_Arena arena;
+    frame_arena_init(&arena, 256);
+
+    uint64_t heap_count = heap_allocations_count();
+
+    void *inside = frame_arena_push(&arena, 200, 8);
+    void *overflow = frame_arena_push(&arena, 5000, 64);
+
+    test_expect(context, test_is_inside(arena, inside, 200));
+    test_expect(context, !test_is_inside(arena, overflow, 5000) && test_is_aligned(overflow, 64));
+    test_expect(context, arena.overflow_blocks.size() == 1);
+    test_expect(context, heap_allocations_count() == heap_count + 1);
+
+    // NOTE(gr3yknigh1): Overflow memory is usable as any other. [2025/04/16]
+    memset(overflow, 0xAB, 5000);
+
+    frame_arena_reset(&arena);
+
+    test_expect(context, arena.grows_count == 1);
+    test_expect(context, arena.capacity >= 200 + 5000 && arena.capacity >= arena.high_water);
+    test_expect(context, arena.overflow_blocks.empty() && arena.overflow_size == 0);
+
+    // NOTE(gr3yknigh1): Same frame again fits without touching the heap. [2025/04/16]
+    heap_count = heap_allocations_count();
+
+    inside = frame_arena_push(&arena, 200, 8);
+    overflow = frame_arena_push(&arena, 5000, 64);
+
+    test_expect(context, test_is_inside(arena, inside, 200) && test_is_inside(arena, overflow, 5000));
+    test_expect(context, heap_allocations_count() == heap_count);
+
+    frame_arena_reset(&arena);
+    test_expect(context, arena.grows_count == 1);
+
+    frame_arena_destroy(&arena);
+    test_expect(context, arena.base == nullptr && arena.capacity == 0);
+}
+
+static void
+test_frame_arena_vector(Test_Context *context)
+{
+    Frame_Arena arena;
+    frame_arena_init(&arena, 64 * 1024);
+
+    uint64_t heap_count = heap_allocations_count();
+
+    Frame_Vector<uint32_t> values{ Frame_Allocator<uint32_t>(&arena) };
+    values.reserve(100);
+    for (uint32_t index = 0; index < 100; ++index) {
+        values.push_back(index * index);
+    }
+
+    test_expect(context, test_is_inside(arena, values.data(), values.size() * sizeof(uint32_t)));
+    test_expect(context, values[99] == 99 * 99);
+    test_expect(context, heap_allocations_count() == heap_count);
+
+    // NOTE(gr3yknigh1): `operator new` is counted too, so the counter itself is checked here. [2025/04/16]
+    auto heap_value = std::make_unique<uint64_t>(1);
+    test_expect(context, heap_allocations_count() == heap_count + 1);
+
+    frame_arena_destroy(&arena);
+}
+
+void
+test_frame_arena(Test_Context *context)
+{
+    test_frame_arena_push(context);
+    test_frame_arena_overflow(context);
+    test_frame_arena_vector(context);
+}
@@ -0,0 +1,84 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/job_system.h"
+#include "test.h"
+
+struct Test_Job_Coverage {
+    std::vector<std::atomic<uint32_t>> visits;
+    uint32_t                           threads_count = 0;
+    uint32_t                           chunk_size    = 0;
+
+    std::atomic<uint32_t> bad_ranges_count  = 0;
+    std::atomic<uint32_t> bad_threads_count = 0;
+};
+
+static void
+test_job_visit(void *user_data, uint32_t begin, uint32_t end, uint32_t thread_index)
+{
+    Test_Job_Coverage *coverage = static_cast<Test_Job_Coverage *>(user_data);
+
+    if (begin >= end || end - begin > coverage->chunk_size || end > coverage->visits.size()) {
+        coverage->bad_ranges_count.fetch_add(1);
+        return;
+    }
+    if (thread_index >= coverage->threads_count) {
+        coverage->bad_threads_count.fetch_add(1);
+        return;
+    }
+
+    for (uint32_t index = begin; index < end; ++index) {
+        coverage->visits[index].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+///
+/// @brief Every index of every run is visited exactly once, in ranges of at most `chunk_size`.
+///
+static void
+test_job_system_coverage(Test_Context *context, uint32_t threads_count)
+{
+    Job_System system;
+    job_system_init(&system, threads_count);
+
+    //
+    // NOTE(gr3yknigh1): The largest count makes more jobs than the deque holds, so thread 0 runs jobs while it is
+    // still pushing. [2025/04/16]
+    //
+    constexpr uint32_t s_counts[] = { 0, 1, 7, 64, 1000, s_job_deque_capacity * 3 + 5 };
+    constexpr uint32_t s_chunk_sizes[] = { 1, 3, 64 };
+
+    for (uint32_t run = 0; run < 20; ++run) {
+        for (uint32_t count : s_counts) {
+            for (uint32_t chunk_size : s_chunk_sizes) {
+                Test_Job_Coverage coverage;
+                coverage.visits = std::vector<std::atomic<uint32_t>>(count);
+                coverage.threads_count = threads_count;
+                coverage.chunk_size = chunk_size;
+
+                job_system_parallel_for(&system, count, chunk_size, test_job_visit, &coverage);
+
+                uint32_t wrong_visits_count = 0;
+                for (const std::atomic<uint32_t> &visits : coverage.visits) {
+                    wrong_visits_count += visits.load() != 1 ? 1 : 0;
+                }
+
+                test_expect(context, wrong_visits_count == 0);
+                test_expect(context, coverage.bad_ranges_count.load() == 0);
+                test_expect(context, coverage.bad_threads_count.load() == 0);
+            }
+        }
+    }
+
+    test_expect(context, system.batch.pending.load() == 0);
+    test_expect(context, system.deque.top.load() == system.deque.bottom.load());
+
+    job_system_destroy(&system);
+}
+
+void
+test_job_system(Test_Context *context)
+{
+    test_job_system_coverage(context, 1);
+    test_job_system_coverage(context, 4);
+    test_job_system_coverage(context, 8);
+}
@@ -0,0 +1,226 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/mapped_file.h"
+#include "../hello-vk/ktx2.h"
+#include "test.h"
+
+//
+// NOTE(gr3yknigh1): Header and level index as laid out by the KTX2 specification, written by hand here, so the
+// test doesn't share the parser's own structs. [2025/04/16]
+//
+static constexpr uint8_t s_test_ktx2_identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+constexpr size_t s_test_ktx2_header_size      = 80;
+constexpr size_t s_test_ktx2_level_index_size = 24;
+
+struct Test_Ktx2 {
+    uint32_t              vk_format        = VK_FORMAT_R8G8B8A8_UNORM;
+    uint32_t              width            = 0;
+    uint32_t              height           = 0;
+    uint32_t              depth            = 0;
+    uint32_t              layers_count     = 0;
+    uint32_t              faces_count      = 1;
+    uint32_t              levels_count     = 0;
+    uint32_t              supercompression = 0;
+    std::vector<uint64_t> level_sizes; // Level 0 first, stored smallest first.
+};
+
+static void
+test_ktx2_put_u32(std::vector<uint8_t> *bytes, size_t offset, uint32_t value)
+{
+    memcpy(bytes->data() + offset, &value, sizeof(value));
+}
+
+static void
+test_ktx2_put_u64(std::vector<uint8_t> *bytes, size_t offset, uint64_t value)
+{
+    memcpy(bytes->data() + offset, &value, sizeof(value));
+}
+
+///
+/// @brief Level data is filled with the level's number, so tests can tell which bytes a level points to.
+///
+static std::vector<uint8_t>
+test_ktx2_build(const Test_Ktx2 &texture)
+{
+    size_t index_size = texture.level_sizes.size() * s_test_ktx2_level_index_size;
+    size_t data_offset = s_test_ktx2_header_size + index_size;
+
+    size_t file_size = data_offset;
+    for (uint64_t size : texture.level_sizes) {
+        file_size += static_cast<size_t>(size);
+    }
+
+    std::vector<uint8_t> bytes(file_size, 0);
+
+    memcpy(bytes.data(), s_test_ktx2_identifier, sizeof(s_test_ktx2_identifier));
+    test_ktx2_put_u32(&bytes, 12, texture.vk_format);
+    test_ktx2_put_u32(&bytes, 16, 1);
+    test_ktx2_put_u32(&bytes, 20, texture.width);
+    test_ktx2_put_u32(&bytes, 24, texture.height);
+    test_ktx2_put_u32(&bytes, 28, texture.depth);
+    test_ktx2_put_u32(&bytes, 32, texture.layers_count);
+    test_ktx2_put_u32(&bytes, 36, texture.faces_count);
+    test_ktx2_put_u32(&bytes, 40, texture.levels_count);
+    test_ktx2_put_u32(&bytes, 44, texture.supercompression);
+
+    // NOTE(gr3yknigh1): Smallest level goes first in the file, like KTX2 tools write it. [2025/04/16]
+    size_t offset = file_size;
+    for (size_t level = 0; level < texture.level_sizes.size(); ++level) {
+        uint64_t size = texture.level_sizes[level];
+        offset -= static_cast<size_t>(size);
+
+        size_t entry = s_test_ktx2_header_size + level * s_test_ktx2_level_index_size;
+        test_ktx2_put_u64(&bytes, entry, offset);
+        test_ktx2_put_u64(&bytes, entry + 8, size);
+        test_ktx2_put_u64(&bytes, entry + 16, size);
+
+        memset(bytes.data() + offset, static_cast<int>(level + 1), static_cast<size_t>(size));
+    }
+
+    return bytes;
+}
+
+static bool
+test_ktx2_open(const std::vector<uint8_t> &bytes, Ktx2_File *texture)
+{
+    std::string path = test_temp_path("texture.ktx2");
+
+    if (!test_write_file(path.c_str(), bytes.data(), bytes.size())) {
+        return false;
+    }
+
+    bool is_opened = ktx2_open(path.c_str(), texture);
+
+    // NOTE(gr3yknigh1): Mapping outlives the file name on POSIX, Windows can't remove a mapped file. [2025/04/16]
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    return is_opened;
+}
+
+static void
+test_ktx2_mips(Test_Context *context)
+{
+    //
+    // NOTE(gr3yknigh1): 12x5 BC1 texture: 3x2, 2x1 and 1x1 blocks of 8 bytes, last level is 1x1 texels, still one
+    // whole block. [2025/04/16]
+    //
+    Test_Ktx2 source;
+    source.vk_format = VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    source.width = 12;
+    source.height = 5;
+    source.levels_count = 4;
+    source.level_sizes = { 3 * 2 * 8, 2 * 1 * 8, 1 * 1 * 8, 1 * 1 * 8 };
+
+    std::vector<uint8_t> bytes = test_ktx2_build(source);
+
+    Ktx2_File texture;
+    if (!test_expect(context, test_ktx2_open(bytes, &texture))) {
+        return;
+    }
+
+    test_expect(context, texture.format == VK_FORMAT_BC1_RGBA_UNORM_BLOCK);
+    test_expect(context, texture.width == 12 && texture.height == 5 && texture.levels_count == 4);
+
+    for (uint32_t level = 0; level < texture.levels_count; ++level) {
+        test_expect(context, texture.levels[level].size == source.level_sizes[level]);
+        test_expect(context, texture.levels[level].data != nullptr && texture.levels[level].data[0] == level + 1);
+    }
+
+    VkExtent3D extent = ktx2_level_extent(texture, 3);
+    test_expect(context, extent.width == 1 && extent.height == 1 && extent.depth == 1);
+
+    // NOTE(gr3yknigh1): Smallest level first, loading lowest mips first reads the file front to back. [2025/04/16]
+    test_expect(context, texture.levels[3].data < texture.levels[0].data);
+
+    ktx2_close(&texture);
+    test_expect(context, texture.file.data == nullptr && texture.levels_count == 0);
+}
+
+static void
+test_ktx2_single_level(Test_Context *context)
+{
+    // NOTE(gr3yknigh1): Level count 0 asks for generated mips, file then holds one level. [2025/04/16]
+    Test_Ktx2 source;
+    source.width = 3;
+    source.height = 2;
+    source.levels_count = 0;
+    source.level_sizes = { 3 * 2 * 4 };
+
+    Ktx2_File texture;
+    if (!test_expect(context, test_ktx2_open(test_ktx2_build(source), &texture))) {
+        return;
+    }
+
+    test_expect(context, texture.format == VK_FORMAT_R8G8B8A8_UNORM && texture.levels_count == 1);
+    test_expect(context, texture.levels[0].size == 24);
+
+    ktx2_close(&texture);
+}
+
+static void
+test_ktx2_rejected(Test_Context *context)
+{
+    Test_Ktx2 valid;
+    valid.width = 4;
+    valid.height = 4;
+    valid.levels_count = 1;
+    valid.level_sizes = { 4 * 4 * 4 };
+
+    Ktx2_File texture;
+
+    std::vector<uint8_t> bytes = test_ktx2_build(valid);
+    bytes[1] = 'X';
+    test_expect(context, !test_ktx2_open(bytes, &texture));
+
+    bytes = test_ktx2_build(valid);
+    bytes.resize(s_test_ktx2_header_size - 1);
+    test_expect(context, !test_ktx2_open(bytes, &texture));
+
+    // NOTE(gr3yknigh1): Level index runs past the end of the file. [2025/04/16]
+    bytes = test_ktx2_build(valid);
+    bytes.resize(s_test_ktx2_header_size + s_test_ktx2_level_index_size - 1);
+    test_expect(context, !test_ktx2_open(bytes, &texture));
+
+    // NOTE(gr3yknigh1): Level data runs past the end of the file. [2025/04/16]
+    bytes = test_ktx2_build(valid);
+    bytes.pop_back();
+    test_expect(context, !test_ktx2_open(bytes, &texture));
+
+    Test_Ktx2 wrong_size = valid;
+    wrong_size.level_sizes = { 4 * 4 * 4 - 4 };
+    test_expect(context, !test_ktx2_open(test_ktx2_build(wrong_size), &texture));
+
+    Test_Ktx2 supercompressed = valid;
+    supercompressed.supercompression = 1;
+    test_expect(context, !test_ktx2_open(test_ktx2_build(supercompressed), &texture));
+
+    Test_Ktx2 cube = valid;
+    cube.faces_count = 6;
+    test_expect(context, !test_ktx2_open(test_ktx2_build(cube), &texture));
+
+    Test_Ktx2 volume = valid;
+    volume.depth = 4;
+    test_expect(context, !test_ktx2_open(test_ktx2_build(volume), &texture));
+
+    Test_Ktx2 unsupported_format = valid;
+    unsupported_format.vk_format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    test_expect(context, !test_ktx2_open(test_ktx2_build(unsupported_format), &texture));
+
+    // NOTE(gr3yknigh1): More levels than a 4x4 texture has. [2025/04/16]
+    Test_Ktx2 too_many_levels = valid;
+    too_many_levels.levels_count = 4;
+    too_many_levels.level_sizes = { 64, 16, 4, 4 };
+    test_expect(context, !test_ktx2_open(test_ktx2_build(too_many_levels), &texture));
+
+    test_expect(context, texture.file.data == nullptr);
+}
+
+void
+test_ktx2(Test_Context *context)
+{
+    test_ktx2_mips(context);
+    test_ktx2_single_level(context);
+    test_ktx2_rejected(context);
+}
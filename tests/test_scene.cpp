@@ -0,0 +1,173 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/mapped_file.h"
+#include "../hello-vk/scene_format.h"
+#include "../hello-vk/scene.h"
+#include "test.h"
+
+// NOTE(gr3yknigh1): Quad with vertex colors, 4 units wide, so positions are divided by 2. [2025/04/16]
+static const char s_test_quad_obj[] =
+    "# Quad, one polygon.\n"
+    "v -2.0 -2.0 0.0 1.0 0.0 0.0\n"
+    "v  2.0 -2.0 0.0 0.0 1.0 0.0\n"
+    "v  2.0  2.0 0.0 0.0 0.0 1.0\n"
+    "v -2.0  2.0 0.0 1.0 1.0 1.0\n"
+    "vt 0.0 0.0\n"
+    "f 1/1 2/1 3/1 4/1\n";
+
+// NOTE(gr3yknigh1): Triangle without colors, they default to white. Negative indices are relative. [2025/04/16]
+static const char s_test_triangle_obj[] =
+    "v 0.0 0.5 0.0\n"
+    "v 0.5 -0.5 0.0\n"
+    "v -0.5 -0.5 0.0\n"
+    "f -3 -2 -1\n";
+
+static bool
+test_scene_convert(const std::string &scene_path, const std::vector<std::string> &obj_paths)
+{
+    std::string command = "\"" HELLO_VK_SCENE_CONVERT "\" \"" + scene_path + "\"";
+    for (const std::string &obj_path : obj_paths) {
+        command += " \"" + obj_path + "\"";
+    }
+
+#if defined(_WIN32)
+    // NOTE(gr3yknigh1): cmd.exe strips the outer pair of quotes of the whole command line. [2025/04/16]
+    command = "\"" + command + "\"";
+#endif
+
+    return std::system(command.c_str()) == 0;
+}
+
+static bool
+test_scene_copy_truncated(const std::string &path, const std::string &truncated_path, uint64_t removed_count)
+{
+    Mapped_File file;
+    if (!mapped_file_open(path.c_str(), &file)) {
+        return false;
+    }
+
+    bool is_written = test_write_file(truncated_path.c_str(), file.data, static_cast<size_t>(file.size - removed_count));
+    mapped_file_close(&file);
+    return is_written;
+}
+
+///
+/// @brief OBJ files go through scene-convert and come back from `scene_open` with the same geometry.
+///
+static void
+test_scene_round_trip(Test_Context *context)
+{
+    std::string quad_path = test_temp_path("quad.obj");
+    std::string triangle_path = test_temp_path("triangle.obj");
+    std::string scene_path = test_temp_path("scene.hvks");
+
+    bool is_converted = test_write_file(quad_path.c_str(), s_test_quad_obj, sizeof(s_test_quad_obj) - 1)
+        && test_write_file(triangle_path.c_str(), s_test_triangle_obj, sizeof(s_test_triangle_obj) - 1)
+        && test_scene_convert(scene_path, { quad_path, triangle_path });
+
+    Scene scene;
+    if (!test_expect(context, is_converted) || !test_expect(context, scene_open(scene_path.c_str(), &scene))) {
+        return;
+    }
+
+    const Scene_Header *header = reinterpret_cast<const Scene_Header *>(scene.file.data);
+    test_expect(context, header->magic == s_scene_magic && header->version == s_scene_version);
+    test_expect(context, header->file_size == scene.file.size);
+
+    if (!test_expect(context, scene.meshes_count == 2)) {
+        scene_close(&scene);
+        return;
+    }
+
+    const Scene_Mesh &quad = scene.meshes[0];
+    const Scene_Mesh &triangle = scene.meshes[1];
+
+    test_expect(context, quad.first_vertex == 0 && quad.vertices_count == 4);
+    test_expect(context, quad.indices_offset == 0 && quad.indices_count == 6 && quad.index_size == 2);
+    test_expect(context, quad.position_scale == 2.0f);
+    test_expect(context, quad.meshlets_count == 1 && scene.meshlets[quad.first_meshlet].triangles_count == 2);
+
+    test_expect(context, triangle.first_vertex == 4 && triangle.vertices_count == 3);
+    test_expect(context, triangle.indices_count == 3 && triangle.indices_offset % 4 == 0);
+    test_expect(context, triangle.first_meshlet == quad.first_meshlet + quad.meshlets_count);
+    test_expect(context, scene.vertices_count == 7);
+
+    // NOTE(gr3yknigh1): Y is flipped, OBJ is Y-up. Positions are SNORM of the mesh's scale. [2025/04/16]
+    const Scene_Vertex &first = scene.vertices[quad.first_vertex];
+    test_expect(context, first.position[0] == -32767 && first.position[1] == 32767);
+    test_expect(context, first.color[0] == 255 && first.color[1] == 0 && first.color[2] == 0 && first.color[3] == 255);
+
+    const Scene_Vertex &top = scene.vertices[triangle.first_vertex];
+    test_expect(context, top.position[0] == 0 && top.position[1] == -32767);
+    test_expect(context, top.color[0] == 255 && top.color[1] == 255 && top.color[2] == 255);
+
+    test_expect(context, fabsf(quad.radius - sqrtf(2.0f)) < 1e-3f);
+
+    // NOTE(gr3yknigh1): Meshlet order may shuffle triangles, but every quad vertex is still used. [2025/04/16]
+    const uint16_t *quad_indices = reinterpret_cast<const uint16_t *>(scene.indices + quad.indices_offset);
+    uint32_t used_mask = 0;
+    for (uint32_t index = 0; index < quad.indices_count; ++index) {
+        used_mask |= quad_indices[index] < quad.vertices_count ? 1u << quad_indices[index] : 0x80000000u;
+    }
+    test_expect(context, used_mask == 0xF);
+
+    const uint16_t *triangle_indices = reinterpret_cast<const uint16_t *>(scene.indices + triangle.indices_offset);
+    test_expect(context, triangle_indices[0] + triangle_indices[1] + triangle_indices[2] == 0 + 1 + 2);
+
+    scene_close(&scene);
+    test_expect(context, scene.file.data == nullptr && scene.meshes_count == 0);
+
+    // NOTE(gr3yknigh1): Truncated file is rejected by the size in its header. [2025/04/16]
+    std::string truncated_path = test_temp_path("truncated.hvks");
+    test_expect(context, test_scene_copy_truncated(scene_path, truncated_path, 1));
+    test_expect(context, !scene_open(truncated_path.c_str(), &scene));
+
+    std::error_code error;
+    for (const std::string &path : { quad_path, triangle_path, scene_path, truncated_path }) {
+        std::filesystem::remove(path, error);
+    }
+}
+
+static void
+test_scene_rejected(Test_Context *context)
+{
+    std::string path = test_temp_path("invalid.hvks");
+    Scene scene;
+
+    test_expect(context, !scene_open(path.c_str(), &scene));
+
+    // NOTE(gr3yknigh1): Header of a valid version, but its sections are missing. [2025/04/16]
+    Scene_Header header = {};
+    header.magic = s_scene_magic;
+    header.version = s_scene_version;
+    header.file_size = sizeof(header);
+    header.sections_offset = sizeof(header);
+
+    test_expect(context, test_write_file(path.c_str(), &header, sizeof(header)));
+    test_expect(context, !scene_open(path.c_str(), &scene));
+
+    header.version = s_scene_version + 1;
+    test_expect(context, test_write_file(path.c_str(), &header, sizeof(header)));
+    test_expect(context, !scene_open(path.c_str(), &scene));
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    // NOTE(gr3yknigh1): Converter refuses OBJ without faces instead of writing an empty mesh. [2025/04/16]
+    std::string points_path = test_temp_path("points.obj");
+    std::string scene_path = test_temp_path("points.hvks");
+    const char points_obj[] = "v 0.0 0.0 0.0\nv 1.0 0.0 0.0\n";
+
+    test_expect(context, test_write_file(points_path.c_str(), points_obj, sizeof(points_obj) - 1));
+    test_expect(context, !test_scene_convert(scene_path, { points_path }));
+
+    std::filesystem::remove(points_path, error);
+    std::filesystem::remove(scene_path, error);
+}
+
+void
+test_scene(Test_Context *context)
+{
+    test_scene_round_trip(context);
+    test_scene_rejected(context);
+}
@@ -0,0 +1,92 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/spsc_queue.h"
+#include "test.h"
+
+static void
+test_spsc_queue_bounds(Test_Context *context)
+{
+    Spsc_Queue<uint32_t, 4> queue;
+    uint32_t item = 0;
+
+    test_expect(context, spsc_queue_is_empty(queue));
+    test_expect(context, !spsc_queue_pop(&queue, &item));
+
+    // NOTE(gr3yknigh1): A few laps, so positions wrap around the slots. [2025/04/16]
+    uint32_t next_pushed = 0;
+    uint32_t next_popped = 0;
+
+    for (uint32_t lap = 0; lap < 3; ++lap) {
+        for (uint32_t index = 0; index < 4; ++index) {
+            test_expect(context, spsc_queue_push(&queue, next_pushed++));
+        }
+        test_expect(context, !spsc_queue_push(&queue, 1000u));
+        test_expect(context, !spsc_queue_is_empty(queue));
+
+        for (uint32_t index = 0; index < 3; ++index) {
+            test_expect(context, spsc_queue_pop(&queue, &item) && item == next_popped++);
+        }
+
+        // NOTE(gr3yknigh1): Freed slots are taken again, one item is still left from before. [2025/04/16]
+        for (uint32_t index = 0; index < 3; ++index) {
+            test_expect(context, spsc_queue_push(&queue, next_pushed++));
+        }
+        test_expect(context, !spsc_queue_push(&queue, 1000u));
+
+        while (spsc_queue_pop(&queue, &item)) {
+            test_expect(context, item == next_popped++);
+        }
+    }
+
+    test_expect(context, next_popped == next_pushed);
+    test_expect(context, spsc_queue_is_empty(queue));
+}
+
+///
+/// @brief Consumer sees every item once, in push order, while the producer keeps running into the full queue.
+///
+static void
+test_spsc_queue_threads(Test_Context *context)
+{
+    constexpr uint32_t s_items_count = 200000;
+
+    auto queue = std::make_unique<Spsc_Queue<uint32_t, 64>>();
+    uint32_t full_count = 0;
+
+    std::thread producer([&queue, &full_count] {
+        for (uint32_t item = 0; item < s_items_count;) {
+            if (spsc_queue_push(queue.get(), item)) {
+                ++item;
+            } else {
+                ++full_count;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t out_of_order_count = 0;
+
+    while (expected < s_items_count) {
+        uint32_t item = 0;
+        if (!spsc_queue_pop(queue.get(), &item)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        out_of_order_count += item != expected ? 1 : 0;
+        expected = item + 1;
+    }
+
+    producer.join();
+
+    test_expect(context, out_of_order_count == 0);
+    test_expect(context, spsc_queue_is_empty(*queue));
+}
+
+void
+test_spsc_queue(Test_Context *context)
+{
+    test_spsc_queue_bounds(context);
+    test_spsc_queue_threads(context);
+}
@@ -0,0 +1,164 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/mpsc_ring.h"
+#include "../hello-vk/profiler.h"
+#include "../hello-vk/task_graph.h"
+#include "test.h"
+
+struct Test_Task_Log {
+    std::atomic<uint32_t> next_stamp = 1;
+
+    // NOTE(gr3yknigh1): Per task, 0 if it never ran. [2025/04/16]
+    std::array<std::atomic<uint32_t>, 16> start_stamps = {};
+    std::array<std::atomic<uint32_t>, 16> end_stamps   = {};
+};
+
+struct Test_Task {
+    Test_Task_Log *log        = nullptr;
+    uint32_t       index      = 0;
+    bool           is_failing = false;
+};
+
+static bool
+test_task_run(void *user_data)
+{
+    Test_Task *task = static_cast<Test_Task *>(user_data);
+
+    task->log->start_stamps[task->index].store(task->log->next_stamp.fetch_add(1));
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    task->log->end_stamps[task->index].store(task->log->next_stamp.fetch_add(1));
+
+    return !task->is_failing;
+}
+
+///
+/// @brief Graph of a startup's shape: two roots, a join, a main thread task and a chain.
+///
+///     0 -> 2 -> 4 -> 5
+///     1 -> 2    3 (main thread) -> 5
+///     1 -> 3
+///
+static void
+test_task_graph_build(Task_Graph *graph, Test_Task_Log *log, std::array<Test_Task, 6> *tasks)
+{
+    for (uint32_t index = 0; index < tasks->size(); ++index) {
+        (*tasks)[index].log = log;
+        (*tasks)[index].index = index;
+    }
+
+    task_graph_add(graph, "0", test_task_run, &(*tasks)[0]);
+    task_graph_add(graph, "1", test_task_run, &(*tasks)[1]);
+    task_graph_add(graph, "2", test_task_run, &(*tasks)[2], { 0, 1 });
+    task_graph_add(graph, "3", test_task_run, &(*tasks)[3], { 1 }, true);
+    task_graph_add(graph, "4", test_task_run, &(*tasks)[4], { 2 });
+    task_graph_add(graph, "5", test_task_run, &(*tasks)[5], { 4, 3 });
+}
+
+static bool
+test_task_graph_is_ordered(const Task_Graph &graph, const Test_Task_Log &log)
+{
+    for (uint32_t index = 0; index < graph.tasks.size(); ++index) {
+        for (uint32_t dependent : graph.tasks[index].dependents) {
+            if (log.end_stamps[index].load() == 0 || log.start_stamps[dependent].load() < log.end_stamps[index].load()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void
+test_task_graph_serial(Test_Context *context)
+{
+    Task_Graph graph;
+    Test_Task_Log log;
+    std::array<Test_Task, 6> tasks;
+    test_task_graph_build(&graph, &log, &tasks);
+
+    test_expect(context, task_graph_run(&graph, 0, nullptr));
+
+    // NOTE(gr3yknigh1): Without workers tasks run one by one, in the order they were added. [2025/04/16]
+    for (uint32_t index = 0; index < tasks.size(); ++index) {
+        test_expect(context, log.start_stamps[index].load() == index * 2 + 1);
+        test_expect(context, graph.tasks[index].state == Task_State::Succeeded);
+        test_expect(context, graph.tasks[index].thread_index == 0);
+    }
+}
+
+static void
+test_task_graph_parallel(Test_Context *context)
+{
+    for (uint32_t run = 0; run < 50; ++run) {
+        Task_Graph graph;
+        Test_Task_Log log;
+        std::array<Test_Task, 6> tasks;
+        test_task_graph_build(&graph, &log, &tasks);
+
+        test_expect(context, task_graph_run(&graph, 4, nullptr));
+        test_expect(context, test_task_graph_is_ordered(graph, log));
+        test_expect(context, graph.tasks[3].thread_index == 0);
+
+        // NOTE(gr3yknigh1): Waiting twice is allowed, it only reports the result again. [2025/04/16]
+        test_expect(context, task_graph_wait(&graph));
+    }
+}
+
+static void
+test_task_graph_failure(Test_Context *context)
+{
+    Task_Graph graph;
+    Test_Task_Log log;
+    std::array<Test_Task, 6> tasks;
+    test_task_graph_build(&graph, &log, &tasks);
+    tasks[2].is_failing = true;
+
+    test_expect(context, !task_graph_run(&graph, 2, nullptr));
+
+    test_expect(context, graph.tasks[2].state == Task_State::Failed);
+    test_expect(context, graph.tasks[4].state == Task_State::Skipped && log.start_stamps[4].load() == 0);
+    test_expect(context, graph.tasks[5].state == Task_State::Skipped && log.start_stamps[5].load() == 0);
+
+    // NOTE(gr3yknigh1): Branch which doesn't depend on the failed task still runs. [2025/04/16]
+    test_expect(context, graph.tasks[3].state == Task_State::Succeeded);
+}
+
+///
+/// @brief Dependency on itself or on a later task (the only way to make a cycle) skips the task instead of hanging.
+///
+static void
+test_task_graph_cycle(Test_Context *context)
+{
+    for (uint32_t workers_count : { 0u, 2u }) {
+        Task_Graph graph;
+        Test_Task_Log log;
+        std::array<Test_Task, 6> tasks;
+        for (uint32_t index = 0; index < tasks.size(); ++index) {
+            tasks[index].log = &log;
+            tasks[index].index = index;
+        }
+
+        task_graph_add(&graph, "0", test_task_run, &tasks[0]);
+        task_graph_add(&graph, "1", test_task_run, &tasks[1], { 0, 2 });
+        task_graph_add(&graph, "2", test_task_run, &tasks[2], { 1 });
+        task_graph_add(&graph, "3", test_task_run, &tasks[3], { 3 });
+        task_graph_add(&graph, "4", test_task_run, &tasks[4], { 0 });
+
+        test_expect(context, !task_graph_run(&graph, workers_count, nullptr));
+
+        test_expect(context, graph.tasks[0].state == Task_State::Succeeded);
+        test_expect(context, graph.tasks[1].state == Task_State::Skipped && log.start_stamps[1].load() == 0);
+        test_expect(context, graph.tasks[2].state == Task_State::Skipped && log.start_stamps[2].load() == 0);
+        test_expect(context, graph.tasks[3].state == Task_State::Skipped && log.start_stamps[3].load() == 0);
+        test_expect(context, graph.tasks[4].state == Task_State::Succeeded);
+    }
+}
+
+void
+test_task_graph(Test_Context *context)
+{
+    test_task_graph_serial(context);
+    test_task_graph_parallel(context);
+    test_task_graph_failure(context);
+    test_task_graph_cycle(context);
+}
@@ -0,0 +1,191 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/vk_bindless.h"
+#include "fake_vulkan.h"
+#include "test.h"
+
+// NOTE(gr3yknigh1): Only written into descriptors, which the fake never reads, any non-null handles work. [2025/04/17]
+static VkImageView
+test_image_view(uint32_t index)
+{
+    return reinterpret_cast<VkImageView>(static_cast<uintptr_t>(0x100 + index));
+}
+
+static VkBuffer
+test_buffer(uint32_t index)
+{
+    return reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(0x200 + index));
+}
+
+static Vk_Bindless_Handle
+test_add_texture(Vk_Bindless_Table *table, uint32_t index)
+{
+    return vk_bindless_add_texture(table, test_image_view(index), VK_NULL_HANDLE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+///
+/// @brief Fake device with descriptor indexing, which allows `textures_limit` textures per stage.
+///
+static Vk_Device_Capabilities
+test_bindless_capabilities(uint32_t textures_limit)
+{
+    Vk_Device_Capabilities capabilities = fake_vulkan_capabilities();
+
+    VkPhysicalDeviceDescriptorIndexingProperties &properties = capabilities.descriptor_indexing_properties;
+    properties.maxDescriptorSetUpdateAfterBindSampledImages = 1024;
+    properties.maxDescriptorSetUpdateAfterBindSamplers = 1024;
+    properties.maxDescriptorSetUpdateAfterBindStorageBuffers = 1024;
+    properties.maxPerStageDescriptorUpdateAfterBindSampledImages = textures_limit;
+    properties.maxPerStageDescriptorUpdateAfterBindSamplers = 1024;
+    properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers = 1024;
+
+    return capabilities;
+}
+
+///
+/// @brief Bindless mode: handles name their slot, which shaders index, and go stale once removed. Slot is reused
+/// only after the last frame which may read it completes, under a new generation.
+///
+static void
+test_vk_bindless_handles(Test_Context *context)
+{
+    fake_vulkan_reset(false);
+
+    Vk_Bindless_Table table = {};
+    if (!test_expect(context, vk_bindless_init(&table, fake_vulkan_device(), test_bindless_capabilities(3), true, 8, 2) == VK_SUCCESS)) {
+        return;
+    }
+
+    // NOTE(gr3yknigh1): Textures are clamped to the device limit. Set layout and the pool of the one set. [2025/04/17]
+    test_expect(context, table.slots[0].capacity == 3 && table.slots[1].capacity == 2);
+    test_expect(context, table.set != VK_NULL_HANDLE && table.descriptor_pools.size() == 1);
+    test_expect(context, g_fake_vulkan.objects_count == 2);
+
+    std::array<Vk_Bindless_Handle, 3> textures = {};
+    for (uint32_t index = 0; index < textures.size(); ++index) {
+        textures[index] = test_add_texture(&table, index);
+
+        test_expect(context, vk_bindless_is_valid(table, textures[index]));
+        test_expect(context, vk_bindless_shader_index(table, textures[index]) == index); // Lowest slots first.
+    }
+
+    test_expect(context, test_add_texture(&table, 3).value == 0);
+    test_expect(context, !vk_bindless_is_valid(table, {}));
+
+    // NOTE(gr3yknigh1): Kinds have their own slots, the same slot of the other kind is another handle. [2025/04/17]
+    Vk_Bindless_Handle buffer = vk_bindless_add_buffer(&table, test_buffer(0), 0, VK_WHOLE_SIZE);
+    test_expect(context, vk_bindless_is_valid(table, buffer) && vk_bindless_shader_index(table, buffer) == 0);
+    test_expect(context, buffer.value != textures[0].value);
+    test_expect(context, table.descriptor_writes_count == 4);
+
+    //
+    // Retire and collect:
+    //
+    vk_bindless_remove(&table, textures[1], 5);
+    test_expect(context, !vk_bindless_is_valid(table, textures[1]));
+    test_expect(context, table.slots[0].used_count == 2 && table.retired.size() == 1);
+
+    // NOTE(gr3yknigh1): Stale handle is ignored, its slot isn't retired twice. [2025/04/17]
+    vk_bindless_remove(&table, textures[1], 6);
+    test_expect(context, table.slots[0].used_count == 2 && table.retired.size() == 1);
+
+    test_expect(context, test_add_texture(&table, 4).value == 0);
+
+    vk_bindless_collect(&table, 4);
+    test_expect(context, table.retired.size() == 1 && test_add_texture(&table, 4).value == 0);
+
+    vk_bindless_collect(&table, 5);
+    test_expect(context, table.retired.empty());
+
+    //
+    // Slot reuse:
+    //
+    Vk_Bindless_Handle reused = test_add_texture(&table, 4);
+    test_expect(context, vk_bindless_is_valid(table, reused) && vk_bindless_shader_index(table, reused) == 1);
+    test_expect(context, reused.value != textures[1].value && !vk_bindless_is_valid(table, textures[1]));
+    test_expect(context, vk_bindless_is_valid(table, textures[0]) && vk_bindless_is_valid(table, textures[2]));
+
+    // NOTE(gr3yknigh1): Generation skips 0 when it wraps, so no handle of a reused slot is ever 0. [2025/04/17]
+    bool is_every_handle_valid = true;
+    for (uint64_t frame_number = 10; frame_number < 4106; ++frame_number) {
+        vk_bindless_remove(&table, reused, frame_number);
+        vk_bindless_collect(&table, frame_number);
+
+        Vk_Bindless_Handle next = test_add_texture(&table, 4);
+        is_every_handle_valid = is_every_handle_valid && next.value != 0 && vk_bindless_is_valid(table, next)
+            && !vk_bindless_is_valid(table, reused);
+        reused = next;
+    }
+    test_expect(context, is_every_handle_valid);
+
+    // NOTE(gr3yknigh1): Whole table is one set, resources themselves are never bound. [2025/04/17]
+    vk_bindless_bind_table(table, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0);
+    vk_bindless_bind_resource(table, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0, buffer);
+    test_expect(context, g_fake_vulkan.descriptor_set_binds_count == 1 && g_fake_vulkan.bound_descriptor_set == table.set);
+
+    vk_bindless_destroy(&table);
+    test_expect(context, g_fake_vulkan.objects_count == 0);
+}
+
+///
+/// @brief Pooled mode: every slot gets its own set, shaders always read index 0. Pools are added in chunks and a
+/// reused slot keeps its set.
+///
+static void
+test_vk_bindless_pooled(Test_Context *context)
+{
+    fake_vulkan_reset(false);
+
+    Vk_Bindless_Table table = {};
+    if (!test_expect(context, vk_bindless_init(&table, fake_vulkan_device(), fake_vulkan_capabilities(), false, 70, 1) == VK_SUCCESS)) {
+        return;
+    }
+
+    // NOTE(gr3yknigh1): No clamping without descriptor indexing, pools come with the first resources. [2025/04/17]
+    test_expect(context, table.slots[0].capacity == 70 && table.set == VK_NULL_HANDLE);
+    test_expect(context, table.descriptor_pools.empty() && g_fake_vulkan.objects_count == 1);
+
+    std::vector<Vk_Bindless_Handle> textures(65);
+    bool is_every_index_zero = true;
+
+    for (uint32_t index = 0; index < textures.size(); ++index) {
+        textures[index] = test_add_texture(&table, index);
+        is_every_index_zero = is_every_index_zero && vk_bindless_shader_index(table, textures[index]) == 0;
+    }
+
+    const Vk_Bindless_Slots &slots = table.slots[0];
+
+    test_expect(context, is_every_index_zero);
+    test_expect(context, table.descriptor_pools.size() == 2 && g_fake_vulkan.objects_count == 3);
+    test_expect(context, slots.sets[0] != VK_NULL_HANDLE && slots.sets[64] != VK_NULL_HANDLE && slots.sets[0] != slots.sets[64]);
+
+    // NOTE(gr3yknigh1): Table itself has nothing to bind, every draw binds its resource's set. [2025/04/17]
+    vk_bindless_bind_table(table, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0);
+    test_expect(context, g_fake_vulkan.descriptor_set_binds_count == 0);
+
+    vk_bindless_bind_resource(table, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0, textures[64]);
+    test_expect(context, g_fake_vulkan.descriptor_set_binds_count == 1 && g_fake_vulkan.bound_descriptor_set == slots.sets[64]);
+
+    VkDescriptorSet first_set = slots.sets[0];
+
+    vk_bindless_remove(&table, textures[0], 1);
+    vk_bindless_collect(&table, 1);
+
+    Vk_Bindless_Handle reused = test_add_texture(&table, 65);
+    test_expect(context, vk_bindless_is_valid(table, reused) && !vk_bindless_is_valid(table, textures[0]));
+    test_expect(context, slots.sets[0] == first_set && table.descriptor_pools.size() == 2);
+
+    vk_bindless_bind_resource(table, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS, VK_NULL_HANDLE, 0, reused);
+    test_expect(context, g_fake_vulkan.bound_descriptor_set == first_set);
+
+    vk_bindless_destroy(&table);
+    test_expect(context, g_fake_vulkan.objects_count == 0);
+}
+
+void
+test_vk_bindless(Test_Context *context)
+{
+    test_vk_bindless_handles(context);
+    test_vk_bindless_pooled(context);
+}
@@ -0,0 +1,192 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/vk_memory.h"
+#include "../hello-vk/vk_draw_queue.h"
+#include "fake_vulkan.h"
+#include "test.h"
+
+struct Test_Draw_Queue {
+    Vk_Allocator  allocator;
+    Vk_Draw_Queue queue;
+
+    // NOTE(gr3yknigh1): Only compared, never used, any distinct non-null handles work. [2025/04/16]
+    std::array<VkPipeline, 2>   pipelines     = {};
+    std::array<VkBuffer, 2>     index_buffers = {};
+    std::array<uint32_t, 2>     pipeline_ids  = {};
+    std::array<uint32_t, 2>     mesh_ids      = {};
+    std::array<Vk_Draw_Mesh, 2> meshes        = {};
+    uint32_t                    material_id   = 0;
+};
+
+static bool
+test_draw_queue_init(Test_Draw_Queue *test, uint32_t max_instances)
+{
+    fake_vulkan_reset(false);
+
+    vk_allocator_init(&test->allocator, fake_vulkan_capabilities(), fake_vulkan_device());
+    if (vk_draw_queue_init(&test->queue, &test->allocator, 2, max_instances, sizeof(uint32_t), VK_NULL_HANDLE, 0) != VK_SUCCESS) {
+        return false;
+    }
+
+    test->material_id = vk_draw_queue_add_material(&test->queue, VK_NULL_HANDLE);
+
+    for (uint32_t index = 0; index < 2; ++index) {
+        test->pipelines[index] = reinterpret_cast<VkPipeline>(static_cast<uintptr_t>(0x100 + index));
+        test->index_buffers[index] = reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(0x200 + index));
+
+        test->meshes[index].index_buffer = test->index_buffers[index];
+        test->meshes[index].index_count = 3 + index * 3;
+        test->meshes[index].first_index = index * 3;
+        test->meshes[index].vertex_offset = static_cast<int32_t>(index * 4);
+
+        test->pipeline_ids[index] = vk_draw_queue_add_pipeline(&test->queue, &test->pipelines[index]);
+        test->mesh_ids[index] = vk_draw_queue_add_mesh(&test->queue, test->meshes[index]);
+    }
+
+    return true;
+}
+
+static void
+test_draw_queue_destroy(Test_Draw_Queue *test)
+{
+    vk_draw_queue_destroy(&test->queue);
+    vk_allocator_destroy(&test->allocator);
+}
+
+static uint64_t
+test_draw_key(const Test_Draw_Queue &test, uint32_t pass, uint32_t pipeline, uint32_t mesh, uint32_t depth)
+{
+    return vk_draw_key(pass, test.pipeline_ids[pipeline], test.material_id, test.mesh_ids[mesh], depth);
+}
+
+///
+/// @brief Draws pushed out of order come out sorted by pass, pipeline, mesh and depth, equal keys in push order, and
+/// only depth differences are merged into one batch.
+///
+static void
+test_vk_draw_queue_sort(Test_Context *context)
+{
+    Test_Draw_Queue test;
+    if (!test_expect(context, test_draw_queue_init(&test, 16))) {
+        return;
+    }
+
+    struct Test_Draw {
+        uint64_t key;
+        uint32_t tag;
+    };
+
+    // NOTE(gr3yknigh1): Tag is the instance data, so written order shows where each draw went. [2025/04/16]
+    const std::array<Test_Draw, 7> draws = {{
+        { test_draw_key(test, 0, 1, 0, 5), 0 },
+        { test_draw_key(test, 0, 0, 1, 2), 1 },
+        { test_draw_key(test, 0, 0, 0, 9), 2 },
+        { test_draw_key(test, 0, 1, 0, 1), 3 },
+        { test_draw_key(test, 0, 0, 1, 2), 4 },
+        { test_draw_key(test, 0, 0, 0, 3), 5 },
+        { test_draw_key(test, 1, 0, 0, 0), 6 },
+    }};
+
+    vk_draw_queue_begin(&test.queue, 1);
+    for (const Test_Draw &draw : draws) {
+        vk_draw_queue_push(&test.queue, draw.key, &draw.tag);
+    }
+    vk_draw_queue_end(&test.queue);
+
+    const uint32_t *instances = static_cast<const uint32_t *>(test.queue.instance_allocations[1].mapped);
+    const std::array<uint32_t, 7> expected_tags = { 5, 2, 1, 4, 3, 0, 6 };
+
+    for (uint32_t position = 0; position < expected_tags.size(); ++position) {
+        test_expect(context, instances[position] == expected_tags[position]);
+    }
+
+    // NOTE(gr3yknigh1): Batch key is of its first draw, i.e. the one with the lowest depth. [2025/04/16]
+    const std::array<Vk_Draw_Batch, 4> expected_batches = {{
+        { draws[5].key, 0, 2 },
+        { draws[1].key, 2, 2 },
+        { draws[3].key, 4, 2 },
+        { draws[6].key, 6, 1 },
+    }};
+
+    if (!test_expect(context, test.queue.batches.size() == expected_batches.size())) {
+        test_draw_queue_destroy(&test);
+        return;
+    }
+
+    for (uint32_t index = 0; index < expected_batches.size(); ++index) {
+        const Vk_Draw_Batch &batch = test.queue.batches[index];
+        test_expect(context, batch.key == expected_batches[index].key);
+        test_expect(context, batch.first_instance == expected_batches[index].first_instance);
+        test_expect(context, batch.instances_count == expected_batches[index].instances_count);
+    }
+
+    test_expect(context, test.queue.stats.draws_count == draws.size());
+
+    // NOTE(gr3yknigh1): Each batch is one instanced draw, binds only change between batches. [2025/04/16]
+    vk_draw_queue_record(&test.queue, VK_NULL_HANDLE, nullptr);
+
+    const std::array<uint32_t, 4> expected_pipelines = { 0, 0, 1, 0 };
+    const std::array<uint32_t, 4> expected_meshes = { 0, 1, 0, 0 };
+
+    if (test_expect(context, g_fake_vulkan.draws.size() == expected_batches.size())) {
+        for (uint32_t index = 0; index < expected_batches.size(); ++index) {
+            const Fake_Draw &draw = g_fake_vulkan.draws[index];
+            const Vk_Draw_Mesh &mesh = test.meshes[expected_meshes[index]];
+
+            test_expect(context, draw.pipeline == test.pipelines[expected_pipelines[index]]);
+            test_expect(context, draw.index_buffer == mesh.index_buffer);
+            test_expect(context, draw.index_count == mesh.index_count && draw.first_index == mesh.first_index);
+            test_expect(context, draw.vertex_offset == mesh.vertex_offset);
+            test_expect(context, draw.first_instance == expected_batches[index].first_instance);
+            test_expect(context, draw.instances_count == expected_batches[index].instances_count);
+        }
+    }
+
+    // NOTE(gr3yknigh1): Meshes have their own index buffers, last batch keeps the buffers of the one before it. [2025/04/17]
+    const Vk_Draw_Queue_Stats &stats = test.queue.stats;
+    test_expect(context, stats.draw_calls_count == 4 && stats.pipeline_binds_count == 3 && stats.buffer_binds_count == 3);
+
+    test_draw_queue_destroy(&test);
+    test_expect(context, g_fake_vulkan.objects_count == 0 && g_fake_vulkan.device_memory_count == 0);
+}
+
+///
+/// @brief Draws past `max_instances` are dropped and counted, the frame's draws still make one batch.
+///
+static void
+test_vk_draw_queue_overflow(Test_Context *context)
+{
+    Test_Draw_Queue test;
+    if (!test_expect(context, test_draw_queue_init(&test, 4))) {
+        return;
+    }
+
+    // NOTE(gr3yknigh1): Empty frame records nothing. [2025/04/16]
+    vk_draw_queue_begin(&test.queue, 0);
+    vk_draw_queue_end(&test.queue);
+    vk_draw_queue_record(&test.queue, VK_NULL_HANDLE, nullptr);
+    test_expect(context, test.queue.batches.empty() && g_fake_vulkan.draws.empty());
+
+    vk_draw_queue_begin(&test.queue, 0);
+    for (uint32_t tag = 0; tag < 6; ++tag) {
+        vk_draw_queue_push(&test.queue, test_draw_key(test, 0, 1, 1, 6 - tag), &tag);
+    }
+    vk_draw_queue_end(&test.queue);
+
+    test_expect(context, test.queue.stats.dropped_count == 2 && test.queue.stats.draws_count == 4);
+    test_expect(context, test.queue.batches.size() == 1 && test.queue.batches[0].instances_count == 4);
+
+    // NOTE(gr3yknigh1): First four pushed are kept, sorted by depth, which goes down with the tag. [2025/04/16]
+    const uint32_t *instances = static_cast<const uint32_t *>(test.queue.instance_allocations[0].mapped);
+    test_expect(context, instances[0] == 3 && instances[1] == 2 && instances[2] == 1 && instances[3] == 0);
+
+    test_draw_queue_destroy(&test);
+}
+
+void
+test_vk_draw_queue(Test_Context *context)
+{
+    test_vk_draw_queue_sort(context);
+    test_vk_draw_queue_overflow(context);
+}
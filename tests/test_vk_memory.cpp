@@ -0,0 +1,163 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/vk_memory.h"
+#include "fake_vulkan.h"
+#include "test.h"
+
+static bool
+test_ranges_equal(const Vk_Memory_Block &block, std::initializer_list<Vk_Memory_Range> expected)
+{
+    if (block.free_ranges.size() != expected.size()) {
+        return false;
+    }
+
+    const Vk_Memory_Range *range = block.free_ranges.data();
+    for (const Vk_Memory_Range &expected_range : expected) {
+        if (range->offset != expected_range.offset || range->size != expected_range.size) {
+            return false;
+        }
+        ++range;
+    }
+    return true;
+}
+
+static VkMemoryRequirements
+test_requirements(VkDeviceSize size, VkDeviceSize alignment)
+{
+    VkMemoryRequirements requirements = {};
+    requirements.size = size;
+    requirements.alignment = alignment;
+    requirements.memoryTypeBits = 0x7;
+    return requirements;
+}
+
+///
+/// @brief First fit splits off leading padding and tail, free merges with both neighbours back into one range.
+///
+static void
+test_vk_memory_split_merge(Test_Context *context)
+{
+    fake_vulkan_reset(false);
+
+    Vk_Allocator allocator = {};
+    vk_allocator_init(&allocator, fake_vulkan_capabilities(), fake_vulkan_device());
+
+    // NOTE(gr3yknigh1): Heap of the fake device is small, its blocks are 1/8 of it. [2025/04/16]
+    VkDeviceSize block_size = s_fake_vulkan_heap_size / 8;
+    test_expect(context, allocator.block_sizes[0] == block_size);
+
+    Vk_Allocation a = {};
+    Vk_Allocation b = {};
+    Vk_Allocation c = {};
+
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(1024, 256), Vk_Memory_Usage::Gpu_Only, true, &a) == VK_SUCCESS);
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(1000, 8), Vk_Memory_Usage::Gpu_Only, true, &b) == VK_SUCCESS);
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(512, 4096), Vk_Memory_Usage::Gpu_Only, true, &c) == VK_SUCCESS);
+
+    if (!test_expect(context, a.block != nullptr && a.block == b.block && b.block == c.block)) {
+        vk_allocator_destroy(&allocator);
+        return;
+    }
+
+    const Vk_Memory_Block &block = *a.block;
+
+    test_expect(context, a.offset == 0);
+    test_expect(context, b.offset == 1024);
+    test_expect(context, c.offset == 4096);
+    test_expect(context, block.used == 1024 + 1000 + 512);
+    test_expect(context, test_ranges_equal(block, { { 2024, 4096 - 2024 }, { 4608, block_size - 4608 } }));
+
+    // NOTE(gr3yknigh1): Padding range in front of `c` is reused by the first fit. [2025/04/16]
+    Vk_Allocation d = {};
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(64, 64), Vk_Memory_Usage::Gpu_Only, true, &d) == VK_SUCCESS);
+    test_expect(context, d.block == &block && d.offset == 2048);
+    test_expect(context, test_ranges_equal(block, { { 2024, 24 }, { 2112, 4096 - 2112 }, { 4608, block_size - 4608 } }));
+
+    vk_allocator_free(&allocator, &b);
+    test_expect(context, b.memory == VK_NULL_HANDLE);
+    test_expect(context, test_ranges_equal(block, { { 1024, 1024 }, { 2112, 4096 - 2112 }, { 4608, block_size - 4608 } }));
+
+    vk_allocator_free(&allocator, &d);
+    test_expect(context, test_ranges_equal(block, { { 1024, 4096 - 1024 }, { 4608, block_size - 4608 } }));
+
+    vk_allocator_free(&allocator, &a);
+    test_expect(context, test_ranges_equal(block, { { 0, 4096 }, { 4608, block_size - 4608 } }));
+
+    Vk_Allocator_Stats stats = vk_allocator_get_stats(&allocator);
+    test_expect(context, stats.largest_free_range == block_size - 4608);
+    test_expect(context, stats.fragmentation > 0.0f);
+
+    vk_allocator_free(&allocator, &c);
+    test_expect(context, test_ranges_equal(block, { { 0, block_size } }));
+    test_expect(context, block.used == 0);
+
+    // NOTE(gr3yknigh1): The only block of its kind is kept for the next allocation. [2025/04/16]
+    stats = vk_allocator_get_stats(&allocator);
+    test_expect(context, stats.blocks_count == 1 && stats.allocations_count == 0);
+    test_expect(context, stats.fragmentation == 0.0f);
+    test_expect(context, g_fake_vulkan.device_memory_count == 1);
+
+    vk_allocator_destroy(&allocator);
+    test_expect(context, g_fake_vulkan.device_memory_count == 0);
+}
+
+static void
+test_vk_memory_blocks(Test_Context *context)
+{
+    fake_vulkan_reset(false);
+
+    Vk_Allocator allocator = {};
+    vk_allocator_init(&allocator, fake_vulkan_capabilities(), fake_vulkan_device());
+
+    VkDeviceSize block_size = allocator.block_sizes[0];
+
+    // NOTE(gr3yknigh1): Bigger than half a block goes to its own `VkDeviceMemory`. [2025/04/16]
+    Vk_Allocation dedicated = {};
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(block_size / 2 + 1, 256), Vk_Memory_Usage::Gpu_Only, true, &dedicated) == VK_SUCCESS);
+    test_expect(context, dedicated.block == nullptr && dedicated.offset == 0);
+    test_expect(context, allocator.dedicated_count == 1);
+
+    // NOTE(gr3yknigh1): Buffers and images never share a block. [2025/04/16]
+    Vk_Allocation linear = {};
+    Vk_Allocation optimal = {};
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(256, 256), Vk_Memory_Usage::Gpu_Only, true, &linear) == VK_SUCCESS);
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(256, 256), Vk_Memory_Usage::Gpu_Only, false, &optimal) == VK_SUCCESS);
+    test_expect(context, linear.block != nullptr && optimal.block != nullptr && linear.block != optimal.block);
+
+    // NOTE(gr3yknigh1): Second block of the same kind is released once it is empty. [2025/04/16]
+    Vk_Allocation first_half = {};
+    Vk_Allocation second_half = {};
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(block_size / 2, 256), Vk_Memory_Usage::Gpu_Only, true, &first_half) == VK_SUCCESS);
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(block_size / 2, 256), Vk_Memory_Usage::Gpu_Only, true, &second_half) == VK_SUCCESS);
+    test_expect(context, first_half.block == linear.block && second_half.block != linear.block);
+    test_expect(context, vk_allocator_get_stats(&allocator).blocks_count == 3);
+
+    vk_allocator_free(&allocator, &second_half);
+    test_expect(context, vk_allocator_get_stats(&allocator).blocks_count == 2);
+
+    // NOTE(gr3yknigh1): Host visible memory is mapped, allocation points at its own offset. [2025/04/16]
+    Vk_Allocation upload = {};
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(128, 64), Vk_Memory_Usage::Cpu_To_Gpu, true, &upload) == VK_SUCCESS);
+    test_expect(context, upload.memory_type == 1 && upload.mapped != nullptr);
+
+    Vk_Allocation readback = {};
+    test_expect(context, vk_allocator_allocate(&allocator, test_requirements(128, 64), Vk_Memory_Usage::Gpu_To_Cpu, true, &readback) == VK_SUCCESS);
+    test_expect(context, readback.memory_type == 2);
+
+    for (Vk_Allocation *allocation : { &dedicated, &linear, &optimal, &first_half, &upload, &readback }) {
+        vk_allocator_free(&allocator, allocation);
+    }
+
+    test_expect(context, allocator.allocations_count == 0 && allocator.dedicated_count == 0);
+
+    vk_allocator_destroy(&allocator);
+    test_expect(context, g_fake_vulkan.device_memory_count == 0);
+}
+
+void
+test_vk_memory(Test_Context *context)
+{
+    test_vk_memory_split_merge(context);
+    test_vk_memory_blocks(context);
+}
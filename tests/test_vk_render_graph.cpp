@@ -0,0 +1,322 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/vk_memory.h"
+#include "../hello-vk/vk_deletion_queue.h"
+#include "../hello-vk/vk_render_graph.h"
+#include "fake_vulkan.h"
+#include "test.h"
+
+struct Test_Render_Graph {
+    Vk_Allocator      allocator;
+    Vk_Deletion_Queue deletion_queue;
+    Vk_Render_Graph   graph;
+};
+
+// NOTE(gr3yknigh1): Pass procs append their name, so execution order can be compared with the compiled one. [2025/04/17]
+static std::vector<std::string> s_executed_passes;
+
+static void
+test_pass_proc(VkCommandBuffer command_buffer, void *user_data)
+{
+    s_executed_passes.push_back(static_cast<const char *>(user_data));
+}
+
+static void
+test_render_graph_init(Test_Render_Graph *test)
+{
+    fake_vulkan_reset(false);
+    s_executed_passes.clear();
+
+    vk_allocator_init(&test->allocator, fake_vulkan_capabilities(), fake_vulkan_device());
+    vk_deletion_queue_init(&test->deletion_queue, fake_vulkan_device(), &test->allocator);
+    vk_render_graph_init(&test->graph, fake_vulkan_device(), &test->allocator, &test->deletion_queue);
+}
+
+static void
+test_render_graph_destroy(Test_Render_Graph *test)
+{
+    vk_render_graph_destroy(&test->graph);
+    vk_deletion_queue_destroy(&test->deletion_queue);
+    vk_allocator_destroy(&test->allocator);
+}
+
+static uint32_t
+test_add_pass(Vk_Render_Graph *graph, const char *name, bool has_side_effects = false)
+{
+    return vk_render_graph_add_pass(graph, name, test_pass_proc, const_cast<char *>(name), has_side_effects);
+}
+
+static uint32_t
+test_import_buffer(Vk_Render_Graph *graph, const char *name, uint32_t index, const Vk_Graph_State &initial_state)
+{
+    VkBuffer buffer = reinterpret_cast<VkBuffer>(static_cast<uintptr_t>(0x100 + index));
+    return vk_render_graph_import_buffer(graph, name, buffer, initial_state, false);
+}
+
+///
+/// @brief Imported color target, written by the graph and transitioned to TRANSFER_SRC after it.
+///
+static uint32_t
+test_import_color(Vk_Render_Graph *graph)
+{
+    Vk_Graph_State initial_state = {};
+    initial_state.stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    initial_state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    Vk_Graph_State final_state = {};
+    final_state.stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    final_state.access = VK_ACCESS_TRANSFER_READ_BIT;
+    final_state.layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkImage image = reinterpret_cast<VkImage>(static_cast<uintptr_t>(0x200));
+    return vk_render_graph_import_image(
+        graph, "color", image, VK_NULL_HANDLE, VK_IMAGE_ASPECT_COLOR_BIT, initial_state, final_state, true);
+}
+
+///
+/// @brief Declares the graph of `test_vk_render_graph_order`. Compute and draw chains are independent until they
+/// meet at the color target, debug chain and the pass without uses feed nothing.
+///
+static void
+test_declare_order_graph(Vk_Render_Graph *graph)
+{
+    vk_render_graph_begin(graph);
+
+    uint32_t color = test_import_color(graph);
+    uint32_t indirect = test_import_buffer(graph, "indirect", 0, {});
+    uint32_t particles = test_import_buffer(graph, "particles", 1, {});
+    uint32_t debug = test_import_buffer(graph, "debug", 2, {});
+    uint32_t debug_stats = test_import_buffer(graph, "debug stats", 3, {});
+
+    uint32_t cull = test_add_pass(graph, "cull");
+    vk_render_graph_use(graph, cull, indirect, Vk_Graph_Usage::Storage_Write_Compute);
+
+    uint32_t draw = test_add_pass(graph, "draw");
+    vk_render_graph_use(graph, draw, indirect, Vk_Graph_Usage::Indirect_Read);
+    vk_render_graph_use(graph, draw, color, Vk_Graph_Usage::Color_Attachment);
+
+    uint32_t simulate = test_add_pass(graph, "simulate");
+    vk_render_graph_use(graph, simulate, particles, Vk_Graph_Usage::Storage_Write_Compute);
+
+    uint32_t particles_draw = test_add_pass(graph, "particles draw");
+    vk_render_graph_use(graph, particles_draw, particles, Vk_Graph_Usage::Storage_Read_Vertex);
+    vk_render_graph_use(graph, particles_draw, color, Vk_Graph_Usage::Color_Attachment);
+
+    uint32_t debug_pass = test_add_pass(graph, "debug");
+    vk_render_graph_use(graph, debug_pass, debug, Vk_Graph_Usage::Storage_Write_Compute);
+
+    uint32_t debug_stats_pass = test_add_pass(graph, "debug stats");
+    vk_render_graph_use(graph, debug_stats_pass, debug, Vk_Graph_Usage::Storage_Read_Compute);
+    vk_render_graph_use(graph, debug_stats_pass, debug_stats, Vk_Graph_Usage::Storage_Write_Compute);
+
+    test_add_pass(graph, "timestamps", true);
+    test_add_pass(graph, "idle");
+}
+
+///
+/// @brief Passes nothing reads from are culled, whole chains of them. The rest is sorted by dependencies, and of
+/// ready passes the one independent of the pass just scheduled goes first.
+///
+static void
+test_vk_render_graph_order(Test_Context *context)
+{
+    Test_Render_Graph test;
+    test_render_graph_init(&test);
+
+    Vk_Render_Graph &graph = test.graph;
+
+    test_declare_order_graph(&graph);
+    if (!test_expect(context, vk_render_graph_compile(&graph, 1) == VK_SUCCESS)) {
+        test_render_graph_destroy(&test);
+        return;
+    }
+
+    test_expect(context, graph.stats.passes_count == 5 && graph.stats.culled_passes_count == 3);
+
+    // NOTE(gr3yknigh1): Declared as cull, draw, simulate, particles draw and timestamps. [2025/04/17]
+    const std::vector<std::string> expected_order = { "cull", "simulate", "draw", "timestamps", "particles draw" };
+
+    vk_render_graph_execute(graph, VK_NULL_HANDLE);
+    test_expect(context, s_executed_passes == expected_order);
+
+    // NOTE(gr3yknigh1): Same structure declared again is not compiled again. [2025/04/17]
+    test_declare_order_graph(&graph);
+    test_expect(context, vk_render_graph_compile(&graph, 2) == VK_SUCCESS && graph.stats.compiles_count == 1);
+
+    test_render_graph_destroy(&test);
+}
+
+///
+/// @brief One `vkCmdPipelineBarrier` per pass at most, buffer hazards merged into a memory barrier. The barrier of
+/// a read covers following reads, until a write.
+///
+static void
+test_vk_render_graph_barriers(Test_Context *context)
+{
+    Test_Render_Graph test;
+    test_render_graph_init(&test);
+
+    Vk_Render_Graph &graph = test.graph;
+    vk_render_graph_begin(&graph);
+
+    // NOTE(gr3yknigh1): Objects were uploaded before the graph, indirect commands are written from scratch. [2025/04/17]
+    Vk_Graph_State uploaded_state = {};
+    uploaded_state.stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    uploaded_state.access = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    uint32_t color = test_import_color(&graph);
+    uint32_t objects = test_import_buffer(&graph, "objects", 0, uploaded_state);
+    uint32_t indirect = test_import_buffer(&graph, "indirect", 1, {});
+
+    uint32_t cull = test_add_pass(&graph, "cull");
+    vk_render_graph_use(&graph, cull, objects, Vk_Graph_Usage::Storage_Read_Compute);
+    vk_render_graph_use(&graph, cull, indirect, Vk_Graph_Usage::Storage_Write_Compute);
+
+    uint32_t draw = test_add_pass(&graph, "draw");
+    vk_render_graph_use(&graph, draw, indirect, Vk_Graph_Usage::Indirect_Read);
+    vk_render_graph_use(&graph, draw, objects, Vk_Graph_Usage::Storage_Read_Vertex);
+    vk_render_graph_use(&graph, draw, color, Vk_Graph_Usage::Color_Attachment);
+
+    if (!test_expect(context, vk_render_graph_compile(&graph, 1) == VK_SUCCESS)) {
+        test_render_graph_destroy(&test);
+        return;
+    }
+
+    // NOTE(gr3yknigh1): Objects before cull (for both passes), indirect and color before draw, color after it. [2025/04/17]
+    test_expect(context, graph.stats.uses_count == 5 && graph.stats.barriers_count == 4 && graph.stats.batches_count == 3);
+
+    const Vk_Graph_Barrier &objects_barrier = graph.barriers[0];
+    test_expect(context, objects_barrier.resource == objects && objects_barrier.src.access == VK_ACCESS_TRANSFER_WRITE_BIT);
+    test_expect(context, objects_barrier.dst.stage == (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT));
+
+    vk_render_graph_execute(graph, VK_NULL_HANDLE);
+
+    const std::vector<Fake_Pipeline_Barrier> &barriers = g_fake_vulkan.pipeline_barriers;
+    if (test_expect(context, barriers.size() == 3)) {
+        test_expect(context, barriers[0].memory_barriers_count == 1 && barriers[0].image_barriers.empty());
+        test_expect(context, barriers[0].src_stages == VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+        test_expect(context, barriers[1].memory_barriers_count == 1);
+        test_expect(context, barriers[1].src_stages == (VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT));
+        test_expect(context, barriers[1].dst_stages & VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+
+        if (test_expect(context, barriers[1].image_barriers.size() == 1)) {
+            const VkImageMemoryBarrier &image_barrier = barriers[1].image_barriers[0];
+            test_expect(context, image_barrier.oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+            test_expect(context, image_barrier.newLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        }
+
+        test_expect(context, barriers[2].memory_barriers_count == 0);
+        if (test_expect(context, barriers[2].image_barriers.size() == 1)) {
+            test_expect(context, barriers[2].image_barriers[0].newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        }
+    }
+
+    test_render_graph_destroy(&test);
+}
+
+///
+/// @brief Transients whose lifetimes don't overlap share memory, the one overlapping both gets its own. First use of
+/// a transient waits for uses of the memory by the one before it.
+///
+static void
+test_vk_render_graph_aliasing(Test_Context *context)
+{
+    Test_Render_Graph test;
+    test_render_graph_init(&test);
+
+    Vk_Render_Graph &graph = test.graph;
+    vk_render_graph_begin(&graph);
+
+    Vk_Graph_Image_Desc desc = {};
+    desc.format = VK_FORMAT_R8G8B8A8_UNORM;
+    desc.extent = { 1024, 1024 };
+
+    Vk_Graph_Image_Desc depth_desc = {};
+    depth_desc.format = VK_FORMAT_D32_SFLOAT;
+    depth_desc.extent = { 512, 512 };
+    depth_desc.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+    uint32_t color = test_import_color(&graph);
+    uint32_t histogram = test_import_buffer(&graph, "histogram", 0, {});
+    uint32_t bloom = vk_render_graph_create_image(&graph, "bloom", desc);
+    uint32_t blur = vk_render_graph_create_image(&graph, "blur", desc);
+    uint32_t depth = vk_render_graph_create_image(&graph, "depth", depth_desc);
+
+    uint32_t bloom_pass = test_add_pass(&graph, "bloom");
+    vk_render_graph_use(&graph, bloom_pass, bloom, Vk_Graph_Usage::Color_Attachment);
+
+    uint32_t composite = test_add_pass(&graph, "composite");
+    vk_render_graph_use(&graph, composite, bloom, Vk_Graph_Usage::Sampled_Fragment);
+    vk_render_graph_use(&graph, composite, depth, Vk_Graph_Usage::Depth_Attachment);
+    vk_render_graph_use(&graph, composite, color, Vk_Graph_Usage::Color_Attachment);
+    vk_render_graph_use(&graph, composite, histogram, Vk_Graph_Usage::Storage_Write_Compute);
+
+    // NOTE(gr3yknigh1): Reads the histogram, so it can't be moved before composite, next to bloom. [2025/04/17]
+    uint32_t blur_pass = test_add_pass(&graph, "blur");
+    vk_render_graph_use(&graph, blur_pass, histogram, Vk_Graph_Usage::Storage_Read_Compute);
+    vk_render_graph_use(&graph, blur_pass, blur, Vk_Graph_Usage::Color_Attachment);
+
+    uint32_t resolve = test_add_pass(&graph, "resolve");
+    vk_render_graph_use(&graph, resolve, blur, Vk_Graph_Usage::Sampled_Fragment);
+    vk_render_graph_use(&graph, resolve, depth, Vk_Graph_Usage::Depth_Attachment);
+    vk_render_graph_use(&graph, resolve, color, Vk_Graph_Usage::Color_Attachment);
+
+    if (!test_expect(context, vk_render_graph_compile(&graph, 1) == VK_SUCCESS)) {
+        test_render_graph_destroy(&test);
+        return;
+    }
+
+    const Vk_Render_Graph_Stats &stats = graph.stats;
+    test_expect(context, stats.passes_count == 4 && stats.transients_count == 3 && graph.blocks.size() == 2);
+    test_expect(context, stats.aliased_bytes < stats.transient_bytes);
+    test_expect(context, stats.aliased_bytes == 5ull * 1024 * 1024 && stats.transient_bytes == 9ull * 1024 * 1024);
+
+    const Vk_Graph_Transient &bloom_transient = graph.transients[graph.resource_transients[bloom]];
+    const Vk_Graph_Transient &blur_transient = graph.transients[graph.resource_transients[blur]];
+    const Vk_Graph_Transient &depth_transient = graph.transients[graph.resource_transients[depth]];
+
+    test_expect(context, bloom_transient.first_pass == 0 && bloom_transient.last_pass == 1);
+    test_expect(context, blur_transient.first_pass == 2 && blur_transient.last_pass == 3);
+    test_expect(context, bloom_transient.block == blur_transient.block && bloom_transient.offset == blur_transient.offset);
+    test_expect(context, depth_transient.block != bloom_transient.block);
+
+    VkImage bloom_image = vk_render_graph_image(graph, bloom);
+    test_expect(context, bloom_image != VK_NULL_HANDLE && bloom_image != vk_render_graph_image(graph, blur));
+    test_expect(context, vk_render_graph_image_view(graph, depth) != VK_NULL_HANDLE);
+
+    // NOTE(gr3yknigh1): Blur's memory was sampled as bloom just before. [2025/04/17]
+    bool has_blur_barrier = false;
+    for (const Vk_Graph_Barrier &barrier : graph.barriers) {
+        if (barrier.resource == blur && barrier.src.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+            has_blur_barrier = (barrier.src.stage & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) != 0;
+        }
+    }
+    test_expect(context, has_blur_barrier);
+
+    // NOTE(gr3yknigh1): Image views of the 3 transients. Changed structure retires them to the deletion queue. [2025/04/17]
+    test_expect(context, g_fake_vulkan.objects_count == 3);
+
+    vk_render_graph_begin(&graph);
+    test_import_color(&graph);
+    test_add_pass(&graph, "timestamps", true);
+
+    test_expect(context, vk_render_graph_compile(&graph, 2) == VK_SUCCESS);
+    test_expect(context, graph.transients.empty() && graph.blocks.empty());
+    test_expect(context, g_fake_vulkan.objects_count == 3 && test.deletion_queue.pending.size() == 8);
+
+    vk_deletion_queue_collect(&test.deletion_queue, 1);
+    test_expect(context, g_fake_vulkan.objects_count == 0 && test.deletion_queue.pending.empty());
+
+    test_render_graph_destroy(&test);
+    test_expect(context, g_fake_vulkan.device_memory_count == 0);
+}
+
+void
+test_vk_render_graph(Test_Context *context)
+{
+    test_vk_render_graph_order(context);
+    test_vk_render_graph_barriers(context);
+    test_vk_render_graph_aliasing(context);
+}
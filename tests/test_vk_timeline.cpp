@@ -0,0 +1,155 @@
+#include "../hello-vk/stdafx.h"
+
+#include "../hello-vk/vk_device.h"
+#include "../hello-vk/vk_timeline.h"
+#include "fake_vulkan.h"
+#include "test.h"
+
+static VkResult
+test_timeline_submit(Vk_Timeline *timeline, const Vk_Submit_Waits *waits, uint64_t *value)
+{
+    return vk_timeline_submit(timeline, fake_vulkan_queue(), nullptr, 0, waits, VK_NULL_HANDLE, value);
+}
+
+///
+/// @brief Device without timeline semaphores: every submit gets a pooled fence, the newest signaled one gives the
+/// completed value.
+///
+static void
+test_vk_timeline_fences(Test_Context *context)
+{
+    fake_vulkan_reset(false);
+
+    Vk_Timeline timeline;
+    test_expect(context, vk_timeline_init(&timeline, fake_vulkan_device(), false, "test") == VK_SUCCESS);
+    test_expect(context, timeline.semaphore == VK_NULL_HANDLE);
+
+    uint64_t values[3] = {};
+    for (uint64_t &value : values) {
+        test_expect(context, test_timeline_submit(&timeline, nullptr, &value) == VK_SUCCESS);
+    }
+
+    test_expect(context, values[0] == 1 && values[1] == 2 && values[2] == 3);
+    test_expect(context, timeline.submitted_value == 3 && timeline.pending_fences.size() == 3);
+    test_expect(context, timeline.fences_count == 3 && g_fake_vulkan.fences_count == 3);
+
+    test_expect(context, vk_timeline_poll(&timeline) == 0);
+    test_expect(context, !vk_timeline_is_completed(&timeline, 1));
+
+    // NOTE(gr3yknigh1): Queue got through two submits, their fences are reset and pooled. [2025/04/16]
+    fake_vulkan_complete_submits(2);
+
+    test_expect(context, vk_timeline_poll(&timeline) == 2);
+    test_expect(context, vk_timeline_is_completed(&timeline, 2) && !vk_timeline_is_completed(&timeline, 3));
+    test_expect(context, timeline.pending_fences.size() == 1 && timeline.free_fences.size() == 2);
+    test_expect(context, timeline.fence_resets_count == 2);
+
+    // NOTE(gr3yknigh1): Steady state reuses pooled fences instead of creating new ones. [2025/04/16]
+    uint64_t value = 0;
+    test_expect(context, test_timeline_submit(&timeline, nullptr, &value) == VK_SUCCESS && value == 4);
+    test_expect(context, timeline.fences_count == 3 && g_fake_vulkan.fences_count == 3);
+
+    // NOTE(gr3yknigh1): Completed value returns without touching the device. [2025/04/16]
+    test_expect(context, vk_timeline_wait(&timeline, 2) == VK_SUCCESS);
+    test_expect(context, vk_timeline_wait(&timeline, 0) == VK_SUCCESS);
+    test_expect(context, timeline.host_waits_count == 0 && g_fake_vulkan.fence_waits_count == 0);
+
+    // NOTE(gr3yknigh1): Waiting for 3 waits on its own fence, not the newest one. [2025/04/16]
+    test_expect(context, vk_timeline_wait(&timeline, 3) == VK_SUCCESS);
+    test_expect(context, timeline.completed_value == 3 && g_fake_vulkan.completed_submits_count == 3);
+    test_expect(context, timeline.host_waits_count == 1 && g_fake_vulkan.fence_waits_count == 1);
+
+    test_expect(context, vk_timeline_wait(&timeline, 4) == VK_SUCCESS);
+    test_expect(context, timeline.completed_value == 4 && timeline.pending_fences.empty());
+    test_expect(context, timeline.free_fences.size() == 3);
+
+    vk_timeline_destroy(&timeline);
+    test_expect(context, g_fake_vulkan.fences_count == 0);
+}
+
+///
+/// @brief Waits on a fence-backed timeline are done on host before submit, they can't be put into the submit.
+///
+static void
+test_vk_timeline_fence_waits(Test_Context *context)
+{
+    fake_vulkan_reset(false);
+
+    Vk_Timeline upload;
+    Vk_Timeline graphics;
+    vk_timeline_init(&upload, fake_vulkan_device(), false, "upload");
+    vk_timeline_init(&graphics, fake_vulkan_device(), false, "graphics");
+
+    uint64_t upload_value = 0;
+    test_expect(context, test_timeline_submit(&upload, nullptr, &upload_value) == VK_SUCCESS);
+
+    Vk_Submit_Waits waits;
+    vk_submit_waits_add_timeline(&waits, &upload, upload_value, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+    uint64_t graphics_value = 0;
+    test_expect(context, test_timeline_submit(&graphics, &waits, &graphics_value) == VK_SUCCESS);
+
+    test_expect(context, vk_timeline_is_completed(&upload, upload_value));
+    test_expect(context, upload.host_waits_count == 1);
+    test_expect(context, g_fake_vulkan.last_submit_waits_count == 0);
+    test_expect(context, !g_fake_vulkan.last_submit_has_timeline_info);
+
+    // NOTE(gr3yknigh1): Graphics submit itself is still in flight. [2025/04/16]
+    test_expect(context, !vk_timeline_is_completed(&graphics, graphics_value));
+
+    vk_timeline_destroy(&graphics);
+    vk_timeline_destroy(&upload);
+    test_expect(context, g_fake_vulkan.fences_count == 0);
+}
+
+///
+/// @brief Fence-backed timeline which waits on a semaphore-backed one still chains the wait value into its submit.
+///
+static void
+test_vk_timeline_mixed_waits(Test_Context *context)
+{
+    fake_vulkan_reset(true);
+
+    Vk_Timeline compute;
+    Vk_Timeline graphics;
+    test_expect(context, vk_timeline_init(&compute, fake_vulkan_device(), true, "compute") == VK_SUCCESS);
+    test_expect(context, vk_timeline_init(&graphics, fake_vulkan_device(), false, "graphics") == VK_SUCCESS);
+    test_expect(context, compute.semaphore != VK_NULL_HANDLE && graphics.semaphore == VK_NULL_HANDLE);
+
+    uint64_t compute_value = 0;
+    test_expect(context, test_timeline_submit(&compute, nullptr, &compute_value) == VK_SUCCESS);
+    test_expect(context, g_fake_vulkan.last_submit_has_timeline_info);
+
+    // NOTE(gr3yknigh1): Binary semaphore, e.g. of swapchain acquire. [2025/04/16]
+    VkSemaphoreCreateInfo semaphore_create_info = {};
+    semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkSemaphore acquire_semaphore = VK_NULL_HANDLE;
+    vkCreateSemaphore(fake_vulkan_device(), &semaphore_create_info, nullptr, &acquire_semaphore);
+
+    Vk_Submit_Waits waits;
+    vk_submit_waits_add_semaphore(&waits, acquire_semaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    vk_submit_waits_add_timeline(&waits, &compute, compute_value, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+    test_expect(context, test_timeline_submit(&graphics, &waits, nullptr) == VK_SUCCESS);
+
+    test_expect(context, g_fake_vulkan.last_submit_waits_count == 2);
+    test_expect(context, g_fake_vulkan.last_submit_has_timeline_info);
+    test_expect(context, g_fake_vulkan.last_submit_wait_values.size() == 2 && g_fake_vulkan.last_submit_wait_values[1] == compute_value);
+
+    // NOTE(gr3yknigh1): Semaphore-backed wait goes to the device, host doesn't block on it. [2025/04/16]
+    test_expect(context, compute.host_waits_count == 0);
+
+    vkDestroySemaphore(fake_vulkan_device(), acquire_semaphore, nullptr);
+    vk_timeline_destroy(&graphics);
+    vk_timeline_destroy(&compute);
+    test_expect(context, g_fake_vulkan.fences_count == 0 && g_fake_vulkan.semaphores_count == 0);
+}
+
+void
+test_vk_timeline(Test_Context *context)
+{
+    test_vk_timeline_fences(context);
+    test_vk_timeline_fence_waits(context);
+    test_vk_timeline_mixed_waits(context);
+}